@@ -0,0 +1,67 @@
+/**
+ * @file    bench_template.cpp
+ * @brief   Benchmark bodies for the C++ PID template (pid.hpp)
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ */
+
+#include "bench_template.h"
+#include "pid.hpp"
+
+namespace {
+
+template <typename Controller>
+float run(const bench_template_gains_t &gains, float setpoint, const float *measurements,
+          unsigned sample_mask, unsigned iterations)
+{
+    pid::Gains<float> g{};
+    g.kp = gains.kp;
+    g.ki = gains.ki;
+    g.kd = gains.kd;
+    g.dt = gains.dt;
+    g.out_min = gains.out_min;
+    g.out_max = gains.out_max;
+    g.integrator_min = gains.integrator_min;
+    g.integrator_max = gains.integrator_max;
+    g.derivative_lpf = gains.derivative_lpf;
+
+    Controller controller(g);
+    float acc = 0.0f;
+
+    for (unsigned i = 0; i < iterations; i++) {
+        acc += controller.compute(setpoint, measurements[i & sample_mask]);
+    }
+    return acc;
+}
+
+} // namespace
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+float bench_template_compute(bench_template_features_t features,
+                             const bench_template_gains_t *gains,
+                             float setpoint,
+                             const float *measurements,
+                             unsigned sample_mask,
+                             unsigned iterations)
+{
+    switch (features) {
+    case BENCH_TEMPLATE_P:
+        return run<pid::Pid<float, pid::Proportional>>(*gains, setpoint, measurements,
+                                                         sample_mask, iterations);
+    case BENCH_TEMPLATE_PID_LPF:
+        return run<pid::FullPid<float>>(*gains, setpoint, measurements, sample_mask, iterations);
+    default:
+        return run<pid::Pid<float, pid::Proportional, pid::Integral, pid::AntiWindup,
+                            pid::Derivative>>(*gains, setpoint, measurements, sample_mask,
+                                              iterations);
+    }
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
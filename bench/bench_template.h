@@ -0,0 +1,68 @@
+/**
+ * @file    bench_template.h
+ * @brief   Benchmark bodies for the C++ PID template (pid.hpp)
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * The template is only usable from C++, and C++ translation units
+ * cannot include pid.h next to the standard library, so pid_bench.c
+ * reaches the template through this C interface. The configuration is
+ * passed as plain floats copied from a pid_t.
+ */
+
+#ifndef BENCH_TEMPLATE_H_
+#define BENCH_TEMPLATE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Feature set compiled into the benchmarked controller
+ */
+typedef enum {
+    BENCH_TEMPLATE_P = 0,      /**< Proportional only */
+    BENCH_TEMPLATE_PID,        /**< P, I with anti-windup, D */
+    BENCH_TEMPLATE_PID_LPF     /**< Every feature (pid_t equivalent) */
+} bench_template_features_t;
+
+/**
+ * @brief Controller configuration, mirrors pid_init_advanced()
+ */
+typedef struct {
+    float kp;
+    float ki;
+    float kd;
+    float dt;
+    float out_min;
+    float out_max;
+    float integrator_min;
+    float integrator_max;
+    float derivative_lpf;
+} bench_template_gains_t;
+
+/**
+ * @brief Run compute() @p iterations times over a measurement buffer
+ *
+ * @param features      Feature set to instantiate
+ * @param gains         Configuration
+ * @param setpoint      Constant setpoint
+ * @param measurements  Measurement buffer (power-of-two length)
+ * @param sample_mask   Buffer length - 1
+ * @param iterations    Calls to compute()
+ * @return Sum of outputs (checksum)
+ */
+float bench_template_compute(bench_template_features_t features,
+                             const bench_template_gains_t *gains,
+                             float setpoint,
+                             const float *measurements,
+                             unsigned sample_mask,
+                             unsigned iterations);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_TEMPLATE_H_ */
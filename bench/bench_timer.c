@@ -0,0 +1,199 @@
+/**
+ * @file    bench_timer.c
+ * @brief   Host timing primitives for the benchmark harness
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Linux: clock_gettime(CLOCK_MONOTONIC) and perf_event_open() for core
+ * cycles and L1D read misses, cycles falling back to rdtsc when perf
+ * events are restricted (perf_event_paranoid, containers). Windows: QueryPerformanceCounter.
+ * Elsewhere: clock(), which has coarse resolution.
+ */
+
+#if defined(__linux__)
+#define _GNU_SOURCE
+#elif defined(__APPLE__)
+#define _DARWIN_C_SOURCE
+#endif
+
+#include "bench_timer.h"
+#include <stddef.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define HAVE_PERF 1
+#else
+#define HAVE_PERF 0
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define HAVE_TSC 1
+#else
+#define HAVE_TSC 0
+#endif
+
+static bench_cycle_source_t source = BENCH_CYCLES_NONE;
+
+#if HAVE_PERF
+static int perf_fd = -1;
+static int l1d_fd = -1;
+
+/* Open and start a user-space counter for this thread, any CPU; -1 on failure */
+static int open_perf(uint32_t type, uint64_t config)
+{
+    struct perf_event_attr attr;
+    int fd;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = type;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    return fd;
+}
+
+static int open_perf_cycles(void)
+{
+    perf_fd = open_perf(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    return perf_fd >= 0;
+}
+
+static uint64_t read_perf(int fd)
+{
+    uint64_t count = 0;
+
+    if (read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count)) {
+        return 0;
+    }
+    return count;
+}
+#endif
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+bench_cycle_source_t bench_timer_init(void)
+{
+#if HAVE_PERF
+    if (open_perf_cycles()) {
+        source = BENCH_CYCLES_PERF;
+        return source;
+    }
+#endif
+#if HAVE_TSC
+    source = BENCH_CYCLES_RDTSC;
+#else
+    source = BENCH_CYCLES_NONE;
+#endif
+    return source;
+}
+
+void bench_timer_close(void)
+{
+#if HAVE_PERF
+    if (perf_fd >= 0) {
+        close(perf_fd);
+        perf_fd = -1;
+    }
+    if (l1d_fd >= 0) {
+        close(l1d_fd);
+        l1d_fd = -1;
+    }
+#endif
+    source = BENCH_CYCLES_NONE;
+}
+
+uint64_t bench_now_ns(void)
+{
+#if defined(__linux__) || defined(__APPLE__)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#elif defined(_WIN32)
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (uint64_t)((double)count.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    return (uint64_t)((double)clock() * 1e9 / (double)CLOCKS_PER_SEC);
+#endif
+}
+
+uint64_t bench_cycles(void)
+{
+    switch (source) {
+#if HAVE_PERF
+    case BENCH_CYCLES_PERF:
+        return read_perf(perf_fd);
+#endif
+#if HAVE_TSC
+    case BENCH_CYCLES_RDTSC:
+        return (uint64_t)__rdtsc();
+#endif
+    default:
+        return 0;
+    }
+}
+
+int bench_l1d_init(void)
+{
+#if HAVE_PERF
+    if (l1d_fd < 0) {
+        l1d_fd = open_perf(PERF_TYPE_HW_CACHE,
+                           PERF_COUNT_HW_CACHE_L1D |
+                           ((uint64_t)PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                           ((uint64_t)PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    }
+    return l1d_fd >= 0;
+#else
+    return 0;
+#endif
+}
+
+uint64_t bench_l1d_misses(void)
+{
+#if HAVE_PERF
+    if (l1d_fd >= 0) {
+        return read_perf(l1d_fd);
+    }
+#endif
+    return 0;
+}
+
+const char *bench_cycle_source_name(bench_cycle_source_t src)
+{
+    switch (src) {
+    case BENCH_CYCLES_PERF:  return "perf_event";
+    case BENCH_CYCLES_RDTSC: return "rdtsc";
+    default:                 return "none";
+    }
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
@@ -0,0 +1,92 @@
+/**
+ * @file    bench_timer.h
+ * @brief   Host timing primitives for the benchmark harness
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Wall-clock nanoseconds, CPU cycle counts and (Linux) L1 data cache
+ * misses for host benchmarks.
+ * Kept in its own translation unit because the POSIX headers it needs
+ * define a pid_t that clashes with the controller type in pid.h.
+ */
+
+#ifndef BENCH_TIMER_H_
+#define BENCH_TIMER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+ * @brief Cycle counter backing bench_cycles()
+ */
+typedef enum {
+    BENCH_CYCLES_NONE = 0,     /**< No cycle counter, bench_cycles() returns 0 */
+    BENCH_CYCLES_RDTSC,        /**< x86 time-stamp counter (reference cycles) */
+    BENCH_CYCLES_PERF          /**< Linux perf_event_open() core cycles */
+} bench_cycle_source_t;
+
+/**
+ * @brief Open the best available cycle counter
+ *
+ * Tries perf_event_open() first (core cycles of this thread), then the
+ * time-stamp counter. Call once before timing.
+ *
+ * @return Selected cycle source
+ */
+bench_cycle_source_t bench_timer_init(void);
+
+/**
+ * @brief Release the cycle counter
+ */
+void bench_timer_close(void);
+
+/**
+ * @brief Monotonic wall-clock time
+ *
+ * @return Nanoseconds since an arbitrary epoch
+ */
+uint64_t bench_now_ns(void);
+
+/**
+ * @brief Current cycle count from the source chosen by bench_timer_init()
+ *
+ * @return Cycle count (0 when no counter is available)
+ */
+uint64_t bench_cycles(void);
+
+/**
+ * @brief Open the L1 data cache read-miss counter
+ *
+ * Linux perf_event_open() only; unavailable where perf events are
+ * restricted (perf_event_paranoid, containers, some VMs).
+ * bench_timer_close() releases it.
+ *
+ * @return 1 if the counter is available, 0 otherwise
+ */
+int bench_l1d_init(void);
+
+/**
+ * @brief L1 data cache read misses of this thread since bench_l1d_init()
+ *
+ * @return Miss count (0 when the counter is unavailable)
+ */
+uint64_t bench_l1d_misses(void);
+
+/**
+ * @brief Printable name of a cycle source ("perf_event", "rdtsc", "none")
+ *
+ * @param source Cycle source
+ * @return Static string
+ */
+const char *bench_cycle_source_name(bench_cycle_source_t source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_TIMER_H_ */
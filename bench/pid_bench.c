@@ -0,0 +1,614 @@
+/**
+ * @file    pid_bench.c
+ * @brief   Micro-benchmark harness for the PID controller and motor model
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Times pid_compute(), pid_compute_fast(), pid_reset(), the fixed-point
+ * and bank variants, the C++ template (when built with a C++ compiler),
+ * motor_update(), the closed loop from main.c (also with per-sample
+ * gain scheduling), a 100k-motor fleet loop over the PID and motor
+ * banks, a multi-rate tick (modulo counters vs. pid_schedule table)
+ * and 4096 loops stored as pid_t vs. split config/state across
+ * controller configurations.
+ * Reports ns/op, cycles/op (see bench_timer.h for the cycle source)
+ * and L1D read misses/op where perf events allow, as a table or as
+ * JSON for regression tracking. Build in Release for meaningful numbers.
+ *
+ * Usage:
+ *   pid_bench [--json] [--iterations N] [--repeats R]
+ */
+
+#include "bench_timer.h"
+#include "motor.h"
+#include "motor_bank.h"
+#include "pid.h"
+#include "pid_bank.h"
+#include "pid_fixed.h"
+#include "pid_gain_schedule.h"
+#include "pid_schedule.h"
+#include "pid_split.h"
+#if PID_BENCH_TEMPLATE
+#include "bench_template.h"
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Defaults (overridable on the command line) */
+#define DEFAULT_ITERATIONS  2000000u   /* Operations per timed run */
+#define DEFAULT_REPEATS     5u         /* Timed runs; the fastest is reported */
+
+/* Measurement buffer cycled through by the compute benchmarks */
+#define NUM_SAMPLES  1024u
+#define SAMPLE_MASK  (NUM_SAMPLES - 1u)
+
+/* Lanes per bank update */
+#define BANK_LANES   256u
+
+/* Motors per fleet closed-loop step (Monte-Carlo scale) */
+#define FLEET_MOTORS 100000u
+
+/* Loops per multi-rate tick, cycling through SCHED_PERIODS */
+#define SCHED_LOOPS  48u
+#define SCHED_STORAGE 4096u
+
+/* Loops per layout comparison: 256 KB of pid_t, well beyond L1 */
+#define LAYOUT_LOOPS 4096u
+
+/* Gains and limits from main.c */
+#define PID_KP   0.8f
+#define PID_KI   0.3f
+#define PID_KD   0.05f
+#define SAMPLE_TIME  0.01f
+#define OUT_MIN  -1.0f
+#define OUT_MAX   1.0f
+#define SETPOINT  3.0f
+
+/** Controller configurations exercised by each compute benchmark */
+typedef enum {
+    CONFIG_P_ONLY = 0,   /**< Kp only */
+    CONFIG_PID,          /**< Kp, Ki, Kd, no filter */
+    CONFIG_PID_LPF,      /**< Kp, Ki, Kd with derivative filter */
+    CONFIG_SATURATED,    /**< PID driven hard into the output limit */
+    NUM_CONFIGS
+} bench_config_t;
+
+static const char *const config_names[NUM_CONFIGS] = {
+    "p_only", "pid", "pid_lpf", "saturated"
+};
+
+/** One benchmark: runs @p iterations operations, returns a checksum */
+typedef float (*bench_fn)(bench_config_t config, unsigned iterations);
+
+typedef struct {
+    const char *name;     /**< Benchmark name (JSON key) */
+    bench_fn fn;          /**< Body */
+    int per_config;       /**< 1: run once per configuration */
+    unsigned ops_per_iteration; /**< Work items per iteration (lanes) */
+} bench_case_t;
+
+static float measurements[NUM_SAMPLES];
+
+/* Keeps the compiler from discarding benchmark results */
+static volatile float sink;
+
+/*============================================================================*/
+/* BENCHMARK BODIES                                                          */
+/*============================================================================*/
+
+/* Setpoint for a configuration: far out of reach when saturating */
+static float config_setpoint(bench_config_t config)
+{
+    return (config == CONFIG_SATURATED) ? 100.0f : SETPOINT;
+}
+
+static void config_pid(pid_t *pid, bench_config_t config)
+{
+    switch (config) {
+    case CONFIG_P_ONLY:
+        pid_init(pid, PID_KP, 0.0f, 0.0f, SAMPLE_TIME, OUT_MIN, OUT_MAX);
+        break;
+    case CONFIG_PID_LPF:
+        pid_init_advanced(pid, PID_KP, PID_KI, PID_KD, SAMPLE_TIME, OUT_MIN, OUT_MAX,
+                          OUT_MIN / PID_KI, OUT_MAX / PID_KI, 0.8f);
+        break;
+    default:
+        pid_init(pid, PID_KP, PID_KI, PID_KD, SAMPLE_TIME, OUT_MIN, OUT_MAX);
+        break;
+    }
+}
+
+static float bench_pid_compute(bench_config_t config, unsigned iterations)
+{
+    pid_t pid;
+    float sp = config_setpoint(config);
+    float acc = 0.0f;
+
+    config_pid(&pid, config);
+    for (unsigned i = 0; i < iterations; i++) {
+        acc += pid_compute(&pid, sp, measurements[i & SAMPLE_MASK]);
+    }
+    return acc;
+}
+
+static float bench_pid_compute_fast(bench_config_t config, unsigned iterations)
+{
+    pid_t pid;
+    float sp = config_setpoint(config);
+    float acc = 0.0f;
+
+    config_pid(&pid, config);
+    for (unsigned i = 0; i < iterations; i++) {
+        acc += pid_compute_fast(&pid, sp, measurements[i & SAMPLE_MASK]);
+    }
+    return acc;
+}
+
+#if PID_BENCH_TEMPLATE
+/* pid::Pid with only the terms the configuration uses compiled in */
+static float bench_pid_template(bench_config_t config, unsigned iterations)
+{
+    pid_t pid;
+    bench_template_gains_t gains;
+    bench_template_features_t features = BENCH_TEMPLATE_PID;
+
+    config_pid(&pid, config);
+    if (config == CONFIG_P_ONLY) {
+        features = BENCH_TEMPLATE_P;
+    } else if (config == CONFIG_PID_LPF) {
+        features = BENCH_TEMPLATE_PID_LPF;
+    }
+    gains.kp = pid.kp;
+    gains.ki = pid.ki;
+    gains.kd = pid.kd;
+    gains.dt = pid.dt;
+    gains.out_min = pid.out_min;
+    gains.out_max = pid.out_max;
+    gains.integrator_min = pid.integrator_min;
+    gains.integrator_max = pid.integrator_max;
+    gains.derivative_lpf = pid.derivative_lpf;
+    return bench_template_compute(features, &gains, config_setpoint(config), measurements,
+                                  SAMPLE_MASK, iterations);
+}
+#endif
+
+static float bench_pid_q31_compute(bench_config_t config, unsigned iterations)
+{
+    static int32_t q31_measurements[NUM_SAMPLES];
+    pid_q31_t pid;
+    pid_t ref;
+    int32_t sp = (config == CONFIG_SATURATED) ? PID_Q31_MAX : (int32_t)(0.3 * 2147483648.0);
+    int64_t acc = 0;
+
+    /* Same gains as the float controller, signals scaled by 1/10 */
+    config_pid(&ref, config);
+    pid_q31_init_advanced(&pid, ref.kp, ref.ki, ref.kd, ref.dt,
+                          PID_Q31_MIN, PID_Q31_MAX,
+                          ref.integrator_min, ref.integrator_max, ref.derivative_lpf);
+    for (unsigned i = 0; i < NUM_SAMPLES; i++) {
+        q31_measurements[i] = (int32_t)(measurements[i] * 0.1 * 2147483648.0);
+    }
+
+    for (unsigned i = 0; i < iterations; i++) {
+        acc += pid_q31_compute(&pid, sp, q31_measurements[i & SAMPLE_MASK]);
+    }
+    return (float)acc;
+}
+
+static float bench_pid_bank_compute(bench_config_t config, unsigned iterations)
+{
+    static float storage[PID_BANK_STORAGE_SIZE(BANK_LANES)];
+    static float setpoints[BANK_LANES];
+    static float outputs[BANK_LANES];
+    pid_bank_t bank;
+    pid_t pid;
+    float acc = 0.0f;
+
+    config_pid(&pid, config);
+    pid_bank_init(&bank, storage, BANK_LANES);
+    for (unsigned lane = 0; lane < BANK_LANES; lane++) {
+        pid_bank_load(&bank, lane, &pid);
+        setpoints[lane] = config_setpoint(config);
+    }
+
+    /* Each iteration updates every lane; offsets walk the sample buffer */
+    for (unsigned i = 0; i < iterations; i++) {
+        const float *meas = &measurements[(i * BANK_LANES) & (SAMPLE_MASK & ~(BANK_LANES - 1u))];
+        pid_bank_compute(&bank, setpoints, meas, outputs, BANK_LANES);
+        acc += outputs[i & (BANK_LANES - 1u)];
+    }
+    return acc;
+}
+
+static float bench_pid_reset(bench_config_t config, unsigned iterations)
+{
+    pid_t pid;
+
+    config_pid(&pid, config);
+    for (unsigned i = 0; i < iterations; i++) {
+        pid.integrator = measurements[i & SAMPLE_MASK];
+        pid_reset(&pid);
+    }
+    return pid.integrator;
+}
+
+static float bench_motor_update(bench_config_t config, unsigned iterations)
+{
+    (void)config;
+
+    motor_init();
+    motor_set_output(0.5f);
+    for (unsigned i = 0; i < iterations; i++) {
+        motor_update();
+    }
+    return motor_get_speed();
+}
+
+/* Control loop body of main.c without the CSV printf */
+static float bench_closed_loop(bench_config_t config, unsigned iterations)
+{
+    pid_t pid;
+    float sp = config_setpoint(config);
+    float acc = 0.0f;
+
+    config_pid(&pid, config);
+    motor_init();
+    for (unsigned i = 0; i < iterations; i++) {
+        float measurement = motor_get_speed();
+        float output = pid_compute(&pid, sp, measurement);
+        motor_set_output(output);
+        motor_update();
+        acc += output;
+    }
+    return acc;
+}
+
+/* Closed loop with the gains rescheduled on measured speed every sample */
+static float bench_closed_loop_scheduled(bench_config_t config, unsigned iterations)
+{
+    pid_t pid;
+    pid_gain_schedule_t schedule;
+    pid_gain_point_t points[4];
+    float sp = config_setpoint(config);
+    float acc = 0.0f;
+
+    config_pid(&pid, config);
+    for (uint32_t k = 0; k < 4u; k++) {
+        float scale = 0.7f + 0.2f * (float)k;
+
+        points[k].at = (float)k * 1.5f;
+        points[k].gains.kp = pid.kp * scale;
+        points[k].gains.ki = pid.ki * scale;
+        points[k].gains.kd = pid.kd * scale;
+    }
+    pid_gain_schedule_init(&schedule, points, 4u);
+    motor_init();
+    for (unsigned i = 0; i < iterations; i++) {
+        float measurement = motor_get_speed();
+        pid_gain_schedule_apply(&schedule, &pid, measurement);
+        float output = pid_compute(&pid, sp, measurement);
+        motor_set_output(output);
+        motor_update();
+        acc += output;
+    }
+    return acc;
+}
+
+/* Closed loop over a fleet: PID bank + motor bank, no per-motor calls */
+static float bench_closed_loop_fleet(bench_config_t config, unsigned iterations)
+{
+    static float pid_storage[PID_BANK_STORAGE_SIZE(FLEET_MOTORS)];
+    static float motor_storage[MOTOR_BANK_STORAGE_SIZE(FLEET_MOTORS)];
+    static float setpoints[FLEET_MOTORS];
+    static float outputs[FLEET_MOTORS];
+    pid_bank_t pids;
+    motor_bank_t motors;
+    pid_t pid;
+    float acc = 0.0f;
+
+    config_pid(&pid, config);
+    pid_bank_init(&pids, pid_storage, FLEET_MOTORS);
+    motor_bank_init(&motors, motor_storage, FLEET_MOTORS);
+    for (unsigned lane = 0; lane < FLEET_MOTORS; lane++) {
+        pid_bank_load(&pids, lane, &pid);
+        setpoints[lane] = config_setpoint(config);
+    }
+
+    for (unsigned i = 0; i < iterations; i++) {
+        pid_bank_compute(&pids, setpoints, motors.speed, outputs, FLEET_MOTORS);
+        motor_bank_set_outputs(&motors, outputs, FLEET_MOTORS);
+        motor_bank_update(&motors, FLEET_MOTORS);
+        acc += outputs[i % FLEET_MOTORS];
+    }
+    return acc;
+}
+
+/* Loop periods of the multi-rate benchmarks, in ticks */
+static const uint32_t sched_periods[] = { 1, 2, 4, 5, 10, 20 };
+
+/* Multi-rate tick with one modulo counter tested per loop */
+static float bench_schedule_modulo(bench_config_t config, unsigned iterations)
+{
+    static pid_t loops[SCHED_LOOPS];
+    static uint32_t periods[SCHED_LOOPS];
+    static uint32_t counters[SCHED_LOOPS];
+    static float outputs[SCHED_LOOPS];
+    float sp = config_setpoint(config);
+    float acc = 0.0f;
+
+    for (unsigned k = 0; k < SCHED_LOOPS; k++) {
+        config_pid(&loops[k], config);
+        periods[k] = sched_periods[k % (sizeof(sched_periods) / sizeof(sched_periods[0]))];
+        counters[k] = 0;
+    }
+
+    for (unsigned i = 0; i < iterations; i++) {
+        const float *meas = &measurements[(i * SCHED_LOOPS) & (SAMPLE_MASK & ~63u)];
+
+        for (unsigned k = 0; k < SCHED_LOOPS; k++) {
+            if (counters[k] == 0u) {
+                outputs[k] = pid_compute(&loops[k], sp, meas[k]);
+            }
+            counters[k] = (counters[k] + 1u == periods[k]) ? 0u : counters[k] + 1u;
+        }
+        acc += outputs[i % SCHED_LOOPS];
+    }
+    return acc;
+}
+
+/* Multi-rate tick walking a staggered pid_schedule table */
+static float bench_schedule_table(bench_config_t config, unsigned iterations)
+{
+    static pid_t loops[SCHED_LOOPS];
+    static uint32_t periods[SCHED_LOOPS];
+    static uint32_t storage[SCHED_STORAGE];
+    static float setpoints[SCHED_LOOPS];
+    static float outputs[SCHED_LOOPS];
+    pid_schedule_t sched;
+    float acc = 0.0f;
+
+    for (unsigned k = 0; k < SCHED_LOOPS; k++) {
+        config_pid(&loops[k], config);
+        periods[k] = sched_periods[k % (sizeof(sched_periods) / sizeof(sched_periods[0]))];
+        setpoints[k] = config_setpoint(config);
+    }
+    if (pid_schedule_build(&sched, loops, periods, SCHED_LOOPS, PID_SCHEDULE_STAGGERED,
+                           storage, SCHED_STORAGE) != 0) {
+        return 0.0f;
+    }
+
+    for (unsigned i = 0; i < iterations; i++) {
+        const float *meas = &measurements[(i * SCHED_LOOPS) & (SAMPLE_MASK & ~63u)];
+
+        pid_schedule_tick(&sched, setpoints, meas, outputs);
+        acc += outputs[i % SCHED_LOOPS];
+    }
+    return acc;
+}
+
+/* Many loops as an array of pid_t (64 bytes each) */
+static float bench_loops_pid_t(bench_config_t config, unsigned iterations)
+{
+    static pid_t loops[LAYOUT_LOOPS];
+    float sp = config_setpoint(config);
+    float acc = 0.0f;
+
+    for (unsigned k = 0; k < LAYOUT_LOOPS; k++) {
+        config_pid(&loops[k], config);
+    }
+    for (unsigned i = 0; i < iterations; i++) {
+        for (unsigned k = 0; k < LAYOUT_LOOPS; k++) {
+            acc += pid_compute(&loops[k], sp, measurements[(i + k) & SAMPLE_MASK]);
+        }
+    }
+    return acc;
+}
+
+/* Same loops split into per-loop config (40 bytes) and state (12 bytes) */
+static float bench_loops_split(bench_config_t config, unsigned iterations)
+{
+    static pid_config_t configs[LAYOUT_LOOPS];
+    static pid_state_t states[LAYOUT_LOOPS];
+    pid_t pid;
+    float sp = config_setpoint(config);
+    float acc = 0.0f;
+
+    config_pid(&pid, config);
+    for (unsigned k = 0; k < LAYOUT_LOOPS; k++) {
+        pid_split_from(&pid, &configs[k], &states[k]);
+    }
+    for (unsigned i = 0; i < iterations; i++) {
+        for (unsigned k = 0; k < LAYOUT_LOOPS; k++) {
+            acc += pid_compute_split(&configs[k], &states[k], sp,
+                                     measurements[(i + k) & SAMPLE_MASK]);
+        }
+    }
+    return acc;
+}
+
+/* Split layout with one configuration shared by every loop */
+static float bench_loops_split_shared(bench_config_t config, unsigned iterations)
+{
+    static pid_state_t states[LAYOUT_LOOPS];
+    pid_config_t shared;
+    pid_t pid;
+    float sp = config_setpoint(config);
+    float acc = 0.0f;
+
+    config_pid(&pid, config);
+    pid_split_from(&pid, &shared, NULL);
+    for (unsigned k = 0; k < LAYOUT_LOOPS; k++) {
+        pid_state_reset(&states[k]);
+    }
+    for (unsigned i = 0; i < iterations; i++) {
+        for (unsigned k = 0; k < LAYOUT_LOOPS; k++) {
+            acc += pid_compute_split(&shared, &states[k], sp,
+                                     measurements[(i + k) & SAMPLE_MASK]);
+        }
+    }
+    return acc;
+}
+
+static const bench_case_t cases[] = {
+    { "pid_compute",      bench_pid_compute,      1, 1u },
+    { "pid_compute_fast", bench_pid_compute_fast, 1, 1u },
+#if PID_BENCH_TEMPLATE
+    { "pid_template",     bench_pid_template,     1, 1u },
+#endif
+    { "pid_q31_compute",  bench_pid_q31_compute,  1, 1u },
+    { "pid_bank_compute", bench_pid_bank_compute, 1, BANK_LANES },
+    { "pid_reset",        bench_pid_reset,        0, 1u },
+    { "motor_update",     bench_motor_update,     0, 1u },
+    { "closed_loop",      bench_closed_loop,      1, 1u },
+    { "closed_loop_sched", bench_closed_loop_scheduled, 1, 1u },
+    { "closed_loop_fleet", bench_closed_loop_fleet, 1, FLEET_MOTORS },
+    { "schedule_modulo",  bench_schedule_modulo,  1, 1u },
+    { "schedule_table",   bench_schedule_table,   1, 1u },
+    { "loops_pid_t",      bench_loops_pid_t,      1, LAYOUT_LOOPS },
+    { "loops_split",      bench_loops_split,      1, LAYOUT_LOOPS },
+    { "loops_split_shared", bench_loops_split_shared, 1, LAYOUT_LOOPS },
+};
+
+/*============================================================================*/
+/* HARNESS                                                                   */
+/*============================================================================*/
+
+typedef struct {
+    double ns_per_op;
+    double cycles_per_op;
+    double l1d_misses_per_op;  /**< < 0 when the counter is unavailable */
+} bench_result_t;
+
+/* Set by main(): L1D miss counter opened */
+static int have_l1d;
+
+/* Time one case; the fastest of @p repeats runs is reported */
+static bench_result_t measure(const bench_case_t *bc, bench_config_t config,
+                              unsigned iterations, unsigned repeats)
+{
+    bench_result_t best = { -1.0, -1.0, -1.0 };
+    unsigned calls = iterations / bc->ops_per_iteration;
+    double ops = (double)calls * (double)bc->ops_per_iteration;
+
+    if (calls == 0) {
+        calls = 1;
+        ops = (double)bc->ops_per_iteration;
+    }
+
+    /* Warm-up run (caches, branch predictors, CPU frequency) */
+    sink = bc->fn(config, calls);
+
+    for (unsigned r = 0; r < repeats; r++) {
+        uint64_t m0 = bench_l1d_misses();
+        uint64_t t0 = bench_now_ns();
+        uint64_t c0 = bench_cycles();
+        sink = bc->fn(config, calls);
+        uint64_t c1 = bench_cycles();
+        uint64_t t1 = bench_now_ns();
+        uint64_t m1 = bench_l1d_misses();
+
+        double ns = (double)(t1 - t0) / ops;
+        double cycles = (double)(c1 - c0) / ops;
+        if (best.ns_per_op < 0.0 || ns < best.ns_per_op) {
+            best.ns_per_op = ns;
+            best.cycles_per_op = cycles;
+            best.l1d_misses_per_op = have_l1d ? (double)(m1 - m0) / ops : -1.0;
+        }
+    }
+    return best;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [--json] [--iterations N] [--repeats R]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    int json = 0;
+    unsigned iterations = DEFAULT_ITERATIONS;
+    unsigned repeats = DEFAULT_REPEATS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = 1;
+        } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--repeats") == 0 && i + 1 < argc) {
+            repeats = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (iterations == 0 || repeats == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /* Slowly varying measurement with a little deterministic noise */
+    for (unsigned i = 0; i < NUM_SAMPLES; i++) {
+        measurements[i] = SETPOINT * (float)i / (float)NUM_SAMPLES +
+                          0.01f * (float)((i * 7u) % 13u);
+    }
+
+    bench_cycle_source_t source = bench_timer_init();
+    have_l1d = bench_l1d_init();
+
+    if (json) {
+        printf("{\n  \"benchmark\": \"pid_bench\",\n");
+        printf("  \"cycle_source\": \"%s\",\n", bench_cycle_source_name(source));
+        printf("  \"l1d_misses\": %s,\n", have_l1d ? "true" : "false");
+        printf("  \"iterations\": %u,\n  \"repeats\": %u,\n", iterations, repeats);
+        printf("  \"results\": [");
+    } else {
+        printf("pid_bench: %u ops x %u runs, cycles from %s, L1D misses %s\n\n",
+               iterations, repeats, bench_cycle_source_name(source),
+               have_l1d ? "from perf_event" : "unavailable");
+        printf("%-18s %-10s %12s %12s %12s\n", "benchmark", "config", "ns/op", "cycles/op",
+               "l1d_miss/op");
+    }
+
+    int first = 1;
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        int num_configs = cases[c].per_config ? NUM_CONFIGS : 1;
+
+        for (int k = 0; k < num_configs; k++) {
+            bench_config_t config = (bench_config_t)k;
+            const char *config_name = cases[c].per_config ? config_names[k] : "-";
+            bench_result_t res = measure(&cases[c], config, iterations, repeats);
+
+            if (json) {
+                printf("%s\n    {\"name\": \"%s\", \"config\": \"%s\", "
+                       "\"ns_per_op\": %.3f, \"cycles_per_op\": %.3f",
+                       first ? "" : ",", cases[c].name, config_name,
+                       res.ns_per_op, res.cycles_per_op);
+                if (have_l1d) {
+                    printf(", \"l1d_misses_per_op\": %.4f", res.l1d_misses_per_op);
+                }
+                printf("}");
+            } else if (have_l1d) {
+                printf("%-18s %-10s %12.2f %12.2f %12.4f\n", cases[c].name, config_name,
+                       res.ns_per_op, res.cycles_per_op, res.l1d_misses_per_op);
+            } else {
+                printf("%-18s %-10s %12.2f %12.2f %12s\n", cases[c].name, config_name,
+                       res.ns_per_op, res.cycles_per_op, "-");
+            }
+            first = 0;
+        }
+    }
+
+    if (json) {
+        printf("\n  ]\n}\n");
+    }
+
+    bench_timer_close();
+    return 0;
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
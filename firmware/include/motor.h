@@ -17,9 +17,85 @@
 extern "C" {
 #endif
 
-#ifdef __cplusplus
-extern "C" {
-#endif
+/**
+ * @brief Simulated first-order motor plant instance
+ *
+ * Holds model parameters and state for one motor so any number of
+ * plants can be simulated in one process (or one per thread). Do not
+ * modify members directly - use the motor_model_* functions.
+ */
+typedef struct {
+    /* Model parameters */
+    float gain;                /**< Steady-state speed per unit input */
+    float alpha;               /**< Response rate per step (dt / tau) */
+
+    /* Simulation state */
+    float speed;               /**< Current speed (arbitrary units) */
+    float output;              /**< Last commanded duty cycle (-1.0 to 1.0) */
+} motor_model_t;
+
+/** Default steady-state gain (speed per unit input) */
+#define MOTOR_MODEL_DEFAULT_GAIN   5.0f
+/** Default response rate: dt / tau = 10ms / 200ms */
+#define MOTOR_MODEL_DEFAULT_ALPHA  0.05f
+
+/**
+ * @brief Initialize a motor model with default parameters
+ *
+ * Zero speed and output, gain and alpha set to the defaults above.
+ *
+ * @param motor Pointer to motor model
+ */
+void motor_model_init(motor_model_t *motor);
+
+/**
+ * @brief Initialize a motor model with custom parameters
+ *
+ * @param motor Pointer to motor model
+ * @param gain  Steady-state speed per unit input
+ * @param alpha Response rate per step, dt / tau (0.0-1.0]
+ */
+void motor_model_init_advanced(motor_model_t *motor, float gain, float alpha);
+
+/**
+ * @brief Set control output of a motor model
+ *
+ * @param motor      Pointer to motor model
+ * @param duty_cycle Control output, clamped to -1.0 to 1.0
+ */
+void motor_model_set_output(motor_model_t *motor, float duty_cycle);
+
+/**
+ * @brief Get current speed of a motor model
+ *
+ * @param motor Pointer to motor model
+ * @return Simulated speed (arbitrary units)
+ */
+float motor_model_get_speed(const motor_model_t *motor);
+
+/**
+ * @brief Advance a motor model by one time step
+ *
+ * @param motor Pointer to motor model
+ */
+void motor_model_update(motor_model_t *motor);
+
+/**
+ * @brief Advance a motor model by a fractional number of time steps
+ *
+ * Exact first-order response to the held output over @p steps nominal
+ * steps: speed approaches gain * output by 1 - (1 - alpha)^steps. Used
+ * to simulate irregular sample intervals; steps = 1 matches
+ * motor_model_update() to float rounding.
+ *
+ * @param motor Pointer to motor model
+ * @param steps Interval in nominal steps (actual dt / nominal dt), >= 0
+ */
+void motor_model_update_dt(motor_model_t *motor, float steps);
+
+/*----------------------------------------------------------------------------*/
+/* Single-motor API (operates on a default instance)                         */
+/*----------------------------------------------------------------------------*/
 
 /**
  * @brief Initialize motor simulation
@@ -51,6 +127,15 @@ float motor_get_speed(void);
  */
 void motor_update(void);
 
+/**
+ * @brief Update motor simulation over an irregular interval
+ *
+ * See motor_model_update_dt().
+ *
+ * @param steps Interval in nominal steps (actual dt / nominal dt), >= 0
+ */
+void motor_update_dt(float steps);
+
 #ifdef __cplusplus
 }
 #endif
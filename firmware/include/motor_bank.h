@@ -0,0 +1,121 @@
+/**
+ * @file    motor_bank.h
+ * @brief   Structure-of-arrays bank of simulated motor plants
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Fleet counterpart of motor_model_t for offline Monte-Carlo runs: the
+ * parameters and state of many first-order plants are stored as
+ * contiguous arrays and advanced in one auto-vectorizable pass. Every
+ * lane produces bit-identical results to motor_model_update() on an
+ * equivalently configured motor_model_t.
+ *
+ * The speed array can be passed straight to pid_bank_compute() as the
+ * measurements, so a closed loop over a whole fleet is three calls per
+ * step with no per-motor function calls:
+ *
+ *     pid_bank_compute(&pids, setpoints, motors.speed, duty, n);
+ *     motor_bank_set_outputs(&motors, duty, n);
+ *     motor_bank_update(&motors, n);
+ */
+
+#ifndef MOTOR_BANK_H_
+#define MOTOR_BANK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "motor.h"
+
+/** Number of floats of caller storage required per lane */
+#define MOTOR_BANK_FLOATS_PER_LANE 4u
+
+/**
+ * @brief Storage size in floats for a bank of @p n motors
+ *
+ * Use to size a static buffer: `static float buf[MOTOR_BANK_STORAGE_SIZE(64)];`
+ */
+#define MOTOR_BANK_STORAGE_SIZE(n) ((size_t)(n) * MOTOR_BANK_FLOATS_PER_LANE)
+
+/**
+ * @brief Bank of motor plants in structure-of-arrays layout
+ *
+ * Each member points into caller-provided storage; element i of every
+ * array belongs to motor i. speed may be read directly; configure lanes
+ * with motor_bank_load() and command them with motor_bank_set_outputs().
+ */
+typedef struct {
+    /* Model parameters */
+    float *model_gain;         /**< Steady-state speed per unit input */
+    float *model_alpha;        /**< Response rate per step (dt / tau) */
+
+    /* Simulation state */
+    float *speed;              /**< Current speeds (arbitrary units) */
+    float *output;             /**< Last commanded duty cycles (-1.0 to 1.0) */
+
+    size_t capacity;           /**< Number of motors the storage can hold */
+} motor_bank_t;
+
+/**
+ * @brief Initialize a bank over caller-provided storage
+ *
+ * Carves @p storage into the per-parameter arrays. No dynamic memory is
+ * used. Every motor starts at rest with MOTOR_MODEL_DEFAULT_GAIN and
+ * MOTOR_MODEL_DEFAULT_ALPHA, matching motor_model_init().
+ *
+ * @param bank      Pointer to bank structure
+ * @param storage   Buffer of at least MOTOR_BANK_STORAGE_SIZE(capacity) floats
+ * @param capacity  Number of motors
+ */
+void motor_bank_init(motor_bank_t *bank, float *storage, size_t capacity);
+
+/**
+ * @brief Copy parameters and state of a motor_model_t into one lane
+ *
+ * @param bank   Pointer to initialized bank
+ * @param lane   Lane index (< capacity)
+ * @param motor  Source motor model
+ */
+void motor_bank_load(motor_bank_t *bank, size_t lane, const motor_model_t *motor);
+
+/**
+ * @brief Copy one lane back into a motor_model_t
+ *
+ * @param bank   Pointer to initialized bank
+ * @param lane   Lane index (< capacity)
+ * @param motor  Destination motor model
+ */
+void motor_bank_store(const motor_bank_t *bank, size_t lane, motor_model_t *motor);
+
+/**
+ * @brief Set control outputs of the first @p n motors
+ *
+ * Equivalent to motor_model_set_output() per lane: values are clamped
+ * to [-1.0, 1.0].
+ *
+ * @param bank         Pointer to initialized bank
+ * @param duty_cycles  Control outputs (n elements, e.g. the outputs of
+ *                     pid_bank_compute(); must not alias bank storage)
+ * @param n            Number of motors to update (<= capacity)
+ */
+void motor_bank_set_outputs(motor_bank_t *bank, const float *duty_cycles, size_t n);
+
+/**
+ * @brief Advance the first @p n motors by one time step
+ *
+ * Equivalent to motor_model_update() per lane.
+ *
+ * @param bank  Pointer to initialized bank
+ * @param n     Number of motors to update (<= capacity)
+ */
+void motor_bank_update(motor_bank_t *bank, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOTOR_BANK_H_ */
@@ -19,6 +19,34 @@ extern "C" {
 
 #include <stdint.h>
 
+#ifndef PID_CYCLE_STATS
+#define PID_CYCLE_STATS 0      /**< 1 = instrument pid_compute() (see pid_cycles.h) */
+#endif
+
+#if PID_CYCLE_STATS
+#include "pid_cycles.h"
+#endif
+
+#ifndef PID_DT_NEWTON_RANGE
+/** pid_compute_dt() replaces 1/dt_actual by one Newton step from the
+ *  nominal 1/dt while |1 - dt_actual/dt| is at most this (relative error
+ *  below its square, 1/1024); longer or shorter intervals divide */
+#define PID_DT_NEWTON_RANGE 0.03125f
+#endif
+
+/**
+ * @brief Feedforward gains for pid_compute_ff()
+ *
+ * Kept outside pid_t so existing layouts are unchanged and one set can
+ * be shared (and const) across loops. For the first-order motor model,
+ * speed = gain * u lagged by tau, the ideal speed-loop values are
+ * kv = 1/gain and ka = tau/gain.
+ */
+typedef struct {
+    float kv;                  /**< Output per unit of reference velocity */
+    float ka;                  /**< Output per unit of reference acceleration */
+} pid_feedforward_t;
+
 /**
  * @brief PID Controller instance structure
  *
@@ -43,6 +71,16 @@ typedef struct {
     float prev_error;          /**< Previous error (reserved for future extensions) */
     float prev_measurement;    /**< Previous measurement (for derivative) */
     float derivative_filtered; /**< Filtered derivative value */
+
+    /* Precomputed coefficients (derived at initialization) */
+    float inv_dt;              /**< 1 / dt */
+    float kd_inv_dt;           /**< kd / dt (unfiltered derivative gain) */
+    float lpf_complement;      /**< 1 - derivative_lpf */
+
+#if PID_CYCLE_STATS
+    /* Instrumentation (PID_CYCLE_STATS builds only) */
+    pid_cycle_stats_t cycles;  /**< Durations of the pid_compute*() calls */
+#endif
 } pid_t;
 
 /**
@@ -106,6 +144,71 @@ void pid_init_advanced(pid_t *pid,
  */
 float pid_compute(pid_t *pid, float setpoint, float measurement);
 
+/**
+ * @brief Calculate PID control output without per-sample division
+ *
+ * Same algorithm and state as pid_compute(), but uses the coefficients
+ * precomputed by pid_init()/pid_init_advanced() so the update is only
+ * multiplies, adds and compares. Intended for cores where division is
+ * expensive (soft-float, Cortex-M0); on cores with a pipelined hardware
+ * divider the two paths cost about the same. Results agree with
+ * pid_compute() to within float rounding; both may be used on the same
+ * instance.
+ *
+ * @param pid         Pointer to initialized PID structure
+ * @param setpoint    Target value
+ * @param measurement Current measured value
+ * @return Control output clamped to [out_min, out_max]
+ */
+float pid_compute_fast(pid_t *pid, float setpoint, float measurement);
+
+/**
+ * @brief Calculate PID control output over a measured sample interval
+ *
+ * Same algorithm and state as pid_compute_fast(), but the integral and
+ * derivative terms use @p dt_actual, the measured time since the last
+ * call, instead of the fixed dt. Use when the loop is not strictly
+ * periodic (ISR latency, scheduler jitter, missed samples).
+ *
+ * 1/dt_actual costs no division for intervals within
+ * PID_DT_NEWTON_RANGE of dt: one Newton step from the precomputed 1/dt
+ * is accurate to the square of the relative deviation. Outliers (a
+ * missed sample, a first call after a pause) take one exact division.
+ * The derivative filter coefficient stays per-sample.
+ *
+ * @param pid         Pointer to initialized PID structure
+ * @param setpoint    Target value
+ * @param measurement Current measured value
+ * @param dt_actual   Seconds since the previous call, > 0
+ * @return Control output clamped to [out_min, out_max]
+ */
+float pid_compute_dt(pid_t *pid, float setpoint, float measurement, float dt_actual);
+
+/**
+ * @brief Calculate PID control output plus velocity/acceleration feedforward
+ *
+ * pid_compute() with kv * velocity + ka * acceleration added before the
+ * output clamp. With a known reference trajectory (see
+ * pid_trajectory.h) the feedforward supplies most of the output and
+ * the feedback only corrects the residual, so tracking no longer needs
+ * high gains. With both gains zero the result equals pid_compute().
+ *
+ * @param pid           Pointer to initialized PID structure
+ * @param ff            Feedforward gains
+ * @param setpoint      Target value
+ * @param measurement   Current measured value
+ * @param velocity      Reference velocity (rate of the controlled variable's
+ *                      reference, or the reference itself in a speed loop)
+ * @param acceleration  Reference acceleration
+ * @return Control output clamped to [out_min, out_max]
+ */
+float pid_compute_ff(pid_t *pid,
+                     const pid_feedforward_t *ff,
+                     float setpoint,
+                     float measurement,
+                     float velocity,
+                     float acceleration);
+
 /**
  * @brief Reset PID controller internal state
  *
@@ -116,6 +219,47 @@ float pid_compute(pid_t *pid, float setpoint, float measurement);
  */
 void pid_reset(pid_t *pid);
 
+/**
+ * @brief Change gains on a running controller without an output bump
+ *
+ * Unlike re-initializing, keeps the state and rescales the integrator
+ * so the integral term ki * integrator is unchanged: the output of the
+ * next sample differs only through the new kp and kd. The integrator
+ * limits are rescaled by the same factor, so the integral-term bound
+ * ki * integrator_min .. ki * integrator_max is kept, including limits
+ * set with pid_init_advanced(). Switching the integral term on (ki from
+ * 0) starts it from zero with the pid_init() limits out_min/ki ..
+ * out_max/ki. Cheap enough to call every sample (one division).
+ *
+ * @param pid  Pointer to initialized PID structure
+ * @param kp   New proportional gain
+ * @param ki   New integral gain (0 to disable)
+ * @param kd   New derivative gain (0 to disable)
+ */
+void pid_set_gains(pid_t *pid, float kp, float ki, float kd);
+
+#if PID_CYCLE_STATS
+/**
+ * @brief Call duration statistics of an instance
+ *
+ * Cleared by pid_init()/pid_init_advanced(), kept by pid_reset().
+ * Only available in PID_CYCLE_STATS builds.
+ *
+ * @param pid Pointer to PID structure
+ * @return Statistics block inside @p pid
+ */
+const pid_cycle_stats_t *pid_get_cycle_stats(const pid_t *pid);
+
+/**
+ * @brief Clear the call duration statistics of an instance
+ *
+ * Only available in PID_CYCLE_STATS builds.
+ *
+ * @param pid Pointer to PID structure
+ */
+void pid_reset_cycle_stats(pid_t *pid);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
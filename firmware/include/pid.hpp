@@ -0,0 +1,392 @@
+/**
+ * @file    pid.hpp
+ * @brief   Header-only C++17 PID controller with compile-time feature selection
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * The algorithm of pid_compute() (pid.c) as a class template,
+ * pid::Pid<T, Features...>, where each term is a policy chosen at
+ * compile time:
+ *
+ *   pid::Proportional      P = kp * error
+ *   pid::Integral          I = ki * integral(error dt)
+ *   pid::AntiWindup        integrator clamped to its limits (needs Integral)
+ *   pid::Derivative        D = kd * -d(measurement)/dt
+ *   pid::DerivativeFilter  low-pass on the derivative (needs Derivative)
+ *
+ * Terms that are not selected generate no code and no state: no ki = 0
+ * multiply, no filter branch, no integrator member. With every feature
+ * selected and T = float, outputs are bit-identical to pid_compute();
+ * a subset matches pid_compute() with the missing gains set to 0 (and,
+ * without AntiWindup, integrator limits that are never reached).
+ *
+ * T may be float, double or pid::Fixed<FracBits> (saturating
+ * fixed-point). Everything is constexpr, so a controller can also be
+ * stepped at compile time.
+ *
+ * The controller type is independent of pid.h: a C++ file that
+ * includes the standard library cannot also include pid.h on POSIX
+ * systems, whose <sys/types.h> defines its own pid_t.
+ */
+
+#ifndef PID_HPP_
+#define PID_HPP_
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace pid {
+
+/*============================================================================*/
+/* FEATURE POLICIES                                                          */
+/*============================================================================*/
+
+struct Proportional {};     /**< Proportional term */
+struct Integral {};         /**< Integral term */
+struct AntiWindup {};       /**< Integrator clamping (requires Integral) */
+struct Derivative {};       /**< Derivative-on-measurement term */
+struct DerivativeFilter {}; /**< Derivative low-pass filter (requires Derivative) */
+
+namespace detail {
+
+template <typename Feature, typename... Features>
+inline constexpr bool has_v = (std::is_same_v<Feature, Features> || ...);
+
+template <typename Feature>
+inline constexpr bool is_feature_v =
+    std::is_same_v<Feature, Proportional> || std::is_same_v<Feature, Integral> ||
+    std::is_same_v<Feature, AntiWindup> || std::is_same_v<Feature, Derivative> ||
+    std::is_same_v<Feature, DerivativeFilter>;
+
+/* Storage of each term; disabled terms become distinct empty bases */
+template <int N> struct Off {};
+template <typename T> struct PTerm { T kp_{}; };
+template <typename T> struct ITerm { T ki_{}; T integrator_{}; };
+template <typename T> struct WindupTerm { T integrator_min_{}; T integrator_max_{}; };
+template <typename T> struct DTerm { T kd_{}; T prev_measurement_{}; };
+template <typename T> struct FilterTerm {
+    T derivative_lpf_{};
+    T lpf_complement_{};
+    T derivative_filtered_{};
+};
+
+template <bool Enabled, typename Term, int N>
+using term_t = std::conditional_t<Enabled, Term, Off<N>>;
+
+/* Clamp value to [min, max] range (same tests as pid.c) */
+template <typename T>
+constexpr T clamp(T value, T min, T max) noexcept
+{
+    if (value > max) return max;
+    if (value < min) return min;
+    return value;
+}
+
+} // namespace detail
+
+/*============================================================================*/
+/* CONFIGURATION                                                             */
+/*============================================================================*/
+
+/**
+ * @brief Full configuration, as passed to pid_init_advanced()
+ *
+ * Members for terms a controller does not select are ignored.
+ */
+template <typename T>
+struct Gains {
+    T kp{};                    /**< Proportional gain */
+    T ki{};                    /**< Integral gain */
+    T kd{};                    /**< Derivative gain */
+    T dt{};                    /**< Sample time in seconds */
+    T out_min{};               /**< Minimum output limit */
+    T out_max{};               /**< Maximum output limit */
+    T integrator_min{};        /**< Min integrator limit (anti-windup) */
+    T integrator_max{};        /**< Max integrator limit (anti-windup) */
+    T derivative_lpf{};        /**< Derivative filter coeff (0.0-1.0, 0=no filter) */
+
+    /**
+     * @brief Configuration of pid_init(): integrator limits out/ki
+     *        (output limits if ki is 0), no derivative filter
+     */
+    static constexpr Gains standard(T kp, T ki, T kd, T dt, T out_min, T out_max) noexcept
+    {
+        Gains g{};
+        g.kp = kp;
+        g.ki = ki;
+        g.kd = kd;
+        g.dt = dt;
+        g.out_min = out_min;
+        g.out_max = out_max;
+        g.integrator_min = (ki != T(0)) ? out_min / ki : out_min;
+        g.integrator_max = (ki != T(0)) ? out_max / ki : out_max;
+        g.derivative_lpf = T(0);
+        return g;
+    }
+};
+
+/*============================================================================*/
+/* CONTROLLER                                                                */
+/*============================================================================*/
+
+/**
+ * @brief PID controller with compile-time term selection
+ *
+ * @tparam T         Scalar type (float, double, pid::Fixed<...>)
+ * @tparam Features  Any of Proportional, Integral, AntiWindup,
+ *                   Derivative, DerivativeFilter (order irrelevant)
+ */
+template <typename T, typename... Features>
+class Pid
+    : private detail::term_t<detail::has_v<Proportional, Features...>, detail::PTerm<T>, 0>,
+      private detail::term_t<detail::has_v<Integral, Features...>, detail::ITerm<T>, 1>,
+      private detail::term_t<detail::has_v<AntiWindup, Features...>, detail::WindupTerm<T>, 2>,
+      private detail::term_t<detail::has_v<Derivative, Features...>, detail::DTerm<T>, 3>,
+      private detail::term_t<detail::has_v<DerivativeFilter, Features...>, detail::FilterTerm<T>, 4>
+{
+public:
+    static constexpr bool has_proportional = detail::has_v<Proportional, Features...>;
+    static constexpr bool has_integral = detail::has_v<Integral, Features...>;
+    static constexpr bool has_anti_windup = detail::has_v<AntiWindup, Features...>;
+    static constexpr bool has_derivative = detail::has_v<Derivative, Features...>;
+    static constexpr bool has_filter = detail::has_v<DerivativeFilter, Features...>;
+
+    static_assert((detail::is_feature_v<Features> && ...), "Unknown PID feature policy");
+    static_assert(has_proportional || has_integral || has_derivative,
+                  "Select at least one of Proportional, Integral, Derivative");
+    static_assert(!has_anti_windup || has_integral, "AntiWindup requires Integral");
+    static_assert(!has_filter || has_derivative, "DerivativeFilter requires Derivative");
+
+    /**
+     * @brief Initialize like pid_init()
+     *
+     * Integrator limits out_min/ki .. out_max/ki (output limits if ki is
+     * 0), no derivative filtering.
+     */
+    constexpr Pid(T kp, T ki, T kd, T dt, T out_min, T out_max) noexcept
+    {
+        configure(Gains<T>::standard(kp, ki, kd, dt, out_min, out_max));
+    }
+
+    /**
+     * @brief Initialize like pid_init_advanced()
+     */
+    constexpr explicit Pid(const Gains<T> &gains) noexcept
+    {
+        configure(gains);
+    }
+
+    /**
+     * @brief Calculate control output (pid_compute() algorithm)
+     *
+     * Must be called periodically at the configured dt.
+     *
+     * @param setpoint     Target value
+     * @param measurement  Current measured value
+     * @return Control output, clamped to [out_min, out_max]
+     */
+    constexpr T compute(T setpoint, T measurement) noexcept
+    {
+        T error = setpoint - measurement;
+        T output{};
+
+        if constexpr (has_proportional) {
+            output = this->kp_ * error;
+        }
+
+        if constexpr (has_integral) {
+            this->integrator_ += error * dt_;
+            if constexpr (has_anti_windup) {
+                this->integrator_ = detail::clamp(this->integrator_, this->integrator_min_,
+                                                  this->integrator_max_);
+            }
+            output = output + this->ki_ * this->integrator_;
+        }
+
+        if constexpr (has_derivative) {
+            T derivative_raw = -(measurement - this->prev_measurement_) / dt_;
+
+            if constexpr (has_filter) {
+                this->derivative_filtered_ = this->derivative_filtered_ * this->derivative_lpf_ +
+                                             derivative_raw * this->lpf_complement_;
+                derivative_raw = this->derivative_filtered_;
+            }
+            output = output + this->kd_ * derivative_raw;
+            this->prev_measurement_ = measurement;
+        }
+
+        return detail::clamp(output, out_min_, out_max_);
+    }
+
+    /**
+     * @brief Clear internal state, keep configuration (pid_reset())
+     */
+    constexpr void reset() noexcept
+    {
+        if constexpr (has_integral) {
+            this->integrator_ = T(0);
+        }
+        if constexpr (has_derivative) {
+            this->prev_measurement_ = T(0);
+        }
+        if constexpr (has_filter) {
+            this->derivative_filtered_ = T(0);
+        }
+    }
+
+    /** @brief Integral accumulator (Integral controllers only) */
+    constexpr T integrator() const noexcept
+    {
+        static_assert(has_integral, "Controller has no integral term");
+        return this->integrator_;
+    }
+
+    /** @brief Filtered derivative (DerivativeFilter controllers only) */
+    constexpr T derivative_filtered() const noexcept
+    {
+        static_assert(has_filter, "Controller has no derivative filter");
+        return this->derivative_filtered_;
+    }
+
+private:
+    constexpr void configure(const Gains<T> &g) noexcept
+    {
+        assert(g.dt > T(0) && "Sample time must be positive");
+        assert(g.out_min < g.out_max && "Output min must be less than max");
+
+        dt_ = g.dt;
+        out_min_ = g.out_min;
+        out_max_ = g.out_max;
+        if constexpr (has_proportional) {
+            this->kp_ = g.kp;
+        }
+        if constexpr (has_integral) {
+            this->ki_ = g.ki;
+        }
+        if constexpr (has_anti_windup) {
+            assert(g.integrator_min < g.integrator_max && "Integrator min must be less than max");
+            this->integrator_min_ = g.integrator_min;
+            this->integrator_max_ = g.integrator_max;
+        }
+        if constexpr (has_derivative) {
+            this->kd_ = g.kd;
+        }
+        if constexpr (has_filter) {
+            this->derivative_lpf_ = detail::clamp(g.derivative_lpf, T(0), T(1));
+            this->lpf_complement_ = T(1) - this->derivative_lpf_;
+        }
+        reset();
+    }
+
+    T dt_{};                   /**< Sample time in seconds */
+    T out_min_{};              /**< Minimum output limit */
+    T out_max_{};              /**< Maximum output limit */
+};
+
+/** Every term, as pid_t: bit-identical to pid_compute() for float */
+template <typename T>
+using FullPid = Pid<T, Proportional, Integral, AntiWindup, Derivative, DerivativeFilter>;
+
+/** PI controller with anti-windup */
+template <typename T>
+using PiController = Pid<T, Proportional, Integral, AntiWindup>;
+
+/*============================================================================*/
+/* FIXED-POINT SCALAR                                                        */
+/*============================================================================*/
+
+/**
+ * @brief Saturating signed fixed-point number with FracBits fraction bits
+ *
+ * Products and quotients go through Wide and saturate to Rep, so a
+ * controller never wraps around. Fixed<16> is Q15.16 on int32_t:
+ * range +/-32768, resolution 1.5e-5.
+ */
+template <int FracBits, typename Rep = std::int32_t, typename Wide = std::int64_t>
+class Fixed {
+    static_assert(std::is_signed_v<Rep> && std::is_signed_v<Wide>, "Fixed needs signed types");
+    static_assert(sizeof(Wide) >= 2 * sizeof(Rep), "Wide must hold a full product");
+    static_assert(FracBits > 0 && FracBits < static_cast<int>(8 * sizeof(Rep)) - 1,
+                  "FracBits out of range");
+
+public:
+    static constexpr Wide one = Wide(1) << FracBits;
+
+    constexpr Fixed() noexcept = default;
+
+    /** @brief Nearest representable value (saturated); implicit for literals */
+    constexpr Fixed(double value) noexcept : raw_(from_double(value)) {}
+
+    /** @brief Wrap a raw Rep value */
+    static constexpr Fixed from_raw(Rep raw) noexcept
+    {
+        Fixed f;
+        f.raw_ = raw;
+        return f;
+    }
+
+    constexpr Rep raw() const noexcept { return raw_; }
+    constexpr double to_double() const noexcept { return static_cast<double>(raw_) / one; }
+    constexpr explicit operator double() const noexcept { return to_double(); }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b) noexcept
+    {
+        return from_raw(saturate(Wide(a.raw_) + b.raw_));
+    }
+    friend constexpr Fixed operator-(Fixed a, Fixed b) noexcept
+    {
+        return from_raw(saturate(Wide(a.raw_) - b.raw_));
+    }
+    friend constexpr Fixed operator*(Fixed a, Fixed b) noexcept
+    {
+        return from_raw(saturate(Wide(a.raw_) * b.raw_ / one));
+    }
+    friend constexpr Fixed operator/(Fixed a, Fixed b) noexcept
+    {
+        assert(b.raw_ != 0 && "Fixed-point division by zero");
+        return from_raw(saturate(Wide(a.raw_) * one / b.raw_));
+    }
+    constexpr Fixed operator-() const noexcept { return from_raw(saturate(-Wide(raw_))); }
+    constexpr Fixed &operator+=(Fixed b) noexcept { return *this = *this + b; }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) noexcept { return a.raw_ == b.raw_; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) noexcept { return a.raw_ != b.raw_; }
+    friend constexpr bool operator<(Fixed a, Fixed b) noexcept { return a.raw_ < b.raw_; }
+    friend constexpr bool operator>(Fixed a, Fixed b) noexcept { return a.raw_ > b.raw_; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) noexcept { return a.raw_ <= b.raw_; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) noexcept { return a.raw_ >= b.raw_; }
+
+private:
+    static constexpr Rep saturate(Wide value) noexcept
+    {
+        if (value > Wide(std::numeric_limits<Rep>::max())) return std::numeric_limits<Rep>::max();
+        if (value < Wide(std::numeric_limits<Rep>::min())) return std::numeric_limits<Rep>::min();
+        return static_cast<Rep>(value);
+    }
+
+    static constexpr Rep from_double(double value) noexcept
+    {
+        double scaled = value * static_cast<double>(one);
+
+        if (scaled >= static_cast<double>(std::numeric_limits<Rep>::max())) {
+            return std::numeric_limits<Rep>::max();
+        }
+        if (scaled <= static_cast<double>(std::numeric_limits<Rep>::min())) {
+            return std::numeric_limits<Rep>::min();
+        }
+        return static_cast<Rep>(scaled + (scaled >= 0.0 ? 0.5 : -0.5));
+    }
+
+    Rep raw_ = 0;
+};
+
+/** Q15.16 on int32_t */
+using Q16 = Fixed<16>;
+
+} // namespace pid
+
+#endif /* PID_HPP_ */
@@ -0,0 +1,185 @@
+/**
+ * @file    pid_autotune.h
+ * @brief   Relay-feedback (Astrom-Hagglund) PID auto-tuner
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Replaces the PID in the control loop with a relay around the setpoint
+ * until the plant settles into a limit cycle, measures its amplitude and
+ * period online, and derives gains from the ultimate gain and period:
+ *
+ *   Ku = 4 d / (pi * sqrt(a^2 - h^2))    Tu = mean cycle period
+ *
+ * where d is the relay amplitude, a the measured oscillation amplitude
+ * and h the relay hysteresis. Memory is O(1): the tuner keeps running
+ * extremes for the current cycle and sums over completed cycles, never
+ * the sample history. Call pid_autotune_step() at the loop rate in place
+ * of pid_compute() and apply the result with pid_autotune_apply().
+ */
+
+#ifndef PID_AUTOTUNE_H_
+#define PID_AUTOTUNE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "pid.h"
+
+/** Cycles averaged by pid_autotune_init() */
+#define PID_AUTOTUNE_DEFAULT_CYCLES   4u
+/** Initial cycles discarded while the oscillation builds up */
+#define PID_AUTOTUNE_SETTLE_CYCLES    2u
+
+/**
+ * @brief Tuning rule mapping (Ku, Tu) to PID gains
+ *
+ * kp = Kp_factor * Ku, ki = kp / Ti, kd = kp * Td with:
+ */
+typedef enum {
+    PID_TUNE_ZIEGLER_NICHOLS = 0, /**< 0.6 Ku, Ti = Tu/2, Td = Tu/8 (aggressive) */
+    PID_TUNE_TYREUS_LUYBEN,       /**< Ku/2.2, Ti = 2.2 Tu, Td = Tu/6.3 (robust) */
+    PID_TUNE_NO_OVERSHOOT         /**< 0.2 Ku, Ti = Tu/2, Td = Tu/3 */
+} pid_tune_rule_t;
+
+/**
+ * @brief Auto-tuner progress
+ */
+typedef enum {
+    PID_AUTOTUNE_RUNNING = 0,  /**< Relay experiment in progress */
+    PID_AUTOTUNE_DONE,         /**< Ku and Tu measured */
+    PID_AUTOTUNE_FAILED        /**< Timed out, or amplitude within hysteresis */
+} pid_autotune_status_t;
+
+/**
+ * @brief Relay auto-tuner instance
+ *
+ * Do not modify members directly - use the API functions.
+ */
+typedef struct {
+    /* Configuration (set during initialization) */
+    float setpoint;            /**< Operating point the relay switches around */
+    float bias;                /**< Output at the operating point */
+    float amplitude;           /**< Relay amplitude d (output = bias +/- d) */
+    float hysteresis;          /**< Switching band h around the setpoint */
+    float dt;                  /**< Sample time in seconds */
+    uint32_t cycles;           /**< Cycles to average after settling */
+    uint32_t max_steps;        /**< Give up after this many steps (0 = never) */
+
+    /* Relay experiment state */
+    int32_t relay;             /**< +1 output high, -1 output low */
+    uint32_t step;             /**< Steps since init */
+    uint32_t cycle_start;      /**< Step of the last low-to-high switch */
+    uint32_t switches;         /**< Low-to-high switches seen */
+    float cycle_max;           /**< Highest measurement in the current cycle */
+    float cycle_min;           /**< Lowest measurement in the current cycle */
+    float amplitude_sum;       /**< Sum of measured half peak-to-peak */
+    uint32_t period_sum;       /**< Sum of measured periods, in steps */
+    uint32_t measured;         /**< Cycles summed */
+    pid_autotune_status_t status;
+
+    /* Results (valid once status is PID_AUTOTUNE_DONE) */
+    float ku;                  /**< Ultimate gain */
+    float tu;                  /**< Ultimate period in seconds */
+} pid_autotune_t;
+
+/**
+ * @brief Initialize an auto-tuner with default cycle count and no timeout
+ *
+ * @param tune        Pointer to auto-tuner
+ * @param setpoint    Operating point to oscillate around
+ * @param bias        Output that holds the plant near the setpoint (the
+ *                    relay is symmetric about it; a poor bias skews the
+ *                    duty cycle and the estimate)
+ * @param amplitude   Relay amplitude, > 0
+ * @param hysteresis  Switching band, >= 0 (set above measurement noise)
+ * @param dt          Sample time in seconds
+ */
+void pid_autotune_init(pid_autotune_t *tune,
+                       float setpoint,
+                       float bias,
+                       float amplitude,
+                       float hysteresis,
+                       float dt);
+
+/**
+ * @brief Initialize an auto-tuner with cycle count and timeout
+ *
+ * @param tune        Pointer to auto-tuner
+ * @param setpoint    Operating point to oscillate around
+ * @param bias        Output that holds the plant near the setpoint
+ * @param amplitude   Relay amplitude, > 0
+ * @param hysteresis  Switching band, >= 0
+ * @param dt          Sample time in seconds
+ * @param cycles      Cycles to average after PID_AUTOTUNE_SETTLE_CYCLES (>= 1)
+ * @param max_steps   Fail after this many steps (0 = never)
+ */
+void pid_autotune_init_advanced(pid_autotune_t *tune,
+                                float setpoint,
+                                float bias,
+                                float amplitude,
+                                float hysteresis,
+                                float dt,
+                                uint32_t cycles,
+                                uint32_t max_steps);
+
+/**
+ * @brief Advance the relay experiment by one sample
+ *
+ * Must be called periodically at the rate specified by dt, in place of
+ * pid_compute(). Once the experiment has finished the output holds
+ * @p bias.
+ *
+ * @param tune         Pointer to initialized auto-tuner
+ * @param measurement  Current measured value
+ * @return Output to apply to the plant
+ */
+float pid_autotune_step(pid_autotune_t *tune, float measurement);
+
+/**
+ * @brief Current progress of the experiment
+ *
+ * @param tune Pointer to auto-tuner
+ * @return Running, done or failed
+ */
+pid_autotune_status_t pid_autotune_status(const pid_autotune_t *tune);
+
+/**
+ * @brief Compute gains from the measured Ku and Tu
+ *
+ * @param tune  Finished auto-tuner
+ * @param rule  Tuning rule
+ * @param kp    Receives the proportional gain
+ * @param ki    Receives the integral gain
+ * @param kd    Receives the derivative gain
+ * @return 0 on success, -1 if the experiment has not finished successfully
+ */
+int pid_autotune_gains(const pid_autotune_t *tune, pid_tune_rule_t rule,
+                       float *kp, float *ki, float *kd);
+
+/**
+ * @brief Initialize a PID controller with the tuned gains
+ *
+ * Calls pid_init_advanced() with the gains of @p rule, the tuner's dt
+ * and integrator limits out_min/ki .. out_max/ki (as pid_init()). The
+ * controller is left untouched on failure.
+ *
+ * @param tune            Finished auto-tuner
+ * @param rule            Tuning rule
+ * @param pid             PID controller to initialize
+ * @param out_min         Minimum output limit
+ * @param out_max         Maximum output limit
+ * @param derivative_lpf  Derivative filter (0.0 = none)
+ * @return 0 on success, -1 if the experiment has not finished successfully
+ */
+int pid_autotune_apply(const pid_autotune_t *tune, pid_tune_rule_t rule, pid_t *pid,
+                       float out_min, float out_max, float derivative_lpf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PID_AUTOTUNE_H_ */
@@ -0,0 +1,183 @@
+/**
+ * @file    pid_bank.h
+ * @brief   Structure-of-arrays bank of PID controllers
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Stores many PID loops as separate contiguous arrays (one per parameter
+ * or state variable) so a whole bank can be updated in one pass that the
+ * compiler can auto-vectorize. Every lane produces bit-identical results
+ * to pid_compute() on an equivalently configured pid_t.
+ */
+
+#ifndef PID_BANK_H_
+#define PID_BANK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "pid.h"
+
+/** Number of floats of caller storage required per lane */
+#define PID_BANK_FLOATS_PER_LANE 12u
+
+/**
+ * @brief Storage size in floats for a bank of @p n lanes
+ *
+ * Use to size a static buffer: `static float buf[PID_BANK_STORAGE_SIZE(64)];`
+ */
+#define PID_BANK_STORAGE_SIZE(n) ((size_t)(n) * PID_BANK_FLOATS_PER_LANE)
+
+/**
+ * @brief Bank of PID controllers in structure-of-arrays layout
+ *
+ * Each member points into caller-provided storage; element i of every
+ * array belongs to lane i. Do not modify members directly - load lanes
+ * with pid_bank_load().
+ */
+typedef struct {
+    /* Configuration */
+    float *kp;                  /**< Proportional gains */
+    float *ki;                  /**< Integral gains */
+    float *kd;                  /**< Derivative gains */
+    float *dt;                  /**< Sample times in seconds */
+    float *out_min;             /**< Minimum output limits */
+    float *out_max;             /**< Maximum output limits */
+    float *integrator_min;      /**< Min integrator limits (anti-windup) */
+    float *integrator_max;      /**< Max integrator limits (anti-windup) */
+    float *derivative_lpf;      /**< Derivative filter coefficients */
+
+    /* Internal state */
+    float *integrator;          /**< Integral accumulators */
+    float *prev_measurement;    /**< Previous measurements (for derivative) */
+    float *derivative_filtered; /**< Filtered derivative values */
+
+    size_t capacity;            /**< Number of lanes the storage can hold */
+} pid_bank_t;
+
+/**
+ * @brief Batch update kernels
+ *
+ * All kernels produce bit-identical results. SIMD kernels are only
+ * available on x86 builds with GCC/Clang and are selected at run time.
+ */
+typedef enum {
+    PID_BANK_KERNEL_AUTO = 0,  /**< Best kernel supported by the running CPU */
+    PID_BANK_KERNEL_SCALAR,    /**< Portable C loop (auto-vectorized) */
+    PID_BANK_KERNEL_SSE41,     /**< x86 SSE4.1, 4 lanes per instruction */
+    PID_BANK_KERNEL_AVX2       /**< x86 AVX2, 8 lanes per instruction */
+} pid_bank_kernel_t;
+
+/**
+ * @brief Initialize a bank over caller-provided storage
+ *
+ * Carves @p storage into the per-parameter arrays. No dynamic memory is
+ * used. For best vectorization, align @p storage to 32 bytes and use a
+ * @p capacity that is a multiple of 8 so every array stays aligned.
+ * All lanes start as zero-gain controllers with [0, 0] limits and
+ * cleared state; configure them with pid_bank_load().
+ *
+ * @param bank      Pointer to bank structure
+ * @param storage   Buffer of at least PID_BANK_STORAGE_SIZE(capacity) floats
+ * @param capacity  Number of lanes
+ */
+void pid_bank_init(pid_bank_t *bank, float *storage, size_t capacity);
+
+/**
+ * @brief Copy configuration and state of a pid_t into one lane
+ *
+ * Configure the source with pid_init() or pid_init_advanced() first.
+ *
+ * @param bank  Pointer to initialized bank
+ * @param lane  Lane index (< capacity)
+ * @param pid   Source controller
+ */
+void pid_bank_load(pid_bank_t *bank, size_t lane, const pid_t *pid);
+
+/**
+ * @brief Copy one lane back into a pid_t
+ *
+ * prev_error is not tracked by the bank and is written as zero, as is
+ * derivative_filtered for lanes without derivative filtering.
+ *
+ * @param bank  Pointer to initialized bank
+ * @param lane  Lane index (< capacity)
+ * @param pid   Destination controller
+ */
+void pid_bank_store(const pid_bank_t *bank, size_t lane, pid_t *pid);
+
+/**
+ * @brief Compute outputs for the first @p n lanes
+ *
+ * Lane i is updated exactly as pid_compute() would update an equivalent
+ * pid_t with setpoints[i] and measurements[i]. The data-dependent
+ * filter branch and the clamps are expressed as selects so the loop
+ * body contains no control flow. Uses the widest SIMD kernel the CPU
+ * supports (see pid_bank_kernel_best()).
+ *
+ * @param bank          Pointer to initialized bank
+ * @param setpoints     Target values (n elements)
+ * @param measurements  Measured values (n elements)
+ * @param outputs       Receives clamped outputs (n elements, must not alias inputs)
+ * @param n             Number of lanes to update (<= capacity)
+ */
+void pid_bank_compute(pid_bank_t *bank,
+                      const float *setpoints,
+                      const float *measurements,
+                      float *outputs,
+                      size_t n);
+
+/**
+ * @brief Compute outputs for the first @p n lanes with a given kernel
+ *
+ * Same contract as pid_bank_compute(). Intended for benchmarking and
+ * cross-checking kernels against each other.
+ *
+ * @param kernel        Kernel to use (must be supported, see below)
+ * @param bank          Pointer to initialized bank
+ * @param setpoints     Target values (n elements)
+ * @param measurements  Measured values (n elements)
+ * @param outputs       Receives clamped outputs (n elements)
+ * @param n             Number of lanes to update (<= capacity)
+ */
+void pid_bank_compute_with(pid_bank_kernel_t kernel,
+                           pid_bank_t *bank,
+                           const float *setpoints,
+                           const float *measurements,
+                           float *outputs,
+                           size_t n);
+
+/**
+ * @brief Check whether a kernel can run on this build and CPU
+ *
+ * @param kernel Kernel to query
+ * @return 1 if supported, 0 otherwise
+ */
+int pid_bank_kernel_supported(pid_bank_kernel_t kernel);
+
+/**
+ * @brief Kernel that PID_BANK_KERNEL_AUTO resolves to
+ *
+ * @return Widest supported kernel
+ */
+pid_bank_kernel_t pid_bank_kernel_best(void);
+
+/**
+ * @brief Reset internal state of every lane
+ *
+ * Clears integrators, previous measurements and filtered derivatives.
+ * Preserves configuration.
+ *
+ * @param bank Pointer to initialized bank
+ */
+void pid_bank_reset(pid_bank_t *bank);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PID_BANK_H_ */
@@ -0,0 +1,138 @@
+/**
+ * @file    pid_cascade.h
+ * @brief   Multi-rate cascade of PID loops (e.g. position-velocity-current)
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Chains up to PID_CASCADE_MAX_STAGES controllers, outermost first: the
+ * output of each stage is the setpoint of the next, and the innermost
+ * output drives the plant. pid_cascade_step() is called at the base
+ * rate; stage k runs every decimation[k] ticks and holds its output in
+ * between. A typical servo axis:
+ *
+ *   stage 0  position  decimation 100   200 Hz
+ *   stage 1  velocity  decimation 10    2 kHz
+ *   stage 2  current   decimation 1     20 kHz (base tick)
+ *
+ * Decimations must nest (each a multiple of the next inner one), so the
+ * stages due on a tick are always a contiguous run ending at the
+ * innermost. A table built at configuration time gives the first due
+ * stage for each phase of the outermost period; a tick is one table
+ * load and a straight loop over the due stages, with no per-stage rate
+ * tests.
+ *
+ * Saturation propagates outwards: a stage whose output is clamped, or
+ * whose inner stages are pinned, blocks the integrator of the stage
+ * outside it from winding further in that direction.
+ */
+
+#ifndef PID_CASCADE_H_
+#define PID_CASCADE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "pid.h"
+
+#ifndef PID_CASCADE_MAX_STAGES
+#define PID_CASCADE_MAX_STAGES 3u   /**< Loops per cascade */
+#endif
+
+#ifndef PID_CASCADE_MAX_PERIOD
+#define PID_CASCADE_MAX_PERIOD 256u /**< Largest outermost decimation (schedule bytes) */
+#endif
+
+/**
+ * @brief Cascade of PID loops at nested rates
+ *
+ * Do not modify members directly - use the API functions.
+ */
+typedef struct {
+    /* Configuration (set by pid_cascade_add_stage()) */
+    pid_t stage[PID_CASCADE_MAX_STAGES];         /**< Loops, outermost first */
+    uint32_t decimation[PID_CASCADE_MAX_STAGES]; /**< Base ticks per stage update */
+    uint32_t count;                              /**< Stages added */
+    uint32_t period;                             /**< Outermost decimation */
+    float dt;                                    /**< Base tick in seconds */
+    uint8_t first_due[PID_CASCADE_MAX_PERIOD];   /**< Outermost stage due, per phase */
+
+    /* Internal state */
+    uint32_t phase;                              /**< Tick within the period */
+    float reference[PID_CASCADE_MAX_STAGES + 1]; /**< Setpoint of stage k; [count] = output */
+    int32_t blocked[PID_CASCADE_MAX_STAGES + 1]; /**< +1/-1: stage k output pinned high/low */
+} pid_cascade_t;
+
+/**
+ * @brief Initialize an empty cascade
+ *
+ * @param cascade  Pointer to cascade
+ * @param dt       Base tick in seconds (period of pid_cascade_step() calls)
+ */
+void pid_cascade_init(pid_cascade_t *cascade, float dt);
+
+/**
+ * @brief Append a stage inside the existing ones
+ *
+ * Add stages outermost first. The controller is copied in; configure it
+ * with pid_init() or pid_init_advanced() using dt = base dt * decimation.
+ *
+ * @param cascade     Pointer to initialized cascade
+ * @param pid         Configured controller for this stage
+ * @param decimation  Base ticks per update: >= 1, dividing the previous
+ *                    stage's decimation (the first stage's must be at
+ *                    most PID_CASCADE_MAX_PERIOD)
+ */
+void pid_cascade_add_stage(pid_cascade_t *cascade, const pid_t *pid, uint32_t decimation);
+
+/**
+ * @brief Advance the cascade by one base tick
+ *
+ * Runs every stage due on this tick, outermost first, each with the
+ * held output of the stage outside it as setpoint. The first tick after
+ * init or reset runs all stages. Measurements of stages not due are
+ * ignored.
+ *
+ * @param cascade       Pointer to cascade with at least one stage
+ * @param setpoint      Setpoint of the outermost stage
+ * @param measurements  Measured value per stage, outermost first (count elements)
+ * @return Innermost output, to apply to the plant
+ */
+float pid_cascade_step(pid_cascade_t *cascade, float setpoint, const float *measurements);
+
+/**
+ * @brief Setpoint last given to a stage
+ *
+ * @param cascade  Pointer to cascade
+ * @param stage    Stage index (< count); count returns the innermost output
+ * @return Held reference
+ */
+float pid_cascade_reference(const pid_cascade_t *cascade, uint32_t stage);
+
+/**
+ * @brief Controller of a stage, for inspection or retuning
+ *
+ * @param cascade  Pointer to cascade
+ * @param stage    Stage index (< count)
+ * @return Pointer to the stage controller
+ */
+pid_t *pid_cascade_stage(pid_cascade_t *cascade, uint32_t stage);
+
+/**
+ * @brief Reset every stage and restart the schedule
+ *
+ * Clears controller state, held references and saturation flags.
+ * Preserves configuration.
+ *
+ * @param cascade Pointer to cascade
+ */
+void pid_cascade_reset(pid_cascade_t *cascade);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PID_CASCADE_H_ */
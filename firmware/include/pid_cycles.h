@@ -0,0 +1,140 @@
+/**
+ * @file    pid_cycles.h
+ * @brief   Cycle-budget instrumentation for pid_compute()
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Build with PID_CYCLE_STATS=1 (CMake option PID_CYCLE_STATS) and every
+ * pid_compute() / pid_compute_fast() / pid_compute_dt() call records its
+ * duration in a stats block inside the pid_t instance: call count, min,
+ * max, total (for the mean) and a log2 histogram whose upper bins show
+ * how close the worst calls come to the ISR deadline. With the default
+ * PID_CYCLE_STATS=0 the hooks expand to nothing and pid_t keeps its
+ * layout, so uninstrumented builds pay neither time nor memory.
+ *
+ * The counter is PID_CYCLE_COUNTER(), which defaults to
+ * pid_cycles_now(): the x86 time-stamp counter where available,
+ * otherwise clock_gettime(CLOCK_MONOTONIC) nanoseconds. On a target,
+ * define it to the core cycle counter when compiling pid.c, e.g.
+ * -D'PID_CYCLE_COUNTER()=DWT->CYCCNT' on Cortex-M3/M4/M7.
+ *
+ * The setting changes the pid_t layout: the library and everything
+ * including pid.h must be built with the same value (the CMake option
+ * exports it to consumers of pid_controller).
+ */
+
+#ifndef PID_CYCLES_H_
+#define PID_CYCLES_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef PID_CYCLE_STATS
+#define PID_CYCLE_STATS 0      /**< 1 = instrument pid_compute() */
+#endif
+
+/** Histogram bins: bin k counts calls of 2^k .. 2^(k+1)-1 cycles (0 in bin 0) */
+#define PID_CYCLE_HIST_BINS 32u
+
+/**
+ * @brief Per-instance call duration statistics
+ *
+ * Durations are in counter ticks (see pid_cycles_source()).
+ */
+typedef struct {
+    uint32_t calls;            /**< Calls recorded */
+    uint32_t min;              /**< Shortest call (UINT32_MAX before the first) */
+    uint32_t max;              /**< Longest call */
+    uint64_t total;            /**< Sum of all calls, for the mean */
+    uint32_t histogram[PID_CYCLE_HIST_BINS]; /**< log2 duration histogram */
+} pid_cycle_stats_t;
+
+/**
+ * @brief Clear statistics
+ *
+ * @param stats Statistics block
+ */
+void pid_cycle_stats_reset(pid_cycle_stats_t *stats);
+
+/**
+ * @brief Record one call
+ *
+ * @param stats   Statistics block
+ * @param cycles  Duration of the call
+ */
+void pid_cycle_stats_record(pid_cycle_stats_t *stats, uint32_t cycles);
+
+/**
+ * @brief Mean call duration
+ *
+ * @param stats Statistics block
+ * @return Total / calls, rounded down (0 before the first call)
+ */
+uint32_t pid_cycle_stats_mean(const pid_cycle_stats_t *stats);
+
+/**
+ * @brief Calls at or above a cycle budget
+ *
+ * Counted from the histogram, so @p budget is rounded down to a power
+ * of two: the result may include calls up to 2x below it, never misses
+ * one above it.
+ *
+ * @param stats   Statistics block
+ * @param budget  Cycle budget (e.g. the ISR deadline minus its other work)
+ * @return Calls in the bins reaching @p budget
+ */
+uint32_t pid_cycle_stats_over(const pid_cycle_stats_t *stats, uint32_t budget);
+
+/**
+ * @brief Print a summary and the non-empty histogram bins
+ *
+ * @param stats  Statistics block
+ * @param name   Label for the first line
+ * @param out    Destination stream
+ */
+void pid_cycle_stats_dump(const pid_cycle_stats_t *stats, const char *name, FILE *out);
+
+/**
+ * @brief Default cycle counter
+ *
+ * x86 time-stamp counter (reference cycles) when built with GCC, Clang
+ * or MSVC for x86; otherwise monotonic nanoseconds. Wraps at 2^32;
+ * differences of two readings are exact for calls shorter than that.
+ *
+ * @return Current counter value
+ */
+uint32_t pid_cycles_now(void);
+
+/**
+ * @brief Unit of pid_cycles_now() ("rdtsc", "ns" or "clock")
+ *
+ * @return Static string
+ */
+const char *pid_cycles_source(void);
+
+#ifndef PID_CYCLE_COUNTER
+#define PID_CYCLE_COUNTER() pid_cycles_now()
+#endif
+
+#if PID_CYCLE_STATS
+/** Open a measured region (declares a local) */
+#define PID_CYCLES_BEGIN() uint32_t pid_cycles_start_ = (uint32_t)PID_CYCLE_COUNTER()
+/** Close the region opened by PID_CYCLES_BEGIN() and record it */
+#define PID_CYCLES_END(stats) \
+    pid_cycle_stats_record((stats), (uint32_t)PID_CYCLE_COUNTER() - pid_cycles_start_)
+#else
+#define PID_CYCLES_BEGIN() ((void)0)
+#define PID_CYCLES_END(stats) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PID_CYCLES_H_ */
@@ -0,0 +1,315 @@
+/**
+ * @file    pid_design.hpp
+ * @brief   Compile-time closed-loop analysis and PI design for the motor plant
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Evaluates a pid_init_advanced()-style configuration (pid::Gains)
+ * against the first-order plant of motor.c,
+ *
+ *   speed[n+1] = speed[n] + alpha * (gain * u[n] - speed[n])
+ *   G(z) = alpha * gain / (z - (1 - alpha))
+ *
+ * with the loop ordered as in main.c (measure, pid_compute(), apply,
+ * update). Everything is constexpr, so a bad tuning can be rejected
+ * when the firmware is built, at no runtime cost:
+ *
+ *   constexpr pid::Gains<double> tuning{ 0.8, 0.3, 0.05, 0.01, -1.0, 1.0, -3.3, 3.3, 0.8 };
+ *   constexpr auto loop = pid::design::analyze(tuning);
+ *   static_assert(loop.stable, "Speed loop tuning is unstable");
+ *   static_assert(loop.stability_margin > 0.02, "Speed loop too lightly damped");
+ *
+ * The analysis is linear: output and integrator clamps are ignored, so
+ * it describes small-signal behaviour around an unsaturated operating
+ * point. Controller terms with zero gain are left out of the model; an
+ * unused integrator would otherwise add a pole at z = 1.
+ */
+
+#ifndef PID_DESIGN_HPP_
+#define PID_DESIGN_HPP_
+
+#include "motor.h"
+#include "pid.hpp"
+
+namespace pid {
+namespace design {
+
+/*============================================================================*/
+/* TYPES                                                                     */
+/*============================================================================*/
+
+/* motor.h defaults as double constants (GCC 12 does not fold the
+ * float-to-double conversion inside a default member initializer) */
+inline constexpr double default_gain = MOTOR_MODEL_DEFAULT_GAIN;
+inline constexpr double default_alpha = MOTOR_MODEL_DEFAULT_ALPHA;
+
+/** First-order plant, as motor_model_init_advanced() */
+struct Plant {
+    double gain = default_gain;    /**< Steady-state speed per unit input */
+    double alpha = default_alpha;  /**< Response rate per step (dt / tau) */
+};
+
+/** Complex number (std::complex is not constexpr in C++17) */
+struct Complex {
+    double re = 0.0;
+    double im = 0.0;
+};
+
+/** Polynomial in z, coefficient k multiplies z^k */
+struct Poly {
+    static constexpr int max_degree = 3;
+
+    double c[max_degree + 1] = {};
+    int degree = 0;
+};
+
+/**
+ * @brief Closed-loop analysis result
+ *
+ * Controller C(z) = num(z) / den(z) is the discretized pid_compute()
+ * (derivative filter included); with derivative_lpf = 0 and all gains
+ * non-zero, num / z^2 gives the familiar difference equation
+ * u[n] = u[n-1] + b0 e[n] + b1 e[n-1] + b2 e[n-2].
+ */
+struct Analysis {
+    Poly controller_num;       /**< C(z) numerator */
+    Poly controller_den;       /**< C(z) denominator (monic) */
+    double plant_pole = 0.0;   /**< 1 - alpha */
+    double plant_gain = 0.0;   /**< alpha * gain */
+    Poly characteristic;       /**< Monic closed-loop characteristic polynomial */
+    Complex poles[Poly::max_degree] = {};  /**< Closed-loop poles */
+    int num_poles = 0;         /**< Valid entries in poles[] */
+    double spectral_radius = 0.0;   /**< Largest pole magnitude */
+    double stability_margin = 0.0;  /**< 1 - spectral_radius (< 0: unstable) */
+    bool stable = false;       /**< All poles strictly inside the unit circle */
+};
+
+namespace detail {
+
+constexpr double abs(double x) noexcept { return x < 0.0 ? -x : x; }
+
+constexpr double sqrt(double x) noexcept
+{
+    if (x <= 0.0) return 0.0;
+    double r = x < 1.0 ? 1.0 : x;
+    for (int i = 0; i < 64; i++) {
+        r = 0.5 * (r + x / r);
+    }
+    return r;
+}
+
+constexpr Complex operator+(Complex a, Complex b) noexcept { return { a.re + b.re, a.im + b.im }; }
+constexpr Complex operator-(Complex a, Complex b) noexcept { return { a.re - b.re, a.im - b.im }; }
+constexpr Complex operator*(Complex a, Complex b) noexcept
+{
+    return { a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re };
+}
+constexpr Complex operator/(Complex a, Complex b) noexcept
+{
+    double d = b.re * b.re + b.im * b.im;
+    return { (a.re * b.re + a.im * b.im) / d, (a.im * b.re - a.re * b.im) / d };
+}
+constexpr double magnitude(Complex a) noexcept { return sqrt(a.re * a.re + a.im * a.im); }
+
+constexpr Poly constant(double value) noexcept
+{
+    Poly p{};
+    p.c[0] = value;
+    return p;
+}
+
+/* z - root */
+constexpr Poly monomial(double root) noexcept
+{
+    Poly p{};
+    p.c[0] = -root;
+    p.c[1] = 1.0;
+    p.degree = 1;
+    return p;
+}
+
+constexpr Poly multiply(const Poly &a, const Poly &b) noexcept
+{
+    Poly p{};
+    p.degree = a.degree + b.degree;
+    assert(p.degree <= Poly::max_degree && "Polynomial degree exceeds max_degree");
+    for (int i = 0; i <= a.degree; i++) {
+        for (int j = 0; j <= b.degree; j++) {
+            p.c[i + j] += a.c[i] * b.c[j];
+        }
+    }
+    return p;
+}
+
+constexpr Poly scale(const Poly &a, double k) noexcept
+{
+    Poly p = a;
+    for (int i = 0; i <= p.degree; i++) {
+        p.c[i] *= k;
+    }
+    return p;
+}
+
+constexpr Poly add(const Poly &a, const Poly &b) noexcept
+{
+    Poly p{};
+    p.degree = a.degree > b.degree ? a.degree : b.degree;
+    for (int i = 0; i <= p.degree; i++) {
+        p.c[i] = (i <= a.degree ? a.c[i] : 0.0) + (i <= b.degree ? b.c[i] : 0.0);
+    }
+    return p;
+}
+
+constexpr Complex evaluate(const Poly &p, Complex z) noexcept
+{
+    Complex acc{ p.c[p.degree], 0.0 };
+    for (int i = p.degree - 1; i >= 0; i--) {
+        acc = acc * z + Complex{ p.c[i], 0.0 };
+    }
+    return acc;
+}
+
+/* Schur-Cohn test: every root strictly inside the unit circle */
+constexpr bool schur_stable(const Poly &p) noexcept
+{
+    Poly a = p;
+
+    while (a.degree > 0) {
+        double lead = a.c[a.degree];
+        double tail = a.c[0];
+        if (abs(tail) >= abs(lead)) return false;
+
+        /* (lead * a(z) - tail * z^m a(1/z)) / z has the same number of
+         * roots inside the circle, one degree lower */
+        Poly r{};
+        r.degree = a.degree - 1;
+        for (int k = 1; k <= a.degree; k++) {
+            r.c[k - 1] = lead * a.c[k] - tail * a.c[a.degree - k];
+        }
+        a = r;
+    }
+    return true;
+}
+
+/* Durand-Kerner iteration on a monic polynomial */
+constexpr void roots(const Poly &p, Complex *out) noexcept
+{
+    const Complex seed{ 0.4, 0.9 };
+    Complex z{ 1.0, 0.0 };
+
+    for (int i = 0; i < p.degree; i++) {
+        out[i] = z;
+        z = z * seed;
+    }
+    for (int iter = 0; iter < 500; iter++) {
+        for (int i = 0; i < p.degree; i++) {
+            Complex denom{ 1.0, 0.0 };
+            for (int j = 0; j < p.degree; j++) {
+                if (j != i) denom = denom * (out[i] - out[j]);
+            }
+            if (denom.re == 0.0 && denom.im == 0.0) continue;
+            out[i] = out[i] - evaluate(p, out[i]) / denom;
+        }
+    }
+}
+
+} // namespace detail
+
+/*============================================================================*/
+/* ANALYSIS AND DESIGN                                                       */
+/*============================================================================*/
+
+/**
+ * @brief Analyze a configuration in closed loop with @p plant
+ *
+ * @param gains  Controller configuration (integrator and output limits unused)
+ * @param plant  Plant parameters (default: motor.c defaults)
+ * @return Discretized controller and plant, closed-loop poles and margin
+ */
+constexpr Analysis analyze(const Gains<double> &gains, Plant plant = Plant{}) noexcept
+{
+    assert(gains.dt > 0.0 && "Sample time must be positive");
+    assert(plant.alpha > 0.0 && plant.alpha <= 1.0 && "Response rate must be in (0, 1]");
+
+    Analysis a{};
+    double lpf = pid::detail::clamp(gains.derivative_lpf, 0.0, 1.0);
+    double kd_eff = gains.kd * (1.0 - lpf) / gains.dt;
+    bool has_i = gains.ki != 0.0;
+    bool has_d = kd_eff != 0.0;
+
+    /* C(z) = kp + ki dt z/(z-1) + kd (1-lpf)/dt (z-1)/(z-lpf) */
+    Poly den_i = has_i ? detail::monomial(1.0) : detail::constant(1.0);
+    Poly den_d = has_d ? detail::monomial(lpf) : detail::constant(1.0);
+    a.controller_den = detail::multiply(den_i, den_d);
+    a.controller_num = detail::scale(a.controller_den, gains.kp);
+    if (has_i) {
+        a.controller_num = detail::add(a.controller_num,
+                                       detail::scale(detail::multiply(detail::monomial(0.0), den_d),
+                                                     gains.ki * gains.dt));
+    }
+    if (has_d) {
+        a.controller_num = detail::add(a.controller_num,
+                                       detail::scale(detail::multiply(detail::monomial(1.0), den_i),
+                                                     kd_eff));
+    }
+
+    /* 1 + C(z) G(z) = 0  ->  den (z - pole) + plant_gain num = 0 */
+    a.plant_pole = 1.0 - plant.alpha;
+    a.plant_gain = plant.alpha * plant.gain;
+    Poly q = detail::add(detail::multiply(a.controller_den, detail::monomial(a.plant_pole)),
+                         detail::scale(a.controller_num, a.plant_gain));
+    a.characteristic = detail::scale(q, 1.0 / q.c[q.degree]);
+
+    a.num_poles = a.characteristic.degree;
+    detail::roots(a.characteristic, a.poles);
+    for (int i = 0; i < a.num_poles; i++) {
+        double m = detail::magnitude(a.poles[i]);
+        if (m > a.spectral_radius) a.spectral_radius = m;
+    }
+    a.stability_margin = 1.0 - a.spectral_radius;
+    a.stable = detail::schur_stable(a.characteristic);
+    return a;
+}
+
+/**
+ * @brief True if the configuration is stable with @p plant
+ */
+constexpr bool is_stable(const Gains<double> &gains, Plant plant = Plant{}) noexcept
+{
+    return analyze(gains, plant).stable;
+}
+
+/**
+ * @brief PI gains placing both closed-loop poles at z = @p pole
+ *
+ * With C(z) = kp + ki dt z/(z-1) the characteristic polynomial is
+ * z^2 + (bg (kp + ki dt) - 1 - p) z + (p - bg kp), bg = alpha * gain,
+ * p = 1 - alpha; matching it to (z - pole)^2 gives kp and ki.
+ * Integrator limits follow pid_init() (out/ki).
+ *
+ * @param plant    Plant parameters
+ * @param dt       Sample time in seconds
+ * @param pole     Desired closed-loop pole, in [0, sqrt(1 - alpha)]
+ * @param out_min  Minimum output limit
+ * @param out_max  Maximum output limit
+ */
+constexpr Gains<double> place_pi(Plant plant, double dt, double pole,
+                                 double out_min, double out_max) noexcept
+{
+    assert(pole >= 0.0 && pole < 1.0 && "Pole must be in [0, 1)");
+
+    double bg = plant.alpha * plant.gain;
+    double p = 1.0 - plant.alpha;
+    double kp = (p - pole * pole) / bg;
+    assert(kp >= 0.0 && "Pole slower than the plant needs a negative kp");
+    double ki = ((1.0 + p - 2.0 * pole) / bg - kp) / dt;
+
+    return Gains<double>::standard(kp, ki, 0.0, dt, out_min, out_max);
+}
+
+} // namespace design
+} // namespace pid
+
+#endif /* PID_DESIGN_HPP_ */
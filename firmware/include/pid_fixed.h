@@ -0,0 +1,204 @@
+/**
+ * @file    pid_fixed.h
+ * @brief   Fixed-point (Q31/Q15) PID controller for cores without an FPU
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Integer-only counterpart of pid.h with the same features: anti-windup,
+ * derivative-on-measurement and optional derivative filtering. Signals
+ * (setpoint, measurement, output, limits) are signed fractions in
+ * [-1, 1): Q31 in int32_t or Q15 in int16_t. Scale engineering units
+ * into that range before calling.
+ *
+ * Gains are given as float to the init functions and converted once;
+ * the compute functions use only integer arithmetic, with 64-bit
+ * intermediates and saturation instead of wrap-around.
+ */
+
+#ifndef PID_FIXED_H_
+#define PID_FIXED_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/** Q31 value of the largest representable fraction (just below 1.0) */
+#define PID_Q31_MAX INT32_MAX
+/** Q31 value of -1.0 */
+#define PID_Q31_MIN INT32_MIN
+/** Q15 value of the largest representable fraction (just below 1.0) */
+#define PID_Q15_MAX INT16_MAX
+/** Q15 value of -1.0 */
+#define PID_Q15_MIN INT16_MIN
+
+/**
+ * @brief Fixed-point coefficient: value = mantissa / 2^shift
+ *
+ * The shift is chosen per coefficient so large gains (kd/dt) and tiny
+ * ones (ki*dt) both keep ~30 bits of precision.
+ */
+typedef struct {
+    int32_t mantissa;          /**< Signed mantissa, |mantissa| < 2^30 */
+    int32_t shift;             /**< Right shift applied after multiply (0-62) */
+} pid_qcoef_t;
+
+/**
+ * @brief Q31 PID controller instance
+ *
+ * Integrator and filtered derivative are stored already multiplied by
+ * their gains (in output units), which removes a multiply per term and
+ * keeps both within Q31 range. Do not modify members directly.
+ */
+typedef struct {
+    /* Configuration (derived during initialization) */
+    pid_qcoef_t kp;            /**< Proportional gain */
+    pid_qcoef_t ki_dt;         /**< Integral gain × sample time */
+    pid_qcoef_t kd_inv_dt;     /**< Derivative gain / sample time */
+    pid_qcoef_t lpf;           /**< Derivative filter coefficient α */
+    pid_qcoef_t lpf_complement;/**< 1 - α */
+    int32_t out_min;           /**< Minimum output limit (Q31) */
+    int32_t out_max;           /**< Maximum output limit (Q31) */
+    int32_t integrator_min;    /**< Min I term (Q31, = Ki × float integrator_min) */
+    int32_t integrator_max;    /**< Max I term (Q31, = Ki × float integrator_max) */
+
+    /* Internal state (modified during operation) */
+    int32_t integrator;        /**< I term (Q31) */
+    int32_t prev_measurement;  /**< Previous measurement (Q31) */
+    int32_t derivative_filtered; /**< Filtered D term (Q31) */
+} pid_q31_t;
+
+/**
+ * @brief Q15 PID controller instance
+ *
+ * Q15 inputs and outputs over a Q31 core: Ki × dt is typically below
+ * Q15 resolution, so 16-bit internal state would lose the integral term.
+ */
+typedef struct {
+    pid_q31_t core;            /**< Q31 controller doing the work */
+} pid_q15_t;
+
+/**
+ * @brief Initialize Q31 PID controller with standard configuration
+ *
+ * Mirrors pid_init(): integrator limits follow the output limits and
+ * derivative filtering is disabled.
+ *
+ * @param pid      Pointer to Q31 PID structure
+ * @param kp       Proportional gain (|kp| < 2^30)
+ * @param ki       Integral gain (0 to disable)
+ * @param kd       Derivative gain (0 to disable)
+ * @param dt       Sample time in seconds
+ * @param out_min  Minimum output limit (Q31)
+ * @param out_max  Maximum output limit (Q31)
+ */
+void pid_q31_init(pid_q31_t *pid,
+                  float kp,
+                  float ki,
+                  float kd,
+                  float dt,
+                  int32_t out_min,
+                  int32_t out_max);
+
+/**
+ * @brief Initialize Q31 PID controller with advanced options
+ *
+ * Mirrors pid_init_advanced(). Integrator limits are given in the same
+ * units as for the float controller (error × seconds, with error as a
+ * fraction) and converted to I-term limits internally.
+ *
+ * @param pid             Pointer to Q31 PID structure
+ * @param kp              Proportional gain
+ * @param ki              Integral gain
+ * @param kd              Derivative gain
+ * @param dt              Sample time in seconds
+ * @param out_min         Minimum output limit (Q31)
+ * @param out_max         Maximum output limit (Q31)
+ * @param integrator_min  Min integrator limit (float controller units)
+ * @param integrator_max  Max integrator limit (float controller units)
+ * @param derivative_lpf  Derivative filter (0.0=none, 0.7-0.9=recommended)
+ */
+void pid_q31_init_advanced(pid_q31_t *pid,
+                           float kp,
+                           float ki,
+                           float kd,
+                           float dt,
+                           int32_t out_min,
+                           int32_t out_max,
+                           float integrator_min,
+                           float integrator_max,
+                           float derivative_lpf);
+
+/**
+ * @brief Calculate Q31 PID control output
+ *
+ * Integer-only equivalent of pid_compute().
+ *
+ * @param pid         Pointer to initialized Q31 PID structure
+ * @param setpoint    Target value (Q31)
+ * @param measurement Current measured value (Q31)
+ * @return Control output (Q31) clamped to [out_min, out_max]
+ */
+int32_t pid_q31_compute(pid_q31_t *pid, int32_t setpoint, int32_t measurement);
+
+/**
+ * @brief Reset Q31 PID controller internal state
+ *
+ * @param pid Pointer to Q31 PID structure
+ */
+void pid_q31_reset(pid_q31_t *pid);
+
+/**
+ * @brief Initialize Q15 PID controller with standard configuration
+ *
+ * @see pid_q31_init()
+ */
+void pid_q15_init(pid_q15_t *pid,
+                  float kp,
+                  float ki,
+                  float kd,
+                  float dt,
+                  int16_t out_min,
+                  int16_t out_max);
+
+/**
+ * @brief Initialize Q15 PID controller with advanced options
+ *
+ * @see pid_q31_init_advanced()
+ */
+void pid_q15_init_advanced(pid_q15_t *pid,
+                           float kp,
+                           float ki,
+                           float kd,
+                           float dt,
+                           int16_t out_min,
+                           int16_t out_max,
+                           float integrator_min,
+                           float integrator_max,
+                           float derivative_lpf);
+
+/**
+ * @brief Calculate Q15 PID control output
+ *
+ * @param pid         Pointer to initialized Q15 PID structure
+ * @param setpoint    Target value (Q15)
+ * @param measurement Current measured value (Q15)
+ * @return Control output (Q15, rounded) clamped to [out_min, out_max]
+ */
+int16_t pid_q15_compute(pid_q15_t *pid, int16_t setpoint, int16_t measurement);
+
+/**
+ * @brief Reset Q15 PID controller internal state
+ *
+ * @param pid Pointer to Q15 PID structure
+ */
+void pid_q15_reset(pid_q15_t *pid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PID_FIXED_H_ */
@@ -0,0 +1,124 @@
+/**
+ * @file    pid_gain_schedule.h
+ * @brief   Gain scheduling table with interpolated, bumpless gain updates
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Maps an operating variable (speed, load, temperature) to kp/ki/kd by
+ * linear interpolation between breakpoints. Intended to run every
+ * sample ahead of pid_compute():
+ *
+ *   pid_gain_schedule_apply(&schedule, &pid, speed);
+ *   output = pid_compute(&pid, setpoint, speed);
+ *
+ * pid_gain_schedule_apply() hands the gains to pid_set_gains(), which
+ * rescales the integrator so the integral term does not jump, so gains
+ * may change every sample without transients or a pid_init().
+ *
+ * Lookup cost does not depend on the table contents: the search runs
+ * log2(PID_GAIN_SCHEDULE_MAX_POINTS) steps of compare-and-add (no
+ * data-dependent branches) over a dense key array padded with FLT_MAX,
+ * then one multiply-add per gain using slopes precomputed at init. The
+ * keys fit in one cache line and each segment record in half of one.
+ * Outside the first/last breakpoint the end gains are held.
+ */
+
+#ifndef PID_GAIN_SCHEDULE_H_
+#define PID_GAIN_SCHEDULE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "pid.h"
+
+#ifndef PID_GAIN_SCHEDULE_MAX_POINTS
+#define PID_GAIN_SCHEDULE_MAX_POINTS 16u   /**< Breakpoints per table (power of two) */
+#endif
+
+#if (PID_GAIN_SCHEDULE_MAX_POINTS & (PID_GAIN_SCHEDULE_MAX_POINTS - 1u)) != 0u
+#error "PID_GAIN_SCHEDULE_MAX_POINTS must be a power of two"
+#endif
+
+/**
+ * @brief Controller gains
+ */
+typedef struct {
+    float kp;                  /**< Proportional gain */
+    float ki;                  /**< Integral gain */
+    float kd;                  /**< Derivative gain */
+} pid_gains_t;
+
+/**
+ * @brief One row of a schedule, as supplied by the caller
+ */
+typedef struct {
+    float at;                  /**< Operating variable value of this row */
+    pid_gains_t gains;         /**< Gains at that value */
+} pid_gain_point_t;
+
+/**
+ * @brief Interpolation segment starting at one breakpoint (32 bytes)
+ */
+typedef struct {
+    float start;               /**< Breakpoint the segment starts at */
+    pid_gains_t gains;         /**< Gains at start */
+    pid_gains_t slope;         /**< Gain change per unit of the operating variable */
+    float reserved;            /**< Padding to 32 bytes */
+} pid_gain_segment_t;
+
+/**
+ * @brief Gain schedule
+ *
+ * Do not modify members directly - use the API functions.
+ */
+typedef struct {
+    float keys[PID_GAIN_SCHEDULE_MAX_POINTS];                 /**< Breakpoints, FLT_MAX padded */
+    pid_gain_segment_t segment[PID_GAIN_SCHEDULE_MAX_POINTS]; /**< Segment per breakpoint */
+    float min;                 /**< First breakpoint */
+    float max;                 /**< Last breakpoint */
+    uint32_t count;            /**< Breakpoints in use */
+} pid_gain_schedule_t;
+
+/**
+ * @brief Build a schedule from rows sorted by operating variable
+ *
+ * @param schedule  Schedule to fill
+ * @param points    Rows, strictly increasing in @p at
+ * @param count     Number of rows (1..PID_GAIN_SCHEDULE_MAX_POINTS)
+ * @return 0 on success, -1 if the rows are not strictly increasing,
+ *         not finite or have negative gains (schedule left unusable)
+ */
+int pid_gain_schedule_init(pid_gain_schedule_t *schedule,
+                           const pid_gain_point_t *points,
+                           uint32_t count);
+
+/**
+ * @brief Interpolated gains at an operating point
+ *
+ * @param schedule  Initialized schedule
+ * @param at        Operating variable (clamped to the table range)
+ * @return Gains linearly interpolated between the enclosing breakpoints
+ */
+pid_gains_t pid_gain_schedule_lookup(const pid_gain_schedule_t *schedule, float at);
+
+/**
+ * @brief Look up gains and apply them to a running controller
+ *
+ * pid_gain_schedule_lookup() followed by pid_set_gains(), so the
+ * integral term stays continuous.
+ *
+ * @param schedule  Initialized schedule
+ * @param pid       Controller to update
+ * @param at        Operating variable
+ */
+void pid_gain_schedule_apply(const pid_gain_schedule_t *schedule, pid_t *pid, float at);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PID_GAIN_SCHEDULE_H_ */
@@ -0,0 +1,188 @@
+/**
+ * @file    pid_pool.h
+ * @brief   Fixed-capacity, statically allocated object pool
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Hands out cache-line-aligned slots for controllers, motor models,
+ * cascades or telemetry buffers from storage sized at compile time, so
+ * a system with a variable number of loops needs no malloc() after boot
+ * and its RAM footprint is fixed at link time:
+ *
+ *   PID_POOL_DEFINE(loop_pool, pid_t, 32);
+ *
+ *   pid_pool_handle_t h = pid_pool_acquire(&loop_pool);
+ *   pid_t *pid = PID_POOL_GET(loop_pool, pid_t, h);
+ *   pid_init(pid, ...);
+ *   ...
+ *   pid_pool_release(&loop_pool, h);
+ *
+ * PID_POOL_DEFINE() emits the slot array as <name>_storage, which the
+ * linker map lists with its size (build with -fdata-sections for one
+ * section per pool). Acquire and release are O(1): released slots go
+ * on a free list, never-used slots are taken from a bump index, so a
+ * statically initialized pool needs no init call.
+ *
+ * Handles carry a generation count. A handle stops resolving once its
+ * slot is released, even after the slot is reused, so a stale handle
+ * yields NULL instead of someone else's object. Pools are not
+ * thread-safe: acquire and release from one context (typically at boot
+ * or from the main loop), or guard them.
+ */
+
+#ifndef PID_POOL_H_
+#define PID_POOL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef PID_POOL_CACHE_LINE
+#define PID_POOL_CACHE_LINE 64     /**< Slot alignment and size granule, bytes */
+#endif
+
+/** Storage alignment attribute (none on unknown compilers) */
+#if defined(__GNUC__) || defined(__clang__)
+#define PID_POOL_ALIGNED __attribute__((aligned(PID_POOL_CACHE_LINE)))
+#elif defined(_MSC_VER)
+#define PID_POOL_ALIGNED __declspec(align(PID_POOL_CACHE_LINE))
+#else
+#define PID_POOL_ALIGNED
+#endif
+
+/** Largest pool capacity (slot indices are 16-bit) */
+#define PID_POOL_MAX_CAPACITY 65535u
+
+/** Object size rounded up to whole cache lines */
+#define PID_POOL_SLOT_SIZE(size) \
+    ((((size_t)(size) + PID_POOL_CACHE_LINE - 1u) / PID_POOL_CACHE_LINE) * PID_POOL_CACHE_LINE)
+
+/** Bytes used by a pool of @p capacity objects of @p type (slots + bookkeeping) */
+#define PID_POOL_FOOTPRINT(type, capacity) \
+    ((size_t)(capacity) * (PID_POOL_SLOT_SIZE(sizeof(type)) + 2u * sizeof(uint16_t)))
+
+/** Handle to an acquired slot; PID_POOL_INVALID never refers to one */
+typedef uint32_t pid_pool_handle_t;
+
+#define PID_POOL_INVALID 0u        /**< Failed acquire / no object */
+
+/**
+ * @brief Object pool over caller-provided (usually static) storage
+ *
+ * Do not modify members directly - use the API functions.
+ */
+typedef struct {
+    unsigned char *storage;    /**< capacity slots of slot_size bytes */
+    uint16_t *links;           /**< Next released slot, per slot */
+    uint16_t *generations;     /**< Odd while acquired, bumped on acquire and release */
+    size_t slot_size;          /**< Bytes per slot (multiple of PID_POOL_CACHE_LINE) */
+    uint16_t capacity;         /**< Number of slots */
+    uint16_t bump;             /**< Slots never acquired start here */
+    uint16_t free_head;        /**< Last released slot, capacity if none */
+    uint16_t live;             /**< Slots currently acquired */
+    uint16_t high_water;       /**< Most slots acquired at once */
+} pid_pool_t;
+
+/**
+ * @brief Define a static pool of @p capacity objects of @p type
+ *
+ * Expands to file-scope static definitions (<name>_storage,
+ * <name>_links, <name>_generations and the pool <name>), ready to use
+ * without pid_pool_init().
+ */
+#define PID_POOL_DEFINE(name, type, capacity)                                            \
+    typedef char name##_capacity_check[((capacity) >= 1 &&                               \
+                                        (capacity) <= PID_POOL_MAX_CAPACITY) ? 1 : -1];  \
+    static PID_POOL_ALIGNED unsigned char                                                \
+        name##_storage[(capacity) * PID_POOL_SLOT_SIZE(sizeof(type))];                   \
+    static uint16_t name##_links[capacity];                                              \
+    static uint16_t name##_generations[capacity];                                        \
+    static pid_pool_t name = { name##_storage, name##_links, name##_generations,         \
+                               PID_POOL_SLOT_SIZE(sizeof(type)), (uint16_t)(capacity),   \
+                               0u, (uint16_t)(capacity), 0u, 0u }
+
+/** Typed pointer to the object behind @p handle in pool @p pool (NULL if stale) */
+#define PID_POOL_GET(pool, type, handle) ((type *)pid_pool_get(&(pool), (handle)))
+
+/**
+ * @brief Initialize a pool over caller-provided storage
+ *
+ * Only needed for pools not created with PID_POOL_DEFINE().
+ *
+ * @param pool         Pool to initialize
+ * @param storage      capacity * slot_size bytes, aligned to PID_POOL_CACHE_LINE
+ * @param slot_size    Bytes per slot, a multiple of PID_POOL_CACHE_LINE
+ *                     (use PID_POOL_SLOT_SIZE(sizeof(type)))
+ * @param capacity     Number of slots (1 to PID_POOL_MAX_CAPACITY)
+ * @param links        capacity elements
+ * @param generations  capacity elements
+ */
+void pid_pool_init(pid_pool_t *pool, void *storage, size_t slot_size, uint16_t capacity,
+                   uint16_t *links, uint16_t *generations);
+
+/**
+ * @brief Take a zeroed slot
+ *
+ * Reuses the most recently released slot first (still warm in cache).
+ *
+ * @param pool Pool
+ * @return Handle, or PID_POOL_INVALID if the pool is exhausted
+ */
+pid_pool_handle_t pid_pool_acquire(pid_pool_t *pool);
+
+/**
+ * @brief Return a slot to the pool
+ *
+ * @param pool    Pool the handle came from
+ * @param handle  Handle from pid_pool_acquire()
+ * @return 0 on success, -1 if the handle is invalid or already released
+ */
+int pid_pool_release(pid_pool_t *pool, pid_pool_handle_t handle);
+
+/**
+ * @brief Object behind a handle
+ *
+ * @param pool    Pool the handle came from
+ * @param handle  Handle from pid_pool_acquire()
+ * @return Slot address, or NULL if the handle is invalid or released
+ */
+void *pid_pool_get(const pid_pool_t *pool, pid_pool_handle_t handle);
+
+/**
+ * @brief Slots currently acquired
+ *
+ * @param pool Pool
+ * @return Live object count
+ */
+uint16_t pid_pool_live(const pid_pool_t *pool);
+
+/**
+ * @brief Most slots ever acquired at once
+ *
+ * Compare with the capacity to right-size PID_POOL_DEFINE().
+ *
+ * @param pool Pool
+ * @return High-water mark
+ */
+uint16_t pid_pool_high_water(const pid_pool_t *pool);
+
+/**
+ * @brief Bytes of static memory the pool occupies
+ *
+ * Same as PID_POOL_FOOTPRINT() for a PID_POOL_DEFINE() pool.
+ *
+ * @param pool Pool
+ * @return Slot storage plus links and generations
+ */
+size_t pid_pool_footprint(const pid_pool_t *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PID_POOL_H_ */
@@ -0,0 +1,131 @@
+/**
+ * @file    pid_schedule.h
+ * @brief   Static multi-rate schedule for many PID loops on one tick
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Loops run at integer multiples of a base tick. Instead of testing a
+ * modulo counter per loop in the ISR, pid_schedule_build() unrolls one
+ * hyperperiod (the least common multiple of the periods) into a flat
+ * table: for each tick, the indices of the loops that fire on it. The
+ * ISR then walks one contiguous run of indices per tick and calls
+ * pid_compute() on each, with no per-loop rate tests.
+ *
+ * The table lives in caller storage (see pid_schedule_storage_size()).
+ * Building can stagger the loop phases to flatten the per-tick load;
+ * the worst tick is reported so it can be checked against the ISR
+ * budget (multiply by the per-call cost, e.g. from pid_cycles.h).
+ */
+
+#ifndef PID_SCHEDULE_H_
+#define PID_SCHEDULE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "pid.h"
+
+#ifndef PID_SCHEDULE_MAX_HYPERPERIOD
+#define PID_SCHEDULE_MAX_HYPERPERIOD 65536u /**< Longest table, in ticks */
+#endif
+
+/**
+ * @brief Phase assignment used by pid_schedule_build()
+ */
+typedef enum {
+    PID_SCHEDULE_ALIGNED = 0,  /**< Every loop fires on tick 0 (keeps cascades in order) */
+    PID_SCHEDULE_STAGGERED     /**< Phases chosen to minimize the busiest tick */
+} pid_schedule_phasing_t;
+
+/**
+ * @brief Precomputed multi-rate schedule
+ *
+ * Do not modify members directly - use the API functions.
+ */
+typedef struct {
+    pid_t *loops;              /**< Controllers, indexed by the table */
+    size_t count;              /**< Number of loops */
+    const uint32_t *offsets;   /**< Tick t runs entries[offsets[t] .. offsets[t + 1]) */
+    const uint32_t *entries;   /**< Loop indices grouped by tick, ascending within a tick */
+    uint32_t hyperperiod;      /**< Ticks before the table repeats */
+    uint32_t phase;            /**< Next tick within the hyperperiod */
+
+    /* Load report (set by pid_schedule_build()) */
+    uint32_t total_calls;      /**< Calls per hyperperiod */
+    uint32_t max_calls;        /**< Calls on the busiest tick */
+    uint32_t worst_tick;       /**< First tick with max_calls */
+} pid_schedule_t;
+
+/**
+ * @brief Storage needed for a schedule
+ *
+ * @param periods  Period of each loop in base ticks (>= 1)
+ * @param count    Number of loops
+ * @return Number of uint32_t to pass to pid_schedule_build() (offsets,
+ *         entries and one phase per loop), or 0 if the hyperperiod
+ *         exceeds PID_SCHEDULE_MAX_HYPERPERIOD
+ */
+size_t pid_schedule_storage_size(const uint32_t *periods, size_t count);
+
+/**
+ * @brief Build the hyperperiod table
+ *
+ * Loops are configured beforehand with pid_init() (dt = base tick *
+ * period) and stay owned by the caller. Staggered phasing assigns
+ * loops fastest first, each to the phase whose ticks are least loaded
+ * so far, earliest phase on ties.
+ *
+ * @param sched     Schedule to initialize
+ * @param loops     Controllers (count elements)
+ * @param periods   Period of each loop in base ticks (>= 1)
+ * @param count     Number of loops (>= 1)
+ * @param phasing   Phase assignment
+ * @param storage   Table buffer
+ * @param capacity  Buffer length in uint32_t
+ * @return 0 on success, -1 if the hyperperiod is too long or @p capacity
+ *         is below pid_schedule_storage_size()
+ */
+int pid_schedule_build(pid_schedule_t *sched,
+                       pid_t *loops,
+                       const uint32_t *periods,
+                       size_t count,
+                       pid_schedule_phasing_t phasing,
+                       uint32_t *storage,
+                       size_t capacity);
+
+/**
+ * @brief Run the loops due on the current tick
+ *
+ * Call once per base tick. Only the outputs of loops that fired are
+ * written; the others keep their previous value.
+ *
+ * @param sched         Built schedule
+ * @param setpoints     Setpoint per loop (count elements)
+ * @param measurements  Measurement per loop (count elements)
+ * @param outputs       Output per loop (count elements)
+ * @return Number of loops computed on this tick
+ */
+uint32_t pid_schedule_tick(pid_schedule_t *sched,
+                           const float *setpoints,
+                           const float *measurements,
+                           float *outputs);
+
+/**
+ * @brief Restart the table at tick 0
+ *
+ * Controller state is left alone; use pid_reset() on the loops.
+ *
+ * @param sched Built schedule
+ */
+void pid_schedule_restart(pid_schedule_t *sched);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PID_SCHEDULE_H_ */
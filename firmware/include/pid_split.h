@@ -0,0 +1,164 @@
+/**
+ * @file    pid_split.h
+ * @brief   PID controller with separate read-only configuration and hot state
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Alternative layout of pid_t for large instance counts. pid_t keeps
+ * 16 floats (64 bytes) per loop, mixing limits and gains with the three
+ * floats the loop actually writes. Here those three live in a packed
+ * 12-byte pid_state_t and everything else in a pid_config_t that
+ * pid_compute_split() only reads, so:
+ *
+ * - 256 loops of state fit in 48 cache lines instead of 256
+ * - the configuration can be const, placed in flash with
+ *   PID_CONFIG_INIT(), and shared by every loop with the same tuning
+ *
+ * Results are bit-identical to pid_compute() on an equivalently
+ * configured pid_t. prev_error, which pid_t keeps but never reads, is
+ * dropped.
+ */
+
+#ifndef PID_SPLIT_H_
+#define PID_SPLIT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "pid.h"
+
+/**
+ * @brief Read-only controller configuration
+ *
+ * Members are in the order pid_compute_split() reads them. Fill with
+ * pid_config_init(), pid_config_init_advanced() or, for const storage,
+ * PID_CONFIG_INIT() / PID_CONFIG_INIT_ADVANCED().
+ */
+typedef struct {
+    float kp;                  /**< Proportional gain */
+    float dt;                  /**< Sample time in seconds */
+    float integrator_min;      /**< Min integrator limit (anti-windup) */
+    float integrator_max;      /**< Max integrator limit (anti-windup) */
+    float ki;                  /**< Integral gain */
+    float derivative_lpf;      /**< Derivative filter coeff (0.0-1.0, 0=no filter) */
+    float lpf_complement;      /**< 1 - derivative_lpf */
+    float kd;                  /**< Derivative gain */
+    float out_min;             /**< Minimum output limit */
+    float out_max;             /**< Maximum output limit */
+} pid_config_t;
+
+/**
+ * @brief Per-loop state written on every sample (12 bytes, no padding)
+ */
+typedef struct {
+    float integrator;          /**< Integral accumulator */
+    float prev_measurement;    /**< Previous measurement (for derivative) */
+    float derivative_filtered; /**< Filtered derivative value */
+} pid_state_t;
+
+/**
+ * @brief Constant initializer matching pid_init()
+ *
+ * Integrator limits out_min/ki .. out_max/ki (output limits if ki is 0),
+ * no derivative filter. For `static const pid_config_t` placement.
+ */
+#define PID_CONFIG_INIT(kp, ki, kd, dt, out_min, out_max)                \
+    PID_CONFIG_INIT_ADVANCED(kp, ki, kd, dt, out_min, out_max,           \
+                             ((ki) != 0.0f ? (out_min) / (ki) : (out_min)), \
+                             ((ki) != 0.0f ? (out_max) / (ki) : (out_max)), 0.0f)
+
+/**
+ * @brief Constant initializer matching pid_init_advanced()
+ *
+ * Unlike pid_init_advanced(), @p derivative_lpf is not clamped; pass a
+ * value in [0, 1].
+ */
+#define PID_CONFIG_INIT_ADVANCED(kp, ki, kd, dt, out_min, out_max,                  \
+                                 integrator_min, integrator_max, derivative_lpf)    \
+    { (kp), (dt), (integrator_min), (integrator_max), (ki), (derivative_lpf),       \
+      1.0f - (derivative_lpf), (kd), (out_min), (out_max) }
+
+/**
+ * @brief Initialize a configuration like pid_init()
+ *
+ * @param config   Configuration to fill
+ * @param kp       Proportional gain
+ * @param ki       Integral gain (0 to disable)
+ * @param kd       Derivative gain (0 to disable)
+ * @param dt       Sample time in seconds
+ * @param out_min  Minimum output limit
+ * @param out_max  Maximum output limit
+ */
+void pid_config_init(pid_config_t *config,
+                     float kp,
+                     float ki,
+                     float kd,
+                     float dt,
+                     float out_min,
+                     float out_max);
+
+/**
+ * @brief Initialize a configuration like pid_init_advanced()
+ *
+ * @param config          Configuration to fill
+ * @param kp              Proportional gain
+ * @param ki              Integral gain
+ * @param kd              Derivative gain
+ * @param dt              Sample time in seconds
+ * @param out_min         Minimum output limit
+ * @param out_max         Maximum output limit
+ * @param integrator_min  Min integrator limit
+ * @param integrator_max  Max integrator limit
+ * @param derivative_lpf  Derivative filter (clamped to [0, 1])
+ */
+void pid_config_init_advanced(pid_config_t *config,
+                              float kp,
+                              float ki,
+                              float kd,
+                              float dt,
+                              float out_min,
+                              float out_max,
+                              float integrator_min,
+                              float integrator_max,
+                              float derivative_lpf);
+
+/**
+ * @brief Split a configured pid_t into configuration and state
+ *
+ * @param pid     Source controller
+ * @param config  Receives the configuration (may be NULL)
+ * @param state   Receives the state (may be NULL)
+ */
+void pid_split_from(const pid_t *pid, pid_config_t *config, pid_state_t *state);
+
+/**
+ * @brief Clear integrator, previous measurement and filtered derivative
+ *
+ * @param state State to reset
+ */
+void pid_state_reset(pid_state_t *state);
+
+/**
+ * @brief Calculate PID control output (same algorithm as pid_compute())
+ *
+ * Must be called periodically at the rate specified by config->dt.
+ *
+ * @param config       Configuration (read only, may be shared between loops)
+ * @param state        State of this loop
+ * @param setpoint     Target value
+ * @param measurement  Current measured value
+ * @return Control output, clamped to [out_min, out_max]
+ */
+float pid_compute_split(const pid_config_t *config,
+                        pid_state_t *state,
+                        float setpoint,
+                        float measurement);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PID_SPLIT_H_ */
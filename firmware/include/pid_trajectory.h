@@ -0,0 +1,100 @@
+/**
+ * @file    pid_trajectory.h
+ * @brief   Trapezoidal and S-curve setpoint trajectories for feedforward
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Samples a point-to-point move under velocity, acceleration and (for
+ * S-curves) jerk limits into a caller-provided buffer. This is done
+ * once, before the move starts. The control loop then only indexes the
+ * buffer and passes each point to pid_compute_ff():
+ *
+ *   static pid_trajectory_point_t move[512];
+ *   uint32_t n = pid_trajectory_generate(&profile, move, 512);
+ *
+ *   // every sample k
+ *   const pid_trajectory_point_t *ref = &move[k < n ? k : n - 1];
+ *   u = pid_compute_ff(&pid, &ff, ref->position, x, ref->velocity, ref->acceleration);
+ *
+ * Shapes:
+ * - Trapezoidal: constant acceleration to max_velocity, cruise,
+ *   constant deceleration. Acceleration steps between 0 and
+ *   +/-max_acceleration.
+ * - S-curve: jerk-limited (seven phases). Acceleration ramps at
+ *   max_jerk, so it is continuous and the feedforward has no steps.
+ *
+ * Short moves that cannot reach max_velocity (or max_acceleration)
+ * lower the peak instead. Both ends are at rest; the last sample is
+ * exactly at @c end.
+ */
+
+#ifndef PID_TRAJECTORY_H_
+#define PID_TRAJECTORY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+ * @brief Profile shape
+ */
+typedef enum {
+    PID_PROFILE_TRAPEZOIDAL = 0,   /**< Acceleration-limited */
+    PID_PROFILE_S_CURVE            /**< Jerk-limited */
+} pid_profile_shape_t;
+
+/**
+ * @brief Point-to-point move description
+ */
+typedef struct {
+    pid_profile_shape_t shape;     /**< Trapezoidal or S-curve */
+    float start;                   /**< Initial position */
+    float end;                     /**< Final position */
+    float max_velocity;            /**< Velocity limit, > 0 */
+    float max_acceleration;        /**< Acceleration limit, > 0 */
+    float max_jerk;                /**< Jerk limit, > 0 (S-curve only) */
+    float dt;                      /**< Sample time in seconds */
+} pid_profile_t;
+
+/**
+ * @brief One trajectory sample
+ */
+typedef struct {
+    float position;                /**< Reference position (the setpoint) */
+    float velocity;                /**< Reference velocity */
+    float acceleration;            /**< Reference acceleration */
+} pid_trajectory_point_t;
+
+/**
+ * @brief Number of samples a move needs, both ends included
+ *
+ * @param profile  Move description
+ * @return Buffer length for pid_trajectory_generate()
+ */
+uint32_t pid_trajectory_samples(const pid_profile_t *profile);
+
+/**
+ * @brief Sample a move into a buffer
+ *
+ * Points are at t = k * dt, k = 0 .. n-1. A zero-length move gives one
+ * point at rest.
+ *
+ * @param profile   Move description
+ * @param buffer    Receives the points
+ * @param capacity  Buffer length in points
+ * @return Points written (n), or 0 if @p capacity is below
+ *         pid_trajectory_samples() (buffer untouched)
+ */
+uint32_t pid_trajectory_generate(const pid_profile_t *profile,
+                                 pid_trajectory_point_t *buffer,
+                                 uint32_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PID_TRAJECTORY_H_ */
@@ -0,0 +1,112 @@
+/**
+ * @file    telemetry.h
+ * @brief   Buffered binary telemetry writer for the simulation demo
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Replaces per-step printf() logging with fixed-width binary records
+ * collected in a buffer and written in large blocks. The stream is:
+ *
+ *   Header (TELEMETRY_HEADER_SIZE bytes, all integers little-endian):
+ *     offset  size  field
+ *     0       4     magic "PIDT"
+ *     4       2     format version (TELEMETRY_VERSION)
+ *     6       2     header size in bytes
+ *     8       4     record size in bytes
+ *     12      4     sample time in seconds (float32)
+ *     16      48    field layout, NUL-padded ASCII, "name:type,..."
+ *                   with numpy type codes (u4 = uint32, f4 = float32)
+ *   Records (record size bytes each, little-endian):
+ *     uint32 step, float32 setpoint, float32 measurement, float32 output
+ *
+ * Records are encoded byte by byte, so the file is identical on big- and
+ * little-endian hosts. sim/pid_simulation.py memory-maps it with numpy.
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/** Format version written to the header */
+#define TELEMETRY_VERSION      1u
+/** Header size in bytes */
+#define TELEMETRY_HEADER_SIZE  64u
+/** Size of one record in bytes */
+#define TELEMETRY_RECORD_SIZE  16u
+/** Records buffered before a write (64 KiB) */
+#define TELEMETRY_BUFFER_RECORDS 4096u
+
+/**
+ * @brief Telemetry writer instance
+ *
+ * Do not modify members directly.
+ */
+typedef struct {
+    FILE *file;                /**< Destination stream (owned by caller) */
+    size_t used;               /**< Bytes pending in buffer */
+    int error;                 /**< Non-zero once a write has failed */
+    unsigned char buffer[TELEMETRY_BUFFER_RECORDS * TELEMETRY_RECORD_SIZE];
+} telemetry_writer_t;
+
+/**
+ * @brief Start a telemetry stream and write its header
+ *
+ * The stream must be opened in binary mode.
+ *
+ * @param writer       Pointer to writer
+ * @param file         Destination stream
+ * @param sample_time  Control loop period in seconds (stored in header)
+ * @return 0 on success, -1 if the header could not be written
+ */
+int telemetry_open(telemetry_writer_t *writer, FILE *file, float sample_time);
+
+/**
+ * @brief Append one control loop record
+ *
+ * Buffers the record and writes the buffer out when it is full. Write
+ * errors are latched and reported by telemetry_close().
+ *
+ * @param writer       Pointer to open writer
+ * @param step         Step index
+ * @param setpoint     Target value
+ * @param measurement  Measured value
+ * @param output       Controller output
+ */
+void telemetry_write(telemetry_writer_t *writer,
+                     uint32_t step,
+                     float setpoint,
+                     float measurement,
+                     float output);
+
+/**
+ * @brief Write out buffered records
+ *
+ * @param writer Pointer to open writer
+ * @return 0 on success, -1 if any write so far has failed
+ */
+int telemetry_flush(telemetry_writer_t *writer);
+
+/**
+ * @brief Flush remaining records and detach from the stream
+ *
+ * Does not close the stream.
+ *
+ * @param writer Pointer to open writer
+ * @return 0 on success, -1 if any write has failed
+ */
+int telemetry_close(telemetry_writer_t *writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TELEMETRY_H_ */
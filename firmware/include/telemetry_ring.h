@@ -0,0 +1,133 @@
+/**
+ * @file    telemetry_ring.h
+ * @brief   Lock-free single-producer/single-consumer telemetry ring buffer
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Lets the control interrupt hand {step, setpoint, measurement, output}
+ * records to a background task without locks or blocking. Exactly one
+ * context may push (e.g. the timer ISR) and exactly one may pop (e.g.
+ * the main loop), concurrently. Push and pop are wait-free: each does
+ * a bounded amount of work and never waits for the other side; a push
+ * into a full ring drops the record and counts it.
+ *
+ * Synchronization:
+ * - C11 with <stdatomic.h>: acquire/release atomics on the indices
+ * - Otherwise: volatile indices ordered by TELEMETRY_RING_BARRIER(),
+ *   which defaults to a full barrier on GCC/Clang and MSVC. Define it
+ *   before including this header on other toolchains, e.g. __DMB() with
+ *   CMSIS (a compiler barrier is enough on single-core Cortex-M).
+ *
+ * The library and every file that includes this header must be built
+ * with the same choice (same C standard), since it changes the index
+ * member types.
+ */
+
+#ifndef TELEMETRY_RING_H_
+#define TELEMETRY_RING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && \
+    !defined(__STDC_NO_ATOMICS__) && !defined(__cplusplus)
+#include <stdatomic.h>
+#define TELEMETRY_RING_C11_ATOMICS 1
+/** Ring index type (free-running, shared between producer and consumer) */
+typedef _Atomic uint32_t telemetry_ring_index_t;
+#else
+#define TELEMETRY_RING_C11_ATOMICS 0
+/** Ring index type (free-running, shared between producer and consumer) */
+typedef volatile uint32_t telemetry_ring_index_t;
+#endif
+
+/**
+ * @brief One control loop sample
+ *
+ * Same fields as a binary telemetry record (see telemetry.h).
+ */
+typedef struct {
+    uint32_t step;             /**< Step index */
+    float setpoint;            /**< Target value */
+    float measurement;         /**< Measured value */
+    float output;              /**< Controller output */
+} telemetry_record_t;
+
+/**
+ * @brief SPSC ring buffer instance
+ *
+ * Indices count records pushed/popped since init and wrap at 2^32;
+ * slot = index & mask. Do not modify members directly.
+ */
+typedef struct {
+    telemetry_record_t *records;   /**< Caller-provided slots */
+    uint32_t mask;                 /**< capacity - 1 */
+    telemetry_ring_index_t head;   /**< Next slot to write (producer-owned) */
+    telemetry_ring_index_t tail;   /**< Next slot to read (consumer-owned) */
+    telemetry_ring_index_t dropped;/**< Records lost to a full ring (producer-owned) */
+} telemetry_ring_t;
+
+/**
+ * @brief Initialize a ring over caller-provided storage
+ *
+ * Call before either side starts. No dynamic memory is used.
+ *
+ * @param ring      Pointer to ring structure
+ * @param storage   Array of @p capacity records
+ * @param capacity  Number of slots, a power of two (1 to 2^31)
+ */
+void telemetry_ring_init(telemetry_ring_t *ring, telemetry_record_t *storage, uint32_t capacity);
+
+/**
+ * @brief Append a record (producer side, ISR-safe)
+ *
+ * @param ring    Pointer to initialized ring
+ * @param record  Record to copy into the ring
+ * @return 0 on success, -1 if the ring was full (record dropped)
+ */
+int telemetry_ring_push(telemetry_ring_t *ring, const telemetry_record_t *record);
+
+/**
+ * @brief Remove up to @p max_records records in FIFO order (consumer side)
+ *
+ * Drains in one batch: one synchronization per call, not per record.
+ *
+ * @param ring         Pointer to initialized ring
+ * @param out          Receives the records
+ * @param max_records  Capacity of @p out
+ * @return Number of records copied (0 if empty)
+ */
+size_t telemetry_ring_pop(telemetry_ring_t *ring, telemetry_record_t *out, size_t max_records);
+
+/**
+ * @brief Number of records waiting (consumer side)
+ *
+ * Exact when called by the consumer, except that the producer may add
+ * more at any time.
+ *
+ * @param ring Pointer to initialized ring
+ * @return Records available to telemetry_ring_pop()
+ */
+uint32_t telemetry_ring_count(const telemetry_ring_t *ring);
+
+/**
+ * @brief Number of records dropped because the ring was full
+ *
+ * May be read from either side.
+ *
+ * @param ring Pointer to initialized ring
+ * @return Dropped record count (wraps at 2^32)
+ */
+uint32_t telemetry_ring_dropped(const telemetry_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TELEMETRY_RING_H_ */
@@ -9,14 +9,49 @@
  * Demonstrates PID-based motor speed control. Runs as desktop simulation
  * with CSV output for analysis. For embedded use, replace with timer
  * interrupt and hardware-specific motor functions.
+ *
+ * Usage:
+ *   pid_demo [--binary] [--iterations N] [--autotune] [--jitter PCT [--nominal-dt]]
+ *            [--profile trapezoid|scurve [--no-feedforward]]
+ *
+ *   --binary        Write binary telemetry (see telemetry.h) instead of CSV;
+ *                   use for long runs where printf() dominates runtime
+ *   --iterations N  Number of simulation steps (default NUM_ITERATIONS)
+ *   --autotune      Start with a relay experiment (see pid_autotune.h) and
+ *                   switch to the tuned gains once it finishes; the gains
+ *                   are reported on stderr
+ *   --jitter PCT    Delay every sample by a random ISR latency of up to
+ *                   PCT% of the sample time; the motor runs for the actual
+ *                   interval and the PID uses pid_compute_dt() with it.
+ *                   The tracking IAE is reported on stderr
+ *   --nominal-dt    With --jitter: keep pid_compute() and the fixed dt,
+ *                   for comparison
+ *   --profile SHAPE Ramp the speed setpoint from 0 to SETPOINT along a
+ *                   precomputed trapezoidal or S-curve trajectory (see
+ *                   pid_trajectory.h), with velocity/acceleration
+ *                   feedforward from the motor model. The tracking IAE
+ *                   is reported on stderr
+ *   --no-feedforward With --profile: feedback only, for comparison
+ *
+ * Built with PID_CYCLE_STATS=1, the demo ends by printing the
+ * pid_compute() cycle statistics and histogram to stderr.
  */
 
 #include "motor.h"
 #include "pid.h"
+#include "pid_autotune.h"
+#include "pid_trajectory.h"
+#include "telemetry.h"
 #include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
 
 /* Configuration */
-#define NUM_ITERATIONS  500     /* Simulation steps */
+#define NUM_ITERATIONS  500     /* Simulation steps (default) */
 #define SAMPLE_TIME     0.01f   /* Control loop period: 10ms = 100Hz */
 
 /* PID gains (tuned for simulation model) */
@@ -31,34 +66,251 @@
 /* Target speed */
 #define SETPOINT  3.0f  /* Desired motor speed */
 
-int main(void)
+/* Relay auto-tuning (--autotune) */
+#define TUNE_BIAS        0.6f    /* Output holding SETPOINT: SETPOINT / motor gain */
+#define TUNE_AMPLITUDE   0.3f    /* Relay swing around the bias */
+#define TUNE_HYSTERESIS  0.05f   /* Switching band, above measurement noise */
+#define TUNE_MAX_STEPS   2000u   /* Keep the default gains if not done by then */
+
+/* Sample timing jitter (--jitter) */
+#define JITTER_SEED      0x2545F491u   /* Fixed: runs are reproducible */
+
+/* Setpoint trajectory (--profile) */
+#define PROFILE_MAX_VELOCITY      6.0f     /* Speed reference slew, units/s */
+#define PROFILE_MAX_ACCELERATION  30.0f
+#define PROFILE_MAX_JERK          300.0f
+#define PROFILE_MAX_SAMPLES       256u
+
+/* Feedforward inverting the motor model: speed' = (gain u - speed) / tau */
+#define FF_KV  (1.0f / MOTOR_MODEL_DEFAULT_GAIN)
+#define FF_KA  (SAMPLE_TIME / (MOTOR_MODEL_DEFAULT_ALPHA * MOTOR_MODEL_DEFAULT_GAIN))
+
+/* Precomputed setpoint trajectory, kept off the stack */
+static pid_trajectory_point_t trajectory[PROFILE_MAX_SAMPLES];
+
+/* Binary telemetry writer (64 KiB buffer, kept off the stack) */
+static telemetry_writer_t telemetry;
+
+/* Parse a positive decimal count. Avoids strtoul(): in GNU mode
+ * <stdlib.h> pulls in the POSIX pid_t, which clashes with pid.h */
+static int parse_count(const char *text, unsigned long *value)
+{
+    unsigned long result = 0;
+
+    if (*text == '\0') {
+        return -1;
+    }
+    for (; *text != '\0'; text++) {
+        if (*text < '0' || *text > '9' || result > (0xFFFFFFFFul - 9u) / 10u) {
+            return -1;
+        }
+        result = result * 10u + (unsigned long)(*text - '0');
+    }
+    *value = result;
+    return (result > 0) ? 0 : -1;
+}
+
+/* Uniform in [0, 1) from a xorshift32 generator */
+static float jitter_uniform(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return (float)(x >> 8) * (1.0f / 16777216.0f);
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [--binary] [--iterations N] [--autotune] "
+                    "[--jitter PCT [--nominal-dt]] "
+                    "[--profile trapezoid|scurve [--no-feedforward]]\n", prog);
+}
+
+int main(int argc, char **argv)
 {
     pid_t motor_pid;
+    pid_autotune_t tuner;
+    int binary = 0;
+    int tuning = 0;
+    int nominal_dt = 0;
+    int profiled = 0;
+    int feedforward = 1;
+    pid_profile_t profile = { PID_PROFILE_TRAPEZOIDAL, 0.0f, SETPOINT,
+                              PROFILE_MAX_VELOCITY, PROFILE_MAX_ACCELERATION,
+                              PROFILE_MAX_JERK, SAMPLE_TIME };
+    const pid_feedforward_t ff = { FF_KV, FF_KA };
+    uint32_t trajectory_len = 0;
+    unsigned long num_iterations = NUM_ITERATIONS;
+    unsigned long jitter_pct = 0;
+    uint32_t jitter_state = JITTER_SEED;
+    float latency = 0.0f;       /* ISR latency of the current sample */
+    float interval = SAMPLE_TIME;   /* Time since the previous sample */
+    double iae = 0.0;
+
+    /* Parse command line */
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--binary") == 0) {
+            binary = 1;
+        } else if (strcmp(argv[i], "--autotune") == 0) {
+            tuning = 1;
+        } else if (strcmp(argv[i], "--nominal-dt") == 0) {
+            nominal_dt = 1;
+        } else if (strcmp(argv[i], "--no-feedforward") == 0) {
+            feedforward = 0;
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profiled = 1;
+            i++;
+            if (strcmp(argv[i], "scurve") == 0) {
+                profile.shape = PID_PROFILE_S_CURVE;
+            } else if (strcmp(argv[i], "trapezoid") != 0) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--jitter") == 0 && i + 1 < argc) {
+            if (parse_count(argv[++i], &jitter_pct) != 0 || jitter_pct > 100u) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            if (parse_count(argv[++i], &num_iterations) != 0) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    /* Profiles run the plain control loop: no relay experiment or jitter */
+    if (profiled && (tuning || jitter_pct > 0)) {
+        usage(argv[0]);
+        return 1;
+    }
+    /* --no-feedforward only modifies --profile, --nominal-dt only --jitter */
+    if ((!feedforward && !profiled) || (nominal_dt && jitter_pct == 0)) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (profiled) {
+        trajectory_len = pid_trajectory_generate(&profile, trajectory, PROFILE_MAX_SAMPLES);
+        if (trajectory_len == 0) {
+            fprintf(stderr, "Profile needs more than %u samples\n", PROFILE_MAX_SAMPLES);
+            return 1;
+        }
+    }
 
     /* Initialize motor and PID controller */
     motor_init();
     pid_init(&motor_pid, PID_KP, PID_KI, PID_KD, SAMPLE_TIME, OUT_MIN, OUT_MAX);
+    if (tuning) {
+        pid_autotune_init_advanced(&tuner, SETPOINT, TUNE_BIAS, TUNE_AMPLITUDE,
+                                   TUNE_HYSTERESIS, SAMPLE_TIME,
+                                   PID_AUTOTUNE_DEFAULT_CYCLES, TUNE_MAX_STEPS);
+    }
 
-    /* CSV header for simulation output */
-    printf("step,setpoint,measurement,output\n");
+    if (binary) {
+#ifdef _WIN32
+        /* Keep the C runtime from translating \n bytes in the stream */
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        if (telemetry_open(&telemetry, stdout, SAMPLE_TIME) != 0) {
+            fprintf(stderr, "Failed to write telemetry header\n");
+            return 1;
+        }
+    } else {
+        /* CSV header for simulation output */
+        printf("step,setpoint,measurement,output\n");
+    }
 
     /* Control loop */
-    for (int step = 0; step < NUM_ITERATIONS; step++) {
+    for (unsigned long step = 0; step < num_iterations; step++) {
         /* Read current motor speed */
         float measurement = motor_get_speed();
+        float setpoint = SETPOINT;
+
+        /* Compute control output: relay while tuning, then PID */
+        float output;
+        if (tuning) {
+            output = pid_autotune_step(&tuner, measurement);
+            if (pid_autotune_status(&tuner) != PID_AUTOTUNE_RUNNING) {
+                tuning = 0;
+                if (pid_autotune_apply(&tuner, PID_TUNE_ZIEGLER_NICHOLS, &motor_pid,
+                                       OUT_MIN, OUT_MAX, 0.0f) == 0) {
+                    fprintf(stderr, "autotune: Ku=%g Tu=%g s -> kp=%g ki=%g kd=%g (step %lu)\n",
+                            tuner.ku, tuner.tu, motor_pid.kp, motor_pid.ki, motor_pid.kd, step);
+                } else {
+                    fprintf(stderr, "autotune: failed, keeping default gains\n");
+                }
+            }
+        } else if (profiled) {
+            /* Speed loop: the trajectory position is the speed reference */
+            const pid_trajectory_point_t *ref =
+                &trajectory[(step < trajectory_len) ? step : trajectory_len - 1u];
+            float error;
 
-        /* Compute PID control output */
-        float output = pid_compute(&motor_pid, SETPOINT, measurement);
+            setpoint = ref->position;
+            if (feedforward) {
+                output = pid_compute_ff(&motor_pid, &ff, setpoint, measurement,
+                                        ref->position, ref->velocity);
+            } else {
+                output = pid_compute(&motor_pid, setpoint, measurement);
+            }
+            error = setpoint - measurement;
+            iae += (double)((error < 0.0f) ? -error : error) * SAMPLE_TIME;
+        } else if (jitter_pct > 0 && !nominal_dt) {
+            output = pid_compute_dt(&motor_pid, SETPOINT, measurement, interval);
+        } else {
+            output = pid_compute(&motor_pid, SETPOINT, measurement);
+        }
 
         /* Apply control output to motor */
         motor_set_output(output);
 
-        /* Update motor simulation */
-        motor_update();
+        /* Update motor simulation: until the next (late) sample with jitter */
+        if (jitter_pct > 0) {
+            float next_latency = (float)jitter_pct * 0.01f * SAMPLE_TIME *
+                                 jitter_uniform(&jitter_state);
+            float error = SETPOINT - measurement;
 
-        /* Log data (CSV format) */
-        printf("%d,%.4f,%.4f,%.4f\n", step, SETPOINT, measurement, output);
+            iae += (double)((error < 0.0f) ? -error : error) * interval;
+            interval = SAMPLE_TIME + next_latency - latency;
+            latency = next_latency;
+            motor_update_dt(interval / SAMPLE_TIME);
+        } else {
+            motor_update();
+        }
+
+        /* Log data (binary records or CSV) */
+        if (binary) {
+            telemetry_write(&telemetry, (uint32_t)step, setpoint, measurement, output);
+        } else {
+            printf("%lu,%.4f,%.4f,%.4f\n", step, setpoint, measurement, output);
+        }
+    }
+
+    if (binary && telemetry_close(&telemetry) != 0) {
+        fprintf(stderr, "Failed to write telemetry\n");
+        return 1;
+    }
+
+    if (jitter_pct > 0) {
+        fprintf(stderr, "jitter: latency up to %lu%% of dt, %s dt, IAE %.6f\n",
+                jitter_pct, nominal_dt ? "nominal" : "measured", iae);
     }
+    if (profiled) {
+        fprintf(stderr, "profile: %s, %u samples, %s, IAE %.6f\n",
+                (profile.shape == PID_PROFILE_S_CURVE) ? "s-curve" : "trapezoid",
+                trajectory_len, feedforward ? "feedforward" : "feedback only", iae);
+    }
+
+#if PID_CYCLE_STATS
+    /* Cycle budget of the control law (PID_CYCLE_STATS builds) */
+    pid_cycle_stats_dump(pid_get_cycle_stats(&motor_pid), "pid_compute", stderr);
+#endif
 
     /*------------------------------------------------------------------------*/
     /* Shutdown Phase (simulation only)                                     */
@@ -83,9 +335,15 @@ int main(void)
      * pid_t g_motor_pid;
      * float g_setpoint = 1000.0f;  // Target RPM
      *
+     * // ISR-to-background telemetry (see telemetry_ring.h)
+     * static telemetry_record_t g_log_storage[256];  // Power of two
+     * telemetry_ring_t g_log;
+     * uint32_t g_step = 0;
+     *
      * void system_init(void) {
      *     motor_init();
      *     pid_init(&g_motor_pid, 1.0f, 0.5f, 0.1f, 0.01f, -100.0f, 100.0f);
+     *     telemetry_ring_init(&g_log, g_log_storage, 256);
      *
      *     // Configure timer for 10ms periodic interrupt
      *     TIM2_Init(100);  // 100Hz = 10ms period
@@ -98,12 +356,21 @@ int main(void)
      *     float output = pid_compute(&g_motor_pid, g_setpoint, speed);
      *     motor_set_output(output);
      *
+     *     // Never blocks: drops (and counts) the sample if the ring is full
+     *     telemetry_record_t rec = { g_step++, g_setpoint, speed, output };
+     *     telemetry_ring_push(&g_log, &rec);
+     *
      *     TIM2_ClearInterruptFlag();
      * }
      *
      * int main(void) {
      *     system_init();
      *     while (1) {
+     *         // Drain telemetry in batches (UART, SD card, ...)
+     *         telemetry_record_t batch[32];
+     *         size_t n = telemetry_ring_pop(&g_log, batch, 32);
+     *         uart_send(batch, n * sizeof(batch[0]));
+     *
      *         // Main loop handles non-time-critical tasks:
      *         // - User interface
      *         // - Communication
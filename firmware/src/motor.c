@@ -13,41 +13,86 @@
  */
 
 #include "motor.h"
+#include <assert.h>
+#include <math.h>
+#include <stddef.h>
 
-/* Simulation state */
-static float current_speed = 0.0f;
-
-/**
- * @brief Current motor control output (last commanded duty cycle)
- *
- * Units: Normalized duty cycle
- * Range: -1.0 (full reverse) to +1.0 (full forward)
- *
- * This stores the most recent value set by motor_set_output()
- * and is used to update the motor model dynamics.
- */
-static float current_output = 0.0f;
-
-/* Model parameters
+/* Default model parameters (MOTOR_MODEL_DEFAULT_* in motor.h)
  * Time constant (tau): 200ms
  * Sample time (dt): 10ms
  * Response rate (alpha): dt/tau = 0.01/0.2 = 0.05
+ * Gain: 5.0 speed units per unit input
  */
-static const float model_gain = 5.0f;     /* Speed per unit input */
-static const float model_alpha = 0.05f;   /* Response rate coefficient */
+
+/**
+ * @brief Default instance behind the single-motor API
+ *
+ * Lets existing code keep calling motor_init()/motor_update() without a
+ * handle. Not thread-safe; threads should own motor_model_t instances.
+ */
+static motor_model_t default_motor = {
+    MOTOR_MODEL_DEFAULT_GAIN, MOTOR_MODEL_DEFAULT_ALPHA, 0.0f, 0.0f
+};
 
 /*============================================================================*/
 /* PUBLIC API IMPLEMENTATION                                                 */
 /*============================================================================*/
 
+void motor_model_init(motor_model_t *motor)
+{
+    motor_model_init_advanced(motor, MOTOR_MODEL_DEFAULT_GAIN, MOTOR_MODEL_DEFAULT_ALPHA);
+}
+
+void motor_model_init_advanced(motor_model_t *motor, float gain, float alpha)
+{
+    assert(motor != NULL && "Motor model pointer cannot be NULL");
+    assert(alpha > 0.0f && alpha <= 1.0f && "Response rate must be in (0, 1]");
+
+    motor->gain = gain;
+    motor->alpha = alpha;
+    motor->speed = 0.0f;    /* Motor starts at rest */
+    motor->output = 0.0f;   /* No control output */
+}
+
+void motor_model_set_output(motor_model_t *motor, float duty_cycle)
+{
+    /* Clamp to [-1.0, 1.0] range */
+    if (duty_cycle > 1.0f) duty_cycle = 1.0f;
+    if (duty_cycle < -1.0f) duty_cycle = -1.0f;
+
+    motor->output = duty_cycle;
+}
+
+float motor_model_get_speed(const motor_model_t *motor)
+{
+    return motor->speed;
+}
+
+void motor_model_update(motor_model_t *motor)
+{
+    /* First-order linear dynamics: speed approaches target_speed */
+    float target_speed = motor->output * motor->gain;
+    motor->speed += motor->alpha * (target_speed - motor->speed);
+}
+
+void motor_model_update_dt(motor_model_t *motor, float steps)
+{
+    assert(steps >= 0.0f && "Interval cannot be negative");
+
+    /* alpha per step compounds: the remaining gap shrinks by (1-alpha)^steps */
+    float target_speed = motor->output * motor->gain;
+    float rate = 1.0f - powf(1.0f - motor->alpha, steps);
+    motor->speed += rate * (target_speed - motor->speed);
+}
+
 /**
  * @brief Initialize motor hardware and simulation model
  *
  * See detailed documentation in motor.h
  *
  * Implementation notes (simulation):
- * - Resets motor speed to zero (stopped)
- * - Resets control output to zero (no commanded motion)
+ * - Resets the default instance: speed and control output to zero,
+ *   model parameters to their defaults
  * - No actual hardware initialization (this is simulation)
  *
  * For real hardware implementation:
@@ -59,17 +104,12 @@ static const float model_alpha = 0.05f;   /* Response rate coefficient */
  */
 void motor_init(void)
 {
-    current_speed = 0.0f;   /* Motor starts at rest */
-    current_output = 0.0f;  /* No control output */
+    motor_model_init(&default_motor);
 }
 
 void motor_set_output(float duty_cycle)
 {
-    /* Clamp to [-1.0, 1.0] range */
-    if (duty_cycle > 1.0f) duty_cycle = 1.0f;
-    if (duty_cycle < -1.0f) duty_cycle = -1.0f;
-
-    current_output = duty_cycle;
+    motor_model_set_output(&default_motor, duty_cycle);
 }
 
 /**
@@ -105,7 +145,7 @@ void motor_set_output(float duty_cycle)
  */
 float motor_get_speed(void)
 {
-    return current_speed;
+    return motor_model_get_speed(&default_motor);
 
     /*------------------------------------------------------------------------*/
     /* Real Hardware Implementation Would Be:                                */
@@ -139,7 +179,10 @@ float motor_get_speed(void)
 
 void motor_update(void)
 {
-    /* First-order linear dynamics: speed approaches target_speed */
-    float target_speed = current_output * model_gain;
-    current_speed += model_alpha * (target_speed - current_speed);
+    motor_model_update(&default_motor);
+}
+
+void motor_update_dt(float steps)
+{
+    motor_model_update_dt(&default_motor, steps);
 }
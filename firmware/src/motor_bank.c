@@ -0,0 +1,115 @@
+/**
+ * @file    motor_bank.c
+ * @brief   Implementation of the structure-of-arrays motor plant bank
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Per-lane arithmetic mirrors motor.c operation for operation, so lanes
+ * are bit-identical to motor_model_update(). Loops go through static
+ * kernels with restrict-qualified parameters so GCC/Clang vectorize them.
+ */
+
+#include "motor_bank.h"
+#include <assert.h>
+
+/* MSVC only accepts restrict as a keyword extension in C */
+#if defined(_MSC_VER) && !defined(__clang__)
+#define restrict __restrict
+#endif
+
+/*============================================================================*/
+/* UPDATE KERNELS                                                            */
+/*============================================================================*/
+
+/* Clamp to [-1.0, 1.0] as selects, same comparisons as motor_model_set_output() */
+static void set_outputs_kernel(size_t n,
+                               const float *restrict duty,
+                               float *restrict output)
+{
+    for (size_t i = 0; i < n; i++) {
+        float d = duty[i];
+        d = (d > 1.0f) ? 1.0f : d;
+        d = (d < -1.0f) ? -1.0f : d;
+        output[i] = d;
+    }
+}
+
+/* First-order dynamics: speed approaches output * gain */
+static void update_kernel(size_t n,
+                          const float *restrict gain,
+                          const float *restrict alpha,
+                          const float *restrict output,
+                          float *restrict speed)
+{
+    for (size_t i = 0; i < n; i++) {
+        float target_speed = output[i] * gain[i];
+        speed[i] += alpha[i] * (target_speed - speed[i]);
+    }
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+void motor_bank_init(motor_bank_t *bank, float *storage, size_t capacity)
+{
+    assert(bank != NULL && "Motor bank pointer cannot be NULL");
+    assert((storage != NULL || capacity == 0) && "Bank storage cannot be NULL");
+
+    bank->model_gain  = storage + 0 * capacity;
+    bank->model_alpha = storage + 1 * capacity;
+    bank->speed       = storage + 2 * capacity;
+    bank->output      = storage + 3 * capacity;
+    bank->capacity = capacity;
+
+    for (size_t i = 0; i < capacity; i++) {
+        bank->model_gain[i] = MOTOR_MODEL_DEFAULT_GAIN;
+        bank->model_alpha[i] = MOTOR_MODEL_DEFAULT_ALPHA;
+        bank->speed[i] = 0.0f;
+        bank->output[i] = 0.0f;
+    }
+}
+
+void motor_bank_load(motor_bank_t *bank, size_t lane, const motor_model_t *motor)
+{
+    assert(bank != NULL && motor != NULL);
+    assert(lane < bank->capacity && "Lane index out of range");
+
+    bank->model_gain[lane] = motor->gain;
+    bank->model_alpha[lane] = motor->alpha;
+    bank->speed[lane] = motor->speed;
+    bank->output[lane] = motor->output;
+}
+
+void motor_bank_store(const motor_bank_t *bank, size_t lane, motor_model_t *motor)
+{
+    assert(bank != NULL && motor != NULL);
+    assert(lane < bank->capacity && "Lane index out of range");
+
+    motor->gain = bank->model_gain[lane];
+    motor->alpha = bank->model_alpha[lane];
+    motor->speed = bank->speed[lane];
+    motor->output = bank->output[lane];
+}
+
+void motor_bank_set_outputs(motor_bank_t *bank, const float *duty_cycles, size_t n)
+{
+    assert(bank != NULL && duty_cycles != NULL);
+    assert(n <= bank->capacity && "Motor count exceeds bank capacity");
+
+    set_outputs_kernel(n, duty_cycles, bank->output);
+}
+
+void motor_bank_update(motor_bank_t *bank, size_t n)
+{
+    assert(bank != NULL && "Motor bank pointer cannot be NULL");
+    assert(n <= bank->capacity && "Motor count exceeds bank capacity");
+
+    update_kernel(n, bank->model_gain, bank->model_alpha, bank->output, bank->speed);
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
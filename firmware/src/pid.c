@@ -11,6 +11,7 @@
  */
 
 #include "pid.h"
+#include "pid_cycles.h"
 #include <assert.h>
 #include <stddef.h>
 
@@ -22,6 +23,18 @@ static float clamp(float value, float min, float max)
     return value;
 }
 
+/* Derive the coefficients used by pid_compute_fast() and pid_compute_dt() */
+static void precompute_coefficients(pid_t *pid)
+{
+    pid->inv_dt = 1.0f / pid->dt;
+    pid->kd_inv_dt = pid->kd * pid->inv_dt;
+    pid->lpf_complement = 1.0f - pid->derivative_lpf;
+
+#if PID_CYCLE_STATS
+    pid_cycle_stats_reset(&pid->cycles);
+#endif
+}
+
 /*============================================================================*/
 /* PUBLIC API IMPLEMENTATION                                                 */
 /*============================================================================*/
@@ -36,6 +49,9 @@ static float clamp(float value, float min, float max)
  * - Integrator limits calculated automatically: integrator_min/max = out_min/max / Ki
  * - Division-by-zero protection: if Ki=0, integrator limits set to output limits
  * - No derivative filtering enabled (derivative_lpf = 0)
+ * - Precomputes 1/dt, kd/dt and 1-derivative_lpf for pid_compute_fast()
+ *   (one division per init instead of one per sample)
+ * - PID_CYCLE_STATS builds also clear the call duration statistics
  * - Takes ~10-20 CPU cycles on typical embedded processors
  */
 void pid_init(pid_t *pid,
@@ -79,6 +95,8 @@ void pid_init(pid_t *pid,
 
     /* No derivative filtering by default */
     pid->derivative_lpf = 0.0f;
+
+    precompute_coefficients(pid);
 }
 
 void pid_init_advanced(pid_t *pid,
@@ -121,6 +139,8 @@ void pid_init_advanced(pid_t *pid,
 
     /* Clamp derivative filter to [0, 1] range */
     pid->derivative_lpf = clamp(derivative_lpf, 0.0f, 1.0f);
+
+    precompute_coefficients(pid);
 }
 
 /**
@@ -160,9 +180,15 @@ void pid_init_advanced(pid_t *pid,
  *    prev_measurement = measurement
  *
  * Performance: ~20-40 CPU cycles on ARM Cortex-M4
+ *
+ * PID_CYCLE_STATS builds time the whole call, including the clamp and
+ * state update, and record it in pid->cycles (see pid_cycles.h); the
+ * hooks compile to nothing otherwise.
  */
 float pid_compute(pid_t *pid, float setpoint, float measurement)
 {
+    PID_CYCLES_BEGIN();
+
     /* Calculate error between desired and actual values */
     float error = setpoint - measurement;
 
@@ -196,6 +222,181 @@ float pid_compute(pid_t *pid, float setpoint, float measurement)
     pid->prev_error = error;
     pid->prev_measurement = measurement;
 
+    PID_CYCLES_END(&pid->cycles);
+    return output;
+}
+
+/**
+ * @brief Calculate PID control output without per-sample division
+ *
+ * See detailed documentation in pid.h
+ *
+ * Differences from pid_compute():
+ * - derivative_raw = (prev_measurement - measurement) × inv_dt
+ *   replaces the division by dt
+ * - Unfiltered: D = kd_inv_dt × (prev_measurement - measurement),
+ *   folding Kd into the reciprocal
+ * - Filtered: uses the precomputed (1-α) instead of subtracting per call
+ * - The integrator keeps its error×dt units so state is interchangeable
+ *   with pid_compute() and the integrator limits keep their meaning;
+ *   folding Ki×dt would change both
+ */
+float pid_compute_fast(pid_t *pid, float setpoint, float measurement)
+{
+    PID_CYCLES_BEGIN();
+
+    float error = setpoint - measurement;
+
+    /* Proportional term */
+    float p = pid->kp * error;
+
+    /* Integral term with anti-windup */
+    pid->integrator += error * pid->dt;
+    pid->integrator = clamp(pid->integrator, pid->integrator_min, pid->integrator_max);
+    float i = pid->ki * pid->integrator;
+
+    /* Derivative term (on measurement) */
+    float delta = pid->prev_measurement - measurement;
+    float d;
+
+    if (pid->derivative_lpf > 0.0f) {
+        pid->derivative_filtered = pid->derivative_filtered * pid->derivative_lpf +
+                                  delta * pid->inv_dt * pid->lpf_complement;
+        d = pid->kd * pid->derivative_filtered;
+    } else {
+        d = pid->kd_inv_dt * delta;
+    }
+
+    /* Combine and clamp output */
+    float output = p + i + d;
+    output = clamp(output, pid->out_min, pid->out_max);
+
+    /* Update state for next iteration */
+    pid->prev_error = error;
+    pid->prev_measurement = measurement;
+
+    PID_CYCLES_END(&pid->cycles);
+    return output;
+}
+
+/**
+ * @brief Calculate PID control output over a measured sample interval
+ *
+ * See detailed documentation in pid.h
+ *
+ * Reciprocal of the interval:
+ * - With r0 = 1/dt (precomputed) and e = 1 - dt_actual × r0, one
+ *   Newton-Raphson step r1 = r0 × (2 - dt_actual × r0) = r0 × (1 + e)
+ *   has relative error e², i.e. below 1/1024 within PID_DT_NEWTON_RANGE
+ * - Outside that range the error grows quickly (and the step diverges
+ *   for dt_actual >= 2 dt), so those rare intervals divide instead
+ *
+ * Cost over pid_compute_fast(): 3 multiplies/adds and a compare on the
+ * common path.
+ */
+float pid_compute_dt(pid_t *pid, float setpoint, float measurement, float dt_actual)
+{
+    PID_CYCLES_BEGIN();
+
+    assert(dt_actual > 0.0f && "Measured sample interval must be positive");
+
+    float error = setpoint - measurement;
+
+    /* Reciprocal of the measured interval */
+    float deviation = 1.0f - dt_actual * pid->inv_dt;
+    float inv_dt_actual;
+
+    if (deviation <= PID_DT_NEWTON_RANGE && deviation >= -PID_DT_NEWTON_RANGE) {
+        inv_dt_actual = pid->inv_dt + pid->inv_dt * deviation;
+    } else {
+        inv_dt_actual = 1.0f / dt_actual;
+    }
+
+    /* Proportional term */
+    float p = pid->kp * error;
+
+    /* Integral term with anti-windup, over the measured interval */
+    pid->integrator += error * dt_actual;
+    pid->integrator = clamp(pid->integrator, pid->integrator_min, pid->integrator_max);
+    float i = pid->ki * pid->integrator;
+
+    /* Derivative term (on measurement) */
+    float derivative_raw = (pid->prev_measurement - measurement) * inv_dt_actual;
+
+    if (pid->derivative_lpf > 0.0f) {
+        pid->derivative_filtered = pid->derivative_filtered * pid->derivative_lpf +
+                                  derivative_raw * pid->lpf_complement;
+        derivative_raw = pid->derivative_filtered;
+    }
+
+    float d = pid->kd * derivative_raw;
+
+    /* Combine and clamp output */
+    float output = p + i + d;
+    output = clamp(output, pid->out_min, pid->out_max);
+
+    /* Update state for next iteration */
+    pid->prev_error = error;
+    pid->prev_measurement = measurement;
+
+    PID_CYCLES_END(&pid->cycles);
+    return output;
+}
+
+/**
+ * @brief Calculate PID control output plus feedforward
+ *
+ * See detailed documentation in pid.h
+ *
+ * Same operations as pid_compute(), with the feedforward added to
+ * P + I + D before the clamp. The integrator limits are unchanged:
+ * they bound the integral term on its own, and with feedforward it
+ * only has to cover the model error.
+ */
+float pid_compute_ff(pid_t *pid,
+                     const pid_feedforward_t *ff,
+                     float setpoint,
+                     float measurement,
+                     float velocity,
+                     float acceleration)
+{
+    PID_CYCLES_BEGIN();
+
+    assert(ff != NULL && "Feedforward gains cannot be NULL");
+
+    float error = setpoint - measurement;
+
+    /* Proportional term */
+    float p = pid->kp * error;
+
+    /* Integral term with anti-windup */
+    pid->integrator += error * pid->dt;
+    pid->integrator = clamp(pid->integrator, pid->integrator_min, pid->integrator_max);
+    float i = pid->ki * pid->integrator;
+
+    /* Derivative term (on measurement) */
+    float derivative_raw = -(measurement - pid->prev_measurement) / pid->dt;
+
+    if (pid->derivative_lpf > 0.0f) {
+        pid->derivative_filtered = pid->derivative_filtered * pid->derivative_lpf +
+                                  derivative_raw * (1.0f - pid->derivative_lpf);
+        derivative_raw = pid->derivative_filtered;
+    }
+
+    float d = pid->kd * derivative_raw;
+
+    /* Feedforward from the reference trajectory */
+    float feedforward = ff->kv * velocity + ff->ka * acceleration;
+
+    /* Combine and clamp output */
+    float output = p + i + d + feedforward;
+    output = clamp(output, pid->out_min, pid->out_max);
+
+    /* Update state for next iteration */
+    pid->prev_error = error;
+    pid->prev_measurement = measurement;
+
+    PID_CYCLES_END(&pid->cycles);
     return output;
 }
 
@@ -225,6 +426,63 @@ void pid_reset(pid_t *pid)
     pid->derivative_filtered = 0.0f;
 }
 
+/**
+ * @brief Change gains without an output bump
+ *
+ * See detailed documentation in pid.h
+ *
+ * Implementation notes:
+ * - integrator *= ki_old / ki_new keeps I = Ki × integrator continuous
+ * - The limits get the same factor, so the bound on the integral term
+ *   (pid_init() default or pid_init_advanced() value) is unchanged
+ * - ki_old = 0: the accumulator was not in the output, start from 0
+ *   with the pid_init() limits out_min/ki .. out_max/ki
+ * - ki_new = 0: the term drops out; accumulator and limits are left as is
+ * - Updates kd/dt for pid_compute_fast(); cycle statistics are kept
+ */
+void pid_set_gains(pid_t *pid, float kp, float ki, float kd)
+{
+    assert(pid != NULL && "PID structure pointer cannot be NULL");
+    assert(kp >= 0.0f && "Proportional gain must be non-negative");
+    assert(ki >= 0.0f && "Integral gain must be non-negative");
+    assert(kd >= 0.0f && "Derivative gain must be non-negative");
+
+    if (ki != 0.0f && pid->ki != 0.0f) {
+        float scale = pid->ki / ki;
+
+        pid->integrator *= scale;
+        pid->integrator_min *= scale;
+        pid->integrator_max *= scale;
+    } else if (ki != 0.0f) {
+        float inv_ki = 1.0f / ki;
+
+        pid->integrator = 0.0f;
+        pid->integrator_min = pid->out_min * inv_ki;
+        pid->integrator_max = pid->out_max * inv_ki;
+    }
+
+    pid->kp = kp;
+    pid->ki = ki;
+    pid->kd = kd;
+    pid->kd_inv_dt = kd * pid->inv_dt;
+}
+
+#if PID_CYCLE_STATS
+const pid_cycle_stats_t *pid_get_cycle_stats(const pid_t *pid)
+{
+    assert(pid != NULL && "PID structure pointer cannot be NULL");
+
+    return &pid->cycles;
+}
+
+void pid_reset_cycle_stats(pid_t *pid)
+{
+    assert(pid != NULL && "PID structure pointer cannot be NULL");
+
+    pid_cycle_stats_reset(&pid->cycles);
+}
+#endif
+
 /*============================================================================*/
 /* END OF FILE                                                               */
 /*============================================================================*/
@@ -0,0 +1,216 @@
+/**
+ * @file    pid_autotune.c
+ * @brief   Implementation of the relay-feedback PID auto-tuner
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * A cycle runs from one low-to-high relay switch to the next. Each
+ * sample updates the running extremes of the current cycle; each cycle
+ * boundary adds its half peak-to-peak and length to the sums and
+ * restarts the extremes, so the cost per sample is a few compares.
+ */
+
+#include "pid_autotune.h"
+#include <assert.h>
+#include <math.h>
+#include <stddef.h>
+
+#define PI_F 3.14159265f
+
+/* Tuning rule constants: kp = kp_ku * Ku, Ti = ti_tu * Tu, Td = td_tu * Tu */
+static const struct {
+    float kp_ku;
+    float ti_tu;
+    float td_tu;
+} tune_rules[] = {
+    { 0.6f,        0.5f, 0.125f      },   /* PID_TUNE_ZIEGLER_NICHOLS */
+    { 1.0f / 2.2f, 2.2f, 1.0f / 6.3f },   /* PID_TUNE_TYREUS_LUYBEN */
+    { 0.2f,        0.5f, 1.0f / 3.0f }    /* PID_TUNE_NO_OVERSHOOT */
+};
+
+/* Turn the sums into Ku and Tu */
+static void finish(pid_autotune_t *tune)
+{
+    float a = tune->amplitude_sum / (float)tune->measured;
+    float h = tune->hysteresis;
+
+    if (a <= h) {
+        tune->status = PID_AUTOTUNE_FAILED;
+        return;
+    }
+    tune->ku = 4.0f * tune->amplitude / (PI_F * sqrtf(a * a - h * h));
+    tune->tu = (float)tune->period_sum / (float)tune->measured * tune->dt;
+    tune->status = PID_AUTOTUNE_DONE;
+}
+
+/* Close the cycle ending at a low-to-high switch */
+static void end_cycle(pid_autotune_t *tune, float measurement)
+{
+    tune->switches++;
+
+    /* The first switch only opens a cycle; the next ones may be transients */
+    if (tune->switches > PID_AUTOTUNE_SETTLE_CYCLES + 1u) {
+        tune->amplitude_sum += 0.5f * (tune->cycle_max - tune->cycle_min);
+        tune->period_sum += tune->step - tune->cycle_start;
+        if (++tune->measured == tune->cycles) {
+            finish(tune);
+        }
+    }
+
+    tune->cycle_start = tune->step;
+    tune->cycle_max = measurement;
+    tune->cycle_min = measurement;
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+void pid_autotune_init(pid_autotune_t *tune,
+                       float setpoint,
+                       float bias,
+                       float amplitude,
+                       float hysteresis,
+                       float dt)
+{
+    pid_autotune_init_advanced(tune, setpoint, bias, amplitude, hysteresis, dt,
+                               PID_AUTOTUNE_DEFAULT_CYCLES, 0);
+}
+
+void pid_autotune_init_advanced(pid_autotune_t *tune,
+                                float setpoint,
+                                float bias,
+                                float amplitude,
+                                float hysteresis,
+                                float dt,
+                                uint32_t cycles,
+                                uint32_t max_steps)
+{
+    assert(tune != NULL && "Auto-tuner pointer cannot be NULL");
+    assert(amplitude > 0.0f && "Relay amplitude must be positive");
+    assert(hysteresis >= 0.0f && "Hysteresis must be non-negative");
+    assert(dt > 0.0f && "Sample time must be positive");
+    assert(cycles > 0 && "At least one cycle must be measured");
+
+    tune->setpoint = setpoint;
+    tune->bias = bias;
+    tune->amplitude = amplitude;
+    tune->hysteresis = hysteresis;
+    tune->dt = dt;
+    tune->cycles = cycles;
+    tune->max_steps = max_steps;
+
+    tune->relay = 0;           /* Chosen from the first measurement */
+    tune->step = 0;
+    tune->cycle_start = 0;
+    tune->switches = 0;
+    tune->cycle_max = 0.0f;
+    tune->cycle_min = 0.0f;
+    tune->amplitude_sum = 0.0f;
+    tune->period_sum = 0;
+    tune->measured = 0;
+    tune->status = PID_AUTOTUNE_RUNNING;
+
+    tune->ku = 0.0f;
+    tune->tu = 0.0f;
+}
+
+/**
+ * @brief Advance the relay experiment by one sample
+ *
+ * See detailed documentation in pid_autotune.h
+ *
+ * Implementation notes:
+ * - The relay goes high below setpoint - h and low above setpoint + h;
+ *   in between it keeps its state (hysteresis rejects noise chatter)
+ * - Extremes are updated before the switch test, so the sample that
+ *   triggers a switch belongs to both the closing and the next cycle
+ * - Samples before the first low-to-high switch are ignored
+ */
+float pid_autotune_step(pid_autotune_t *tune, float measurement)
+{
+    float error;
+
+    assert(tune != NULL && "Auto-tuner pointer cannot be NULL");
+
+    if (tune->status != PID_AUTOTUNE_RUNNING) {
+        return tune->bias;
+    }
+
+    error = tune->setpoint - measurement;
+    if (tune->relay == 0) {
+        tune->relay = (error >= 0.0f) ? 1 : -1;
+    }
+
+    if (measurement > tune->cycle_max) tune->cycle_max = measurement;
+    if (measurement < tune->cycle_min) tune->cycle_min = measurement;
+
+    if (tune->relay > 0 && error < -tune->hysteresis) {
+        tune->relay = -1;
+    } else if (tune->relay < 0 && error > tune->hysteresis) {
+        tune->relay = 1;
+        end_cycle(tune, measurement);
+    }
+
+    tune->step++;
+    if (tune->status == PID_AUTOTUNE_RUNNING &&
+        tune->max_steps != 0 && tune->step >= tune->max_steps) {
+        tune->status = PID_AUTOTUNE_FAILED;
+    }
+    if (tune->status != PID_AUTOTUNE_RUNNING) {
+        return tune->bias;
+    }
+
+    return tune->bias + (float)tune->relay * tune->amplitude;
+}
+
+pid_autotune_status_t pid_autotune_status(const pid_autotune_t *tune)
+{
+    assert(tune != NULL && "Auto-tuner pointer cannot be NULL");
+
+    return tune->status;
+}
+
+int pid_autotune_gains(const pid_autotune_t *tune, pid_tune_rule_t rule,
+                       float *kp, float *ki, float *kd)
+{
+    float p;
+
+    assert(tune != NULL && kp != NULL && ki != NULL && kd != NULL &&
+           "Auto-tuner and gain pointers cannot be NULL");
+    assert((unsigned)rule < sizeof(tune_rules) / sizeof(tune_rules[0]) &&
+           "Unknown tuning rule");
+
+    if (tune->status != PID_AUTOTUNE_DONE) {
+        return -1;
+    }
+
+    p = tune_rules[rule].kp_ku * tune->ku;
+    *kp = p;
+    *ki = p / (tune_rules[rule].ti_tu * tune->tu);
+    *kd = p * tune_rules[rule].td_tu * tune->tu;
+    return 0;
+}
+
+int pid_autotune_apply(const pid_autotune_t *tune, pid_tune_rule_t rule, pid_t *pid,
+                       float out_min, float out_max, float derivative_lpf)
+{
+    float kp, ki, kd;
+
+    assert(pid != NULL && "PID structure pointer cannot be NULL");
+
+    if (pid_autotune_gains(tune, rule, &kp, &ki, &kd) != 0) {
+        return -1;
+    }
+
+    /* ki > 0 here: Ku and Tu are positive once the experiment is done */
+    pid_init_advanced(pid, kp, ki, kd, tune->dt, out_min, out_max,
+                      out_min / ki, out_max / ki, derivative_lpf);
+    return 0;
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
@@ -0,0 +1,382 @@
+/**
+ * @file    pid_bank.c
+ * @brief   Implementation of the structure-of-arrays PID bank
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * The update loop mirrors pid_compute() operation for operation so each
+ * lane is bit-identical to the scalar controller, but replaces branches
+ * with selects so GCC/Clang can vectorize the loop. On x86 with GCC or
+ * Clang, hand-written SSE4.1 and AVX2 kernels are selected at run time.
+ */
+
+#include "pid_bank.h"
+#include <assert.h>
+#include <string.h>
+
+/* MSVC only accepts restrict as a keyword extension in C */
+#if defined(_MSC_VER) && !defined(__clang__)
+#define restrict __restrict
+#endif
+
+/* Explicit SIMD kernels need per-function target attributes and
+ * __builtin_cpu_supports(), so they are limited to GCC/Clang on x86 */
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PID_BANK_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define PID_BANK_X86_SIMD 0
+#endif
+
+/*============================================================================*/
+/* UPDATE KERNELS                                                            */
+/*============================================================================*/
+
+/* Bank update kernel
+ *
+ * Takes every array as a restrict-qualified parameter: GCC only trusts
+ * restrict on parameters, and without it the loop is versioned for
+ * aliasing or left scalar. */
+static void bank_kernel(size_t n,
+                        const float *restrict kp,
+                        const float *restrict ki,
+                        const float *restrict kd,
+                        const float *restrict dt,
+                        const float *restrict out_min,
+                        const float *restrict out_max,
+                        const float *restrict int_min,
+                        const float *restrict int_max,
+                        const float *restrict lpf,
+                        float *restrict integrator,
+                        float *restrict prev_meas,
+                        float *restrict filtered,
+                        const float *restrict sp,
+                        const float *restrict meas,
+                        float *restrict out)
+{
+    for (size_t i = 0; i < n; i++) {
+        float error = sp[i] - meas[i];
+
+        /* Proportional term */
+        float p = kp[i] * error;
+
+        /* Integral term with anti-windup */
+        float integ = integrator[i] + error * dt[i];
+        integ = (integ > int_max[i]) ? int_max[i] : integ;
+        integ = (integ < int_min[i]) ? int_min[i] : integ;
+        integrator[i] = integ;
+        float in = ki[i] * integ;
+
+        /* Derivative on measurement; the filter always runs and the
+         * output selects the raw derivative for unfiltered lanes */
+        float derivative_raw = -(meas[i] - prev_meas[i]) / dt[i];
+        float filt = filtered[i] * lpf[i] + derivative_raw * (1.0f - lpf[i]);
+        filtered[i] = filt;
+        float d = kd[i] * ((lpf[i] > 0.0f) ? filt : derivative_raw);
+
+        /* Combine and clamp output */
+        float output = p + in + d;
+        output = (output > out_max[i]) ? out_max[i] : output;
+        output = (output < out_min[i]) ? out_min[i] : output;
+        out[i] = output;
+
+        prev_meas[i] = meas[i];
+    }
+}
+
+#if PID_BANK_X86_SIMD
+
+/* SIMD kernels
+ *
+ * Each kernel updates the largest multiple of its width and returns the
+ * number of lanes processed; the caller finishes the tail with
+ * bank_kernel(). Operations match pid_compute() one to one (no FMA, true
+ * division). Clamps use compare + blendv rather than min/max: minps and
+ * maxps resolve equal operands and NaNs differently from clamp(), e.g.
+ * clamping -0.0f to [x, +0.0f] must return -0.0f. */
+
+__attribute__((target("sse4.1")))
+static size_t bank_kernel_sse41(pid_bank_t *bank,
+                                const float *sp,
+                                const float *meas,
+                                float *out,
+                                size_t n)
+{
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128 m = _mm_loadu_ps(meas + i);
+        __m128 dt = _mm_loadu_ps(bank->dt + i);
+        __m128 error = _mm_sub_ps(_mm_loadu_ps(sp + i), m);
+
+        /* Proportional term */
+        __m128 p = _mm_mul_ps(_mm_loadu_ps(bank->kp + i), error);
+
+        /* Integral term with anti-windup */
+        __m128 lim = _mm_loadu_ps(bank->integrator_max + i);
+        __m128 integ = _mm_add_ps(_mm_loadu_ps(bank->integrator + i), _mm_mul_ps(error, dt));
+        integ = _mm_blendv_ps(integ, lim, _mm_cmpgt_ps(integ, lim));
+        lim = _mm_loadu_ps(bank->integrator_min + i);
+        integ = _mm_blendv_ps(integ, lim, _mm_cmplt_ps(integ, lim));
+        _mm_storeu_ps(bank->integrator + i, integ);
+        __m128 in = _mm_mul_ps(_mm_loadu_ps(bank->ki + i), integ);
+
+        /* Derivative on measurement, filter always on */
+        __m128 delta = _mm_sub_ps(m, _mm_loadu_ps(bank->prev_measurement + i));
+        __m128 raw = _mm_div_ps(_mm_xor_ps(delta, sign), dt);
+        __m128 alpha = _mm_loadu_ps(bank->derivative_lpf + i);
+        __m128 filt = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(bank->derivative_filtered + i), alpha),
+                                 _mm_mul_ps(raw, _mm_sub_ps(one, alpha)));
+        _mm_storeu_ps(bank->derivative_filtered + i, filt);
+        raw = _mm_blendv_ps(raw, filt, _mm_cmpgt_ps(alpha, zero));
+        __m128 d = _mm_mul_ps(_mm_loadu_ps(bank->kd + i), raw);
+
+        /* Combine and clamp output */
+        __m128 output = _mm_add_ps(_mm_add_ps(p, in), d);
+        lim = _mm_loadu_ps(bank->out_max + i);
+        output = _mm_blendv_ps(output, lim, _mm_cmpgt_ps(output, lim));
+        lim = _mm_loadu_ps(bank->out_min + i);
+        output = _mm_blendv_ps(output, lim, _mm_cmplt_ps(output, lim));
+        _mm_storeu_ps(out + i, output);
+
+        _mm_storeu_ps(bank->prev_measurement + i, m);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+static size_t bank_kernel_avx2(pid_bank_t *bank,
+                               const float *sp,
+                               const float *meas,
+                               float *out,
+                               size_t n)
+{
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256 m = _mm256_loadu_ps(meas + i);
+        __m256 dt = _mm256_loadu_ps(bank->dt + i);
+        __m256 error = _mm256_sub_ps(_mm256_loadu_ps(sp + i), m);
+
+        /* Proportional term */
+        __m256 p = _mm256_mul_ps(_mm256_loadu_ps(bank->kp + i), error);
+
+        /* Integral term with anti-windup */
+        __m256 lim = _mm256_loadu_ps(bank->integrator_max + i);
+        __m256 integ = _mm256_add_ps(_mm256_loadu_ps(bank->integrator + i), _mm256_mul_ps(error, dt));
+        integ = _mm256_blendv_ps(integ, lim, _mm256_cmp_ps(integ, lim, _CMP_GT_OQ));
+        lim = _mm256_loadu_ps(bank->integrator_min + i);
+        integ = _mm256_blendv_ps(integ, lim, _mm256_cmp_ps(integ, lim, _CMP_LT_OQ));
+        _mm256_storeu_ps(bank->integrator + i, integ);
+        __m256 in = _mm256_mul_ps(_mm256_loadu_ps(bank->ki + i), integ);
+
+        /* Derivative on measurement, filter always on */
+        __m256 delta = _mm256_sub_ps(m, _mm256_loadu_ps(bank->prev_measurement + i));
+        __m256 raw = _mm256_div_ps(_mm256_xor_ps(delta, sign), dt);
+        __m256 alpha = _mm256_loadu_ps(bank->derivative_lpf + i);
+        __m256 filt = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(bank->derivative_filtered + i), alpha),
+                                    _mm256_mul_ps(raw, _mm256_sub_ps(one, alpha)));
+        _mm256_storeu_ps(bank->derivative_filtered + i, filt);
+        raw = _mm256_blendv_ps(raw, filt, _mm256_cmp_ps(alpha, zero, _CMP_GT_OQ));
+        __m256 d = _mm256_mul_ps(_mm256_loadu_ps(bank->kd + i), raw);
+
+        /* Combine and clamp output */
+        __m256 output = _mm256_add_ps(_mm256_add_ps(p, in), d);
+        lim = _mm256_loadu_ps(bank->out_max + i);
+        output = _mm256_blendv_ps(output, lim, _mm256_cmp_ps(output, lim, _CMP_GT_OQ));
+        lim = _mm256_loadu_ps(bank->out_min + i);
+        output = _mm256_blendv_ps(output, lim, _mm256_cmp_ps(output, lim, _CMP_LT_OQ));
+        _mm256_storeu_ps(out + i, output);
+
+        _mm256_storeu_ps(bank->prev_measurement + i, m);
+    }
+
+    return i;
+}
+
+#endif /* PID_BANK_X86_SIMD */
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+void pid_bank_init(pid_bank_t *bank, float *storage, size_t capacity)
+{
+    assert(bank != NULL && "PID bank pointer cannot be NULL");
+    assert((storage != NULL || capacity == 0) && "Bank storage cannot be NULL");
+
+    memset(storage, 0, PID_BANK_STORAGE_SIZE(capacity) * sizeof(float));
+
+    bank->kp                  = storage +  0 * capacity;
+    bank->ki                  = storage +  1 * capacity;
+    bank->kd                  = storage +  2 * capacity;
+    bank->dt                  = storage +  3 * capacity;
+    bank->out_min             = storage +  4 * capacity;
+    bank->out_max             = storage +  5 * capacity;
+    bank->integrator_min      = storage +  6 * capacity;
+    bank->integrator_max      = storage +  7 * capacity;
+    bank->derivative_lpf      = storage +  8 * capacity;
+    bank->integrator          = storage +  9 * capacity;
+    bank->prev_measurement    = storage + 10 * capacity;
+    bank->derivative_filtered = storage + 11 * capacity;
+    bank->capacity = capacity;
+
+    /* Avoid 0/0 in unconfigured lanes */
+    for (size_t i = 0; i < capacity; i++) {
+        bank->dt[i] = 1.0f;
+    }
+}
+
+void pid_bank_load(pid_bank_t *bank, size_t lane, const pid_t *pid)
+{
+    assert(bank != NULL && pid != NULL);
+    assert(lane < bank->capacity && "Lane index out of range");
+
+    bank->kp[lane] = pid->kp;
+    bank->ki[lane] = pid->ki;
+    bank->kd[lane] = pid->kd;
+    bank->dt[lane] = pid->dt;
+    bank->out_min[lane] = pid->out_min;
+    bank->out_max[lane] = pid->out_max;
+    bank->integrator_min[lane] = pid->integrator_min;
+    bank->integrator_max[lane] = pid->integrator_max;
+    bank->derivative_lpf[lane] = pid->derivative_lpf;
+    bank->integrator[lane] = pid->integrator;
+    bank->prev_measurement[lane] = pid->prev_measurement;
+    bank->derivative_filtered[lane] = pid->derivative_filtered;
+}
+
+void pid_bank_store(const pid_bank_t *bank, size_t lane, pid_t *pid)
+{
+    assert(bank != NULL && pid != NULL);
+    assert(lane < bank->capacity && "Lane index out of range");
+
+    pid->kp = bank->kp[lane];
+    pid->ki = bank->ki[lane];
+    pid->kd = bank->kd[lane];
+    pid->dt = bank->dt[lane];
+    pid->out_min = bank->out_min[lane];
+    pid->out_max = bank->out_max[lane];
+    pid->integrator_min = bank->integrator_min[lane];
+    pid->integrator_max = bank->integrator_max[lane];
+    pid->derivative_lpf = bank->derivative_lpf[lane];
+    pid->integrator = bank->integrator[lane];
+    pid->prev_error = 0.0f;
+    pid->prev_measurement = bank->prev_measurement[lane];
+    /* Unfiltered lanes hold scratch data; pid_compute() leaves it at zero */
+    pid->derivative_filtered = (bank->derivative_lpf[lane] > 0.0f)
+                                   ? bank->derivative_filtered[lane] : 0.0f;
+
+    /* Coefficients for pid_compute_fast(), as pid_init() derives them */
+    pid->inv_dt = 1.0f / pid->dt;
+    pid->kd_inv_dt = pid->kd * pid->inv_dt;
+    pid->lpf_complement = 1.0f - pid->derivative_lpf;
+}
+
+int pid_bank_kernel_supported(pid_bank_kernel_t kernel)
+{
+    switch (kernel) {
+    case PID_BANK_KERNEL_AUTO:
+    case PID_BANK_KERNEL_SCALAR:
+        return 1;
+#if PID_BANK_X86_SIMD
+    case PID_BANK_KERNEL_SSE41:
+        return __builtin_cpu_supports("sse4.1") ? 1 : 0;
+    case PID_BANK_KERNEL_AVX2:
+        return __builtin_cpu_supports("avx2") ? 1 : 0;
+#endif
+    default:
+        return 0;
+    }
+}
+
+pid_bank_kernel_t pid_bank_kernel_best(void)
+{
+    if (pid_bank_kernel_supported(PID_BANK_KERNEL_AVX2)) return PID_BANK_KERNEL_AVX2;
+    if (pid_bank_kernel_supported(PID_BANK_KERNEL_SSE41)) return PID_BANK_KERNEL_SSE41;
+    return PID_BANK_KERNEL_SCALAR;
+}
+
+/**
+ * @brief Compute outputs with an explicitly selected kernel
+ *
+ * See detailed documentation in pid_bank.h
+ *
+ * Implementation notes:
+ * - clamp() becomes two selects, which map to min/max or blend
+ * - The filter state is written unconditionally. A conditional store
+ *   would need masked stores (AVX) to vectorize, so lanes with
+ *   derivative_lpf == 0 carry a scratch value that never reaches the
+ *   output; pid_bank_store() reports it as zero like pid_compute()
+ * - Build with -ftree-vectorize (set in CMakeLists.txt) so GCC uses its
+ *   dynamic cost model at -O2
+ * - SIMD kernels handle whole vectors; the remaining lanes go through
+ *   the scalar loop
+ */
+void pid_bank_compute_with(pid_bank_kernel_t kernel,
+                           pid_bank_t *bank,
+                           const float *setpoints,
+                           const float *measurements,
+                           float *outputs,
+                           size_t n)
+{
+    assert(bank != NULL);
+    assert(n <= bank->capacity && "Lane count exceeds bank capacity");
+    assert(pid_bank_kernel_supported(kernel) && "Kernel not supported on this CPU");
+
+    size_t done = 0;
+
+    if (kernel == PID_BANK_KERNEL_AUTO) {
+        kernel = pid_bank_kernel_best();
+    }
+
+#if PID_BANK_X86_SIMD
+    if (kernel == PID_BANK_KERNEL_AVX2) {
+        done = bank_kernel_avx2(bank, setpoints, measurements, outputs, n);
+    } else if (kernel == PID_BANK_KERNEL_SSE41) {
+        done = bank_kernel_sse41(bank, setpoints, measurements, outputs, n);
+    }
+#endif
+
+    bank_kernel(n - done,
+                bank->kp + done, bank->ki + done, bank->kd + done, bank->dt + done,
+                bank->out_min + done, bank->out_max + done,
+                bank->integrator_min + done, bank->integrator_max + done,
+                bank->derivative_lpf + done,
+                bank->integrator + done, bank->prev_measurement + done,
+                bank->derivative_filtered + done,
+                setpoints + done, measurements + done, outputs + done);
+}
+
+void pid_bank_compute(pid_bank_t *bank,
+                      const float *setpoints,
+                      const float *measurements,
+                      float *outputs,
+                      size_t n)
+{
+    pid_bank_compute_with(PID_BANK_KERNEL_AUTO, bank, setpoints, measurements, outputs, n);
+}
+
+void pid_bank_reset(pid_bank_t *bank)
+{
+    assert(bank != NULL);
+
+    for (size_t i = 0; i < bank->capacity; i++) {
+        bank->integrator[i] = 0.0f;
+        bank->prev_measurement[i] = 0.0f;
+        bank->derivative_filtered[i] = 0.0f;
+    }
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
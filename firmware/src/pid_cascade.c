@@ -0,0 +1,153 @@
+/**
+ * @file    pid_cascade.c
+ * @brief   Implementation of the multi-rate PID cascade
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * The schedule is rebuilt whenever a stage is added: first_due[p] is the
+ * outermost stage whose decimation divides p (count if none does, when
+ * the innermost stage is itself decimated). Saturation flags are
+ * computed with compares turned into integers so the per-stage work is
+ * the same on every tick.
+ */
+
+#include "pid_cascade.h"
+#include <assert.h>
+#include <stddef.h>
+
+/* Fill first_due[] for the current stages */
+static void build_schedule(pid_cascade_t *cascade)
+{
+    for (uint32_t phase = 0; phase < cascade->period; phase++) {
+        uint32_t first = cascade->count;
+
+        for (uint32_t k = cascade->count; k-- > 0;) {
+            if (phase % cascade->decimation[k] == 0u) {
+                first = k;
+            }
+        }
+        cascade->first_due[phase] = (uint8_t)first;
+    }
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+void pid_cascade_init(pid_cascade_t *cascade, float dt)
+{
+    assert(cascade != NULL && "Cascade pointer cannot be NULL");
+    assert(dt > 0.0f && "Base tick must be positive");
+
+    cascade->count = 0;
+    cascade->period = 1;
+    cascade->dt = dt;
+    cascade->first_due[0] = 0;
+    pid_cascade_reset(cascade);
+}
+
+void pid_cascade_add_stage(pid_cascade_t *cascade, const pid_t *pid, uint32_t decimation)
+{
+    assert(cascade != NULL && pid != NULL && "Cascade and PID pointers cannot be NULL");
+    assert(cascade->count < PID_CASCADE_MAX_STAGES && "Cascade is full");
+    assert(decimation >= 1u && "Decimation must be at least 1");
+    assert((cascade->count > 0u || decimation <= PID_CASCADE_MAX_PERIOD) &&
+           "Outermost decimation exceeds PID_CASCADE_MAX_PERIOD");
+    assert((cascade->count == 0u ||
+            cascade->decimation[cascade->count - 1u] % decimation == 0u) &&
+           "Decimation must divide the outer stage's decimation");
+    assert(pid->dt > cascade->dt * (float)decimation * 0.999f &&
+           pid->dt < cascade->dt * (float)decimation * 1.001f &&
+           "Stage dt must be base dt * decimation");
+
+    uint32_t k = cascade->count++;
+
+    cascade->stage[k] = *pid;
+    pid_reset(&cascade->stage[k]);
+    cascade->decimation[k] = decimation;
+    if (k == 0u) {
+        cascade->period = decimation;
+    }
+
+    build_schedule(cascade);
+    pid_cascade_reset(cascade);
+}
+
+/**
+ * @brief Advance the cascade by one base tick
+ *
+ * See detailed documentation in pid_cascade.h
+ *
+ * Implementation notes:
+ * - reference[k] is stage k's setpoint, reference[k + 1] its output,
+ *   so a due stage reads what the stage outside it last wrote
+ * - blocked[k] is +1/-1 when stage k's output, or anything inside it,
+ *   is clamped high/low; blocked[count] (the plant) stays 0
+ * - A stage integrating towards its inner stage's block has the step
+ *   undone (conditional integration); the output of that call still
+ *   includes it, later calls do not
+ */
+float pid_cascade_step(pid_cascade_t *cascade, float setpoint, const float *measurements)
+{
+    assert(cascade != NULL && measurements != NULL &&
+           "Cascade and measurements cannot be NULL");
+    assert(cascade->count > 0u && "Cascade has no stages");
+
+    uint32_t first = cascade->first_due[cascade->phase];
+    uint32_t next = cascade->phase + 1u;
+
+    cascade->phase = next * (uint32_t)(next < cascade->period);
+    cascade->reference[0] = setpoint;
+
+    for (uint32_t k = first; k < cascade->count; k++) {
+        pid_t *pid = &cascade->stage[k];
+        float held = pid->integrator;
+        float output = pid_compute_fast(pid, cascade->reference[k], measurements[k]);
+
+        /* Conditional integration against the inner block */
+        float wind = (pid->integrator - held) * (float)cascade->blocked[k + 1u];
+        pid->integrator = (wind > 0.0f) ? held : pid->integrator;
+
+        int32_t own = (int32_t)(output >= pid->out_max) - (int32_t)(output <= pid->out_min);
+        cascade->blocked[k] = own + (int32_t)(own == 0) * cascade->blocked[k + 1u];
+        cascade->reference[k + 1u] = output;
+    }
+
+    return cascade->reference[cascade->count];
+}
+
+float pid_cascade_reference(const pid_cascade_t *cascade, uint32_t stage)
+{
+    assert(cascade != NULL && "Cascade pointer cannot be NULL");
+    assert(stage <= cascade->count && "Stage index out of range");
+
+    return cascade->reference[stage];
+}
+
+pid_t *pid_cascade_stage(pid_cascade_t *cascade, uint32_t stage)
+{
+    assert(cascade != NULL && "Cascade pointer cannot be NULL");
+    assert(stage < cascade->count && "Stage index out of range");
+
+    return &cascade->stage[stage];
+}
+
+void pid_cascade_reset(pid_cascade_t *cascade)
+{
+    assert(cascade != NULL && "Cascade pointer cannot be NULL");
+
+    for (uint32_t k = 0; k < cascade->count; k++) {
+        pid_reset(&cascade->stage[k]);
+    }
+    for (uint32_t k = 0; k <= PID_CASCADE_MAX_STAGES; k++) {
+        cascade->reference[k] = 0.0f;
+        cascade->blocked[k] = 0;
+    }
+    cascade->phase = 0;
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
@@ -0,0 +1,159 @@
+/**
+ * @file    pid_cycles.c
+ * @brief   Implementation of the pid_compute() cycle-budget statistics
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Recording is a handful of compares and one log2 by binary search, so
+ * the hook adds a fixed, small cost to every measured call. The host
+ * counter lives here rather than in pid.c: <time.h> in POSIX mode
+ * defines a pid_t that clashes with the controller type in pid.h.
+ */
+
+#if defined(__linux__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "pid_cycles.h"
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define HAVE_TSC 1
+#else
+#define HAVE_TSC 0
+#endif
+
+/* floor(log2(value)), 0 for 0 */
+static unsigned log2_bin(uint32_t value)
+{
+    unsigned bin = 0;
+
+    if (value >= 1u << 16) { value >>= 16; bin += 16; }
+    if (value >= 1u << 8)  { value >>= 8;  bin += 8; }
+    if (value >= 1u << 4)  { value >>= 4;  bin += 4; }
+    if (value >= 1u << 2)  { value >>= 2;  bin += 2; }
+    if (value >= 1u << 1)  { bin += 1; }
+    return bin;
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+void pid_cycle_stats_reset(pid_cycle_stats_t *stats)
+{
+    assert(stats != NULL && "Stats pointer cannot be NULL");
+
+    memset(stats, 0, sizeof(*stats));
+    stats->min = UINT32_MAX;
+}
+
+void pid_cycle_stats_record(pid_cycle_stats_t *stats, uint32_t cycles)
+{
+    assert(stats != NULL && "Stats pointer cannot be NULL");
+
+    stats->calls++;
+    stats->total += cycles;
+    if (cycles < stats->min) stats->min = cycles;
+    if (cycles > stats->max) stats->max = cycles;
+    stats->histogram[log2_bin(cycles)]++;
+}
+
+uint32_t pid_cycle_stats_mean(const pid_cycle_stats_t *stats)
+{
+    assert(stats != NULL && "Stats pointer cannot be NULL");
+
+    return (stats->calls > 0) ? (uint32_t)(stats->total / stats->calls) : 0u;
+}
+
+uint32_t pid_cycle_stats_over(const pid_cycle_stats_t *stats, uint32_t budget)
+{
+    uint32_t count = 0;
+
+    assert(stats != NULL && "Stats pointer cannot be NULL");
+
+    for (unsigned bin = log2_bin(budget); bin < PID_CYCLE_HIST_BINS; bin++) {
+        count += stats->histogram[bin];
+    }
+    return count;
+}
+
+/**
+ * @brief Print a summary and the non-empty histogram bins
+ *
+ * See detailed documentation in pid_cycles.h
+ *
+ * Output format:
+ *   <name>: <calls> calls, min <n> mean <n> max <n> <unit>
+ *     [<lo>, <hi>) <count> <bar>
+ * with bars scaled to the fullest bin
+ */
+void pid_cycle_stats_dump(const pid_cycle_stats_t *stats, const char *name, FILE *out)
+{
+    uint32_t peak = 0;
+
+    assert(stats != NULL && name != NULL && out != NULL &&
+           "Stats, name and stream cannot be NULL");
+
+    if (stats->calls == 0) {
+        fprintf(out, "%s: no calls recorded\n", name);
+        return;
+    }
+    fprintf(out, "%s: %lu calls, min %lu mean %lu max %lu %s\n", name,
+            (unsigned long)stats->calls, (unsigned long)stats->min,
+            (unsigned long)pid_cycle_stats_mean(stats), (unsigned long)stats->max,
+            pid_cycles_source());
+
+    for (unsigned bin = 0; bin < PID_CYCLE_HIST_BINS; bin++) {
+        if (stats->histogram[bin] > peak) peak = stats->histogram[bin];
+    }
+    for (unsigned bin = 0; bin < PID_CYCLE_HIST_BINS; bin++) {
+        uint32_t count = stats->histogram[bin];
+        unsigned width = (unsigned)((uint64_t)count * 40u / peak);
+
+        if (count == 0) {
+            continue;
+        }
+        fprintf(out, "  [%10llu, %10llu) %10lu ", (bin == 0) ? 0ull : 1ull << bin,
+                2ull << bin, (unsigned long)count);
+        for (unsigned i = 0; i < width; i++) fputc('#', out);
+        fputc('\n', out);
+    }
+}
+
+uint32_t pid_cycles_now(void)
+{
+#if HAVE_TSC
+    return (uint32_t)__rdtsc();
+#elif defined(__linux__) || defined(__APPLE__)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+#else
+    return (uint32_t)clock();
+#endif
+}
+
+const char *pid_cycles_source(void)
+{
+#if HAVE_TSC
+    return "rdtsc";
+#elif defined(__linux__) || defined(__APPLE__)
+    return "ns";
+#else
+    return "clock";
+#endif
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
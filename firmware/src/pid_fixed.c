@@ -0,0 +1,280 @@
+/**
+ * @file    pid_fixed.c
+ * @brief   Implementation of the fixed-point (Q31/Q15) PID controller
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Same algorithm as pid.c in integer arithmetic. Terms are computed in
+ * 64-bit and saturated to 32-bit, so overflow clips instead of wrapping.
+ * Assumes arithmetic right shift of negative values, as provided by all
+ * supported compilers (GCC, Clang, MSVC, ARM/IAR toolchains).
+ */
+
+#include "pid_fixed.h"
+#include <assert.h>
+#include <stddef.h>
+
+/* Mantissas stay below 2^30 so a product with a 33-bit signal fits int64 */
+#define COEF_MANTISSA_LIMIT 1073741824.0   /* 2^30 */
+#define COEF_MAX_SHIFT      62
+#define Q31_ONE             2147483648.0   /* 2^31 */
+#define Q15_TO_Q31          65536          /* 2^16 */
+
+/* P and D terms are clipped to ±2^40 (±512.0) before summing: far beyond
+ * any output limit, but small enough that P + I + D cannot overflow */
+#define TERM_LIMIT          ((int64_t)1 << 40)
+
+/* Convert a real coefficient to mantissa/shift form (init time only) */
+static pid_qcoef_t make_coef(double value)
+{
+    pid_qcoef_t coef = { 0, 0 };
+    double magnitude = (value < 0.0) ? -value : value;
+
+    assert(magnitude < COEF_MANTISSA_LIMIT && "Coefficient out of fixed-point range");
+
+    if (magnitude == 0.0) {
+        return coef;
+    }
+
+    /* Largest shift that keeps the mantissa below 2^30 */
+    while (coef.shift < COEF_MAX_SHIFT && magnitude * 2.0 < COEF_MANTISSA_LIMIT) {
+        magnitude *= 2.0;
+        coef.shift++;
+    }
+
+    coef.mantissa = (int32_t)(magnitude + 0.5);
+    if (value < 0.0) {
+        coef.mantissa = -coef.mantissa;
+    }
+    return coef;
+}
+
+/* Multiply a Q31 value (up to 33 bits) by a coefficient, rounding to nearest */
+static int64_t coef_mul(pid_qcoef_t coef, int64_t value)
+{
+    int64_t product = value * coef.mantissa;
+
+    if (coef.shift == 0) {
+        return product;
+    }
+    return (product + ((int64_t)1 << (coef.shift - 1))) >> coef.shift;
+}
+
+/* Clamp a 64-bit intermediate to [min, max] */
+static int64_t clamp64(int64_t value, int64_t min, int64_t max)
+{
+    if (value > max) return max;
+    if (value < min) return min;
+    return value;
+}
+
+/* Convert a real value to saturated Q31 (init time only) */
+static int32_t q31_from_real(double value)
+{
+    double scaled = value * Q31_ONE;
+
+    if (scaled >= (double)INT32_MAX) return INT32_MAX;
+    if (scaled <= (double)INT32_MIN) return INT32_MIN;
+    return (int32_t)scaled;
+}
+
+/* Store gains, clear state; integrator limits are set by the caller */
+static void configure(pid_q31_t *pid,
+                      float kp,
+                      float ki,
+                      float kd,
+                      float dt,
+                      int32_t out_min,
+                      int32_t out_max,
+                      float derivative_lpf)
+{
+    assert(pid != NULL && "PID structure pointer cannot be NULL");
+    assert(dt > 0.0f && "Sample time must be positive");
+    assert(kp >= 0.0f && "Proportional gain must be non-negative");
+    assert(ki >= 0.0f && "Integral gain must be non-negative");
+    assert(kd >= 0.0f && "Derivative gain must be non-negative");
+    assert(out_min < out_max && "Output min must be less than max");
+
+    /* Clamp derivative filter to [0, 1] range */
+    if (derivative_lpf < 0.0f) derivative_lpf = 0.0f;
+    if (derivative_lpf > 1.0f) derivative_lpf = 1.0f;
+
+    pid->kp = make_coef(kp);
+    pid->ki_dt = make_coef((double)ki * dt);
+    pid->kd_inv_dt = make_coef((double)kd / dt);
+    pid->lpf = make_coef(derivative_lpf);
+    pid->lpf_complement = make_coef(1.0 - derivative_lpf);
+    pid->out_min = out_min;
+    pid->out_max = out_max;
+
+    pid_q31_reset(pid);
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+/**
+ * @brief Initialize Q31 PID controller with standard configuration
+ *
+ * See detailed documentation in pid_fixed.h
+ *
+ * Implementation notes:
+ * - pid_init() sets integrator limits to out_min/max / Ki, so the I term
+ *   Ki × integrator is limited to [out_min, out_max]; the Q31 controller
+ *   stores the I term directly and uses the output limits
+ */
+void pid_q31_init(pid_q31_t *pid,
+                  float kp,
+                  float ki,
+                  float kd,
+                  float dt,
+                  int32_t out_min,
+                  int32_t out_max)
+{
+    configure(pid, kp, ki, kd, dt, out_min, out_max, 0.0f);
+
+    pid->integrator_min = out_min;
+    pid->integrator_max = out_max;
+}
+
+void pid_q31_init_advanced(pid_q31_t *pid,
+                           float kp,
+                           float ki,
+                           float kd,
+                           float dt,
+                           int32_t out_min,
+                           int32_t out_max,
+                           float integrator_min,
+                           float integrator_max,
+                           float derivative_lpf)
+{
+    assert(integrator_min < integrator_max && "Integrator min must be less than max");
+
+    configure(pid, kp, ki, kd, dt, out_min, out_max, derivative_lpf);
+
+    /* Float limits bound error×dt; the stored I term is Ki times that */
+    pid->integrator_min = q31_from_real((double)ki * integrator_min);
+    pid->integrator_max = q31_from_real((double)ki * integrator_max);
+}
+
+/**
+ * @brief Calculate Q31 PID control output
+ *
+ * See detailed documentation in pid_fixed.h
+ *
+ * Implementation algorithm (all values Q31 in 64-bit intermediates):
+ *
+ * 1. error = setpoint - measurement            (33-bit, no overflow)
+ * 2. P = Kp × error
+ * 3. I = clamp(I + (Ki×dt) × error, I_min, I_max)
+ * 4. D = (Kd/dt) × (prev_measurement - measurement)
+ *    If filtering enabled:
+ *      D_filtered = α × D_filtered + (1-α) × D
+ *    Filtering the Kd-scaled value is equivalent to filtering the raw
+ *    derivative because Kd is constant
+ * 5. output = clamp(P + I + D, out_min, out_max)
+ */
+int32_t pid_q31_compute(pid_q31_t *pid, int32_t setpoint, int32_t measurement)
+{
+    int64_t error = (int64_t)setpoint - measurement;
+
+    /* Proportional term */
+    int64_t p = clamp64(coef_mul(pid->kp, error), -TERM_LIMIT, TERM_LIMIT);
+
+    /* Integral term with anti-windup */
+    int64_t i = pid->integrator + coef_mul(pid->ki_dt, error);
+    i = clamp64(i, pid->integrator_min, pid->integrator_max);
+    pid->integrator = (int32_t)i;
+
+    /* Derivative term (on measurement, not error) */
+    int64_t d = coef_mul(pid->kd_inv_dt, (int64_t)pid->prev_measurement - measurement);
+    d = clamp64(d, -TERM_LIMIT, TERM_LIMIT);
+
+    /* Optional low-pass filter (exponential moving average) */
+    if (pid->lpf.mantissa != 0) {
+        d = clamp64(d, INT32_MIN, INT32_MAX);
+        d = coef_mul(pid->lpf, pid->derivative_filtered) + coef_mul(pid->lpf_complement, d);
+        pid->derivative_filtered = (int32_t)clamp64(d, INT32_MIN, INT32_MAX);
+        d = pid->derivative_filtered;
+    }
+
+    /* Combine and clamp output */
+    int64_t output = clamp64(p + i + d, pid->out_min, pid->out_max);
+
+    /* Update state for next iteration */
+    pid->prev_measurement = measurement;
+
+    return (int32_t)output;
+}
+
+void pid_q31_reset(pid_q31_t *pid)
+{
+    pid->integrator = 0;
+    pid->prev_measurement = 0;
+    pid->derivative_filtered = 0;
+}
+
+void pid_q15_init(pid_q15_t *pid,
+                  float kp,
+                  float ki,
+                  float kd,
+                  float dt,
+                  int16_t out_min,
+                  int16_t out_max)
+{
+    assert(pid != NULL && "PID structure pointer cannot be NULL");
+
+    pid_q31_init(&pid->core, kp, ki, kd, dt,
+                 (int32_t)out_min * Q15_TO_Q31,
+                 (int32_t)out_max * Q15_TO_Q31);
+}
+
+void pid_q15_init_advanced(pid_q15_t *pid,
+                           float kp,
+                           float ki,
+                           float kd,
+                           float dt,
+                           int16_t out_min,
+                           int16_t out_max,
+                           float integrator_min,
+                           float integrator_max,
+                           float derivative_lpf)
+{
+    assert(pid != NULL && "PID structure pointer cannot be NULL");
+
+    pid_q31_init_advanced(&pid->core, kp, ki, kd, dt,
+                          (int32_t)out_min * Q15_TO_Q31,
+                          (int32_t)out_max * Q15_TO_Q31,
+                          integrator_min, integrator_max, derivative_lpf);
+}
+
+/**
+ * @brief Calculate Q15 PID control output
+ *
+ * See detailed documentation in pid_fixed.h
+ *
+ * Inputs are widened to Q31 (exact), the Q31 core runs, and the output
+ * is rounded back to Q15. Output limits are whole Q15 values, so the
+ * rounded result stays within them.
+ */
+int16_t pid_q15_compute(pid_q15_t *pid, int16_t setpoint, int16_t measurement)
+{
+    int32_t output = pid_q31_compute(&pid->core,
+                                     (int32_t)setpoint * Q15_TO_Q31,
+                                     (int32_t)measurement * Q15_TO_Q31);
+
+    int64_t rounded = ((int64_t)output + (Q15_TO_Q31 / 2)) >> 16;
+    return (int16_t)clamp64(rounded, INT16_MIN, INT16_MAX);
+}
+
+void pid_q15_reset(pid_q15_t *pid)
+{
+    pid_q31_reset(&pid->core);
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
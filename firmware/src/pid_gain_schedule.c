@@ -0,0 +1,130 @@
+/**
+ * @file    pid_gain_schedule.c
+ * @brief   Implementation of the gain scheduling table
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * The search keeps a base index and, for step = N/2 .. 1, advances it
+ * by step when keys[base + step] <= at. The step is selected with a
+ * conditional expression compilers turn into a conditional move, and
+ * the trip count is fixed by PID_GAIN_SCHEDULE_MAX_POINTS, so the only
+ * branch is the perfectly predicted loop test. The last real breakpoint
+ * gets a zero slope, which holds the end gains once the input is
+ * clamped to the range.
+ */
+
+#include "pid_gain_schedule.h"
+#include <assert.h>
+#include <float.h>
+#include <stddef.h>
+
+/* Clamp value to [min, max] range */
+static float clamp(float value, float min, float max)
+{
+    if (value > max) return max;
+    if (value < min) return min;
+    return value;
+}
+
+static float non_negative(float value)
+{
+    return (value > 0.0f) ? value : 0.0f;
+}
+
+/* Finite and strictly below the FLT_MAX padding */
+static int is_key(float value)
+{
+    return value > -FLT_MAX && value < FLT_MAX;
+}
+
+static int gains_valid(const pid_gains_t *gains)
+{
+    return gains->kp >= 0.0f && gains->ki >= 0.0f && gains->kd >= 0.0f &&
+           gains->kp < FLT_MAX && gains->ki < FLT_MAX && gains->kd < FLT_MAX;
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+int pid_gain_schedule_init(pid_gain_schedule_t *schedule,
+                           const pid_gain_point_t *points,
+                           uint32_t count)
+{
+    assert(schedule != NULL && points != NULL && "Schedule and points cannot be NULL");
+    assert(count >= 1u && count <= PID_GAIN_SCHEDULE_MAX_POINTS &&
+           "Breakpoint count out of range");
+
+    schedule->count = 0;
+    for (uint32_t k = 0; k < count; k++) {
+        if (!is_key(points[k].at) || !gains_valid(&points[k].gains)) {
+            return -1;
+        }
+        if (k > 0u && !(points[k].at > points[k - 1u].at)) {
+            return -1;
+        }
+    }
+
+    for (uint32_t k = 0; k < PID_GAIN_SCHEDULE_MAX_POINTS; k++) {
+        pid_gain_segment_t *seg = &schedule->segment[k];
+        const pid_gain_point_t *point = &points[(k < count) ? k : count - 1u];
+
+        schedule->keys[k] = (k < count) ? point->at : FLT_MAX;
+        seg->start = point->at;
+        seg->gains = point->gains;
+        seg->slope.kp = 0.0f;
+        seg->slope.ki = 0.0f;
+        seg->slope.kd = 0.0f;
+        seg->reserved = 0.0f;
+
+        if (k + 1u < count) {
+            const pid_gain_point_t *next = &points[k + 1u];
+            float inv_width = 1.0f / (next->at - point->at);
+
+            seg->slope.kp = (next->gains.kp - point->gains.kp) * inv_width;
+            seg->slope.ki = (next->gains.ki - point->gains.ki) * inv_width;
+            seg->slope.kd = (next->gains.kd - point->gains.kd) * inv_width;
+        }
+    }
+
+    schedule->min = points[0].at;
+    schedule->max = points[count - 1u].at;
+    schedule->count = count;
+    return 0;
+}
+
+pid_gains_t pid_gain_schedule_lookup(const pid_gain_schedule_t *schedule, float at)
+{
+    assert(schedule != NULL && schedule->count > 0u && "Schedule not initialized");
+
+    const float *keys = schedule->keys;
+    uint32_t base = 0;
+
+    at = clamp(at, schedule->min, schedule->max);
+    for (uint32_t step = PID_GAIN_SCHEDULE_MAX_POINTS / 2u; step > 0u; step >>= 1) {
+        base += (keys[base + step] <= at) ? step : 0u;
+    }
+
+    const pid_gain_segment_t *seg = &schedule->segment[base];
+    float offset = at - seg->start;
+    pid_gains_t gains;
+
+    /* Rounding can dip just below a zero end point */
+    gains.kp = non_negative(seg->gains.kp + offset * seg->slope.kp);
+    gains.ki = non_negative(seg->gains.ki + offset * seg->slope.ki);
+    gains.kd = non_negative(seg->gains.kd + offset * seg->slope.kd);
+    return gains;
+}
+
+void pid_gain_schedule_apply(const pid_gain_schedule_t *schedule, pid_t *pid, float at)
+{
+    pid_gains_t gains = pid_gain_schedule_lookup(schedule, at);
+
+    pid_set_gains(pid, gains.kp, gains.ki, gains.kd);
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
@@ -0,0 +1,132 @@
+/**
+ * @file    pid_pool.c
+ * @brief   Implementation of the fixed-capacity object pool
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * A handle is (generation << 16) | slot. Generations start even (free),
+ * become odd on acquire and even again on release, so a handle resolves
+ * only while its own acquisition is live, and never encodes to 0.
+ */
+
+#include "pid_pool.h"
+#include <assert.h>
+#include <string.h>
+
+/* Slot of a live handle, or capacity */
+static uint16_t live_slot(const pid_pool_t *pool, pid_pool_handle_t handle)
+{
+    uint16_t slot = (uint16_t)(handle & 0xFFFFu);
+    uint16_t generation = (uint16_t)(handle >> 16);
+
+    if (slot >= pool->bump || (generation & 1u) == 0u ||
+        pool->generations[slot] != generation) {
+        return pool->capacity;
+    }
+    return slot;
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+void pid_pool_init(pid_pool_t *pool, void *storage, size_t slot_size, uint16_t capacity,
+                   uint16_t *links, uint16_t *generations)
+{
+    assert(pool != NULL && storage != NULL && links != NULL && generations != NULL &&
+           "Pool, storage, links and generations cannot be NULL");
+    assert(capacity >= 1u && "Pool capacity must be at least 1");
+    assert(slot_size > 0u && slot_size % PID_POOL_CACHE_LINE == 0u &&
+           "Slot size must be a multiple of PID_POOL_CACHE_LINE");
+    assert((uintptr_t)storage % PID_POOL_CACHE_LINE == 0u &&
+           "Pool storage must be cache-line aligned");
+
+    pool->storage = (unsigned char *)storage;
+    pool->links = links;
+    pool->generations = generations;
+    pool->slot_size = slot_size;
+    pool->capacity = capacity;
+    pool->bump = 0;
+    pool->free_head = capacity;
+    pool->live = 0;
+    pool->high_water = 0;
+}
+
+pid_pool_handle_t pid_pool_acquire(pid_pool_t *pool)
+{
+    uint16_t slot;
+
+    assert(pool != NULL && "Pool pointer cannot be NULL");
+
+    if (pool->free_head != pool->capacity) {
+        slot = pool->free_head;
+        pool->free_head = pool->links[slot];
+    } else if (pool->bump < pool->capacity) {
+        slot = pool->bump++;
+        pool->generations[slot] = 0;
+    } else {
+        return PID_POOL_INVALID;
+    }
+
+    pool->generations[slot]++;
+    pool->live++;
+    if (pool->live > pool->high_water) {
+        pool->high_water = pool->live;
+    }
+    memset(pool->storage + (size_t)slot * pool->slot_size, 0, pool->slot_size);
+    return ((pid_pool_handle_t)pool->generations[slot] << 16) | slot;
+}
+
+int pid_pool_release(pid_pool_t *pool, pid_pool_handle_t handle)
+{
+    assert(pool != NULL && "Pool pointer cannot be NULL");
+
+    uint16_t slot = live_slot(pool, handle);
+    if (slot == pool->capacity) {
+        return -1;
+    }
+
+    pool->generations[slot]++;
+    pool->links[slot] = pool->free_head;
+    pool->free_head = slot;
+    pool->live--;
+    return 0;
+}
+
+void *pid_pool_get(const pid_pool_t *pool, pid_pool_handle_t handle)
+{
+    assert(pool != NULL && "Pool pointer cannot be NULL");
+
+    uint16_t slot = live_slot(pool, handle);
+    if (slot == pool->capacity) {
+        return NULL;
+    }
+    return pool->storage + (size_t)slot * pool->slot_size;
+}
+
+uint16_t pid_pool_live(const pid_pool_t *pool)
+{
+    assert(pool != NULL && "Pool pointer cannot be NULL");
+
+    return pool->live;
+}
+
+uint16_t pid_pool_high_water(const pid_pool_t *pool)
+{
+    assert(pool != NULL && "Pool pointer cannot be NULL");
+
+    return pool->high_water;
+}
+
+size_t pid_pool_footprint(const pid_pool_t *pool)
+{
+    assert(pool != NULL && "Pool pointer cannot be NULL");
+
+    return (size_t)pool->capacity * (pool->slot_size + 2u * sizeof(uint16_t));
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
@@ -0,0 +1,221 @@
+/**
+ * @file    pid_schedule.c
+ * @brief   Implementation of the static multi-rate PID schedule
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Storage layout: offsets[hyperperiod + 1], then the entries, then one
+ * phase per loop. While building, offsets[] first counts the calls per
+ * tick (the load the staggering balances), is turned into start
+ * positions by a prefix sum, advanced as entries are placed and finally
+ * shifted back by one tick, so no scratch memory beyond the caller's
+ * buffer is needed.
+ */
+
+#include "pid_schedule.h"
+#include <assert.h>
+
+/* Greatest common divisor (Euclid) */
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+    while (b != 0u) {
+        uint32_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+/* Least common multiple of the periods, 0 if above the limit */
+static uint32_t hyperperiod_of(const uint32_t *periods, size_t count)
+{
+    uint64_t lcm = 1;
+
+    for (size_t k = 0; k < count; k++) {
+        assert(periods[k] >= 1u && "Loop period must be at least one tick");
+        lcm = lcm / gcd((uint32_t)lcm, periods[k]) * periods[k];
+        if (lcm > PID_SCHEDULE_MAX_HYPERPERIOD) {
+            return 0;
+        }
+    }
+    return (uint32_t)lcm;
+}
+
+/* Phase in [0, period) whose ticks carry the smallest peak load */
+static uint32_t least_loaded_phase(const uint32_t *load, uint32_t hyperperiod, uint32_t period)
+{
+    uint32_t best_phase = 0;
+    uint32_t best_peak = UINT32_MAX;
+
+    for (uint32_t phase = 0; phase < period; phase++) {
+        uint32_t peak = 0;
+
+        for (uint32_t t = phase; t < hyperperiod; t += period) {
+            if (load[t] > peak) peak = load[t];
+        }
+        if (peak < best_peak) {
+            best_peak = peak;
+            best_phase = phase;
+        }
+    }
+    return best_phase;
+}
+
+/* Assign phases fastest loop first (ties by index), counting calls per tick */
+static void assign_phases(const uint32_t *periods, size_t count, pid_schedule_phasing_t phasing,
+                          uint32_t hyperperiod, uint32_t *load, uint32_t *phases)
+{
+    size_t prev = count;
+
+    for (size_t n = 0; n < count; n++) {
+        size_t next = count;
+
+        /* Next loop in (period, index) order after prev */
+        for (size_t k = 0; k < count; k++) {
+            int after_prev = (prev == count) || periods[k] > periods[prev] ||
+                             (periods[k] == periods[prev] && k > prev);
+            int before_next = (next == count) || periods[k] < periods[next] ||
+                              (periods[k] == periods[next] && k < next);
+            if (after_prev && before_next) {
+                next = k;
+            }
+        }
+
+        phases[next] = (phasing == PID_SCHEDULE_STAGGERED)
+                     ? least_loaded_phase(load, hyperperiod, periods[next]) : 0u;
+        for (uint32_t t = phases[next]; t < hyperperiod; t += periods[next]) {
+            load[t]++;
+        }
+        prev = next;
+    }
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+size_t pid_schedule_storage_size(const uint32_t *periods, size_t count)
+{
+    assert(periods != NULL && "Periods cannot be NULL");
+
+    uint32_t hyperperiod = hyperperiod_of(periods, count);
+    size_t size = (size_t)hyperperiod + 1u + count;
+
+    if (hyperperiod == 0u) {
+        return 0;
+    }
+    for (size_t k = 0; k < count; k++) {
+        size += hyperperiod / periods[k];
+    }
+    return size;
+}
+
+/**
+ * @brief Build the hyperperiod table
+ *
+ * See detailed documentation in pid_schedule.h
+ *
+ * Implementation notes:
+ * - Entries are placed in loop index order, so each tick's run is
+ *   ascending and walks the loops array forwards
+ * - Build cost is O(count^2 + count * hyperperiod), paid once at boot
+ */
+int pid_schedule_build(pid_schedule_t *sched,
+                       pid_t *loops,
+                       const uint32_t *periods,
+                       size_t count,
+                       pid_schedule_phasing_t phasing,
+                       uint32_t *storage,
+                       size_t capacity)
+{
+    assert(sched != NULL && loops != NULL && periods != NULL && storage != NULL &&
+           "Schedule, loops, periods and storage cannot be NULL");
+    assert(count >= 1u && "Schedule needs at least one loop");
+
+    size_t needed = pid_schedule_storage_size(periods, count);
+    if (needed == 0u || capacity < needed) {
+        return -1;
+    }
+
+    uint32_t hyperperiod = hyperperiod_of(periods, count);
+    uint32_t *offsets = storage;
+    uint32_t *entries = storage + hyperperiod + 1u;
+    uint32_t *phases = storage + needed - count;
+    uint32_t start = 0;
+
+    /* Calls per tick */
+    for (uint32_t t = 0; t <= hyperperiod; t++) {
+        offsets[t] = 0;
+    }
+    assign_phases(periods, count, phasing, hyperperiod, offsets, phases);
+
+    /* Load report, then counts -> start positions */
+    sched->max_calls = 0;
+    sched->worst_tick = 0;
+    for (uint32_t t = 0; t < hyperperiod; t++) {
+        uint32_t calls = offsets[t];
+
+        if (calls > sched->max_calls) {
+            sched->max_calls = calls;
+            sched->worst_tick = t;
+        }
+        offsets[t] = start;
+        start += calls;
+    }
+    offsets[hyperperiod] = start;
+    sched->total_calls = start;
+
+    /* Place entries (each offsets[t] ends at the start of t + 1) ... */
+    for (size_t k = 0; k < count; k++) {
+        for (uint32_t t = phases[k]; t < hyperperiod; t += periods[k]) {
+            entries[offsets[t]++] = (uint32_t)k;
+        }
+    }
+    /* ... and shift the starts back */
+    for (uint32_t t = hyperperiod; t > 0u; t--) {
+        offsets[t] = offsets[t - 1u];
+    }
+    offsets[0] = 0;
+
+    sched->loops = loops;
+    sched->count = count;
+    sched->offsets = offsets;
+    sched->entries = entries;
+    sched->hyperperiod = hyperperiod;
+    sched->phase = 0;
+    return 0;
+}
+
+uint32_t pid_schedule_tick(pid_schedule_t *sched,
+                           const float *setpoints,
+                           const float *measurements,
+                           float *outputs)
+{
+    assert(sched != NULL && setpoints != NULL && measurements != NULL && outputs != NULL &&
+           "Schedule and data arrays cannot be NULL");
+
+    uint32_t first = sched->offsets[sched->phase];
+    uint32_t last = sched->offsets[sched->phase + 1u];
+    uint32_t next = sched->phase + 1u;
+
+    sched->phase = next * (uint32_t)(next < sched->hyperperiod);
+
+    for (uint32_t i = first; i < last; i++) {
+        uint32_t k = sched->entries[i];
+        outputs[k] = pid_compute(&sched->loops[k], setpoints[k], measurements[k]);
+    }
+    return last - first;
+}
+
+void pid_schedule_restart(pid_schedule_t *sched)
+{
+    assert(sched != NULL && "Schedule pointer cannot be NULL");
+
+    sched->phase = 0;
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
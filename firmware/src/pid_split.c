@@ -0,0 +1,151 @@
+/**
+ * @file    pid_split.c
+ * @brief   Implementation of the split configuration/state PID controller
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * pid_compute_split() repeats pid_compute() operation for operation
+ * (including the division by dt) so the two stay bit-identical; only
+ * where the operands live differs.
+ */
+
+#include "pid_split.h"
+#include <assert.h>
+#include <stddef.h>
+
+/* Clamp value to [min, max] range */
+static float clamp(float value, float min, float max)
+{
+    if (value > max) return max;
+    if (value < min) return min;
+    return value;
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+void pid_config_init(pid_config_t *config,
+                     float kp,
+                     float ki,
+                     float kd,
+                     float dt,
+                     float out_min,
+                     float out_max)
+{
+    assert(config != NULL && "Configuration pointer cannot be NULL");
+
+    /* Same limits as pid_init() */
+    if (ki != 0.0f) {
+        pid_config_init_advanced(config, kp, ki, kd, dt, out_min, out_max,
+                                 out_min / ki, out_max / ki, 0.0f);
+    } else {
+        pid_config_init_advanced(config, kp, ki, kd, dt, out_min, out_max,
+                                 out_min, out_max, 0.0f);
+    }
+}
+
+void pid_config_init_advanced(pid_config_t *config,
+                              float kp,
+                              float ki,
+                              float kd,
+                              float dt,
+                              float out_min,
+                              float out_max,
+                              float integrator_min,
+                              float integrator_max,
+                              float derivative_lpf)
+{
+    assert(config != NULL && "Configuration pointer cannot be NULL");
+    assert(dt > 0.0f && "Sample time must be positive");
+    assert(kp >= 0.0f && "Proportional gain must be non-negative");
+    assert(ki >= 0.0f && "Integral gain must be non-negative");
+    assert(kd >= 0.0f && "Derivative gain must be non-negative");
+    assert(out_min < out_max && "Output min must be less than max");
+    assert(integrator_min < integrator_max && "Integrator min must be less than max");
+
+    config->kp = kp;
+    config->dt = dt;
+    config->integrator_min = integrator_min;
+    config->integrator_max = integrator_max;
+    config->ki = ki;
+    config->derivative_lpf = clamp(derivative_lpf, 0.0f, 1.0f);
+    config->lpf_complement = 1.0f - config->derivative_lpf;
+    config->kd = kd;
+    config->out_min = out_min;
+    config->out_max = out_max;
+}
+
+void pid_split_from(const pid_t *pid, pid_config_t *config, pid_state_t *state)
+{
+    assert(pid != NULL && "PID structure pointer cannot be NULL");
+
+    if (config != NULL) {
+        config->kp = pid->kp;
+        config->dt = pid->dt;
+        config->integrator_min = pid->integrator_min;
+        config->integrator_max = pid->integrator_max;
+        config->ki = pid->ki;
+        config->derivative_lpf = pid->derivative_lpf;
+        config->lpf_complement = pid->lpf_complement;
+        config->kd = pid->kd;
+        config->out_min = pid->out_min;
+        config->out_max = pid->out_max;
+    }
+    if (state != NULL) {
+        state->integrator = pid->integrator;
+        state->prev_measurement = pid->prev_measurement;
+        state->derivative_filtered = pid->derivative_filtered;
+    }
+}
+
+void pid_state_reset(pid_state_t *state)
+{
+    assert(state != NULL && "State pointer cannot be NULL");
+
+    state->integrator = 0.0f;
+    state->prev_measurement = 0.0f;
+    state->derivative_filtered = 0.0f;
+}
+
+float pid_compute_split(const pid_config_t *config,
+                        pid_state_t *state,
+                        float setpoint,
+                        float measurement)
+{
+    assert(config != NULL && state != NULL && "Configuration and state cannot be NULL");
+
+    float error = setpoint - measurement;
+
+    /* Proportional term */
+    float p = config->kp * error;
+
+    /* Integral term with anti-windup */
+    state->integrator += error * config->dt;
+    state->integrator = clamp(state->integrator, config->integrator_min, config->integrator_max);
+    float i = config->ki * state->integrator;
+
+    /* Derivative term (on measurement) */
+    float derivative_raw = -(measurement - state->prev_measurement) / config->dt;
+
+    if (config->derivative_lpf > 0.0f) {
+        state->derivative_filtered = state->derivative_filtered * config->derivative_lpf +
+                                     derivative_raw * config->lpf_complement;
+        derivative_raw = state->derivative_filtered;
+    }
+
+    float d = config->kd * derivative_raw;
+
+    /* Combine and clamp output */
+    float output = p + i + d;
+    output = clamp(output, config->out_min, config->out_max);
+
+    state->prev_measurement = measurement;
+    return output;
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
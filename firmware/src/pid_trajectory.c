@@ -0,0 +1,198 @@
+/**
+ * @file    pid_trajectory.c
+ * @brief   Implementation of trapezoidal and S-curve trajectory sampling
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * A move is planned as up to seven phases of constant jerk (the
+ * trapezoid uses three phases of zero jerk with stepped acceleration)
+ * for the distance |end - start|. The state at each phase start is
+ * integrated once. Generation then walks the samples and the phases
+ * together in a single pass, evaluating the cubic of the current phase
+ * at each sample, and applies the direction of the move.
+ *
+ * Peak velocity of a short move:
+ * - Trapezoid: v = sqrt(D a) when D < v_max^2 / a
+ * - S-curve, acceleration limit reached: v^2/a + v a/j = D
+ * - S-curve, limit not reached: D = 2 v^(3/2) / sqrt(j)
+ */
+
+#include "pid_trajectory.h"
+#include <assert.h>
+#include <math.h>
+#include <stddef.h>
+
+#define MAX_PHASES 7u
+
+/* Constant-jerk phase, state at its start (positive-direction move) */
+typedef struct {
+    float duration;
+    float jerk;
+    float t0;
+    float p0;
+    float v0;
+    float a0;
+} phase_t;
+
+typedef struct {
+    phase_t phase[MAX_PHASES];
+    uint32_t count;
+    float total;               /* Duration of the move */
+} plan_t;
+
+static void add_phase(plan_t *plan, float duration, float a0, float jerk)
+{
+    phase_t *ph = &plan->phase[plan->count++];
+
+    ph->duration = (duration > 0.0f) ? duration : 0.0f;
+    ph->a0 = a0;
+    ph->jerk = jerk;
+}
+
+/* Plan |end - start| as constant-jerk phases and integrate their start states */
+static void plan_move(const pid_profile_t *profile, plan_t *plan)
+{
+    float distance = fabsf(profile->end - profile->start);
+    float v = profile->max_velocity;
+    float a = profile->max_acceleration;
+
+    plan->count = 0;
+    if (profile->shape == PID_PROFILE_TRAPEZOIDAL) {
+        if (distance * a < v * v) {
+            v = sqrtf(distance * a);
+        }
+        float t_acc = v / a;
+        float t_cruise = (v > 0.0f) ? distance / v - t_acc : 0.0f;
+
+        add_phase(plan, t_acc, a, 0.0f);
+        add_phase(plan, t_cruise, 0.0f, 0.0f);
+        add_phase(plan, t_acc, -a, 0.0f);
+    } else {
+        float j = profile->max_jerk;
+        float t_jerk, t_acc;
+
+        /* Accelerating to v (and back) covers v * (2 t_jerk + t_acc) */
+        if (v * j >= a * a) {
+            t_jerk = a / j;
+            t_acc = v / a - t_jerk;
+        } else {
+            t_jerk = sqrtf(v / j);
+            t_acc = 0.0f;
+        }
+        if (distance < v * (2.0f * t_jerk + t_acc)) {
+            float ratio = a / j;
+
+            v = 0.5f * a * (sqrtf(ratio * ratio + 4.0f * distance / a) - ratio);
+            if (v * j >= a * a) {
+                t_jerk = ratio;
+                t_acc = v / a - t_jerk;
+            } else {
+                v = cbrtf(distance * distance * j * 0.25f);
+                t_jerk = sqrtf(v / j);
+                t_acc = 0.0f;
+            }
+        }
+        float peak = j * t_jerk;
+        float t_cruise = (v > 0.0f) ? distance / v - (2.0f * t_jerk + t_acc) : 0.0f;
+
+        add_phase(plan, t_jerk, 0.0f, j);
+        add_phase(plan, t_acc, peak, 0.0f);
+        add_phase(plan, t_jerk, peak, -j);
+        add_phase(plan, t_cruise, 0.0f, 0.0f);
+        add_phase(plan, t_jerk, 0.0f, -j);
+        add_phase(plan, t_acc, -peak, 0.0f);
+        add_phase(plan, t_jerk, -peak, j);
+    }
+
+    float t = 0.0f, p = 0.0f, vel = 0.0f;
+    for (uint32_t k = 0; k < plan->count; k++) {
+        phase_t *ph = &plan->phase[k];
+        float d = ph->duration;
+
+        ph->t0 = t;
+        ph->p0 = p;
+        ph->v0 = vel;
+        p += d * (vel + d * (0.5f * ph->a0 + d * ph->jerk * (1.0f / 6.0f)));
+        vel += d * (ph->a0 + 0.5f * d * ph->jerk);
+        t += d;
+    }
+    plan->total = t;
+}
+
+static uint32_t samples_for(const plan_t *plan, float dt)
+{
+    return (uint32_t)ceilf(plan->total / dt) + 1u;
+}
+
+static void check_profile(const pid_profile_t *profile)
+{
+    assert(profile != NULL && "Profile pointer cannot be NULL");
+    assert(profile->dt > 0.0f && "Sample time must be positive");
+    assert(profile->max_velocity > 0.0f && "Velocity limit must be positive");
+    assert(profile->max_acceleration > 0.0f && "Acceleration limit must be positive");
+    assert((profile->shape == PID_PROFILE_TRAPEZOIDAL || profile->max_jerk > 0.0f) &&
+           "Jerk limit must be positive");
+    (void)profile;
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+uint32_t pid_trajectory_samples(const pid_profile_t *profile)
+{
+    plan_t plan;
+
+    check_profile(profile);
+    plan_move(profile, &plan);
+    return samples_for(&plan, profile->dt);
+}
+
+uint32_t pid_trajectory_generate(const pid_profile_t *profile,
+                                 pid_trajectory_point_t *buffer,
+                                 uint32_t capacity)
+{
+    plan_t plan;
+
+    check_profile(profile);
+    assert(buffer != NULL && "Buffer pointer cannot be NULL");
+
+    plan_move(profile, &plan);
+    uint32_t count = samples_for(&plan, profile->dt);
+    if (capacity < count) {
+        return 0;
+    }
+
+    float sign = (profile->end < profile->start) ? -1.0f : 1.0f;
+    uint32_t k = 0;
+
+    for (uint32_t n = 0; n + 1u < count; n++) {
+        float t = (float)n * profile->dt;
+
+        while (k + 1u < plan.count && t >= plan.phase[k + 1u].t0) {
+            k++;
+        }
+
+        const phase_t *ph = &plan.phase[k];
+        float tau = t - ph->t0;
+        float a = ph->a0 + tau * ph->jerk;
+        float v = ph->v0 + tau * (ph->a0 + 0.5f * tau * ph->jerk);
+        float p = ph->p0 + tau * (ph->v0 + tau * (0.5f * ph->a0 + tau * ph->jerk * (1.0f / 6.0f)));
+
+        buffer[n].position = profile->start + sign * p;
+        buffer[n].velocity = sign * v;
+        buffer[n].acceleration = sign * a;
+    }
+
+    /* Land exactly on the end, at rest */
+    buffer[count - 1u].position = profile->end;
+    buffer[count - 1u].velocity = 0.0f;
+    buffer[count - 1u].acceleration = 0.0f;
+    return count;
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
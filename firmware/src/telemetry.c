@@ -0,0 +1,122 @@
+/**
+ * @file    telemetry.c
+ * @brief   Implementation of the buffered binary telemetry writer
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ */
+
+#include "telemetry.h"
+#include <assert.h>
+#include <string.h>
+
+/* Field layout stored in the header; must match telemetry_write() */
+static const char field_layout[] = "step:u4,setpoint:f4,measurement:f4,output:f4";
+
+/* Offset of the field layout string within the header */
+#define LAYOUT_OFFSET 16u
+
+/* Encode integers/floats little-endian regardless of host byte order */
+static unsigned char *put_u16(unsigned char *p, uint16_t value)
+{
+    p[0] = (unsigned char)(value & 0xFFu);
+    p[1] = (unsigned char)(value >> 8);
+    return p + 2;
+}
+
+static unsigned char *put_u32(unsigned char *p, uint32_t value)
+{
+    p[0] = (unsigned char)(value & 0xFFu);
+    p[1] = (unsigned char)((value >> 8) & 0xFFu);
+    p[2] = (unsigned char)((value >> 16) & 0xFFu);
+    p[3] = (unsigned char)(value >> 24);
+    return p + 4;
+}
+
+static unsigned char *put_f32(unsigned char *p, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return put_u32(p, bits);
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+int telemetry_open(telemetry_writer_t *writer, FILE *file, float sample_time)
+{
+    unsigned char header[TELEMETRY_HEADER_SIZE];
+    unsigned char *p = header;
+
+    assert(writer != NULL && "Telemetry writer pointer cannot be NULL");
+    assert(file != NULL && "Telemetry stream cannot be NULL");
+    assert(sizeof(field_layout) <= TELEMETRY_HEADER_SIZE - LAYOUT_OFFSET &&
+           "Field layout does not fit in header");
+
+    writer->file = file;
+    writer->used = 0;
+    writer->error = 0;
+
+    memset(header, 0, sizeof(header));
+    memcpy(p, "PIDT", 4);
+    p += 4;
+    p = put_u16(p, TELEMETRY_VERSION);
+    p = put_u16(p, TELEMETRY_HEADER_SIZE);
+    p = put_u32(p, TELEMETRY_RECORD_SIZE);
+    p = put_f32(p, sample_time);
+    memcpy(header + LAYOUT_OFFSET, field_layout, sizeof(field_layout));
+
+    if (fwrite(header, 1, sizeof(header), file) != sizeof(header)) {
+        writer->error = 1;
+        return -1;
+    }
+    return 0;
+}
+
+void telemetry_write(telemetry_writer_t *writer,
+                     uint32_t step,
+                     float setpoint,
+                     float measurement,
+                     float output)
+{
+    if (writer->used + TELEMETRY_RECORD_SIZE > sizeof(writer->buffer)) {
+        (void)telemetry_flush(writer);
+    }
+
+    unsigned char *p = writer->buffer + writer->used;
+    p = put_u32(p, step);
+    p = put_f32(p, setpoint);
+    p = put_f32(p, measurement);
+    (void)put_f32(p, output);
+    writer->used += TELEMETRY_RECORD_SIZE;
+}
+
+int telemetry_flush(telemetry_writer_t *writer)
+{
+    assert(writer != NULL && writer->file != NULL && "Telemetry writer is not open");
+
+    if (writer->used > 0) {
+        if (fwrite(writer->buffer, 1, writer->used, writer->file) != writer->used) {
+            writer->error = 1;
+        }
+        writer->used = 0;
+    }
+    return writer->error ? -1 : 0;
+}
+
+int telemetry_close(telemetry_writer_t *writer)
+{
+    int status = telemetry_flush(writer);
+
+    if (fflush(writer->file) != 0) {
+        status = -1;
+    }
+    writer->file = NULL;
+    return status;
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
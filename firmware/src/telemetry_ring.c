@@ -0,0 +1,141 @@
+/**
+ * @file    telemetry_ring.c
+ * @brief   Implementation of the SPSC telemetry ring buffer
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Classic two-index SPSC queue. Each index has a single writer, so no
+ * read-modify-write atomics are needed (they are unavailable on
+ * Cortex-M0): the producer publishes a record by releasing head after
+ * writing the slot, and the consumer frees slots by releasing tail
+ * after reading them. Each side acquires the other's index before
+ * touching slots.
+ */
+
+#include "telemetry_ring.h"
+#include <assert.h>
+
+#if TELEMETRY_RING_C11_ATOMICS
+
+#define LOAD_OWN(index)          atomic_load_explicit(&(index), memory_order_relaxed)
+#define LOAD_ACQUIRE(index)      atomic_load_explicit(&(index), memory_order_acquire)
+#define STORE_RELEASE(index, v)  atomic_store_explicit(&(index), (v), memory_order_release)
+#define STORE_RELAXED(index, v)  atomic_store_explicit(&(index), (v), memory_order_relaxed)
+
+#else /* C99 fallback: volatile indices + explicit barriers */
+
+#ifndef TELEMETRY_RING_BARRIER
+#if defined(__GNUC__)
+#define TELEMETRY_RING_BARRIER() __sync_synchronize()
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#if defined(_M_ARM64)
+#define TELEMETRY_RING_BARRIER() __dmb(_ARM64_BARRIER_ISH)
+#elif defined(_M_ARM)
+#define TELEMETRY_RING_BARRIER() __dmb(_ARM_BARRIER_ISH)
+#else
+#define TELEMETRY_RING_BARRIER() _ReadWriteBarrier()   /* x86 is TSO */
+#endif
+#else
+#error "Define TELEMETRY_RING_BARRIER() for this toolchain (e.g. __DMB())"
+#endif
+#endif
+
+/* Barrier after the load: later slot accesses cannot move before it */
+static uint32_t load_acquire(const telemetry_ring_index_t *index)
+{
+    uint32_t value = *index;
+    TELEMETRY_RING_BARRIER();
+    return value;
+}
+
+/* Barrier before the store: earlier slot accesses complete first */
+static void store_release(telemetry_ring_index_t *index, uint32_t value)
+{
+    TELEMETRY_RING_BARRIER();
+    *index = value;
+}
+
+#define LOAD_OWN(index)          (index)
+#define LOAD_ACQUIRE(index)      load_acquire(&(index))
+#define STORE_RELEASE(index, v)  store_release(&(index), (v))
+#define STORE_RELAXED(index, v)  ((index) = (v))
+
+#endif /* TELEMETRY_RING_C11_ATOMICS */
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+void telemetry_ring_init(telemetry_ring_t *ring, telemetry_record_t *storage, uint32_t capacity)
+{
+    assert(ring != NULL && "Ring pointer cannot be NULL");
+    assert(storage != NULL && "Ring storage cannot be NULL");
+    assert(capacity > 0 && capacity <= 0x80000000u && "Ring capacity out of range");
+    assert((capacity & (capacity - 1u)) == 0 && "Ring capacity must be a power of two");
+
+    ring->records = storage;
+    ring->mask = capacity - 1u;
+    STORE_RELAXED(ring->head, 0u);
+    STORE_RELAXED(ring->tail, 0u);
+    STORE_RELAXED(ring->dropped, 0u);
+}
+
+/**
+ * @brief Append a record (producer side)
+ *
+ * See detailed documentation in telemetry_ring.h
+ *
+ * Implementation notes:
+ * - head - tail is the fill level even after the indices wrap, because
+ *   unsigned subtraction is modulo 2^32 and capacity <= 2^31
+ * - A stale tail only makes the ring look fuller than it is, never
+ *   emptier, so the producer cannot overwrite an unread slot
+ */
+int telemetry_ring_push(telemetry_ring_t *ring, const telemetry_record_t *record)
+{
+    uint32_t head = LOAD_OWN(ring->head);
+    uint32_t tail = LOAD_ACQUIRE(ring->tail);
+
+    if (head - tail > ring->mask) {
+        STORE_RELAXED(ring->dropped, LOAD_OWN(ring->dropped) + 1u);
+        return -1;
+    }
+
+    ring->records[head & ring->mask] = *record;
+    STORE_RELEASE(ring->head, head + 1u);
+    return 0;
+}
+
+size_t telemetry_ring_pop(telemetry_ring_t *ring, telemetry_record_t *out, size_t max_records)
+{
+    uint32_t tail = LOAD_OWN(ring->tail);
+    uint32_t head = LOAD_ACQUIRE(ring->head);
+    uint32_t available = head - tail;
+    uint32_t count = (max_records < available) ? (uint32_t)max_records : available;
+
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = ring->records[(tail + i) & ring->mask];
+    }
+
+    if (count > 0) {
+        STORE_RELEASE(ring->tail, tail + count);
+    }
+    return count;
+}
+
+uint32_t telemetry_ring_count(const telemetry_ring_t *ring)
+{
+    return LOAD_ACQUIRE(ring->head) - LOAD_OWN(ring->tail);
+}
+
+uint32_t telemetry_ring_dropped(const telemetry_ring_t *ring)
+{
+    return LOAD_ACQUIRE(ring->dropped);
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
@@ -0,0 +1,197 @@
+/**
+ * @file    pid_bode.c
+ * @brief   Command-line frequency-response (Bode) analyzer
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Excites the simulated loop with multisines at the plant input
+ * (sim_freq.h), measures the open loop L = C P and the closed loop
+ * T = L / (1 + L) at log-spaced FFT bins, and prints one CSV line per
+ * frequency. Gain and phase margins go to stderr, with a warning if the
+ * loop hit an output limit or the motor's +/-1 input range during the
+ * measurement.
+ *
+ * Usage:
+ *   pid_bode [--points N] [--record-log2 N] [--lines-per-record N]
+ *            [--amplitude F] [--settle N] [--threads N]
+ *            [--schedule steal|static] [--NAME VALUE ...] [--output FILE]
+ *
+ *   Lines span 1 / (N dt) to the Nyquist frequency 1 / (2 dt), N being
+ *   the record length 2^record-log2 (default 4096). NAME is any
+ *   sim_config_set() option (kp, ki, kd, lpf, motor-gain, dt, ...); the
+ *   loop is run for --steps steps at the last setpoint before the
+ *   excitation starts. --threads 0 (default) uses one worker per
+ *   processor; records are spread over the workers.
+ *
+ *   Columns: frequency_hz, gain_db, phase_deg (open loop, unwrapped),
+ *   closed_gain_db, closed_phase_deg, sensitivity_db, saturated_steps.
+ */
+
+#include "sim_freq.h"
+#include "sim_thread.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [--points N] [--record-log2 N] [--lines-per-record N]\n"
+            "          [--amplitude F] [--settle N] [--threads N]\n"
+            "          [--schedule steal|static] [--NAME VALUE ...] [--output FILE]\n"
+            "NAME: kp ki kd dt out-min out-max integrator-min integrator-max lpf\n"
+            "      motor-gain motor-alpha steps setpoint profile (STEP:VALUE,...)\n",
+            prog);
+}
+
+int main(int argc, char **argv)
+{
+    static sim_freq_point_t points[SIM_FREQ_MAX_POINTS];
+    sim_config_t base;
+    sim_freq_t freq;
+    sim_freq_t options;
+    sim_freq_margins_t margins;
+    sim_sched_stats_t stats;
+    const char *output = NULL;
+    const char *problem;
+    FILE *out = stdout;
+    unsigned long value_ul = 0;
+    unsigned long threads = 0;
+    unsigned workers;
+    uint32_t lines;
+    uint64_t start_ns;
+    double elapsed;
+    int status = 0;
+    int bad;
+
+    sim_config_defaults(&base);
+    sim_freq_init(&options, &base);
+
+    /* Parse command line */
+    for (int i = 1; i < argc; i++) {
+        const char *name = argv[i] + 2;
+        const char *value;
+
+        if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+            usage(argv[0]);
+            return 0;
+        }
+        if (strncmp(argv[i], "--", 2) != 0 || i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        value = argv[++i];
+
+        if (strcmp(name, "points") == 0) {
+            bad = sim_parse_count(value, SIM_FREQ_MAX_POINTS, &value_ul);
+            options.points = (uint32_t)value_ul;
+        } else if (strcmp(name, "record-log2") == 0) {
+            bad = sim_parse_count(value, SIM_FREQ_MAX_LOG2, &value_ul);
+            options.record_log2 = (uint32_t)value_ul;
+        } else if (strcmp(name, "lines-per-record") == 0) {
+            bad = sim_parse_count(value, SIM_FREQ_MAX_POINTS, &value_ul);
+            options.lines_per_record = (uint32_t)value_ul;
+        } else if (strcmp(name, "settle") == 0) {
+            bad = sim_parse_count(value, 1024ul, &value_ul);
+            options.settle_records = (uint32_t)value_ul;
+        } else if (strcmp(name, "amplitude") == 0) {
+            bad = sim_parse_float(value, &options.amplitude);
+        } else if (strcmp(name, "threads") == 0) {
+            bad = sim_parse_count(value, 4096ul, &threads);
+        } else if (strcmp(name, "schedule") == 0) {
+            bad = 0;
+            if (strcmp(value, "steal") == 0) options.policy = SIM_SCHED_STEAL;
+            else if (strcmp(value, "static") == 0) options.policy = SIM_SCHED_STATIC;
+            else bad = -1;
+        } else if (strcmp(name, "output") == 0) {
+            output = value;
+            bad = 0;
+        } else {
+            bad = sim_config_set(&base, name, value);
+        }
+
+        if (bad != 0) {
+            fprintf(stderr, "Invalid option: --%s %s\n", name, value);
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    freq = options;
+    freq.base = base;
+    problem = sim_freq_validate(&freq);
+    if (problem != NULL) {
+        fprintf(stderr, "Invalid analysis: %s\n", problem);
+        return 1;
+    }
+
+    start_ns = sim_now_ns();
+    workers = sim_freq_run(&freq, (unsigned)threads, points, &stats);
+    elapsed = (double)(sim_now_ns() - start_ns) * 1e-9;
+    if (workers == 0) {
+        fprintf(stderr, "Out of memory for %u-sample records\n", 1u << freq.record_log2);
+        return 1;
+    }
+
+    if (output != NULL) {
+        out = fopen(output, "w");
+        if (out == NULL) {
+            fprintf(stderr, "Cannot open output file: %s\n", output);
+            return 1;
+        }
+    }
+
+    lines = sim_freq_lines(&freq, NULL);
+    fprintf(out, "frequency_hz,gain_db,phase_deg,closed_gain_db,closed_phase_deg,"
+                 "sensitivity_db,saturated_steps\n");
+    for (uint32_t i = 0; i < lines; i++) {
+        const sim_freq_point_t *p = &points[i];
+
+        fprintf(out, "%.6g,%.4f,%.3f,%.4f,%.3f,%.4f,%lu\n",
+                p->frequency, p->gain_db, p->phase_deg, p->closed_gain_db,
+                p->closed_phase_deg,
+                20.0 * log10(hypot(p->sensitivity.re, p->sensitivity.im)),
+                (unsigned long)p->saturated_steps);
+    }
+
+    sim_freq_margins(points, lines, &margins);
+    fprintf(stderr, "pid_bode: %lu lines in %lu records of %u samples, %u workers, %.3f s\n",
+            (unsigned long)lines, (unsigned long)sim_freq_records(&freq),
+            1u << freq.record_log2, workers, elapsed);
+    if (margins.has_gain_margin) {
+        fprintf(stderr, "  gain margin:  %.2f dB at %.4g Hz\n",
+                margins.gain_margin_db, margins.phase_crossover_hz);
+    } else {
+        fprintf(stderr, "  gain margin:  none (phase never reaches -180 deg)\n");
+    }
+    if (margins.has_phase_margin) {
+        fprintf(stderr, "  phase margin: %.2f deg at %.4g Hz\n",
+                margins.phase_margin_deg, margins.gain_crossover_hz);
+    } else {
+        fprintf(stderr, "  phase margin: none (no 0 dB crossover)\n");
+    }
+    fprintf(stderr, "  modulus margin: %.3f (peak sensitivity %.2f dB)\n",
+            margins.modulus_margin, margins.peak_sensitivity_db);
+    if (margins.saturated_steps > 0) {
+        fprintf(stderr, "  warning: output clamped on %lu steps; the loop is not linear "
+                        "at this operating point and the margins are not valid\n",
+                (unsigned long)margins.saturated_steps);
+    }
+
+    if (ferror(out)) {
+        status = 1;
+    }
+    if (out != stdout && fclose(out) != 0) {
+        status = 1;
+    }
+    if (status != 0) {
+        fprintf(stderr, "Failed to write output\n");
+    }
+    return status;
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
@@ -0,0 +1,259 @@
+/**
+ * @file    pid_sim.c
+ * @brief   Command-line closed-loop simulation runner
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * One build serves any number of runs: gains, limits, sample time,
+ * horizon, plant parameters, setpoint profile and output format come
+ * from the command line or a config file instead of the #defines in
+ * main.c. With no options the CSV output is identical to pid_demo.
+ *
+ * Usage:
+ *   pid_sim [--config FILE] [--NAME VALUE ...]
+ *           [--format csv|binary|summary] [--output FILE]
+ *
+ *   NAME is any sim_config_set() option: kp, ki, kd, dt, out-min,
+ *   out-max, integrator-min, integrator-max, lpf, motor-gain,
+ *   motor-alpha, steps, setpoint, profile ("STEP:VALUE,...").
+ *
+ *   A config file holds "name = value" lines using the same names
+ *   (plus format and output); '#' starts a comment. Options apply in
+ *   order, so flags after --config override the file.
+ *
+ *   Formats: csv (step,setpoint,measurement,output), binary (telemetry.h
+ *   stream, for long horizons) or summary (one JSON object of metrics,
+ *   no per-step output, for sweeps).
+ */
+
+#include "sim_core.h"
+#include "telemetry.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+/** Output formats */
+typedef enum {
+    FORMAT_CSV = 0,
+    FORMAT_BINARY,
+    FORMAT_SUMMARY
+} output_format_t;
+
+/** Runner options on top of the simulation config */
+typedef struct {
+    sim_config_t config;
+    output_format_t format;
+    char output[512];          /**< Output path, empty for stdout */
+} runner_t;
+
+/* Binary telemetry writer (64 KiB buffer, kept off the stack) */
+static telemetry_writer_t telemetry;
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [--config FILE] [--NAME VALUE ...]\n"
+            "          [--format csv|binary|summary] [--output FILE]\n"
+            "NAME: kp ki kd dt out-min out-max integrator-min integrator-max lpf\n"
+            "      motor-gain motor-alpha steps setpoint profile (STEP:VALUE,...)\n",
+            prog);
+}
+
+/* Apply one runner or simulation option */
+static int apply_option(runner_t *runner, const char *name, const char *value)
+{
+    if (strcmp(name, "format") == 0) {
+        if (strcmp(value, "csv") == 0) runner->format = FORMAT_CSV;
+        else if (strcmp(value, "binary") == 0) runner->format = FORMAT_BINARY;
+        else if (strcmp(value, "summary") == 0) runner->format = FORMAT_SUMMARY;
+        else return -1;
+        return 0;
+    }
+    if (strcmp(name, "output") == 0) {
+        if (strlen(value) >= sizeof(runner->output)) {
+            return -1;
+        }
+        strcpy(runner->output, value);
+        return 0;
+    }
+    return sim_config_set(&runner->config, name, value);
+}
+
+/* Strip leading and trailing whitespace in place */
+static char *trim(char *text)
+{
+    char *end;
+
+    while (*text == ' ' || *text == '\t') {
+        text++;
+    }
+    end = text + strlen(text);
+    while (end > text && (end[-1] == ' ' || end[-1] == '\t' ||
+                          end[-1] == '\r' || end[-1] == '\n')) {
+        *--end = '\0';
+    }
+    return text;
+}
+
+/* Apply "name = value" lines from a config file */
+static int load_config(runner_t *runner, const char *path)
+{
+    char line[512];
+    int line_number = 0;
+    FILE *file = fopen(path, "r");
+
+    if (file == NULL) {
+        fprintf(stderr, "Cannot open config file: %s\n", path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char *comment = strchr(line, '#');
+        char *equals;
+        char *name;
+
+        line_number++;
+        if (comment != NULL) {
+            *comment = '\0';
+        }
+        name = trim(line);
+        if (*name == '\0') {
+            continue;
+        }
+
+        equals = strchr(name, '=');
+        if (equals != NULL) {
+            *equals = '\0';
+        }
+        if (equals == NULL || apply_option(runner, trim(name), trim(equals + 1)) != 0) {
+            fprintf(stderr, "%s:%d: invalid option\n", path, line_number);
+            fclose(file);
+            return -1;
+        }
+    }
+
+    fclose(file);
+    return 0;
+}
+
+static void write_csv_record(void *context, const telemetry_record_t *record)
+{
+    fprintf((FILE *)context, "%lu,%.4f,%.4f,%.4f\n", (unsigned long)record->step,
+            record->setpoint, record->measurement, record->output);
+}
+
+static void write_binary_record(void *context, const telemetry_record_t *record)
+{
+    telemetry_write((telemetry_writer_t *)context, record->step,
+                    record->setpoint, record->measurement, record->output);
+}
+
+static void write_summary(FILE *out, const sim_config_t *config, const sim_metrics_t *m)
+{
+    fprintf(out,
+            "{\"kp\":%g,\"ki\":%g,\"kd\":%g,\"dt\":%g,\"steps\":%lu,"
+            "\"iae\":%.6g,\"ise\":%.6g,\"itae\":%.6g,\"overshoot_pct\":%.4f,"
+            "\"rise_time\":%g,\"settling_time\":%g,"
+            "\"final_error\":%.6g,\"saturated_steps\":%lu}\n",
+            config->kp, config->ki, config->kd, config->dt, (unsigned long)config->steps,
+            m->iae, m->ise, m->itae, m->overshoot_pct, m->rise_time, m->settling_time,
+            m->final_error, (unsigned long)m->saturated_steps);
+}
+
+int main(int argc, char **argv)
+{
+    runner_t runner;
+    sim_metrics_t metrics;
+    const char *problem;
+    FILE *out = stdout;
+    int status = 0;
+
+    sim_config_defaults(&runner.config);
+    runner.format = FORMAT_CSV;
+    runner.output[0] = '\0';
+
+    /* Parse command line (options apply in order) */
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+            usage(argv[0]);
+            return 0;
+        }
+        if (strncmp(argv[i], "--", 2) != 0 || i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        if (strcmp(argv[i], "--config") == 0) {
+            if (load_config(&runner, argv[++i]) != 0) {
+                return 1;
+            }
+        } else if (apply_option(&runner, argv[i] + 2, argv[i + 1]) != 0) {
+            fprintf(stderr, "Invalid option: %s %s\n", argv[i], argv[i + 1]);
+            usage(argv[0]);
+            return 1;
+        } else {
+            i++;
+        }
+    }
+
+    problem = sim_config_validate(&runner.config);
+    if (problem != NULL) {
+        fprintf(stderr, "Invalid configuration: %s\n", problem);
+        return 1;
+    }
+
+    if (runner.output[0] != '\0') {
+        out = fopen(runner.output, (runner.format == FORMAT_BINARY) ? "wb" : "w");
+        if (out == NULL) {
+            fprintf(stderr, "Cannot open output file: %s\n", runner.output);
+            return 1;
+        }
+    }
+#ifdef _WIN32
+    else if (runner.format == FORMAT_BINARY) {
+        /* Keep the C runtime from translating \n bytes in the stream */
+        _setmode(_fileno(stdout), _O_BINARY);
+    }
+#endif
+
+    switch (runner.format) {
+    case FORMAT_CSV:
+        fprintf(out, "step,setpoint,measurement,output\n");
+        sim_run(&runner.config, write_csv_record, out, &metrics);
+        break;
+    case FORMAT_BINARY:
+        if (telemetry_open(&telemetry, out, runner.config.dt) != 0) {
+            status = 1;
+            break;
+        }
+        sim_run(&runner.config, write_binary_record, &telemetry, &metrics);
+        if (telemetry_close(&telemetry) != 0) {
+            status = 1;
+        }
+        break;
+    case FORMAT_SUMMARY:
+        sim_run(&runner.config, NULL, NULL, &metrics);
+        write_summary(out, &runner.config, &metrics);
+        break;
+    }
+
+    if (ferror(out)) {
+        status = 1;
+    }
+    if (out != stdout && fclose(out) != 0) {
+        status = 1;
+    }
+    if (status != 0) {
+        fprintf(stderr, "Failed to write output\n");
+    }
+    return status;
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
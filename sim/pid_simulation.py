@@ -3,8 +3,9 @@
 PID Controller Simulation and Validation Tool
 
 This script provides desktop simulation and visualization of the PID motor
-controller before embedded hardware deployment. It compiles the firmware
-code, executes it in simulation mode, captures the control loop data, and
+controller before embedded hardware deployment. It compiles the pid_sim
+runner once (rebuilding only when sources change), executes it with the
+requested gains and setpoint profile, captures the control loop data, and
 generates response plots for analysis.
 
 Author:  Onesmo Ogore
@@ -13,17 +14,22 @@ Version: 1.0.0
 License: MIT
 
 Usage:
-    python sim/pid_simulation.py
+    python sim/pid_simulation.py [--kp KP] [--ki KI] [--kd KD] [--dt DT]
+                                 [--steps N] [--setpoint SP | --profile P]
+                                 [--exe PATH] [--rebuild] [--csv]
 
 Output:
-    - sim/log.csv: Raw simulation data (step, setpoint, measurement, output)
+    - sim/log.bin: Binary telemetry (step, setpoint, measurement, output),
+      or sim/log.csv with --csv
     - step_response.png: Visualization of PID step response
 
 Features:
-    - Automatic firmware compilation with GCC
+    - Automatic firmware compilation with GCC, reused across runs
+    - Gains, horizon and setpoint profile set per run (no recompiling)
     - Cross-platform support (Windows, Linux, macOS)
     - CI/CD integration (headless plotting)
     - Step response analysis
+    - Binary telemetry loaded with np.memmap (no text parsing)
     - Control effort visualization
 
 Requirements:
@@ -35,10 +41,13 @@ Requirements:
 SPDX-License-Identifier: MIT
 """
 
+import argparse
+import json
+import struct
 import subprocess
 import sys
 from pathlib import Path
-from typing import Tuple
+from typing import Dict, List, Sequence, Tuple
 
 import numpy as np
 import os
@@ -58,33 +67,75 @@ import matplotlib.pyplot as plt
 ROOT = Path(__file__).resolve().parents[1]   # Repository root
 FIRMWARE_SRC = ROOT / "firmware" / "src"     # C source files
 FIRMWARE_INC = ROOT / "firmware" / "include" # C header files
+SIM_DIR = ROOT / "sim"                       # Simulation runner sources
 BUILD_DIR = ROOT / "build"                   # Build artifacts
-LOG_FILE = ROOT / "sim" / "log.csv"          # Simulation output
+LOG_FILE = ROOT / "sim" / "log.bin"          # Simulation output (binary)
+CSV_LOG_FILE = ROOT / "sim" / "log.csv"      # Simulation output (--csv)
 
 # Platform-specific executable name
-EXE_NAME = "pid_demo.exe" if sys.platform.startswith("win") else "pid_demo"
+EXE_NAME = "pid_sim.exe" if sys.platform.startswith("win") else "pid_sim"
 EXE_PATH = BUILD_DIR / EXE_NAME
 
-# Simulation parameters (must match main.c configuration)
+# Sources of the pid_sim runner (any change triggers a rebuild)
+SIM_SOURCES = [
+    SIM_DIR / "pid_sim.c",                   # Command-line runner
+    SIM_DIR / "sim_core.c",                  # Parameterized closed loop
+    SIM_DIR / "sim_closed.c",                # Closed-form spans (sim_core.c)
+    FIRMWARE_SRC / "pid.c",                  # PID controller implementation
+    FIRMWARE_SRC / "motor.c",                # Motor simulation model
+    FIRMWARE_SRC / "telemetry.c",            # Binary telemetry writer
+]
+
+# Default sample time (matches main.c and pid_sim defaults)
 SAMPLE_TIME_SEC = 0.01  # 10ms control loop period (100Hz)
 
+# Binary telemetry format (must match firmware/include/telemetry.h)
+TELEMETRY_MAGIC = b"PIDT"
+TELEMETRY_VERSION = 1
+TELEMETRY_PREFIX = struct.Struct("<4sHHIf")  # magic, version, header/record size, dt
+LOG_COLUMNS = ("step", "setpoint", "measurement", "output")
+
 #===============================================================================
 # BUILD FUNCTIONS
 #===============================================================================
 
-def build_firmware() -> None:
+def firmware_up_to_date() -> bool:
     """
-    Compile firmware sources into desktop executable.
+    Check whether the pid_sim executable is newer than all its inputs.
+
+    Returns:
+        bool: True if EXE_PATH exists and no source or header is newer
+    """
+    if not EXE_PATH.exists():
+        return False
+    inputs = SIM_SOURCES + list(FIRMWARE_INC.glob("*.h")) + list(SIM_DIR.glob("*.h"))
+    newest = max(path.stat().st_mtime for path in inputs)
+    return EXE_PATH.stat().st_mtime >= newest
 
-    Compiles the PID controller firmware (main.c, pid.c, motor.c) into a
-    standalone executable for desktop simulation. Uses GCC with strict
-    warnings enabled for code quality validation.
+
+def build_firmware(force: bool = False) -> None:
+    """
+    Compile the pid_sim simulation runner into a desktop executable.
+
+    Compiles the runner (pid_sim.c, sim_core.c, sim_closed.c) with the
+    firmware it simulates (pid.c, motor.c, telemetry.c). Gains, horizon
+    and setpoint are runtime options of pid_sim, so the build is reused
+    across runs and only repeated when a source or header changes. Uses
+    GCC with strict warnings enabled for code quality validation. The
+    Sim_Script_Sources test (tests/check_sim_sources.py) links
+    SIM_SOURCES, so a missing source fails ctest rather than this script.
 
     Compiler flags:
-        -Wall:   Enable all common warnings
-        -Wextra: Enable extra warnings beyond -Wall
-        -Werror: Treat warnings as errors (ensures clean code)
-        -I:      Include directory for headers
+        -std=c99: Strict C99 (GNU mode declares a POSIX pid_t that
+                  clashes with the controller type)
+        -O2:      Optimize (long horizons, many runs)
+        -Wall:    Enable all common warnings
+        -Wextra:  Enable extra warnings beyond -Wall
+        -Werror:  Treat warnings as errors (ensures clean code)
+        -I:       Include directories for headers
+
+    Args:
+        force: Rebuild even if the executable is up to date
 
     Raises:
         SystemExit: If compilation fails (non-zero return code)
@@ -94,20 +145,27 @@ def build_firmware() -> None:
         - Generates executable at BUILD_DIR/EXE_NAME
         - Prints build commands and status to stdout
     """
+    if not force and firmware_up_to_date():
+        print(f"[OK] Reusing up-to-date build: {EXE_PATH}")
+        print()
+        return
+
     BUILD_DIR.mkdir(exist_ok=True)
 
     # GCC compilation command
     cmd = [
         "gcc",
+        "-std=c99",                       # Strict C99
+        "-O2",                            # Optimize
         "-Wall",                          # Enable all warnings
         "-Wextra",                        # Enable extra warnings
         "-Werror",                        # Treat warnings as errors
-        f"-I{FIRMWARE_INC}",              # Include path for headers
-        str(FIRMWARE_SRC / "main.c"),     # Main application
-        str(FIRMWARE_SRC / "pid.c"),      # PID controller implementation
-        str(FIRMWARE_SRC / "motor.c"),    # Motor simulation model
+        f"-I{FIRMWARE_INC}",              # Include path for firmware headers
+        f"-I{SIM_DIR}",                   # Include path for sim_core.h
+        *[str(src) for src in SIM_SOURCES],
         "-o",
         str(EXE_PATH),                    # Output executable path
+        "-lm",                            # Math library
     ]
 
     print("=" * 70)
@@ -133,16 +191,64 @@ def build_firmware() -> None:
 # SIMULATION FUNCTIONS
 #===============================================================================
 
-def run_firmware_and_capture_log() -> None:
+def sim_args(params: Dict[str, object]) -> List[str]:
+    """
+    Convert simulation parameters to pid_sim command-line options.
+
+    Keys use Python spelling (underscores), e.g. {"kp": 1.2,
+    "motor_gain": 4.0, "profile": "0:3,250:-1"}; None values are skipped.
+
+    Args:
+        params: Option names (see sim/sim_core.h) mapped to values
+
+    Returns:
+        list: Arguments such as ["--kp", "1.2", "--motor-gain", "4.0"]
+    """
+    args: List[str] = []
+    for name, value in params.items():
+        if value is not None:
+            args += ["--" + name.replace("_", "-"), str(value)]
+    return args
+
+
+def run_summary(params: Dict[str, object], exe: Path = EXE_PATH) -> Dict[str, float]:
+    """
+    Run one simulation and return its metrics without logging samples.
+
+    Intended for sweeps: each call is a single pid_sim process with
+    --format summary, no compilation and no per-step output.
+
+    Args:
+        params: Simulation parameters (see sim_args())
+        exe: pid_sim executable
+
+    Returns:
+        dict: Metrics (iae, ise, itae, overshoot_pct, rise_time,
+              settling_time, final_error, saturated_steps) and the gains
+              that produced them
+
+    Raises:
+        subprocess.CalledProcessError: If pid_sim rejects the parameters
+    """
+    result = subprocess.run(
+        [str(exe), *sim_args(params), "--format", "summary"],
+        capture_output=True, text=True, check=True,
+    )
+    return json.loads(result.stdout)
+
+
+def run_firmware_and_capture_log(log_file: Path = LOG_FILE,
+                                 options: Sequence[str] = (),
+                                 exe: Path = EXE_PATH) -> None:
     """
     Execute firmware simulation and capture control loop data.
 
-    Runs the compiled firmware executable, which simulates the PID motor
-    control loop. The program outputs CSV-formatted data (step, setpoint,
-    measurement, output) to stdout, which is redirected to log.csv.
+    Runs the pid_sim executable, which simulates the PID motor control
+    loop, and writes (step, setpoint, measurement, output) records to
+    log_file: binary telemetry for a .bin file, CSV otherwise.
 
-    The simulation runs for NUM_CONTROL_ITERATIONS steps (defined in main.c),
-    typically 1000 steps = 10 seconds at 10ms sample time.
+    Without options the run matches the main.c demo: 500 steps = 5 seconds
+    at 10ms sample time, setpoint 3.0.
 
     Output format (CSV with header):
         step,setpoint,measurement,output
@@ -150,35 +256,42 @@ def run_firmware_and_capture_log() -> None:
         1, 3.0000, 0.0096, 2.2400
         ...
 
+    Args:
+        log_file: Destination file; the suffix selects the format
+        options: Extra pid_sim options (see sim_args())
+        exe: pid_sim executable
+
     Raises:
         FileNotFoundError: If executable doesn't exist (build first)
         SystemExit: If simulation fails (non-zero return code)
 
     Side effects:
-        - Creates/overwrites sim/log.csv with simulation data
+        - Creates/overwrites log_file with simulation data
         - Prints execution status to stdout
     """
-    if not EXE_PATH.exists():
+    if not exe.exists():
         raise FileNotFoundError(
-            f"Executable not found: {EXE_PATH}\n"
+            f"Executable not found: {exe}\n"
             f"Run build_firmware() first."
         )
 
     print("=" * 70)
     print("Running firmware simulation...")
     print("=" * 70)
-    print(f"Executable: {EXE_PATH}")
-    print(f"Output:     {LOG_FILE}")
+    print(f"Executable: {exe}")
+    print(f"Options:    {' '.join(options) or '(defaults)'}")
+    print(f"Output:     {log_file}")
     print()
 
-    with LOG_FILE.open("w", encoding="utf-8") as f:
-        # Redirect stdout of firmware executable directly to log.csv
-        result = subprocess.run(
-            [str(EXE_PATH)],
-            stdout=f,                    # Capture stdout to file
-            stderr=subprocess.PIPE,      # Capture stderr for error handling
-            text=True,
-        )
+    output_format = "binary" if log_file.suffix == ".bin" else "csv"
+    cmd = [str(exe), *options, "--format", output_format, "--output", str(log_file)]
+
+    result = subprocess.run(
+        cmd,
+        stdout=subprocess.PIPE,          # Nothing expected on stdout
+        stderr=subprocess.PIPE,          # Capture stderr for error handling
+        text=True,
+    )
 
     if result.returncode != 0:
         print("[FAIL] SIMULATION FAILED")
@@ -186,19 +299,68 @@ def run_firmware_and_capture_log() -> None:
         print(result.stderr)
         raise SystemExit(result.returncode)
 
-    print(f"[OK] Simulation complete: {LOG_FILE}")
+    print(f"[OK] Simulation complete: {log_file}")
     print()
 
 #===============================================================================
 # DATA ANALYSIS FUNCTIONS
 #===============================================================================
 
-def load_log() -> Tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray]:
+def load_binary_log(log_file: Path = LOG_FILE) -> np.ndarray:
     """
-    Load and parse simulation data from CSV log file.
+    Memory-map a binary telemetry log (pid_demo --binary, pid_sim --format binary).
+
+    Parses the self-describing header (see firmware/include/telemetry.h)
+    and maps the records as a numpy structured array without reading or
+    parsing them, so multi-million-step logs load instantly. A trailing
+    partial record (e.g. from an interrupted run) is ignored.
+
+    Args:
+        log_file: Path to the binary log
+
+    Returns:
+        np.memmap: Structured array with one field per logged column
+
+    Raises:
+        FileNotFoundError: If the log file doesn't exist
+        ValueError: If the header is invalid or the layout is unexpected
+    """
+    with log_file.open("rb") as f:
+        prefix = f.read(TELEMETRY_PREFIX.size)
+        if len(prefix) < TELEMETRY_PREFIX.size:
+            raise ValueError(f"Truncated telemetry header in {log_file}")
+        magic, version, header_size, record_size, _ = TELEMETRY_PREFIX.unpack(prefix)
+        if magic != TELEMETRY_MAGIC or version != TELEMETRY_VERSION:
+            raise ValueError(
+                f"Not a version {TELEMETRY_VERSION} telemetry file: {log_file}"
+            )
+        layout = f.read(header_size - TELEMETRY_PREFIX.size).split(b"\0", 1)[0]
+
+    # "name:type,..." -> little-endian structured dtype
+    fields = [item.split(":") for item in layout.decode("ascii").split(",")]
+    dtype = np.dtype([(name, "<" + code) for name, code in fields])
+    if dtype.itemsize != record_size:
+        raise ValueError(
+            f"Record size mismatch in {log_file}: header says {record_size}, "
+            f"layout '{layout.decode('ascii')}' gives {dtype.itemsize}"
+        )
+
+    num_records = (log_file.stat().st_size - header_size) // record_size
+    if num_records <= 0:
+        raise ValueError(f"No records in {log_file}")
+
+    return np.memmap(log_file, dtype=dtype, mode="r",
+                     offset=header_size, shape=(num_records,))
 
-    Reads the CSV output from the firmware simulation and extracts the
-    four data columns into numpy arrays for analysis and plotting.
+
+def load_log(log_file: Path = LOG_FILE,
+             dt: float = SAMPLE_TIME_SEC) -> Tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray]:
+    """
+    Load simulation data from a binary or CSV log file.
+
+    Binary logs (.bin) are memory-mapped with load_binary_log(); CSV logs
+    are parsed with np.loadtxt. The four data columns are returned as
+    numpy arrays for analysis and plotting.
 
     CSV format (with header):
         Header: step,setpoint,measurement,output
@@ -207,12 +369,16 @@ def load_log() -> Tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray]:
         Column 2: Measurement (actual motor speed)
         Column 3: Control output (PID output, duty cycle)
 
+    Args:
+        log_file: Path to the log; the suffix selects the format
+        dt: Sample time of the run, in seconds (for the summary)
+
     Returns:
         tuple: (step, setpoint, speed, control) as numpy arrays
 
     Raises:
-        FileNotFoundError: If log.csv doesn't exist
-        ValueError: If CSV format is invalid or empty
+        FileNotFoundError: If the log file doesn't exist
+        ValueError: If the file format is invalid or empty
 
     Example:
         >>> step, setpoint, speed, control = load_log()
@@ -222,19 +388,25 @@ def load_log() -> Tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray]:
     print("=" * 70)
     print("Loading simulation data...")
     print("=" * 70)
-    print(f"File: {LOG_FILE}")
+    print(f"File: {log_file}")
 
-    try:
-        # Load CSV data (delimiter=comma, skip header row)
-        data = np.loadtxt(LOG_FILE, delimiter=",", skiprows=1)
-    except FileNotFoundError:
+    if not log_file.exists():
         raise FileNotFoundError(
-            f"Log file not found: {LOG_FILE}\n"
+            f"Log file not found: {log_file}\n"
             f"Run run_firmware_and_capture_log() first."
         )
+
+    if log_file.suffix == ".bin":
+        records = load_binary_log(log_file)
+        # Column views into the mapping; arithmetic below promotes as needed
+        return _report_columns(*(records[name] for name in LOG_COLUMNS), dt)
+
+    try:
+        # Load CSV data (delimiter=comma, skip header row)
+        data = np.loadtxt(log_file, delimiter=",", skiprows=1)
     except ValueError as e:
         raise ValueError(
-            f"Invalid CSV format in {LOG_FILE}\n"
+            f"Invalid CSV format in {log_file}\n"
             f"Expected: step,setpoint,measurement,output\n"
             f"Error: {e}"
         )
@@ -252,8 +424,17 @@ def load_log() -> Tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray]:
     speed = data[:, 2]      # Measured speed (process variable)
     control = data[:, 3]    # Control output (manipulated variable)
 
+    return _report_columns(step, setpoint, speed, control, dt)
+
+
+def _report_columns(step: np.ndarray,
+                    setpoint: np.ndarray,
+                    speed: np.ndarray,
+                    control: np.ndarray,
+                    dt: float) -> Tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray]:
+    """Print a summary of loaded log columns and return them unchanged."""
     print(f"[OK] Loaded {len(step)} data points")
-    print(f"     Time span: {len(step) * SAMPLE_TIME_SEC:.2f} seconds")
+    print(f"     Time span: {len(step) * dt:.2f} seconds")
     print(f"     Setpoint range: [{setpoint.min():.3f}, {setpoint.max():.3f}]")
     print(f"     Speed range: [{speed.min():.3f}, {speed.max():.3f}]")
     print(f"     Control range: [{control.min():.3f}, {control.max():.3f}]")
@@ -268,7 +449,8 @@ def load_log() -> Tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray]:
 def plot_response(step: np.ndarray,
                   setpoint: np.ndarray,
                   speed: np.ndarray,
-                  control: np.ndarray) -> None:
+                  control: np.ndarray,
+                  dt: float = SAMPLE_TIME_SEC) -> None:
     """
     Generate and save PID step response plots.
 
@@ -288,6 +470,7 @@ def plot_response(step: np.ndarray,
         setpoint: Target speed array
         speed: Measured speed array (process variable)
         control: Control output array (manipulated variable)
+        dt: Sample time of the run, in seconds
 
     Side effects:
         - Creates step_response.png in current directory
@@ -305,8 +488,7 @@ def plot_response(step: np.ndarray,
     print("=" * 70)
 
     # Convert step index to time (seconds)
-    # Assumes SAMPLE_TIME_SEC matches the dt in main.c
-    time = step * SAMPLE_TIME_SEC
+    time = step * dt
 
     # Create figure with two subplots
     fig, (ax1, ax2) = plt.subplots(2, 1, figsize=(10, 8))
@@ -357,7 +539,7 @@ def plot_response(step: np.ndarray,
     # Calculate control statistics
     control_mean = control.mean()
     control_std = control.std()
-    saturation_time = np.sum(np.abs(control) >= 0.99) * SAMPLE_TIME_SEC
+    saturation_time = np.sum(np.abs(control) >= 0.99) * dt
 
     # Add control statistics text box
     control_text = (
@@ -392,13 +574,14 @@ def plot_response(step: np.ndarray,
 # MAIN PROGRAM
 #===============================================================================
 
-def main() -> None:
+def main(argv=None) -> None:
     """
     Main simulation workflow.
 
     Executes the complete PID simulation pipeline:
-    1. Compile firmware sources to desktop executable
-    2. Run simulation and capture control loop data
+    1. Compile firmware sources to desktop executable (skipped when the
+       existing build is up to date or --exe is given)
+    2. Run simulation with the requested parameters and capture data
     3. Load and parse simulation results
     4. Generate performance analysis plots
 
@@ -409,9 +592,37 @@ def main() -> None:
     - Performance analysis
     - Documentation generation
 
+    Args:
+        argv: Command-line arguments (defaults to sys.argv[1:])
+
     Raises:
         SystemExit: If any step fails (build, simulation, or plotting)
     """
+    parser = argparse.ArgumentParser(description="PID controller simulation tool")
+    parser.add_argument("--csv", action="store_true",
+                        help="log as CSV (sim/log.csv) instead of binary telemetry")
+    parser.add_argument("--exe", type=Path,
+                        help="use an existing pid_sim (e.g. build/pid_sim) instead of compiling")
+    parser.add_argument("--rebuild", action="store_true",
+                        help="recompile even if the build is up to date")
+    parser.add_argument("--kp", type=float, help="proportional gain (default 0.8)")
+    parser.add_argument("--ki", type=float, help="integral gain (default 0.3)")
+    parser.add_argument("--kd", type=float, help="derivative gain (default 0.05)")
+    parser.add_argument("--dt", type=float, default=SAMPLE_TIME_SEC,
+                        help="sample time in seconds (default 0.01)")
+    parser.add_argument("--steps", type=int, help="number of control steps (default 500)")
+    target = parser.add_mutually_exclusive_group()
+    target.add_argument("--setpoint", type=float, help="constant setpoint (default 3.0)")
+    target.add_argument("--profile",
+                        help="piecewise-constant setpoint, e.g. 0:3,2500:-1.5")
+    args = parser.parse_args(argv)
+    log_file = CSV_LOG_FILE if args.csv else LOG_FILE
+    options = sim_args({
+        "kp": args.kp, "ki": args.ki, "kd": args.kd, "dt": args.dt,
+        "steps": args.steps, "setpoint": args.setpoint, "profile": args.profile,
+    })
+    exe = args.exe if args.exe is not None else EXE_PATH
+
     print()
     print("=" * 70)
     print("PID CONTROLLER SIMULATION TOOL")
@@ -419,24 +630,25 @@ def main() -> None:
     print()
 
     try:
-        # Step 1: Build firmware for desktop
-        build_firmware()
+        # Step 1: Build firmware for desktop (reused when up to date)
+        if args.exe is None:
+            build_firmware(force=args.rebuild)
 
         # Step 2: Run simulation
-        run_firmware_and_capture_log()
+        run_firmware_and_capture_log(log_file, options, exe)
 
         # Step 3: Load results
-        step, setpoint, speed, control = load_log()
+        step, setpoint, speed, control = load_log(log_file, args.dt)
 
         # Step 4: Visualize performance
-        plot_response(step, setpoint, speed, control)
+        plot_response(step, setpoint, speed, control, args.dt)
 
         print("=" * 70)
         print("SIMULATION COMPLETE - SUCCESS")
         print("=" * 70)
         print()
         print("Output files:")
-        print(f"  - {LOG_FILE}")
+        print(f"  - {log_file}")
         print(f"  - step_response.png")
         print()
 
@@ -0,0 +1,587 @@
+/**
+ * @file    sim_closed.c
+ * @brief   Implementation of the closed-form linear loop evaluator
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Poles are the roots of the characteristic polynomial of A
+ * (Faddeev-LeVerrier, then Durand-Kerner). Rather than computing
+ * eigenvectors, each signal is fitted to its modes from the first
+ * order + 1 steps of the linear map (a Vandermonde solve, checked
+ * against the extra step), which is all the span sums need. Everything
+ * runs in double so the closed form is more accurate than the float
+ * loop it replaces.
+ *
+ * Build as strict C99 (no GNU extensions): see sim_core.c.
+ */
+
+#include "sim_closed.h"
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+/* Signals fitted per span: the state variables, then PID output and
+ * updated integrator */
+#define MAX_SIGNALS   (SIM_CLOSED_MAX_ORDER + 2u)
+
+/* Closest two poles may be before the modal fit is ill-conditioned */
+#define MIN_POLE_GAP  1e-6
+
+/* Relative mismatch of the fit at the check step */
+#define FIT_TOLERANCE 1e-9
+
+/* Widening of span bounds for the float rounding of the stepped loop */
+#define BOUND_MARGIN  1e-5
+
+/*----------------------------------------------------------------------------*/
+/* Complex arithmetic                                                        */
+/*----------------------------------------------------------------------------*/
+
+static sim_complex_t cplx(double re, double im)
+{
+    sim_complex_t z;
+    z.re = re;
+    z.im = im;
+    return z;
+}
+
+static sim_complex_t cadd(sim_complex_t a, sim_complex_t b)
+{
+    return cplx(a.re + b.re, a.im + b.im);
+}
+
+static sim_complex_t csub(sim_complex_t a, sim_complex_t b)
+{
+    return cplx(a.re - b.re, a.im - b.im);
+}
+
+static sim_complex_t cmul(sim_complex_t a, sim_complex_t b)
+{
+    return cplx(a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re);
+}
+
+static sim_complex_t cscale(sim_complex_t a, double s)
+{
+    return cplx(a.re * s, a.im * s);
+}
+
+static sim_complex_t cdiv(sim_complex_t a, sim_complex_t b)
+{
+    double d = b.re * b.re + b.im * b.im;
+    return cplx((a.re * b.re + a.im * b.im) / d, (a.im * b.re - a.re * b.im) / d);
+}
+
+static double cabs_(sim_complex_t a)
+{
+    return hypot(a.re, a.im);
+}
+
+/* z^n in polar form (cost independent of n) */
+static sim_complex_t cpow_n(sim_complex_t z, double n)
+{
+    double r = cabs_(z);
+    double angle;
+
+    if (n == 0.0) {
+        return cplx(1.0, 0.0);
+    }
+    if (r == 0.0) {
+        return cplx(0.0, 0.0);
+    }
+    r = pow(r, n);
+    angle = atan2(z.im, z.re) * n;
+    return cplx(r * cos(angle), r * sin(angle));
+}
+
+/* sum_{m<n} z^m */
+static sim_complex_t geometric_sum(sim_complex_t z, double n)
+{
+    sim_complex_t one = cplx(1.0, 0.0);
+
+    if (z.re == 1.0 && z.im == 0.0) {
+        return cplx(n, 0.0);
+    }
+    return cdiv(csub(one, cpow_n(z, n)), csub(one, z));
+}
+
+/* sum_{m<n} m z^m = (z - n z^n + (n-1) z^(n+1)) / (1-z)^2 */
+static sim_complex_t weighted_geometric_sum(sim_complex_t z, double n)
+{
+    sim_complex_t one_minus, zn, num;
+
+    if (z.re == 1.0 && z.im == 0.0) {
+        return cplx(0.5 * n * (n - 1.0), 0.0);
+    }
+    one_minus = csub(cplx(1.0, 0.0), z);
+    zn = cpow_n(z, n);
+    num = cadd(csub(z, cscale(zn, n)), cscale(cmul(zn, z), n - 1.0));
+    return cdiv(num, cmul(one_minus, one_minus));
+}
+
+/*----------------------------------------------------------------------------*/
+/* Linear algebra                                                            */
+/*----------------------------------------------------------------------------*/
+
+/* Solve m x = rhs in place (n <= SIM_CLOSED_MAX_ORDER); -1 if singular */
+static int solve_real(double m[SIM_CLOSED_MAX_ORDER][SIM_CLOSED_MAX_ORDER],
+                      double rhs[SIM_CLOSED_MAX_ORDER], unsigned n)
+{
+    for (unsigned col = 0; col < n; col++) {
+        unsigned pivot = col;
+        for (unsigned r = col + 1; r < n; r++) {
+            if (fabs(m[r][col]) > fabs(m[pivot][col])) pivot = r;
+        }
+        if (fabs(m[pivot][col]) < 1e-12) {
+            return -1;
+        }
+        for (unsigned c = 0; c < n; c++) {
+            double t = m[col][c]; m[col][c] = m[pivot][c]; m[pivot][c] = t;
+        }
+        double t = rhs[col]; rhs[col] = rhs[pivot]; rhs[pivot] = t;
+
+        for (unsigned r = col + 1; r < n; r++) {
+            double f = m[r][col] / m[col][col];
+            for (unsigned c = col; c < n; c++) m[r][c] -= f * m[col][c];
+            rhs[r] -= f * rhs[col];
+        }
+    }
+    for (unsigned r = n; r-- > 0;) {
+        for (unsigned c = r + 1; c < n; c++) rhs[r] -= m[r][c] * rhs[c];
+        rhs[r] /= m[r][r];
+    }
+    return 0;
+}
+
+/* Solve v c = rhs for @p count right-hand sides (columns); -1 if singular */
+static int solve_complex(sim_complex_t v[SIM_CLOSED_MAX_ORDER][SIM_CLOSED_MAX_ORDER],
+                         sim_complex_t rhs[SIM_CLOSED_MAX_ORDER][MAX_SIGNALS],
+                         unsigned n, unsigned count)
+{
+    for (unsigned col = 0; col < n; col++) {
+        unsigned pivot = col;
+        for (unsigned r = col + 1; r < n; r++) {
+            if (cabs_(v[r][col]) > cabs_(v[pivot][col])) pivot = r;
+        }
+        if (cabs_(v[pivot][col]) < 1e-300) {
+            return -1;
+        }
+        for (unsigned c = 0; c < n; c++) {
+            sim_complex_t t = v[col][c]; v[col][c] = v[pivot][c]; v[pivot][c] = t;
+        }
+        for (unsigned s = 0; s < count; s++) {
+            sim_complex_t t = rhs[col][s]; rhs[col][s] = rhs[pivot][s]; rhs[pivot][s] = t;
+        }
+
+        for (unsigned r = col + 1; r < n; r++) {
+            sim_complex_t f = cdiv(v[r][col], v[col][col]);
+            for (unsigned c = col; c < n; c++) v[r][c] = csub(v[r][c], cmul(f, v[col][c]));
+            for (unsigned s = 0; s < count; s++) rhs[r][s] = csub(rhs[r][s], cmul(f, rhs[col][s]));
+        }
+    }
+    for (unsigned r = n; r-- > 0;) {
+        for (unsigned s = 0; s < count; s++) {
+            for (unsigned c = r + 1; c < n; c++) rhs[r][s] = csub(rhs[r][s], cmul(v[r][c], rhs[c][s]));
+            rhs[r][s] = cdiv(rhs[r][s], v[r][r]);
+        }
+    }
+    return 0;
+}
+
+/* Monic characteristic polynomial: coef[n] = 1, det(zI - A) = sum coef[k] z^k */
+static void characteristic_polynomial(const sim_closed_model_t *model, double coef[SIM_CLOSED_MAX_ORDER + 1])
+{
+    unsigned n = model->order;
+    double m[SIM_CLOSED_MAX_ORDER][SIM_CLOSED_MAX_ORDER];
+    double am[SIM_CLOSED_MAX_ORDER][SIM_CLOSED_MAX_ORDER];
+
+    /* Faddeev-LeVerrier: M_k = A M_(k-1) + coef[n-k+1] I, coef[n-k] = -tr(A M_k) / k */
+    memset(m, 0, sizeof(m));
+    coef[n] = 1.0;
+    for (unsigned k = 1; k <= n; k++) {
+        double trace = 0.0;
+
+        for (unsigned r = 0; r < n; r++) {
+            for (unsigned c = 0; c < n; c++) {
+                double sum = 0.0;
+                for (unsigned j = 0; j < n; j++) sum += model->a[r][j] * m[j][c];
+                am[r][c] = sum;
+            }
+        }
+        for (unsigned r = 0; r < n; r++) {
+            for (unsigned c = 0; c < n; c++) m[r][c] = am[r][c];
+            m[r][r] += coef[n - k + 1];
+        }
+        for (unsigned r = 0; r < n; r++) {
+            for (unsigned j = 0; j < n; j++) trace += model->a[r][j] * m[j][r];
+        }
+        coef[n - k] = -trace / (double)k;
+    }
+}
+
+static sim_complex_t poly_eval(const double *coef, unsigned n, sim_complex_t z)
+{
+    sim_complex_t p = cplx(coef[n], 0.0);
+    for (unsigned k = n; k-- > 0;) {
+        p = cadd(cmul(p, z), cplx(coef[k], 0.0));
+    }
+    return p;
+}
+
+/* Durand-Kerner iteration on a monic polynomial of degree n */
+static void poly_roots(const double *coef, unsigned n, sim_complex_t *root)
+{
+    sim_complex_t seed = cplx(0.4, 0.9);
+    sim_complex_t z = cplx(1.0, 0.0);
+
+    for (unsigned i = 0; i < n; i++) {
+        root[i] = z;
+        z = cmul(z, seed);
+    }
+    for (int iter = 0; iter < 500; iter++) {
+        double delta = 0.0;
+
+        for (unsigned i = 0; i < n; i++) {
+            sim_complex_t den = cplx(1.0, 0.0);
+            sim_complex_t step;
+
+            for (unsigned j = 0; j < n; j++) {
+                if (j != i) den = cmul(den, csub(root[i], root[j]));
+            }
+            step = cdiv(poly_eval(coef, n, root[i]), den);
+            root[i] = csub(root[i], step);
+            if (cabs_(step) > delta) delta = cabs_(step);
+        }
+        if (delta < 1e-15) {
+            break;
+        }
+    }
+    /* Real roots come out with rounding-level imaginary parts */
+    for (unsigned i = 0; i < n; i++) {
+        if (fabs(root[i].im) < 1e-9 * (1.0 + fabs(root[i].re))) {
+            root[i].im = 0.0;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/* State packing                                                             */
+/*----------------------------------------------------------------------------*/
+
+static void pack(const sim_closed_model_t *model, const sim_closed_state_t *state, double *x)
+{
+    unsigned i = 2;
+
+    x[0] = state->speed;
+    x[1] = state->prev_measurement;
+    if (model->has_integrator) x[i++] = state->integrator;
+    if (model->has_filter) x[i] = state->derivative_filtered;
+}
+
+/* Variables that are not states keep their value in @p state */
+static void unpack(const sim_closed_model_t *model, const double *x, sim_closed_state_t *state)
+{
+    unsigned i = 2;
+
+    state->speed = x[0];
+    state->prev_measurement = x[1];
+    if (model->has_integrator) state->integrator = x[i++];
+    if (model->has_filter) state->derivative_filtered = x[i];
+}
+
+static double affine(const double *form, const double *x, unsigned n)
+{
+    double sum = form[n];
+    for (unsigned j = 0; j < n; j++) sum += form[j] * x[j];
+    return sum;
+}
+
+static void apply_map(const sim_closed_model_t *model, const double *x, double *next)
+{
+    for (unsigned r = 0; r < model->order; r++) {
+        next[r] = model->b[r];
+        for (unsigned c = 0; c < model->order; c++) next[r] += model->a[r][c] * x[c];
+    }
+}
+
+/* Bounds s* +/- sum |c_i|, widened for float rounding */
+static void bounds(double steady, const sim_complex_t *coef, unsigned n, double *lo, double *hi)
+{
+    double spread = 0.0;
+    double margin;
+
+    for (unsigned i = 0; i < n; i++) spread += cabs_(coef[i]);
+    margin = BOUND_MARGIN * (1.0 + fabs(steady) + spread);
+    *lo = steady - spread - margin;
+    *hi = steady + spread + margin;
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+/**
+ * @brief Build the linear closed loop of a configuration at one setpoint
+ *
+ * See detailed documentation in sim_closed.h
+ *
+ * Implementation notes (affine forms over x, constant term last):
+ * - e = r - speed, I' = I + e dt, d = (prev_measurement - speed) / dt
+ * - Filtered: D = kd (lpf f + (1 - lpf) d), f' = that filtered value
+ * - u = kp e + ki I' + D; speed' = speed + alpha (gain u - speed)
+ * - With ki = 0 the integrator does not reach the output and is left
+ *   out of the state (it would add a pole at 1)
+ */
+int sim_closed_model_init(sim_closed_model_t *model, const sim_config_t *config, float setpoint)
+{
+    double e[SIM_CLOSED_MAX_ORDER + 1] = { 0 };
+    double draw[SIM_CLOSED_MAX_ORDER + 1] = { 0 };
+    double filt[SIM_CLOSED_MAX_ORDER + 1] = { 0 };
+    double m[SIM_CLOSED_MAX_ORDER][SIM_CLOSED_MAX_ORDER];
+    double coef[SIM_CLOSED_MAX_ORDER + 1];
+    const double *deriv = draw;
+    double dt, lpf, gain, alpha;
+    unsigned n = 2, ii = 0, fi = 0;
+
+    assert(model != NULL && config != NULL && "Model and config cannot be NULL");
+
+    memset(model, 0, sizeof(*model));
+    model->has_integrator = (config->ki != 0.0f);
+    model->has_filter = (config->derivative_lpf > 0.0f);
+    if (model->has_integrator) ii = n++;
+    if (model->has_filter) fi = n++;
+    model->order = n;
+    model->setpoint = setpoint;
+    model->dt = dt = config->dt;
+    lpf = config->derivative_lpf;
+    gain = config->motor_gain;
+    alpha = config->motor_alpha;
+
+    e[0] = -1.0;
+    e[n] = model->setpoint;
+    draw[0] = -1.0 / dt;
+    draw[1] = 1.0 / dt;
+
+    for (unsigned j = 0; j <= n; j++) model->integ[j] = dt * e[j];
+    if (model->has_integrator) model->integ[ii] += 1.0;
+
+    if (model->has_filter) {
+        for (unsigned j = 0; j <= n; j++) filt[j] = (1.0 - lpf) * draw[j];
+        filt[fi] += lpf;
+        deriv = filt;
+    }
+
+    for (unsigned j = 0; j <= n; j++) {
+        model->out[j] = config->kp * e[j] + config->ki * model->integ[j] + config->kd * deriv[j];
+    }
+
+    /* speed' = (1 - alpha) speed + alpha gain u */
+    for (unsigned j = 0; j < n; j++) model->a[0][j] = alpha * gain * model->out[j];
+    model->a[0][0] += 1.0 - alpha;
+    model->b[0] = alpha * gain * model->out[n];
+    model->a[1][0] = 1.0;
+    if (model->has_integrator) {
+        for (unsigned j = 0; j < n; j++) model->a[ii][j] = model->integ[j];
+        model->b[ii] = model->integ[n];
+    }
+    if (model->has_filter) {
+        for (unsigned j = 0; j < n; j++) model->a[fi][j] = filt[j];
+        model->b[fi] = filt[n];
+    }
+
+    /* Fixed point: (I - A) x* = b */
+    for (unsigned r = 0; r < n; r++) {
+        for (unsigned c = 0; c < n; c++) m[r][c] = ((r == c) ? 1.0 : 0.0) - model->a[r][c];
+        model->equilibrium[r] = model->b[r];
+    }
+    if (solve_real(m, model->equilibrium, n) != 0) {
+        return -1;
+    }
+
+    characteristic_polynomial(model, coef);
+    poly_roots(coef, n, model->pole);
+    for (unsigned i = 0; i < n; i++) {
+        if (!(cabs_(model->pole[i]) <= SIM_CLOSED_MAX_POLE)) {
+            return -1;
+        }
+        for (unsigned j = 0; j < i; j++) {
+            if (cabs_(csub(model->pole[i], model->pole[j])) < MIN_POLE_GAP) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+void sim_closed_step(const sim_closed_model_t *model, sim_closed_state_t *state)
+{
+    double x[SIM_CLOSED_MAX_ORDER], next[SIM_CLOSED_MAX_ORDER];
+
+    assert(model != NULL && state != NULL && "Model and state cannot be NULL");
+
+    pack(model, state, x);
+    apply_map(model, x, next);
+    if (!model->has_integrator) {
+        state->integrator += model->dt * (model->setpoint - x[0]);
+    }
+    unpack(model, next, state);
+}
+
+/**
+ * @brief Evaluate N steps of the linear loop in closed form
+ *
+ * See detailed documentation in sim_closed.h
+ *
+ * Implementation notes:
+ * - Signal s (state variables, output, updated integrator) is fitted as
+ *   s[m] = s* + sum_i c_i p_i^m from steps 0..order-1 and checked at
+ *   step order; the fit is exact in exact arithmetic
+ * - Bounds: |s[m] - s*| <= sum_i |c_i| |p_i|^m <= sum_i |c_i|
+ * - Error sign: with s* treated as a mode at 1, if the slowest mode is
+ *   real and positive and |c_0| > sum of the other |c_i|, the other
+ *   modes decay at least as fast and can never flip the sign
+ * - Sums use closed-form geometric series per mode (pairs of modes for
+ *   the squared error)
+ * - Without an integrator state, the integrator is advanced by
+ *   dt * sum(e) without clamping; it does not reach the output
+ */
+int sim_closed_span(const sim_closed_model_t *model, const sim_closed_state_t *state,
+                    uint32_t steps, sim_closed_span_t *span)
+{
+    const unsigned n = model->order;
+    const unsigned count = n + 2u;       /* Signals: states, output, integrator */
+    const unsigned out_sig = n, integ_sig = n + 1u;
+    double x[SIM_CLOSED_MAX_ORDER], next[SIM_CLOSED_MAX_ORDER];
+    double sample[SIM_CLOSED_MAX_ORDER + 1][MAX_SIGNALS];
+    double steady[MAX_SIGNALS];
+    sim_complex_t v[SIM_CLOSED_MAX_ORDER][SIM_CLOSED_MAX_ORDER];
+    sim_complex_t c[SIM_CLOSED_MAX_ORDER][MAX_SIGNALS];
+    sim_complex_t mode[SIM_CLOSED_MAX_ORDER + 1];      /* Error modes + constant */
+    sim_complex_t weight[SIM_CLOSED_MAX_ORDER + 1];
+    unsigned modes = 0;
+    const double big_n = (double)steps;
+    double error_steady;
+
+    assert(model != NULL && state != NULL && span != NULL && "Arguments cannot be NULL");
+    assert(steps >= 1 && "Span must have at least one step");
+
+    /* Samples of every signal at steps 0..n */
+    pack(model, state, x);
+    for (unsigned m = 0; m <= n; m++) {
+        for (unsigned j = 0; j < n; j++) sample[m][j] = x[j];
+        sample[m][out_sig] = affine(model->out, x, n);
+        sample[m][integ_sig] = affine(model->integ, x, n);
+        apply_map(model, x, next);
+        memcpy(x, next, sizeof(x));
+    }
+    for (unsigned j = 0; j < n; j++) steady[j] = model->equilibrium[j];
+    steady[out_sig] = affine(model->out, model->equilibrium, n);
+    steady[integ_sig] = affine(model->integ, model->equilibrium, n);
+
+    /* Modal coefficients: sum_i c_i p_i^m = s[m] - s* */
+    for (unsigned m = 0; m < n; m++) {
+        for (unsigned i = 0; i < n; i++) v[m][i] = cpow_n(model->pole[i], (double)m);
+        for (unsigned s = 0; s < count; s++) c[m][s] = cplx(sample[m][s] - steady[s], 0.0);
+    }
+    if (solve_complex(v, c, n, count) != 0) {
+        return -1;
+    }
+    for (unsigned s = 0; s < count; s++) {
+        sim_complex_t fit = cplx(steady[s], 0.0);
+        double scale = 1.0 + fabs(steady[s]);
+
+        for (unsigned i = 0; i < n; i++) {
+            fit = cadd(fit, cmul(c[i][s], cpow_n(model->pole[i], (double)n)));
+            scale += cabs_(c[i][s]);
+        }
+        if (fabs(fit.re - sample[n][s]) > FIT_TOLERANCE * scale) {
+            return -1;
+        }
+    }
+
+    /* Bounds and end values */
+    {
+        sim_complex_t col[SIM_CLOSED_MAX_ORDER] = { { 0.0, 0.0 } };
+        double lo, hi;
+
+        for (unsigned i = 0; i < n; i++) col[i] = c[i][0];
+        bounds(steady[0], col, n, &lo, &hi);
+        span->error_min = model->setpoint - hi;
+        span->error_max = model->setpoint - lo;
+        span->error_peak = fabs(model->setpoint - steady[0]);
+        for (unsigned i = 0; i < n; i++) span->error_peak += cabs_(col[i]);
+        for (unsigned i = 0; i < n; i++) col[i] = c[i][out_sig];
+        bounds(steady[out_sig], col, n, &span->output_min, &span->output_max);
+        for (unsigned i = 0; i < n; i++) col[i] = c[i][integ_sig];
+        bounds(steady[integ_sig], col, n, &span->integrator_min, &span->integrator_max);
+    }
+    for (unsigned j = 0; j < n; j++) {
+        double value = steady[j];
+        for (unsigned i = 0; i < n; i++) value += cmul(c[i][j], cpow_n(model->pole[i], big_n)).re;
+        x[j] = value;
+    }
+    span->end = *state;
+    unpack(model, x, &span->end);
+    span->last_output = steady[out_sig];
+    span->last_error = model->setpoint - steady[0];
+    for (unsigned i = 0; i < n; i++) {
+        sim_complex_t p = cpow_n(model->pole[i], big_n - 1.0);
+        span->last_output += cmul(c[i][out_sig], p).re;
+        span->last_error -= cmul(c[i][0], p).re;
+    }
+
+    /* Error modes: e[m] = sum weight_k mode_k^m, the constant as a mode at 1 */
+    error_steady = model->setpoint - steady[0];
+    for (unsigned i = 0; i < n; i++) {
+        mode[modes] = model->pole[i];
+        weight[modes++] = cscale(c[i][0], -1.0);
+    }
+    if (error_steady != 0.0) {
+        mode[modes] = cplx(1.0, 0.0);
+        weight[modes++] = cplx(error_steady, 0.0);
+    }
+
+    /* Sign: slowest mode real positive and dominant at m = 0 */
+    span->error_sign = 0;
+    if (modes > 0) {
+        unsigned slow = 0;
+        double others = 0.0;
+
+        for (unsigned k = 1; k < modes; k++) {
+            if (cabs_(mode[k]) > cabs_(mode[slow])) slow = k;
+        }
+        for (unsigned k = 0; k < modes; k++) {
+            if (k != slow) others += cabs_(weight[k]);
+        }
+        if (mode[slow].im == 0.0 && mode[slow].re > 0.0 && cabs_(weight[slow]) > others) {
+            span->error_sign = (weight[slow].re > 0.0) ? 1 : -1;
+        }
+    }
+
+    /* Sums */
+    {
+        sim_complex_t sum = cplx(0.0, 0.0), sum_step = cplx(0.0, 0.0), sum_sq = cplx(0.0, 0.0);
+
+        for (unsigned k = 0; k < modes; k++) {
+            sum = cadd(sum, cmul(weight[k], geometric_sum(mode[k], big_n)));
+            sum_step = cadd(sum_step, cmul(weight[k], weighted_geometric_sum(mode[k], big_n)));
+            for (unsigned l = 0; l < modes; l++) {
+                sum_sq = cadd(sum_sq, cmul(cmul(weight[k], weight[l]),
+                                           geometric_sum(cmul(mode[k], mode[l]), big_n)));
+            }
+        }
+        span->sum_error = sum.re;
+        span->sum_step_error = sum_step.re;
+        span->sum_error_sq = sum_sq.re;
+    }
+
+    if (!model->has_integrator) {
+        span->end.integrator = state->integrator + model->dt * span->sum_error;
+    }
+    return 0;
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
@@ -0,0 +1,146 @@
+/**
+ * @file    sim_closed.h
+ * @brief   Closed-form evaluation of the linear closed loop
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * While no clamp is active, pid_compute() driving the motor.c plant
+ * (speed += alpha * (gain * u - speed)) is an affine map x' = A x + b on
+ * the state x = (speed, prev_measurement[, integrator][, derivative_filtered]).
+ * For a constant setpoint and distinct stable poles every signal of the
+ * loop is a sum of modes, s[m] = s* + sum_i c_i * lambda_i^m, so a run of
+ * N steps - the state at its end, bounds on error, output and integrator
+ * and the sums behind IAE, ISE and ITAE - costs the same for any N.
+ * sim_run_closed_form() (sim_core.h) uses this to skip the quiet tail of
+ * each setpoint segment and steps the loop everywhere else.
+ */
+
+#ifndef SIM_CLOSED_H_
+#define SIM_CLOSED_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "sim_core.h"
+
+/** Largest closed-loop order */
+#define SIM_CLOSED_MAX_ORDER 4u
+
+/** Largest pole magnitude accepted: slower modes are stepped */
+#define SIM_CLOSED_MAX_POLE 0.999
+
+/** Shortest span sim_run_closed_form() evaluates in closed form */
+#define SIM_CLOSED_MIN_SPAN 32u
+
+/** Error (in float ulps of the setpoint) below which an oscillating
+ *  tail is skipped although its sign is unknown */
+#define SIM_CLOSED_NOISE_ULPS 8.0
+
+/** Steps sim_run_closed_form() waits after the first rejected span of a
+ *  segment (doubled after each further rejection) */
+#define SIM_CLOSED_RETRY_STEPS 16u
+
+/** Complex number (C99 _Complex is not available on every compiler) */
+typedef struct {
+    double re;                 /**< Real part */
+    double im;                 /**< Imaginary part */
+} sim_complex_t;
+
+/**
+ * @brief Loop state before a step
+ */
+typedef struct {
+    double speed;              /**< Plant speed (the next measurement) */
+    double prev_measurement;   /**< PID previous measurement */
+    double integrator;         /**< PID integrator */
+    double derivative_filtered;/**< PID filtered derivative */
+} sim_closed_state_t;
+
+/**
+ * @brief Linear closed loop of one setpoint segment
+ *
+ * Initialize with sim_closed_model_init().
+ */
+typedef struct {
+    unsigned order;            /**< Number of state variables (2-4) */
+    int has_integrator;        /**< Integrator is a state (ki != 0) */
+    int has_filter;            /**< Filtered derivative is a state (lpf > 0) */
+    double setpoint;           /**< Setpoint of the segment */
+    double a[SIM_CLOSED_MAX_ORDER][SIM_CLOSED_MAX_ORDER]; /**< State matrix */
+    double b[SIM_CLOSED_MAX_ORDER];                       /**< State offset */
+    double out[SIM_CLOSED_MAX_ORDER + 1];   /**< PID output = out . x + out[order] */
+    double integ[SIM_CLOSED_MAX_ORDER + 1]; /**< Updated integrator, same form */
+    double equilibrium[SIM_CLOSED_MAX_ORDER]; /**< Fixed point x* */
+    sim_complex_t pole[SIM_CLOSED_MAX_ORDER]; /**< Eigenvalues of A */
+    double dt;                 /**< Sample time */
+} sim_closed_model_t;
+
+/**
+ * @brief Closed-form summary of N consecutive steps
+ *
+ * Step m of the span (0 <= m < N) has error e[m] = setpoint - speed[m].
+ * Bounds enclose every step of the span (and all later ones, while the
+ * setpoint holds) and are widened to cover the float rounding of the
+ * stepped loop.
+ */
+typedef struct {
+    double error_min;          /**< Lower bound on e[m] */
+    double error_max;          /**< Upper bound on e[m] */
+    double output_min;         /**< Lower bound on the unclamped PID output */
+    double output_max;         /**< Upper bound on the unclamped PID output */
+    double integrator_min;     /**< Lower bound on the updated integrator */
+    double integrator_max;     /**< Upper bound on the updated integrator */
+    double error_peak;         /**< Bound on |e[m]| (not widened) */
+    int error_sign;            /**< +1 or -1 if e[m] provably keeps that
+                                    sign over the span, 0 if unknown */
+    double sum_error;          /**< Sum of e[m] */
+    double sum_error_sq;       /**< Sum of e[m]^2 */
+    double sum_step_error;     /**< Sum of m * e[m] */
+    double last_error;         /**< e[N - 1] */
+    double last_output;        /**< PID output of step N - 1 */
+    sim_closed_state_t end;    /**< State after the span */
+} sim_closed_span_t;
+
+/**
+ * @brief Build the linear closed loop of a configuration at one setpoint
+ *
+ * @param model     Model to fill
+ * @param config    Valid configuration (see sim_config_validate())
+ * @param setpoint  Setpoint of the segment
+ * @return 0 if the loop has distinct poles inside SIM_CLOSED_MAX_POLE
+ *         and a unique fixed point, -1 if it must be stepped
+ */
+int sim_closed_model_init(sim_closed_model_t *model, const sim_config_t *config, float setpoint);
+
+/**
+ * @brief Apply the linear map once (no clamping)
+ *
+ * @param model  Model from sim_closed_model_init()
+ * @param state  State to advance in place
+ */
+void sim_closed_step(const sim_closed_model_t *model, sim_closed_state_t *state);
+
+/**
+ * @brief Evaluate N steps of the linear loop in closed form
+ *
+ * Only valid as a prediction of the real loop if no clamp is active,
+ * which the caller checks against the returned bounds.
+ *
+ * @param model  Model from a successful sim_closed_model_init()
+ * @param state  State before the first step
+ * @param steps  Span length N (>= 1)
+ * @param span   Receives the summary
+ * @return 0 on success, -1 if the modal fit is not accurate enough
+ */
+int sim_closed_span(const sim_closed_model_t *model, const sim_closed_state_t *state,
+                    uint32_t steps, sim_closed_span_t *span);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_CLOSED_H_ */
@@ -0,0 +1,570 @@
+/**
+ * @file    sim_core.c
+ * @brief   Implementation of the parameterized simulation core
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Build as strict C99 (no GNU extensions): in GNU mode <stdlib.h>
+ * declares the POSIX pid_t, which clashes with pid.h.
+ */
+
+#include "sim_core.h"
+#include "sim_closed.h"
+#include "motor.h"
+#include "pid.h"
+#include <assert.h>
+#include <errno.h>
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Parse an unsigned 32-bit count; the whole string must be consumed */
+static int parse_u32(const char *text, uint32_t *value)
+{
+    unsigned long parsed;
+
+    if (sim_parse_count(text, 0xFFFFFFFFul, &parsed) != 0) {
+        return -1;
+    }
+    *value = (uint32_t)parsed;
+    return 0;
+}
+
+/* Setpoint of the segment active at @p step */
+static float profile_value(const sim_profile_t *profile, uint32_t step, size_t *segment)
+{
+    while (*segment < profile->count && profile->start[*segment] <= step) {
+        (*segment)++;
+    }
+    return (*segment == 0) ? 0.0f : profile->value[*segment - 1];
+}
+
+/* Per-run state shared by the stepped and closed-form runners */
+typedef struct {
+    const sim_config_t *config;
+    pid_t pid;
+    motor_model_t motor;
+    sim_metrics_t m;
+    uint32_t step;             /* Next step to run */
+    size_t segment;            /* Segments started up to the last step */
+    size_t active;             /* Segment the metrics below belong to */
+    double direction;
+    double amplitude;
+    uint32_t segment_start;
+    uint32_t rise_steps;
+    uint32_t settle_steps;
+    int risen;
+    int settled;
+} run_t;
+
+static void run_init(run_t *run, const sim_config_t *config)
+{
+    assert(config != NULL && sim_config_validate(config) == NULL && "Invalid simulation config");
+
+    memset(run, 0, sizeof(*run));
+    run->config = config;
+    run->active = (size_t)-1;
+
+    pid_init(&run->pid, config->kp, config->ki, config->kd, config->dt,
+             config->out_min, config->out_max);
+    if (config->has_integrator_limits || config->derivative_lpf > 0.0f) {
+        pid_init_advanced(&run->pid, config->kp, config->ki, config->kd, config->dt,
+                          config->out_min, config->out_max,
+                          config->has_integrator_limits ? config->integrator_min : run->pid.integrator_min,
+                          config->has_integrator_limits ? config->integrator_max : run->pid.integrator_max,
+                          config->derivative_lpf);
+    }
+    motor_model_init_advanced(&run->motor, config->motor_gain, config->motor_alpha);
+}
+
+/* Simulate one step and update the metrics */
+static void run_step(run_t *run, telemetry_record_t *record)
+{
+    const sim_config_t *config = run->config;
+    sim_metrics_t *m = &run->m;
+    uint32_t step = run->step++;
+    float setpoint = profile_value(&config->profile, step, &run->segment);
+    float measurement = motor_model_get_speed(&run->motor);
+    float output = pid_compute(&run->pid, setpoint, measurement);
+
+    motor_model_set_output(&run->motor, output);
+    motor_model_update(&run->motor);
+
+    record->step = step;
+    record->setpoint = setpoint;
+    record->measurement = measurement;
+    record->output = output;
+
+    /* Tracking metrics */
+    double error = (double)setpoint - (double)measurement;
+    double abs_error = fabs(error);
+    m->iae += abs_error * config->dt;
+    m->ise += error * error * config->dt;
+    m->itae += (double)step * config->dt * abs_error * config->dt;
+    /* Either clamp: the PID limits or motor_model_set_output()'s +/-1 */
+    if (output <= config->out_min || output >= config->out_max ||
+        output < -1.0f || output > 1.0f) {
+        m->saturated_steps++;
+    }
+
+    /* New setpoint segment (or first step): record step direction/size */
+    if (run->segment != run->active) {
+        run->active = run->segment;
+        run->direction = (error > 0.0) ? 1.0 : -1.0;
+        run->amplitude = abs_error;
+        run->segment_start = step;
+        run->risen = 0;
+        run->settled = 0;
+    }
+    if (run->amplitude > 0.0) {
+        double excess = -error * run->direction;
+        if (excess > 0.0 && 100.0 * excess / run->amplitude > m->overshoot_pct) {
+            m->overshoot_pct = 100.0 * excess / run->amplitude;
+        }
+    }
+
+    /* Rise: remaining error in the step direction within 10% of the step */
+    if (!run->risen && error * run->direction <= (1.0 - SIM_RISE_FRACTION) * run->amplitude) {
+        run->risen = 1;
+        run->rise_steps = step - run->segment_start;
+    }
+    /* Settling: (re)starts at the first sample back inside the band */
+    if (abs_error > SIM_SETTLING_BAND * run->amplitude) {
+        run->settled = 0;
+    } else if (!run->settled) {
+        run->settled = 1;
+        run->settle_steps = step - run->segment_start;
+    }
+    m->final_error = (float)error;
+    m->steps_run = step + 1;
+}
+
+/* Advance to @p end (exclusive, same segment) in closed form if provably
+ * equivalent to stepping; 0 if the loop must be stepped */
+static int run_jump(run_t *run, const sim_closed_model_t *model, uint32_t end)
+{
+    const sim_config_t *config = run->config;
+    sim_metrics_t *m = &run->m;
+    sim_closed_state_t state;
+    sim_closed_span_t span;
+    double dt = config->dt;
+    double noise = SIM_CLOSED_NOISE_ULPS * FLT_EPSILON * fmax(1.0, fabs(model->setpoint));
+    double excess_max, toward_min, abs_min, abs_max;
+    int sign;
+
+    state.speed = run->motor.speed;
+    state.prev_measurement = run->pid.prev_measurement;
+    state.integrator = run->pid.integrator;
+    state.derivative_filtered = run->pid.derivative_filtered;
+    if (sim_closed_span(model, &state, end - run->step, &span) != 0) {
+        return 0;
+    }
+    sign = span.error_sign;
+    if (sign > 0) {
+        /* The bounds are symmetric about the fixed point; a proven sign
+         * rules out the other side */
+        span.error_min = fmax(span.error_min, 0.0);
+    } else if (sign < 0) {
+        span.error_max = fmin(span.error_max, 0.0);
+    } else {
+        /* An oscillating tail is only skipped once it is within a few
+         * float ulps of the setpoint, where the stepped loop's error is
+         * rounding noise of either sign anyway */
+        if (!(span.error_peak <= noise)) {
+            return 0;
+        }
+        sign = (span.sum_error >= 0.0) ? 1 : -1;
+        span.error_min = -span.error_peak;
+        span.error_max = span.error_peak;
+    }
+
+    /* No clamp engages: PID output, motor input, integrator */
+    if (!(span.output_min > config->out_min && span.output_max < config->out_max &&
+          span.output_min >= -1.0 && span.output_max <= 1.0)) {
+        return 0;
+    }
+    if (model->has_integrator &&
+        !(span.integrator_min >= run->pid.integrator_min &&
+          span.integrator_max <= run->pid.integrator_max)) {
+        return 0;
+    }
+
+    /* Overshoot, rise and settling state cannot change */
+    excess_max = (run->direction > 0.0) ? -span.error_min : span.error_max;
+    toward_min = (run->direction > 0.0) ? span.error_min : -span.error_max;
+    abs_max = fmax(fabs(span.error_min), fabs(span.error_max));
+    abs_min = (span.error_min > 0.0) ? span.error_min :
+              (span.error_max < 0.0) ? -span.error_max : 0.0;
+    /* Excursions within rounding noise of the setpoint are not overshoot
+     * the stepped loop would resolve (it sits on a float plateau there) */
+    if (run->amplitude > 0.0 && excess_max > noise &&
+        100.0 * excess_max / run->amplitude > m->overshoot_pct) {
+        return 0;
+    }
+    if (!run->risen && !(toward_min > (1.0 - SIM_RISE_FRACTION) * run->amplitude)) {
+        return 0;
+    }
+    if (run->settled ? !(abs_max <= SIM_SETTLING_BAND * run->amplitude)
+                     : !(abs_min > SIM_SETTLING_BAND * run->amplitude)) {
+        return 0;
+    }
+
+    /* |e| = sign * e over the span; steps are absolute for ITAE */
+    m->iae += sign * span.sum_error * dt;
+    m->ise += span.sum_error_sq * dt;
+    m->itae += sign * ((double)run->step * span.sum_error + span.sum_step_error) * dt * dt;
+    m->final_error = (float)span.last_error;
+    m->steps_run = end;
+    run->step = end;
+
+    /* Restore the loop state the stepped run would have reached */
+    run->motor.speed = (float)span.end.speed;
+    run->motor.output = (float)span.last_output;
+    run->pid.prev_measurement = (float)span.end.prev_measurement;
+    run->pid.prev_error = (float)span.last_error;
+    run->pid.derivative_filtered = (float)span.end.derivative_filtered;
+    run->pid.integrator = (float)fmin(fmax(span.end.integrator, run->pid.integrator_min),
+                                      run->pid.integrator_max);
+    return 1;
+}
+
+static void run_finish(const run_t *run, sim_metrics_t *metrics)
+{
+    if (metrics == NULL) {
+        return;
+    }
+
+    /* memcpy keeps the zeroed padding, so results compare with memcmp */
+    memcpy(metrics, &run->m, sizeof(*metrics));
+    metrics->rise_time = run->risen ? (float)run->rise_steps * run->config->dt : -1.0f;
+    metrics->settling_time = run->settled ? (float)run->settle_steps * run->config->dt : -1.0f;
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+void sim_config_defaults(sim_config_t *config)
+{
+    assert(config != NULL && "Config pointer cannot be NULL");
+
+    memset(config, 0, sizeof(*config));
+    config->kp = 0.8f;
+    config->ki = 0.3f;
+    config->kd = 0.05f;
+    config->dt = 0.01f;
+    config->out_min = -1.0f;
+    config->out_max = 1.0f;
+    config->motor_gain = MOTOR_MODEL_DEFAULT_GAIN;
+    config->motor_alpha = MOTOR_MODEL_DEFAULT_ALPHA;
+    config->steps = 500;
+    config->profile.count = 1;
+    config->profile.start[0] = 0;
+    config->profile.value[0] = 3.0f;
+}
+
+int sim_parse_float(const char *text, float *value)
+{
+    char *end;
+    double parsed;
+
+    assert(text != NULL && value != NULL && "Text and value cannot be NULL");
+
+    parsed = strtod(text, &end);
+    if (end == text || *end != '\0' || !isfinite(parsed)) {
+        return -1;
+    }
+    *value = (float)parsed;
+    return 0;
+}
+
+int sim_parse_count(const char *text, unsigned long max, unsigned long *value)
+{
+    char *end;
+    unsigned long parsed;
+
+    assert(text != NULL && value != NULL && "Text and value cannot be NULL");
+
+    if (*text < '0' || *text > '9') {
+        return -1;
+    }
+    errno = 0;
+    parsed = strtoul(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || parsed > max) {
+        return -1;
+    }
+    *value = parsed;
+    return 0;
+}
+
+int sim_profile_parse(sim_profile_t *profile, const char *text)
+{
+    sim_profile_t parsed;
+    char item[64];
+
+    parsed.count = 0;
+    while (*text != '\0') {
+        size_t len = strcspn(text, ",");
+        char *colon;
+
+        if (len == 0 || len >= sizeof(item) || parsed.count == SIM_PROFILE_MAX) {
+            return -1;
+        }
+        memcpy(item, text, len);
+        item[len] = '\0';
+        text += len;
+        if (*text == ',') {
+            text++;
+            if (*text == '\0') {
+                return -1;
+            }
+        }
+
+        colon = strchr(item, ':');
+        if (colon == NULL) {
+            return -1;
+        }
+        *colon = '\0';
+        if (parse_u32(item, &parsed.start[parsed.count]) != 0 ||
+            sim_parse_float(colon + 1, &parsed.value[parsed.count]) != 0) {
+            return -1;
+        }
+        if (parsed.count > 0 && parsed.start[parsed.count] <= parsed.start[parsed.count - 1]) {
+            return -1;
+        }
+        parsed.count++;
+    }
+
+    if (parsed.count == 0) {
+        return -1;
+    }
+    *profile = parsed;
+    return 0;
+}
+
+int sim_config_set(sim_config_t *config, const char *name, const char *value)
+{
+    /* Float options, by name and field */
+    static const struct {
+        const char *name;
+        size_t offset;
+    } float_options[] = {
+        { "kp",          offsetof(sim_config_t, kp) },
+        { "ki",          offsetof(sim_config_t, ki) },
+        { "kd",          offsetof(sim_config_t, kd) },
+        { "dt",          offsetof(sim_config_t, dt) },
+        { "out-min",     offsetof(sim_config_t, out_min) },
+        { "out-max",     offsetof(sim_config_t, out_max) },
+        { "lpf",         offsetof(sim_config_t, derivative_lpf) },
+        { "motor-gain",  offsetof(sim_config_t, motor_gain) },
+        { "motor-alpha", offsetof(sim_config_t, motor_alpha) },
+    };
+
+    assert(config != NULL && name != NULL && value != NULL);
+
+    for (size_t i = 0; i < sizeof(float_options) / sizeof(float_options[0]); i++) {
+        if (strcmp(name, float_options[i].name) == 0) {
+            return sim_parse_float(value, (float *)((char *)config + float_options[i].offset));
+        }
+    }
+
+    if (strcmp(name, "integrator-min") == 0 || strcmp(name, "integrator-max") == 0) {
+        int is_min = (strcmp(name, "integrator-min") == 0);
+        float limit;
+        if (sim_parse_float(value, &limit) != 0) {
+            return -1;
+        }
+        if (!config->has_integrator_limits) {
+            /* The other limit stays unbounded unless it is given too */
+            config->integrator_min = -INFINITY;
+            config->integrator_max = INFINITY;
+            config->has_integrator_limits = 1;
+        }
+        if (is_min) config->integrator_min = limit;
+        else config->integrator_max = limit;
+        return 0;
+    }
+    if (strcmp(name, "steps") == 0) {
+        return parse_u32(value, &config->steps);
+    }
+    if (strcmp(name, "setpoint") == 0) {
+        float setpoint;
+        if (sim_parse_float(value, &setpoint) != 0) {
+            return -1;
+        }
+        config->profile.count = 1;
+        config->profile.start[0] = 0;
+        config->profile.value[0] = setpoint;
+        return 0;
+    }
+    if (strcmp(name, "profile") == 0) {
+        return sim_profile_parse(&config->profile, value);
+    }
+    return -1;
+}
+
+const char *sim_config_validate(const sim_config_t *config)
+{
+    if (!(config->dt > 0.0f)) return "dt must be positive";
+    if (config->kp < 0.0f || config->ki < 0.0f || config->kd < 0.0f) {
+        return "gains must be non-negative";
+    }
+    if (!(config->out_min < config->out_max)) return "out-min must be less than out-max";
+    if (config->has_integrator_limits && !(config->integrator_min < config->integrator_max)) {
+        return "integrator-min must be less than integrator-max";
+    }
+    if (config->derivative_lpf < 0.0f || config->derivative_lpf > 1.0f) {
+        return "lpf must be in [0, 1]";
+    }
+    if (!(config->motor_alpha > 0.0f && config->motor_alpha <= 1.0f)) {
+        return "motor-alpha must be in (0, 1]";
+    }
+    if (config->steps == 0) return "steps must be positive";
+    return NULL;
+}
+
+void sim_settle_stop_init(sim_settle_stop_t *stop, float band, uint32_t hold_steps,
+                          uint32_t after_step)
+{
+    assert(stop != NULL && "Predicate pointer cannot be NULL");
+    assert(band > 0.0f && hold_steps >= 1 && "Band must be positive and hold at least 1 step");
+
+    stop->band = band;
+    stop->hold_steps = hold_steps;
+    stop->after_step = after_step;
+    stop->inside = 0;
+}
+
+int sim_stop_settled(void *context, const telemetry_record_t *record)
+{
+    sim_settle_stop_t *stop = (sim_settle_stop_t *)context;
+
+    if (record->step < stop->after_step ||
+        fabsf(record->setpoint - record->measurement) > stop->band) {
+        stop->inside = 0;
+        return 0;
+    }
+    return ++stop->inside >= stop->hold_steps;
+}
+
+/**
+ * @brief Run one closed-loop simulation
+ *
+ * See detailed documentation in sim_core.h
+ */
+void sim_run(const sim_config_t *config, sim_sink_fn sink, void *context,
+             sim_metrics_t *metrics)
+{
+    sim_run_until(config, sink, context, NULL, NULL, metrics);
+}
+
+/**
+ * @brief Run one closed-loop simulation with an early-termination predicate
+ *
+ * See detailed documentation in sim_core.h
+ *
+ * Implementation notes (run_init()/run_step()):
+ * - Overshoot is tracked per setpoint segment: the step size is the
+ *   distance from the measurement at the segment start to the new
+ *   setpoint, and overshoot is the largest excursion past the setpoint
+ *   in the direction of that step
+ * - Rise and settling time restart at every segment, so the reported
+ *   values belong to the last one; a step of zero size counts as risen
+ *   and settled at its first step
+ * - Metrics accumulate in double so long horizons do not lose the tail
+ */
+void sim_run_until(const sim_config_t *config, sim_sink_fn sink, void *context,
+                   sim_stop_fn stop, void *stop_context, sim_metrics_t *metrics)
+{
+    run_t run;
+    telemetry_record_t record;
+
+    run_init(&run, config);
+    while (run.step < config->steps) {
+        run_step(&run, &record);
+        if (sink != NULL) {
+            sink(context, &record);
+        }
+        if (stop != NULL && stop(stop_context, &record)) {
+            break;
+        }
+    }
+    run_finish(&run, metrics);
+}
+
+/**
+ * @brief Run one simulation, skipping linear stretches in closed form
+ *
+ * See detailed documentation in sim_core.h
+ *
+ * Implementation notes:
+ * - The first step of every segment is stepped, which fixes the step
+ *   direction and size its metrics are measured against
+ * - A jump covers the rest of the segment and is only taken if the span
+ *   bounds prove that no clamp engages (output, motor input, integrator)
+ *   and that saturation count, overshoot, rise and settling cannot
+ *   change, and the error keeps one sign (so |e| sums are +/- e sums)
+ * - A failed attempt is retried SIM_CLOSED_RETRY_STEPS steps later, and
+ *   the interval doubles with every further failure in the segment, so
+ *   a loop that never linearizes costs O(log N) span evaluations
+ * - A segment without a usable model (unstable or repeated poles) is
+ *   stepped to its end
+ */
+uint32_t sim_run_closed_form(const sim_config_t *config, sim_metrics_t *metrics)
+{
+    run_t run;
+    telemetry_record_t record;
+    sim_closed_model_t model;
+    size_t model_segment = (size_t)-1;
+    int model_ok = 0;
+    uint32_t next_try = 0;
+    uint32_t retry = SIM_CLOSED_RETRY_STEPS;
+    uint32_t skipped = 0;
+
+    run_init(&run, config);
+    while (run.step < config->steps) {
+        const sim_profile_t *profile = &config->profile;
+        uint32_t start = run.step;
+        uint32_t end;
+
+        if (run.step == 0 || run.step < next_try) {
+            run_step(&run, &record);
+            continue;
+        }
+
+        /* Segment of the next step; stepped until it has started */
+        end = (run.segment < profile->count) ? profile->start[run.segment] : config->steps;
+        if (end > config->steps) end = config->steps;
+        if (run.active != run.segment || run.step >= end ||
+            end - run.step < SIM_CLOSED_MIN_SPAN) {
+            run_step(&run, &record);
+            continue;
+        }
+
+        if (model_segment != run.segment) {
+            float setpoint = (run.segment == 0) ? 0.0f : profile->value[run.segment - 1];
+            model_segment = run.segment;
+            model_ok = (sim_closed_model_init(&model, config, setpoint) == 0);
+            retry = SIM_CLOSED_RETRY_STEPS;
+        }
+        if (!model_ok) {
+            next_try = end;
+            run_step(&run, &record);
+        } else if (run_jump(&run, &model, end)) {
+            skipped += end - start;
+        } else {
+            next_try = run.step + retry;
+            retry = (retry < end - run.step) ? 2u * retry : retry;
+            run_step(&run, &record);
+        }
+    }
+    run_finish(&run, metrics);
+    return skipped;
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
@@ -0,0 +1,273 @@
+/**
+ * @file    sim_core.h
+ * @brief   Parameterized closed-loop simulation core for host tools
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Runs the control loop of main.c (pid_compute() driving a motor_model_t)
+ * with gains, limits, sample time, horizon, plant parameters and
+ * setpoint profile taken from a runtime configuration instead of
+ * #defines, and computes tracking metrics on the fly. Shared by the
+ * pid_sim command-line runner and the unit tests.
+ */
+
+#ifndef SIM_CORE_H_
+#define SIM_CORE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "telemetry_ring.h"
+
+/** Maximum number of setpoint profile segments */
+#define SIM_PROFILE_MAX 16u
+
+/**
+ * @brief Piecewise-constant setpoint profile
+ *
+ * The setpoint at step n is the value of the last segment whose start
+ * step is <= n (0 before the first segment). Start steps are strictly
+ * increasing.
+ */
+typedef struct {
+    size_t count;                        /**< Number of segments */
+    uint32_t start[SIM_PROFILE_MAX];     /**< First step of each segment */
+    float value[SIM_PROFILE_MAX];        /**< Setpoint of each segment */
+} sim_profile_t;
+
+/**
+ * @brief Simulation configuration
+ *
+ * Initialize with sim_config_defaults() (the values of main.c), then
+ * override fields directly or with sim_config_set().
+ */
+typedef struct {
+    /* Controller */
+    float kp;                  /**< Proportional gain */
+    float ki;                  /**< Integral gain */
+    float kd;                  /**< Derivative gain */
+    float dt;                  /**< Sample time in seconds */
+    float out_min;             /**< Minimum output limit */
+    float out_max;             /**< Maximum output limit */
+    float integrator_min;      /**< Min integrator limit (if has_integrator_limits) */
+    float integrator_max;      /**< Max integrator limit (if has_integrator_limits) */
+    int has_integrator_limits; /**< 0: limits derived as in pid_init() */
+    float derivative_lpf;      /**< Derivative filter coefficient (0 = off) */
+
+    /* Plant */
+    float motor_gain;          /**< Steady-state speed per unit input */
+    float motor_alpha;         /**< Response rate per step (dt / tau) */
+
+    /* Run */
+    uint32_t steps;            /**< Horizon in control steps */
+    sim_profile_t profile;     /**< Setpoint profile */
+} sim_config_t;
+
+/** Settling band of sim_metrics_t::settling_time, fraction of the step */
+#define SIM_SETTLING_BAND 0.05f
+
+/** Rise threshold of sim_metrics_t::rise_time, fraction of the step */
+#define SIM_RISE_FRACTION 0.9f
+
+/**
+ * @brief Tracking metrics of one run
+ *
+ * Integrals use the rectangle rule over the logged samples. Rise and
+ * settling time describe the response to the last setpoint segment and
+ * are measured from that segment's first step (the definitions used by
+ * plot_response() in sim/pid_simulation.py).
+ */
+typedef struct {
+    double iae;                /**< Integral of |error| dt */
+    double ise;                /**< Integral of error² dt */
+    double itae;               /**< Integral of t·|error| dt */
+    double overshoot_pct;      /**< Largest overshoot over all setpoint
+                                    segments, % of the segment's step size */
+    float rise_time;           /**< Seconds to cover SIM_RISE_FRACTION of the
+                                    step, -1 if never reached */
+    float settling_time;       /**< Seconds until the error stays within
+                                    SIM_SETTLING_BAND of the step, -1 if
+                                    still outside at the last step */
+    float final_error;         /**< Error at the last step */
+    uint32_t saturated_steps;  /**< Steps with output at a limit or outside
+                                    the motor's +/-1 input range */
+    uint32_t steps_run;        /**< Steps simulated (< steps if stopped early) */
+} sim_metrics_t;
+
+/**
+ * @brief Per-step callback receiving each logged sample
+ *
+ * @param context  Caller context passed to sim_run()
+ * @param record   Sample of the current step
+ */
+typedef void (*sim_sink_fn)(void *context, const telemetry_record_t *record);
+
+/**
+ * @brief Early-termination predicate, evaluated after every step
+ *
+ * @param context  Caller context passed to sim_run_until()
+ * @param record   Sample of the step just simulated
+ * @return Non-zero to end the run after this step
+ */
+typedef int (*sim_stop_fn)(void *context, const telemetry_record_t *record);
+
+/**
+ * @brief State of the sim_stop_settled() predicate
+ *
+ * Stops once |setpoint - measurement| <= band has held for hold_steps
+ * consecutive steps, counting only steps >= after_step (set it to the
+ * start of the last setpoint segment so earlier segments run in full).
+ * The remaining horizon then contributes at most band per step to IAE.
+ */
+typedef struct {
+    float band;                /**< Absolute error band */
+    uint32_t hold_steps;       /**< Consecutive steps required inside the band */
+    uint32_t after_step;       /**< First step that may count */
+    uint32_t inside;           /**< Steps inside the band so far */
+} sim_settle_stop_t;
+
+/**
+ * @brief Fill a configuration with the main.c demo values
+ *
+ * Kp 0.8, Ki 0.3, Kd 0.05, dt 0.01 s, output [-1, 1], default motor
+ * model, 500 steps at setpoint 3.0.
+ *
+ * @param config Configuration to fill
+ */
+void sim_config_defaults(sim_config_t *config);
+
+/**
+ * @brief Set one option from its textual name and value
+ *
+ * Names match the pid_sim command-line options without the leading
+ * dashes: kp, ki, kd, dt, out-min, out-max, integrator-min,
+ * integrator-max, lpf, motor-gain, motor-alpha, steps, setpoint
+ * (constant) and profile ("STEP:VALUE,STEP:VALUE,...").
+ *
+ * @param config  Configuration to update
+ * @param name    Option name
+ * @param value   Option value
+ * @return 0 on success, -1 for an unknown name or malformed value
+ */
+int sim_config_set(sim_config_t *config, const char *name, const char *value);
+
+/**
+ * @brief Parse a setpoint profile string
+ *
+ * @param profile  Profile to fill
+ * @param text     "STEP:VALUE[,STEP:VALUE...]" with increasing steps
+ * @return 0 on success, -1 if malformed or longer than SIM_PROFILE_MAX
+ */
+int sim_profile_parse(sim_profile_t *profile, const char *text);
+
+/**
+ * @brief Parse a finite float option value
+ *
+ * Shared by sim_config_set() and the command-line tools.
+ *
+ * @param text   Text to parse; the whole string must be consumed
+ * @param value  Receives the value (unchanged on failure)
+ * @return 0 on success, -1 if malformed or not finite
+ */
+int sim_parse_float(const char *text, float *value);
+
+/**
+ * @brief Parse an unsigned decimal count option value
+ *
+ * @param text   Text to parse: digits only, the whole string consumed
+ * @param max    Largest accepted value
+ * @param value  Receives the value (unchanged on failure)
+ * @return 0 on success, -1 if malformed or greater than @p max
+ */
+int sim_parse_count(const char *text, unsigned long max, unsigned long *value);
+
+/**
+ * @brief Check a configuration before running it
+ *
+ * The controller only asserts its preconditions, which compile out in
+ * release builds; command-line input must be checked here instead.
+ *
+ * @param config Configuration to check
+ * @return NULL if valid, otherwise a description of the first problem
+ */
+const char *sim_config_validate(const sim_config_t *config);
+
+/**
+ * @brief Run one closed-loop simulation
+ *
+ * Each step reads the plant speed, calls pid_compute(), applies the
+ * output and advances the plant, exactly like main.c. With the default
+ * configuration the samples are bit-identical to the demo.
+ *
+ * @param config   Valid configuration (see sim_config_validate())
+ * @param sink     Called once per step, or NULL to skip logging
+ * @param context  Passed to @p sink
+ * @param metrics  Receives the run's metrics, or NULL
+ */
+void sim_run(const sim_config_t *config, sim_sink_fn sink, void *context,
+             sim_metrics_t *metrics);
+
+/**
+ * @brief Run one closed-loop simulation with an early-termination predicate
+ *
+ * Like sim_run(), but ends after the first step for which @p stop returns
+ * non-zero. Metrics cover the steps run (see sim_metrics_t::steps_run);
+ * up to that point the samples are identical to sim_run().
+ *
+ * @param config        Valid configuration (see sim_config_validate())
+ * @param sink          Called once per step, or NULL to skip logging
+ * @param context       Passed to @p sink
+ * @param stop          Predicate, or NULL to run the full horizon
+ * @param stop_context  Passed to @p stop
+ * @param metrics       Receives the run's metrics, or NULL
+ */
+void sim_run_until(const sim_config_t *config, sim_sink_fn sink, void *context,
+                   sim_stop_fn stop, void *stop_context, sim_metrics_t *metrics);
+
+/**
+ * @brief Run one simulation, evaluating quiet stretches in closed form
+ *
+ * Same metrics as sim_run() without a sink, but once a setpoint segment
+ * reaches a stretch where no clamp can engage and no event metric
+ * (saturation, overshoot, rise, settling) can change, the rest of the
+ * segment is evaluated in closed form (sim_closed.h) instead of step by
+ * step. Results agree with sim_run() to float rounding; integer metrics
+ * are identical unless the stepped loop sits within rounding of a
+ * threshold.
+ *
+ * @param config   Valid configuration (see sim_config_validate())
+ * @param metrics  Receives the run's metrics, or NULL
+ * @return Number of steps evaluated in closed form
+ */
+uint32_t sim_run_closed_form(const sim_config_t *config, sim_metrics_t *metrics);
+
+/**
+ * @brief Initialize a settling predicate for sim_run_until()
+ *
+ * @param stop        Predicate state
+ * @param band        Absolute error band (> 0)
+ * @param hold_steps  Consecutive steps required inside the band (>= 1)
+ * @param after_step  First step that may count
+ */
+void sim_settle_stop_init(sim_settle_stop_t *stop, float band, uint32_t hold_steps,
+                          uint32_t after_step);
+
+/**
+ * @brief sim_stop_fn that stops once the response has settled
+ *
+ * @param context  sim_settle_stop_t initialized by sim_settle_stop_init()
+ * @param record   Sample of the step just simulated
+ * @return Non-zero once settled
+ */
+int sim_stop_settled(void *context, const telemetry_record_t *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_CORE_H_ */
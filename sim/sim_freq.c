@@ -0,0 +1,444 @@
+/**
+ * @file    sim_freq.c
+ * @brief   Implementation of the closed-loop frequency-response analysis
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Build as strict C99 (no GNU extensions): in GNU mode <stdlib.h>
+ * declares the POSIX pid_t, which clashes with pid.h.
+ *
+ * c and u are real, so one complex FFT of z = c + j u yields both:
+ * C[k] = (Z[k] + conj(Z[N-k])) / 2 and U[k] = (Z[k] - conj(Z[N-k])) / 2j.
+ * The excitation spectrum is known in closed form: a sine of amplitude a
+ * and phase phi on bin k has D[k] = (N a / 2) (sin phi - j cos phi). On
+ * the Nyquist bin (k = N/2) both images coincide: the line is the
+ * cosine a (-1)^n and D[k] = N a, with real C[k] and U[k].
+ */
+
+#include "sim_freq.h"
+#include "sim_thread.h"
+#include "motor.h"
+#include "pid.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+#define PI 3.14159265358979323846
+
+/* Shared state of one sim_freq_run() call */
+typedef struct {
+    const sim_freq_t *freq;
+    uint32_t bins[SIM_FREQ_MAX_POINTS];
+    uint32_t lines;
+    sim_complex_t *buffer;     /* One record buffer per worker */
+    sim_freq_point_t *points;
+} freq_job_t;
+
+static sim_complex_t cmul(sim_complex_t a, sim_complex_t b)
+{
+    sim_complex_t r = { a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re };
+    return r;
+}
+
+static sim_complex_t cdiv(sim_complex_t a, sim_complex_t b)
+{
+    double scale = 1.0 / (b.re * b.re + b.im * b.im);
+    sim_complex_t r = { (a.re * b.re + a.im * b.im) * scale,
+                        (a.im * b.re - a.re * b.im) * scale };
+    return r;
+}
+
+static float magnitude_db(sim_complex_t a)
+{
+    return (float)(20.0 * log10(hypot(a.re, a.im)));
+}
+
+static float phase_deg(sim_complex_t a)
+{
+    return (float)(atan2(a.im, a.re) * (180.0 / PI));
+}
+
+/* In-place radix-2 decimation-in-time FFT, X[k] = sum x[n] e^(-2 pi j k n / N) */
+static void fft(sim_complex_t *x, uint32_t log2n)
+{
+    uint32_t n = 1u << log2n;
+
+    for (uint32_t i = 1, j = 0; i < n; i++) {
+        uint32_t bit = n >> 1;
+
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j |= bit;
+        if (i < j) {
+            sim_complex_t t = x[i];
+            x[i] = x[j];
+            x[j] = t;
+        }
+    }
+
+    for (uint32_t len = 2; len <= n; len <<= 1) {
+        uint32_t half = len >> 1;
+
+        for (uint32_t k = 0; k < half; k++) {
+            double angle = -2.0 * PI * (double)k / (double)len;
+            sim_complex_t w = { cos(angle), sin(angle) };
+
+            for (uint32_t start = k; start < n; start += len) {
+                sim_complex_t t = cmul(w, x[start + half]);
+
+                x[start + half].re = x[start].re - t.re;
+                x[start + half].im = x[start].im - t.im;
+                x[start].re += t.re;
+                x[start].im += t.im;
+            }
+        }
+    }
+}
+
+/* Controller and plant of the configuration, as in sim_run() */
+static void loop_init(const sim_config_t *config, pid_t *pid, motor_model_t *motor)
+{
+    pid_init(pid, config->kp, config->ki, config->kd, config->dt,
+             config->out_min, config->out_max);
+    if (config->has_integrator_limits || config->derivative_lpf > 0.0f) {
+        pid_init_advanced(pid, config->kp, config->ki, config->kd, config->dt,
+                          config->out_min, config->out_max,
+                          config->has_integrator_limits ? config->integrator_min : pid->integrator_min,
+                          config->has_integrator_limits ? config->integrator_max : pid->integrator_max,
+                          config->derivative_lpf);
+    }
+    motor_model_init_advanced(motor, config->motor_gain, config->motor_alpha);
+}
+
+/* Run one record and fill its lines; @p z holds 2^record_log2 samples */
+static void measure_record(const sim_freq_t *freq, const uint32_t *bins, uint32_t lines,
+                           uint32_t record, sim_complex_t *z, sim_freq_point_t *points)
+{
+    const sim_config_t *config = &freq->base;
+    const sim_profile_t *profile = &config->profile;
+    uint32_t n = 1u << freq->record_log2;
+    uint32_t first = record * freq->lines_per_record;
+    uint32_t count = lines - first;
+    float setpoint = (profile->count > 0) ? profile->value[profile->count - 1] : 0.0f;
+    double omega[SIM_FREQ_MAX_POINTS];
+    double phi[SIM_FREQ_MAX_POINTS];
+    double amplitude;
+    uint64_t total;
+    uint64_t analyzed;
+    uint32_t saturated = 0;
+    /* Plant input range: the PID limits and motor_model_set_output()'s +/-1 */
+    float u_min = (config->out_min > -1.0f) ? config->out_min : -1.0f;
+    float u_max = (config->out_max < 1.0f) ? config->out_max : 1.0f;
+    pid_t pid;
+    motor_model_t motor;
+
+    if (count > freq->lines_per_record) {
+        count = freq->lines_per_record;
+    }
+
+    /* Equal amplitudes bound the sum; quadratic (Schroeder) phases keep
+     * the lines from peaking together */
+    amplitude = (double)freq->amplitude / (double)count;
+    for (uint32_t i = 0; i < count; i++) {
+        omega[i] = 2.0 * PI * (double)bins[first + i] / (double)n;
+        phi[i] = -PI * (double)i * (double)(i + 1u) / (double)count;
+        if (bins[first + i] == n / 2u) {
+            phi[i] = 0.5 * PI;
+        }
+    }
+
+    /* Operating point */
+    loop_init(config, &pid, &motor);
+    for (uint32_t step = 0; step < config->steps; step++) {
+        float measurement = motor_model_get_speed(&motor);
+
+        motor_model_set_output(&motor, pid_compute(&pid, setpoint, measurement));
+        motor_model_update(&motor);
+    }
+
+    /* Excited periods; the last one is recorded */
+    analyzed = (uint64_t)freq->settle_records * n;
+    total = analyzed + n;
+    for (uint64_t step = 0; step < total; step++) {
+        uint32_t m = (uint32_t)(step & (n - 1u));
+        float measurement = motor_model_get_speed(&motor);
+        float c = pid_compute(&pid, setpoint, measurement);
+        double d = 0.0;
+
+        for (uint32_t i = 0; i < count; i++) {
+            d += amplitude * sin(omega[i] * (double)m + phi[i]);
+        }
+
+        float raw = c + (float)d;
+        float u = (raw < u_min) ? u_min : (raw > u_max) ? u_max : raw;
+        if (u != raw || c <= config->out_min || c >= config->out_max) {
+            saturated++;
+        }
+
+        motor_model_set_output(&motor, u);
+        motor_model_update(&motor);
+
+        if (step >= analyzed) {
+            z[m].re = (double)c;
+            z[m].im = (double)u;
+        }
+    }
+
+    fft(z, freq->record_log2);
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t k = bins[first + i];
+        sim_complex_t zk = z[k];
+        sim_complex_t zr = { z[n - k].re, -z[n - k].im };   /* conj(Z[N-k]) */
+        sim_complex_t cf = { 0.5 * (zk.re + zr.re), 0.5 * (zk.im + zr.im) };
+        sim_complex_t uf = { 0.5 * (zk.im - zr.im), -0.5 * (zk.re - zr.re) };
+        double scale = (k == n / 2u) ? (double)n * amplitude : 0.5 * (double)n * amplitude;
+        sim_complex_t df = { scale * sin(phi[i]), -scale * cos(phi[i]) };
+        sim_complex_t minus_c = { -cf.re, -cf.im };
+        sim_complex_t complementary;
+        sim_freq_point_t *p = &points[first + i];
+
+        p->bin = k;
+        p->frequency = (float)((double)k / ((double)n * (double)config->dt));
+        p->open_loop = cdiv(minus_c, uf);
+        p->sensitivity = cdiv(uf, df);
+        complementary.re = 1.0 - p->sensitivity.re;
+        complementary.im = -p->sensitivity.im;
+        p->gain_db = magnitude_db(p->open_loop);
+        p->phase_deg = phase_deg(p->open_loop);
+        p->closed_gain_db = magnitude_db(complementary);
+        p->closed_phase_deg = phase_deg(complementary);
+        p->saturated_steps = saturated;
+    }
+}
+
+/* @p phase shifted by whole turns to within 180 degrees of @p prev */
+static float unwrap(float phase, float prev)
+{
+    while (phase - prev > 180.0f) {
+        phase -= 360.0f;
+    }
+    while (phase - prev < -180.0f) {
+        phase += 360.0f;
+    }
+    return phase;
+}
+
+static void freq_task(void *context, size_t task, unsigned worker)
+{
+    const freq_job_t *job = (const freq_job_t *)context;
+    sim_complex_t *z = job->buffer + ((size_t)worker << job->freq->record_log2);
+
+    measure_record(job->freq, job->bins, job->lines, (uint32_t)task, z, job->points);
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+void sim_freq_init(sim_freq_t *freq, const sim_config_t *base)
+{
+    assert(freq != NULL && "Analysis pointer cannot be NULL");
+    assert(base != NULL && "Base configuration cannot be NULL");
+
+    freq->base = *base;
+    freq->amplitude = 0.1f;
+    freq->record_log2 = 12;
+    freq->settle_records = 2;
+    freq->points = 48;
+    freq->lines_per_record = 4;
+    freq->policy = SIM_SCHED_STEAL;
+}
+
+const char *sim_freq_validate(const sim_freq_t *freq)
+{
+    assert(freq != NULL && "Analysis pointer cannot be NULL");
+
+    if (!(freq->amplitude > 0.0f) || !isfinite(freq->amplitude)) {
+        return "amplitude must be positive";
+    }
+    if (freq->record_log2 < SIM_FREQ_MIN_LOG2 || freq->record_log2 > SIM_FREQ_MAX_LOG2) {
+        return "record length must be 2^4 to 2^20 samples";
+    }
+    if (freq->points < 2u || freq->points > SIM_FREQ_MAX_POINTS) {
+        return "points must be in 2..512";
+    }
+    if (freq->lines_per_record == 0) {
+        return "lines per record must be positive";
+    }
+    return sim_config_validate(&freq->base);
+}
+
+uint32_t sim_freq_lines(const sim_freq_t *freq, uint32_t *bins)
+{
+    uint32_t top;
+    uint32_t lines = 0;
+    uint32_t prev = 0;
+
+    assert(freq != NULL && sim_freq_validate(freq) == NULL && "Invalid analysis");
+
+    /* Log-spaced over bins 1 .. N/2 */
+    top = 1u << (freq->record_log2 - 1u);
+    for (uint32_t i = 0; i < freq->points; i++) {
+        double x = exp(log((double)top) * (double)i / (double)(freq->points - 1u));
+        uint32_t bin = (uint32_t)floor(x + 0.5);
+
+        if (bin > top) {
+            bin = top;
+        }
+        if (bin == prev) {
+            continue;
+        }
+        if (bins != NULL) {
+            bins[lines] = bin;
+        }
+        lines++;
+        prev = bin;
+    }
+    return lines;
+}
+
+uint32_t sim_freq_records(const sim_freq_t *freq)
+{
+    uint32_t lines = sim_freq_lines(freq, NULL);
+
+    return (lines + freq->lines_per_record - 1u) / freq->lines_per_record;
+}
+
+int sim_freq_evaluate(const sim_freq_t *freq, uint32_t record, sim_freq_point_t *points)
+{
+    uint32_t bins[SIM_FREQ_MAX_POINTS];
+    uint32_t lines;
+    sim_complex_t *z;
+
+    assert(points != NULL && "Points cannot be NULL");
+    lines = sim_freq_lines(freq, bins);
+    assert(record < sim_freq_records(freq) && "Record index out of range");
+
+    z = (sim_complex_t *)malloc(sizeof(sim_complex_t) << freq->record_log2);
+    if (z == NULL) {
+        return -1;
+    }
+    measure_record(freq, bins, lines, record, z, points);
+    free(z);
+    return 0;
+}
+
+unsigned sim_freq_run(const sim_freq_t *freq, unsigned threads,
+                      sim_freq_point_t *points, sim_sched_stats_t *stats)
+{
+    freq_job_t job;
+    uint32_t records;
+    unsigned workers;
+
+    assert(points != NULL && "Points cannot be NULL");
+
+    job.freq = freq;
+    job.lines = sim_freq_lines(freq, job.bins);
+    job.points = points;
+    records = sim_freq_records(freq);
+
+    /* Same cap as sim_sched_run(): one buffer per worker it will start */
+    workers = (threads == 0) ? sim_cpu_count() : threads;
+    if (workers > SIM_SCHED_MAX_WORKERS) {
+        workers = SIM_SCHED_MAX_WORKERS;
+    }
+    if (workers > records) {
+        workers = records;
+    }
+
+    job.buffer = (sim_complex_t *)malloc(((size_t)workers * sizeof(sim_complex_t))
+                                         << freq->record_log2);
+    if (job.buffer == NULL) {
+        return 0;
+    }
+    workers = sim_sched_run(records, workers, freq->policy, freq_task, &job, stats);
+    free(job.buffer);
+
+    for (uint32_t i = 1; i < job.lines; i++) {
+        points[i].phase_deg = unwrap(points[i].phase_deg, points[i - 1u].phase_deg);
+        points[i].closed_phase_deg = unwrap(points[i].closed_phase_deg,
+                                            points[i - 1u].closed_phase_deg);
+    }
+    return workers;
+}
+
+void sim_freq_margins(const sim_freq_point_t *points, uint32_t count,
+                      sim_freq_margins_t *margins)
+{
+    assert(points != NULL && count >= 1u && "Need at least one line");
+    assert(margins != NULL && "Margins pointer cannot be NULL");
+
+    margins->has_gain_margin = 0;
+    margins->gain_margin_db = 0.0f;
+    margins->phase_crossover_hz = 0.0f;
+    margins->has_phase_margin = 0;
+    margins->phase_margin_deg = 0.0f;
+    margins->gain_crossover_hz = 0.0f;
+    margins->modulus_margin = INFINITY;
+    margins->peak_sensitivity_db = -INFINITY;
+    margins->saturated_steps = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const sim_freq_point_t *p = &points[i];
+        float distance = (float)hypot(1.0 + p->open_loop.re, p->open_loop.im);
+        float sensitivity = magnitude_db(p->sensitivity);
+
+        if (distance < margins->modulus_margin) {
+            margins->modulus_margin = distance;
+        }
+        if (sensitivity > margins->peak_sensitivity_db) {
+            margins->peak_sensitivity_db = sensitivity;
+        }
+        margins->saturated_steps += p->saturated_steps;
+    }
+
+    for (uint32_t i = 1; i < count; i++) {
+        const sim_freq_point_t *a = &points[i - 1u];
+        const sim_freq_point_t *b = &points[i];
+        double log_fa = log((double)a->frequency);
+        double log_fb = log((double)b->frequency);
+
+        /* Gain crossover: |L| passes 0 dB */
+        if ((a->gain_db >= 0.0f) != (b->gain_db >= 0.0f)) {
+            double t = (double)a->gain_db / ((double)a->gain_db - (double)b->gain_db);
+            double phase = a->phase_deg + t * ((double)b->phase_deg - (double)a->phase_deg);
+            double margin = fmod(phase + 180.0, 360.0);
+
+            /* Wrap to (-180, 180]: negative means the loop is unstable */
+            if (margin > 180.0) {
+                margin -= 360.0;
+            } else if (margin <= -180.0) {
+                margin += 360.0;
+            }
+            if (!margins->has_phase_margin || margin < margins->phase_margin_deg) {
+                margins->has_phase_margin = 1;
+                margins->phase_margin_deg = (float)margin;
+                margins->gain_crossover_hz = (float)exp(log_fa + t * (log_fb - log_fa));
+            }
+        }
+
+        /* Phase crossovers: every -180 + 360 k between the two phases */
+        double lo = fmin(a->phase_deg, b->phase_deg);
+        double hi = fmax(a->phase_deg, b->phase_deg);
+        for (double target = -180.0 + 360.0 * ceil((lo + 180.0) / 360.0);
+             target <= hi; target += 360.0) {
+            double span = (double)b->phase_deg - (double)a->phase_deg;
+            double t = (span != 0.0) ? (target - a->phase_deg) / span : 0.0;
+            double margin = -(a->gain_db + t * ((double)b->gain_db - (double)a->gain_db));
+
+            if (!margins->has_gain_margin || margin < margins->gain_margin_db) {
+                margins->has_gain_margin = 1;
+                margins->gain_margin_db = (float)margin;
+                margins->phase_crossover_hz = (float)exp(log_fa + t * (log_fb - log_fa));
+            }
+        }
+    }
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
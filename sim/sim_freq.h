@@ -0,0 +1,195 @@
+/**
+ * @file    sim_freq.h
+ * @brief   Frequency-response (Bode) analysis of the simulated closed loop
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Measures the loop of sim_run() - pid_compute() driving a motor_model_t
+ * - at an operating point by adding a multisine to the plant input:
+ *
+ *   u = clamp(c + d),   c = pid_compute(setpoint, y),   y = plant(u)
+ *
+ * where the clamp is the intersection of [out_min, out_max] and the
+ * motor model's own +/-1 input range, so u is what the plant receives.
+ * With the setpoint held, c = -L u for the open loop L = C P, and the
+ * injection sees the sensitivity S = U / D = 1 / (1 + L). Both follow
+ * from the FFT of c and u over one record of 2^record_log2 samples:
+ *
+ *   L = -C(f) / U(f),   S = U(f) / D(f),   T = 1 - S = L / (1 + L)
+ *
+ * Every excited line sits on an FFT bin and the excitation repeats every
+ * record, so after settle_records periods the loop is in periodic steady
+ * state and the record has no leakage. Lines are log-spaced over bins
+ * 1 .. N/2 and split into records of lines_per_record consecutive lines.
+ * The Nyquist line is kept: L is real there, and the phase of a sampled
+ * loop with a one-step delay often reaches -180 deg only there. Each
+ * record is an independent run and the records are scheduled on a pool
+ * of worker threads (sim_sched.h). Splitting keeps every line's
+ * amplitude (amplitude / lines_per_record) usable while the summed
+ * excitation stays within @p amplitude.
+ *
+ * The measurement is only meaningful while no clamp engages, be it the
+ * PID output limits or the plant input range inside them: a loop that
+ * saturates around its operating point is not linear there. Each line
+ * reports the saturated steps of its record.
+ */
+
+#ifndef SIM_FREQ_H_
+#define SIM_FREQ_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "sim_closed.h"
+#include "sim_core.h"
+#include "sim_sched.h"
+
+/** Maximum number of frequency lines */
+#define SIM_FREQ_MAX_POINTS 512u
+
+/** Record length limits (log2 of the FFT size) */
+#define SIM_FREQ_MIN_LOG2 4u
+#define SIM_FREQ_MAX_LOG2 20u
+
+/**
+ * @brief Analysis description
+ *
+ * The operating point is @p base run for base.steps steps at the value
+ * of its last setpoint segment, without excitation. Initialize with
+ * sim_freq_init().
+ */
+typedef struct {
+    sim_config_t base;         /**< Controller, plant and warm-up horizon */
+    float amplitude;           /**< Peak of the summed excitation (> 0) */
+    uint32_t record_log2;      /**< Record length N = 2^record_log2 samples */
+    uint32_t settle_records;   /**< Excited periods discarded before the record */
+    uint32_t points;           /**< Requested lines (2..SIM_FREQ_MAX_POINTS);
+                                    fewer if bins coincide */
+    uint32_t lines_per_record; /**< Lines excited together (>= 1) */
+    sim_sched_policy_t policy; /**< Scheduling policy */
+} sim_freq_t;
+
+/**
+ * @brief Response at one frequency line
+ */
+typedef struct {
+    uint32_t bin;              /**< FFT bin (cycles per record) */
+    float frequency;           /**< Hz: bin / (N dt) */
+    sim_complex_t open_loop;   /**< L = C P */
+    sim_complex_t sensitivity; /**< S = 1 / (1 + L) */
+    float gain_db;             /**< 20 log10 |L| */
+    float phase_deg;           /**< arg L (unwrapped by sim_freq_run()) */
+    float closed_gain_db;      /**< 20 log10 |T| */
+    float closed_phase_deg;    /**< arg T (unwrapped by sim_freq_run()) */
+    uint32_t saturated_steps;  /**< Steps of this line's settle periods and
+                                    record with c at an output limit or u
+                                    clamped (0 = valid) */
+} sim_freq_point_t;
+
+/**
+ * @brief Stability margins of a measured open loop
+ *
+ * Crossovers are interpolated linearly in log frequency between lines.
+ * If the response crosses more than once, the smallest margin is kept.
+ */
+typedef struct {
+    int has_gain_margin;       /**< Phase crosses -180 deg (mod 360) */
+    float gain_margin_db;      /**< -20 log10 |L| at the phase crossover */
+    float phase_crossover_hz;  /**< Frequency of that crossover */
+    int has_phase_margin;      /**< |L| crosses 0 dB */
+    float phase_margin_deg;    /**< 180 + arg L at the gain crossover */
+    float gain_crossover_hz;   /**< Frequency of that crossover */
+    float modulus_margin;      /**< Smallest |1 + L| over the lines */
+    float peak_sensitivity_db; /**< Largest |S| over the lines */
+    uint32_t saturated_steps;  /**< Sum over the lines; margins are not
+                                    valid unless 0 */
+} sim_freq_margins_t;
+
+/**
+ * @brief Initialize an analysis with default settings
+ *
+ * Amplitude 0.1, 4096-sample records, 2 settle periods, 48 lines, 4 lines
+ * per record, work stealing.
+ *
+ * @param freq  Analysis to initialize
+ * @param base  Controller, plant and warm-up horizon
+ */
+void sim_freq_init(sim_freq_t *freq, const sim_config_t *base);
+
+/**
+ * @brief Check an analysis before running it
+ *
+ * @param freq Analysis to check
+ * @return NULL if valid, otherwise a description of the first problem
+ */
+const char *sim_freq_validate(const sim_freq_t *freq);
+
+/**
+ * @brief Frequency lines of an analysis
+ *
+ * @param freq  Valid analysis (see sim_freq_validate())
+ * @param bins  Receives the bins in increasing order (up to
+ *              SIM_FREQ_MAX_POINTS), or NULL
+ * @return Number of lines
+ */
+uint32_t sim_freq_lines(const sim_freq_t *freq, uint32_t *bins);
+
+/**
+ * @brief Number of records (independent runs) of an analysis
+ *
+ * @param freq Valid analysis (see sim_freq_validate())
+ * @return ceil(lines / lines_per_record)
+ */
+uint32_t sim_freq_records(const sim_freq_t *freq);
+
+/**
+ * @brief Measure one record on the calling thread
+ *
+ * Fills the lines of record @p record (lines record * lines_per_record
+ * onwards) in @p points. Phases are wrapped to (-180, 180].
+ *
+ * @param freq    Valid analysis (see sim_freq_validate())
+ * @param record  Record index (< sim_freq_records())
+ * @param points  Array of sim_freq_lines() points, indexed by line
+ * @return 0 on success, -1 if the record buffer cannot be allocated
+ */
+int sim_freq_evaluate(const sim_freq_t *freq, uint32_t record, sim_freq_point_t *points);
+
+/**
+ * @brief Measure every line
+ *
+ * Records are scheduled with sim_sched_run() under the analysis policy.
+ * Each worker owns one record buffer and writes only its own lines, so
+ * results are bit-identical to sim_freq_evaluate() for any thread count.
+ * Phases are then unwrapped across lines, starting from the lowest.
+ *
+ * @param freq     Valid analysis (see sim_freq_validate())
+ * @param threads  Worker count, 0 for one per processor; capped at the
+ *                 number of records and SIM_SCHED_MAX_WORKERS
+ * @param points   Receives sim_freq_lines() points
+ * @param stats    Receives per-worker scheduling statistics, or NULL
+ * @return Number of workers used, 0 if the record buffers cannot be
+ *         allocated (@p points not filled)
+ */
+unsigned sim_freq_run(const sim_freq_t *freq, unsigned threads,
+                      sim_freq_point_t *points, sim_sched_stats_t *stats);
+
+/**
+ * @brief Gain and phase margins of a measured response
+ *
+ * @param points   Lines in increasing frequency with unwrapped phases
+ * @param count    Number of lines (>= 1)
+ * @param margins  Receives the margins
+ */
+void sim_freq_margins(const sim_freq_point_t *points, uint32_t count,
+                      sim_freq_margins_t *margins);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_FREQ_H_ */
@@ -0,0 +1,220 @@
+/**
+ * @file    sim_sched.c
+ * @brief   Implementation of the work-stealing task scheduler
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Tasks are known up front, so a deque is a range [next, end) of task
+ * indices guarded by a per-worker mutex. The owner claims next++; a thief
+ * moves the back half of the victim's range into its own (empty) deque.
+ * Tasks are whole simulations (microseconds to seconds), so an uncontended
+ * lock per task costs nothing measurable and keeps the scheduler portable
+ * C99 without compare-and-swap.
+ */
+
+#include "sim_sched.h"
+#include "sim_thread.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Per-worker deque and statistics; padded so neighbours do not share a
+ * cache line */
+typedef struct {
+    sim_mutex_t *lock;
+    size_t next;               /* First unclaimed task */
+    size_t end;                /* One past the last task */
+    uint32_t rng;              /* Victim selection state */
+    sim_worker_stats_t stats;
+    unsigned char pad[64];
+} worker_t;
+
+/* Shared state of one sim_sched_run() call */
+typedef struct {
+    worker_t *worker;
+    unsigned workers;
+    sim_sched_policy_t policy;
+    sim_task_fn fn;
+    void *context;
+} sched_job_t;
+
+/* Claim the front task of a worker's own deque */
+static int pop_own(worker_t *self, size_t *task)
+{
+    int found = 0;
+
+    sim_mutex_lock(self->lock);
+    if (self->next < self->end) {
+        *task = self->next++;
+        found = 1;
+    }
+    sim_mutex_unlock(self->lock);
+    return found;
+}
+
+/* Move the back half of a victim's deque into the thief's empty deque */
+static int steal(worker_t *thief, worker_t *victim)
+{
+    size_t first = 0, end = 0;
+
+    sim_mutex_lock(victim->lock);
+    if (victim->next < victim->end) {
+        size_t half = (victim->end - victim->next + 1) / 2;
+        end = victim->end;
+        first = end - half;
+        victim->end = first;
+    }
+    sim_mutex_unlock(victim->lock);
+
+    if (first == end) {
+        thief->stats.failed_steals++;
+        return 0;
+    }
+
+    /* Only the owner refills its deque, and it is empty here */
+    sim_mutex_lock(thief->lock);
+    thief->next = first;
+    thief->end = end;
+    sim_mutex_unlock(thief->lock);
+    thief->stats.steals++;
+    return 1;
+}
+
+/* Scan the other workers from a random start; 0 when all are empty */
+static int steal_any(const sched_job_t *job, unsigned self)
+{
+    worker_t *thief = &job->worker[self];
+    unsigned start;
+
+    /* xorshift32 */
+    thief->rng ^= thief->rng << 13;
+    thief->rng ^= thief->rng >> 17;
+    thief->rng ^= thief->rng << 5;
+    start = thief->rng % job->workers;
+
+    for (unsigned i = 0; i < job->workers; i++) {
+        unsigned victim = (start + i) % job->workers;
+        if (victim != self && steal(thief, &job->worker[victim])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void sched_worker(void *arg, unsigned index)
+{
+    const sched_job_t *job = (const sched_job_t *)arg;
+    worker_t *self = &job->worker[index];
+    size_t task;
+
+    for (;;) {
+        while (pop_own(self, &task)) {
+            uint64_t start = sim_now_ns();
+            job->fn(job->context, task, index);
+            self->stats.busy_ns += sim_now_ns() - start;
+            self->stats.tasks++;
+        }
+        if (job->policy != SIM_SCHED_STEAL || !steal_any(job, index)) {
+            break;
+        }
+    }
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+unsigned sim_sched_run(size_t tasks, unsigned workers, sim_sched_policy_t policy,
+                       sim_task_fn fn, void *context, sim_sched_stats_t *stats)
+{
+    sched_job_t job;
+    uint64_t start;
+    unsigned created = 0;
+
+    assert(fn != NULL && "Task function cannot be NULL");
+
+    if (workers == 0) {
+        workers = sim_cpu_count();
+    }
+    if (workers > SIM_SCHED_MAX_WORKERS) {
+        workers = SIM_SCHED_MAX_WORKERS;
+    }
+    if (workers > tasks) {
+        workers = (tasks > 0) ? (unsigned)tasks : 1u;
+    }
+
+    job.worker = (worker_t *)calloc(workers, sizeof(worker_t));
+    if (job.worker != NULL) {
+        for (created = 0; created < workers; created++) {
+            job.worker[created].lock = sim_mutex_create();
+            if (job.worker[created].lock == NULL) {
+                break;
+            }
+        }
+    }
+    /* Out of resources: run with the workers that have a lock */
+    if (created == 0) {
+        free(job.worker);
+        start = sim_now_ns();
+        for (size_t task = 0; task < tasks; task++) {
+            fn(context, task, 0);
+        }
+        if (stats != NULL) {
+            memset(stats, 0, sizeof(*stats));
+            stats->workers = 1;
+            stats->wall_ns = sim_now_ns() - start;
+            stats->worker[0].busy_ns = stats->wall_ns;
+            stats->worker[0].tasks = tasks;
+        }
+        return 1;
+    }
+    workers = created;
+
+    /* Contiguous initial blocks */
+    for (unsigned w = 0; w < workers; w++) {
+        job.worker[w].next = tasks * w / workers;
+        job.worker[w].end = tasks * (w + 1) / workers;
+        job.worker[w].rng = 2654435761u * (w + 1);
+    }
+    job.workers = workers;
+    job.policy = policy;
+    job.fn = fn;
+    job.context = context;
+
+    start = sim_now_ns();
+    sim_parallel_run(workers, sched_worker, &job);
+
+    if (stats != NULL) {
+        memset(stats, 0, sizeof(*stats));
+        stats->workers = workers;
+        stats->wall_ns = sim_now_ns() - start;
+        for (unsigned w = 0; w < workers; w++) {
+            stats->worker[w] = job.worker[w].stats;
+        }
+    }
+
+    for (unsigned w = 0; w < workers; w++) {
+        sim_mutex_destroy(job.worker[w].lock);
+    }
+    free(job.worker);
+    return workers;
+}
+
+double sim_sched_utilization(const sim_sched_stats_t *stats, unsigned worker)
+{
+    double utilization;
+
+    assert(stats != NULL && worker < stats->workers && "Invalid worker index");
+
+    if (stats->wall_ns == 0) {
+        return 0.0;
+    }
+    utilization = (double)stats->worker[worker].busy_ns / (double)stats->wall_ns;
+    return (utilization > 1.0) ? 1.0 : utilization;
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
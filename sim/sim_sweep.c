@@ -0,0 +1,336 @@
+/**
+ * @file    sim_sweep.c
+ * @brief   Implementation of the multithreaded gain-grid and Monte-Carlo sweep
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Build as strict C99 (no GNU extensions): in GNU mode <stdlib.h>
+ * declares the POSIX pid_t, which clashes with pid.h.
+ */
+
+#include "sim_sweep.h"
+#include "sim_thread.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Results of one worker not yet handed to the callback */
+typedef struct {
+    sim_sweep_result_t results[SIM_SWEEP_BATCH];
+    size_t count;
+} batch_t;
+
+/* Shared state of one sim_sweep_run() call */
+typedef struct {
+    const sim_sweep_t *sweep;
+    batch_t *batch;            /* One per worker */
+    sim_sweep_fn callback;
+    void *context;
+    sim_mutex_t *lock;         /* NULL when running a single worker */
+} sweep_job_t;
+
+/* Value @p i of an axis */
+static float axis_value(const sim_sweep_axis_t *axis, uint32_t i)
+{
+    if (axis->count <= 1 || i == 0) {
+        return axis->min;
+    }
+    if (i == axis->count - 1) {
+        return axis->max;
+    }
+    return (float)((double)axis->min +
+                   ((double)axis->max - (double)axis->min) * i / (axis->count - 1));
+}
+
+/* Integer hash (lowbias32): decorrelates consecutive indices */
+static uint32_t mix32(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+/* Plant scale factor in [1 - spread, 1 + spread) for draw @p k of a candidate */
+static float plant_factor(const sim_sweep_t *sweep, size_t index, uint32_t k)
+{
+    uint64_t wide = (uint64_t)index;
+    uint32_t h = mix32(sweep->seed ^ mix32((uint32_t)wide ^ mix32((uint32_t)(wide >> 32) + k)));
+    double uniform = (double)(h >> 8) * (1.0 / 16777216.0);    /* [0, 1) */
+
+    return (float)(1.0 + (double)sweep->plant_spread * (2.0 * uniform - 1.0));
+}
+
+static void flush(const sweep_job_t *job, batch_t *batch)
+{
+    if (batch->count == 0) {
+        return;
+    }
+    if (job->lock != NULL) {
+        sim_mutex_lock(job->lock);
+    }
+    job->callback(job->context, batch->results, batch->count);
+    if (job->lock != NULL) {
+        sim_mutex_unlock(job->lock);
+    }
+    batch->count = 0;
+}
+
+/* Task body: evaluate one candidate into the worker's batch */
+static void sweep_task(void *arg, size_t index, unsigned worker)
+{
+    const sweep_job_t *job = (const sweep_job_t *)arg;
+    batch_t *batch = &job->batch[worker];
+
+    sim_sweep_evaluate(job->sweep, index, &batch->results[batch->count]);
+    if (++batch->count == SIM_SWEEP_BATCH) {
+        flush(job, batch);
+    }
+}
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+void sim_sweep_init(sim_sweep_t *sweep, const sim_config_t *base)
+{
+    assert(sweep != NULL && base != NULL && "Sweep and base config cannot be NULL");
+
+    sweep->base = *base;
+    sweep->kp.min = sweep->kp.max = base->kp;
+    sweep->ki.min = sweep->ki.max = base->ki;
+    sweep->kd.min = sweep->kd.max = base->kd;
+    sweep->lpf.min = sweep->lpf.max = base->derivative_lpf;
+    sweep->kp.count = sweep->ki.count = sweep->kd.count = sweep->lpf.count = 1;
+    sweep->trials = 1;
+    sweep->plant_spread = 0.0f;
+    sweep->seed = 1;
+    sweep->stop_band = 0.0f;
+    sweep->stop_hold = 1;
+    sweep->closed_form = 0;
+    sweep->policy = SIM_SCHED_STEAL;
+}
+
+int sim_sweep_axis_parse(sim_sweep_axis_t *axis, const char *text)
+{
+    sim_sweep_axis_t parsed;
+    char *end;
+    double min, max;
+    unsigned long count;
+
+    min = strtod(text, &end);
+    if (end == text || !isfinite(min)) {
+        return -1;
+    }
+    if (*end == '\0') {
+        parsed.min = parsed.max = (float)min;
+        parsed.count = 1;
+        *axis = parsed;
+        return 0;
+    }
+
+    text = end;
+    if (*text++ != ':') {
+        return -1;
+    }
+    max = strtod(text, &end);
+    if (end == text || *end != ':' || !isfinite(max) || max < min) {
+        return -1;
+    }
+    text = end + 1;
+    if (*text < '0' || *text > '9') {
+        return -1;
+    }
+    count = strtoul(text, &end, 10);
+    if (*end != '\0' || count == 0 || count > 0xFFFFFFFFul) {
+        return -1;
+    }
+
+    parsed.min = (float)min;
+    parsed.max = (float)max;
+    parsed.count = (uint32_t)count;
+    *axis = parsed;
+    return 0;
+}
+
+size_t sim_sweep_size(const sim_sweep_t *sweep)
+{
+    assert(sweep != NULL && "Sweep pointer cannot be NULL");
+
+    return (size_t)sweep->kp.count * sweep->ki.count * sweep->kd.count * sweep->lpf.count *
+           sweep->trials;
+}
+
+uint32_t sim_sweep_config(const sim_sweep_t *sweep, size_t index, sim_config_t *config)
+{
+    uint32_t trial;
+
+    assert(sweep != NULL && config != NULL && "Sweep and config cannot be NULL");
+    assert(index < sim_sweep_size(sweep) && "Candidate index out of range");
+
+    *config = sweep->base;
+    if (sweep->plant_spread > 0.0f) {
+        config->motor_gain *= plant_factor(sweep, index, 0);
+        config->motor_alpha *= plant_factor(sweep, index, 1);
+    }
+
+    trial = (uint32_t)(index % sweep->trials);
+    index /= sweep->trials;
+    config->derivative_lpf = axis_value(&sweep->lpf, (uint32_t)(index % sweep->lpf.count));
+    index /= sweep->lpf.count;
+    config->kd = axis_value(&sweep->kd, (uint32_t)(index % sweep->kd.count));
+    index /= sweep->kd.count;
+    config->ki = axis_value(&sweep->ki, (uint32_t)(index % sweep->ki.count));
+    index /= sweep->ki.count;
+    config->kp = axis_value(&sweep->kp, (uint32_t)index);
+    return trial;
+}
+
+void sim_sweep_evaluate(const sim_sweep_t *sweep, size_t index, sim_sweep_result_t *result)
+{
+    sim_config_t config;
+
+    assert(result != NULL && "Result pointer cannot be NULL");
+
+    result->index = index;
+    result->trial = sim_sweep_config(sweep, index, &config);
+    result->kp = config.kp;
+    result->ki = config.ki;
+    result->kd = config.kd;
+    result->lpf = config.derivative_lpf;
+    result->motor_gain = config.motor_gain;
+    result->motor_alpha = config.motor_alpha;
+
+    if (sweep->stop_band > 0.0f) {
+        const sim_profile_t *profile = &config.profile;
+        sim_settle_stop_t stop;
+
+        sim_settle_stop_init(&stop, sweep->stop_band, sweep->stop_hold,
+                             profile->start[profile->count - 1]);
+        sim_run_until(&config, NULL, NULL, sim_stop_settled, &stop, &result->metrics);
+    } else if (sweep->closed_form) {
+        sim_run_closed_form(&config, &result->metrics);
+    } else {
+        sim_run(&config, NULL, NULL, &result->metrics);
+    }
+}
+
+const char *sim_sweep_validate(const sim_sweep_t *sweep)
+{
+    const sim_sweep_axis_t *axes[4];
+    sim_config_t corner;
+    size_t size;
+
+    assert(sweep != NULL && "Sweep pointer cannot be NULL");
+
+    axes[0] = &sweep->kp;
+    axes[1] = &sweep->ki;
+    axes[2] = &sweep->kd;
+    axes[3] = &sweep->lpf;
+    for (int i = 0; i < 4; i++) {
+        if (axes[i]->count == 0 || !(axes[i]->min <= axes[i]->max)) {
+            return "sweep axes need count >= 1 and min <= max";
+        }
+    }
+
+    if (sweep->trials == 0) {
+        return "trials must be positive";
+    }
+
+    /* sim_sweep_size() must not wrap: multiply one factor at a time */
+    size = sweep->trials;
+    for (int i = 0; i < 4; i++) {
+        if (size > SIZE_MAX / axes[i]->count) {
+            return "too many candidates (axis counts times trials overflow)";
+        }
+        size *= axes[i]->count;
+    }
+    if (!(sweep->plant_spread >= 0.0f && sweep->plant_spread < 1.0f)) {
+        return "plant spread must be in [0, 1)";
+    }
+    if (!(sweep->stop_band >= 0.0f) || !isfinite(sweep->stop_band)) {
+        return "stop band must be non-negative";
+    }
+    if (sweep->stop_band > 0.0f && sweep->stop_hold == 0) {
+        return "stop hold must be positive";
+    }
+    if (sweep->stop_band > 0.0f && sweep->closed_form) {
+        return "closed-form evaluation cannot stop early";
+    }
+
+    /* Bit i of c selects the max end of axis i; bits 4-5 the plant extremes */
+    for (unsigned c = 0; c < 64u; c++) {
+        corner = sweep->base;
+        corner.kp = (c & 1u) ? sweep->kp.max : sweep->kp.min;
+        corner.ki = (c & 2u) ? sweep->ki.max : sweep->ki.min;
+        corner.kd = (c & 4u) ? sweep->kd.max : sweep->kd.min;
+        corner.derivative_lpf = (c & 8u) ? sweep->lpf.max : sweep->lpf.min;
+        corner.motor_gain *= (c & 16u) ? 1.0f + sweep->plant_spread : 1.0f - sweep->plant_spread;
+        corner.motor_alpha *= (c & 32u) ? 1.0f + sweep->plant_spread : 1.0f - sweep->plant_spread;
+
+        const char *problem = sim_config_validate(&corner);
+        if (problem != NULL) {
+            return problem;
+        }
+    }
+    return NULL;
+}
+
+unsigned sim_sweep_run(const sim_sweep_t *sweep, unsigned threads,
+                       sim_sweep_fn callback, void *context, sim_sched_stats_t *stats)
+{
+    sweep_job_t job;
+    batch_t single;
+    size_t size;
+    unsigned workers;
+
+    assert(sweep != NULL && sim_sweep_validate(sweep) == NULL && "Invalid sweep");
+    assert(callback != NULL && "Callback cannot be NULL");
+
+    size = sim_sweep_size(sweep);
+    workers = (threads == 0) ? sim_cpu_count() : threads;
+    if (workers > SIM_SCHED_MAX_WORKERS) {
+        workers = SIM_SCHED_MAX_WORKERS;
+    }
+    if (workers > size) {
+        workers = (unsigned)size;
+    }
+
+    job.sweep = sweep;
+    job.callback = callback;
+    job.context = context;
+    job.lock = (workers > 1) ? sim_mutex_create() : NULL;
+    job.batch = (job.lock != NULL) ? (batch_t *)malloc(workers * sizeof(batch_t)) : NULL;
+    if (job.batch == NULL) {
+        /* One worker (or out of resources): a single batch on the stack */
+        sim_mutex_destroy(job.lock);
+        job.lock = NULL;
+        job.batch = &single;
+        workers = 1;
+    }
+    for (unsigned w = 0; w < workers; w++) {
+        job.batch[w].count = 0;
+    }
+
+    workers = sim_sched_run(size, workers, sweep->policy, sweep_task, &job, stats);
+
+    /* Partial batches, after all workers have finished */
+    for (unsigned w = 0; w < workers; w++) {
+        flush(&job, &job.batch[w]);
+    }
+
+    if (job.batch != &single) {
+        free(job.batch);
+    }
+    sim_mutex_destroy(job.lock);
+    return workers;
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
@@ -0,0 +1,190 @@
+/**
+ * @file    sim_sweep.h
+ * @brief   Multithreaded gain-grid and Monte-Carlo sweep over the simulation core
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Evaluates every (kp, ki, kd, derivative_lpf) combination of a linear
+ * grid with sim_run() and streams each candidate's metrics to a callback.
+ * Each grid point can be repeated over Monte-Carlo trials with randomly
+ * perturbed plant parameters, and runs can end early once settled.
+ * Candidates are scheduled on a pool of worker threads with work
+ * stealing (sim_sched.h); every run owns its controller and plant
+ * instance, so workers share nothing but the read-only sweep description
+ * and the result callback.
+ */
+
+#ifndef SIM_SWEEP_H_
+#define SIM_SWEEP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sim_core.h"
+#include "sim_sched.h"
+
+/** Results a worker buffers before taking the callback lock */
+#define SIM_SWEEP_BATCH 64u
+
+/**
+ * @brief One grid axis: @p count values evenly spaced over [min, max]
+ *
+ * A single-value axis has count 1 and min == max.
+ */
+typedef struct {
+    float min;                 /**< First value */
+    float max;                 /**< Last value */
+    uint32_t count;            /**< Number of values (>= 1) */
+} sim_sweep_axis_t;
+
+/**
+ * @brief Sweep description
+ *
+ * Every candidate is @p base with kp, ki, kd and derivative_lpf replaced
+ * by one grid point and, over @p trials, the plant gain and alpha each
+ * scaled by an independent factor drawn uniformly from
+ * [1 - plant_spread, 1 + plant_spread]. Draws depend only on the seed
+ * and candidate index, so results do not depend on scheduling.
+ * Initialize with sim_sweep_init().
+ */
+typedef struct {
+    sim_config_t base;         /**< Configuration shared by all candidates */
+    sim_sweep_axis_t kp;       /**< Proportional gain axis */
+    sim_sweep_axis_t ki;       /**< Integral gain axis */
+    sim_sweep_axis_t kd;       /**< Derivative gain axis */
+    sim_sweep_axis_t lpf;      /**< Derivative filter axis */
+    uint32_t trials;           /**< Monte-Carlo trials per grid point (>= 1) */
+    float plant_spread;        /**< Relative plant perturbation, in [0, 1) */
+    uint32_t seed;             /**< Seed of the plant perturbations */
+    float stop_band;           /**< Stop once |error| <= stop_band for
+                                    stop_hold steps in the last setpoint
+                                    segment (0 = run the full horizon) */
+    uint32_t stop_hold;        /**< Consecutive settled steps required */
+    int closed_form;           /**< Evaluate with sim_run_closed_form()
+                                    (not with stop_band) */
+    sim_sched_policy_t policy; /**< Scheduling policy */
+} sim_sweep_t;
+
+/**
+ * @brief Metrics of one candidate
+ */
+typedef struct {
+    size_t index;              /**< Candidate index (see sim_sweep_config()) */
+    uint32_t trial;            /**< Monte-Carlo trial of the grid point */
+    float kp;                  /**< Candidate proportional gain */
+    float ki;                  /**< Candidate integral gain */
+    float kd;                  /**< Candidate derivative gain */
+    float lpf;                 /**< Candidate derivative filter */
+    float motor_gain;          /**< Plant gain of this trial */
+    float motor_alpha;         /**< Plant alpha of this trial */
+    sim_metrics_t metrics;     /**< Metrics of the run */
+} sim_sweep_result_t;
+
+/**
+ * @brief Callback receiving a batch of results
+ *
+ * Calls are serialized (never concurrent) but come from worker threads,
+ * in no particular order.
+ *
+ * @param context  Caller context passed to sim_sweep_run()
+ * @param results  Results of this batch
+ * @param count    Number of results (1..SIM_SWEEP_BATCH)
+ */
+typedef void (*sim_sweep_fn)(void *context, const sim_sweep_result_t *results, size_t count);
+
+/**
+ * @brief Initialize a sweep whose axes hold only the base values
+ *
+ * One trial, no plant perturbation, full horizon, work stealing.
+ *
+ * @param sweep  Sweep to initialize
+ * @param base   Configuration shared by all candidates
+ */
+void sim_sweep_init(sim_sweep_t *sweep, const sim_config_t *base);
+
+/**
+ * @brief Parse an axis from text
+ *
+ * @param axis  Axis to fill
+ * @param text  "VALUE" (single point) or "MIN:MAX:COUNT" with MIN <= MAX
+ * @return 0 on success, -1 if malformed
+ */
+int sim_sweep_axis_parse(sim_sweep_axis_t *axis, const char *text);
+
+/**
+ * @brief Number of candidates
+ *
+ * @param sweep Sweep (the product cannot overflow once sim_sweep_validate()
+ *              accepts it)
+ * @return Product of the axis counts and trials
+ */
+size_t sim_sweep_size(const sim_sweep_t *sweep);
+
+/**
+ * @brief Configuration of one candidate
+ *
+ * Index order is kp-major, trial-minor:
+ * index = (((kp_i * ki.count + ki_i) * kd.count + kd_i) * lpf.count + lpf_i)
+ *         * trials + trial.
+ *
+ * @param sweep   Sweep
+ * @param index   Candidate index (< sim_sweep_size())
+ * @param config  Receives the candidate's configuration
+ * @return Monte-Carlo trial of the candidate
+ */
+uint32_t sim_sweep_config(const sim_sweep_t *sweep, size_t index, sim_config_t *config);
+
+/**
+ * @brief Run one candidate on the calling thread
+ *
+ * Runs sim_sweep_config(@p index) with sim_run(), with sim_run_until()
+ * and sim_stop_settled() when stop_band > 0 (counting from the start of
+ * the last setpoint segment), or with sim_run_closed_form() when
+ * closed_form is set.
+ *
+ * @param sweep   Valid sweep (see sim_sweep_validate())
+ * @param index   Candidate index (< sim_sweep_size())
+ * @param result  Receives the candidate and its metrics
+ */
+void sim_sweep_evaluate(const sim_sweep_t *sweep, size_t index, sim_sweep_result_t *result);
+
+/**
+ * @brief Check a sweep before running it
+ *
+ * Validates the axes, trial settings, that the candidate count fits a
+ * size_t, and every corner of the grid and plant perturbation range with sim_config_validate() (constraints are
+ * monotonic in each parameter).
+ *
+ * @param sweep Sweep to check
+ * @return NULL if valid, otherwise a description of the first problem
+ */
+const char *sim_sweep_validate(const sim_sweep_t *sweep);
+
+/**
+ * @brief Run every candidate of a sweep
+ *
+ * Candidates are scheduled with sim_sched_run() under the sweep's
+ * policy; each worker hands results to @p callback in batches of up to
+ * SIM_SWEEP_BATCH. Results are bit-identical to sim_sweep_evaluate().
+ *
+ * @param sweep     Valid sweep (see sim_sweep_validate())
+ * @param threads   Worker count, 0 for one per processor; capped at the
+ *                  number of candidates and SIM_SCHED_MAX_WORKERS
+ * @param callback  Receives every result exactly once
+ * @param context   Passed to @p callback
+ * @param stats     Receives per-worker scheduling statistics, or NULL
+ * @return Number of workers used
+ */
+unsigned sim_sweep_run(const sim_sweep_t *sweep, unsigned threads,
+                       sim_sweep_fn callback, void *context, sim_sched_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_SWEEP_H_ */
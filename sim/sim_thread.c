@@ -0,0 +1,210 @@
+/**
+ * @file    sim_thread.c
+ * @brief   Portable threading for host simulation tools
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * POSIX: pthreads and clock_gettime(CLOCK_MONOTONIC), enabled by the
+ * build with SIM_HAVE_PTHREADS. Windows: CreateThread, SRWLOCK and
+ * QueryPerformanceCounter. Elsewhere workers run serially and the clock
+ * is clock(), which has coarse resolution.
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "sim_thread.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(SIM_HAVE_PTHREADS)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+struct sim_mutex {
+#if defined(_WIN32)
+    SRWLOCK lock;
+#elif defined(SIM_HAVE_PTHREADS)
+    pthread_mutex_t lock;
+#else
+    int unused;
+#endif
+};
+
+/* Arguments of one spawned worker */
+typedef struct {
+    sim_worker_fn fn;
+    void *context;
+    unsigned worker;
+} worker_args_t;
+
+#if defined(_WIN32)
+typedef HANDLE thread_handle_t;
+
+static DWORD WINAPI worker_entry(LPVOID arg)
+{
+    worker_args_t *args = (worker_args_t *)arg;
+    args->fn(args->context, args->worker);
+    return 0;
+}
+#elif defined(SIM_HAVE_PTHREADS)
+typedef pthread_t thread_handle_t;
+
+static void *worker_entry(void *arg)
+{
+    worker_args_t *args = (worker_args_t *)arg;
+    args->fn(args->context, args->worker);
+    return NULL;
+}
+#endif
+
+/*============================================================================*/
+/* PUBLIC API IMPLEMENTATION                                                 */
+/*============================================================================*/
+
+unsigned sim_cpu_count(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 0) ? (unsigned)info.dwNumberOfProcessors : 1u;
+#elif defined(SIM_HAVE_PTHREADS) && defined(_SC_NPROCESSORS_ONLN)
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (unsigned)count : 1u;
+#else
+    return 1u;
+#endif
+}
+
+void sim_parallel_run(unsigned workers, sim_worker_fn fn, void *context)
+{
+    assert(workers >= 1 && "At least one worker is required");
+    assert(fn != NULL && "Worker function cannot be NULL");
+
+#if defined(_WIN32) || defined(SIM_HAVE_PTHREADS)
+    worker_args_t *args = (worker_args_t *)malloc(workers * sizeof(*args));
+    thread_handle_t *threads = (thread_handle_t *)malloc(workers * sizeof(*threads));
+    unsigned spawned = 1;
+
+    /* Spawn workers 1..n-1, stopping at the first failure */
+    while (args != NULL && threads != NULL && spawned < workers) {
+        args[spawned].fn = fn;
+        args[spawned].context = context;
+        args[spawned].worker = spawned;
+#if defined(_WIN32)
+        threads[spawned] = CreateThread(NULL, 0, worker_entry, &args[spawned], 0, NULL);
+        if (threads[spawned] == NULL) {
+            break;
+        }
+#else
+        if (pthread_create(&threads[spawned], NULL, worker_entry, &args[spawned]) != 0) {
+            break;
+        }
+#endif
+        spawned++;
+    }
+
+    fn(context, 0);
+
+    /* Workers without a thread run here */
+    for (unsigned worker = spawned; worker < workers; worker++) {
+        fn(context, worker);
+    }
+
+    for (unsigned worker = 1; worker < spawned; worker++) {
+#if defined(_WIN32)
+        WaitForSingleObject(threads[worker], INFINITE);
+        CloseHandle(threads[worker]);
+#else
+        pthread_join(threads[worker], NULL);
+#endif
+    }
+
+    free(threads);
+    free(args);
+#else
+    for (unsigned worker = 0; worker < workers; worker++) {
+        fn(context, worker);
+    }
+#endif
+}
+
+sim_mutex_t *sim_mutex_create(void)
+{
+    sim_mutex_t *mutex = (sim_mutex_t *)malloc(sizeof(*mutex));
+
+    if (mutex == NULL) {
+        return NULL;
+    }
+#if defined(_WIN32)
+    InitializeSRWLock(&mutex->lock);
+#elif defined(SIM_HAVE_PTHREADS)
+    if (pthread_mutex_init(&mutex->lock, NULL) != 0) {
+        free(mutex);
+        return NULL;
+    }
+#endif
+    return mutex;
+}
+
+void sim_mutex_destroy(sim_mutex_t *mutex)
+{
+    if (mutex == NULL) {
+        return;
+    }
+#if defined(SIM_HAVE_PTHREADS) && !defined(_WIN32)
+    pthread_mutex_destroy(&mutex->lock);
+#endif
+    free(mutex);
+}
+
+void sim_mutex_lock(sim_mutex_t *mutex)
+{
+    assert(mutex != NULL && "Mutex cannot be NULL");
+#if defined(_WIN32)
+    AcquireSRWLockExclusive(&mutex->lock);
+#elif defined(SIM_HAVE_PTHREADS)
+    pthread_mutex_lock(&mutex->lock);
+#else
+    (void)mutex;
+#endif
+}
+
+void sim_mutex_unlock(sim_mutex_t *mutex)
+{
+    assert(mutex != NULL && "Mutex cannot be NULL");
+#if defined(_WIN32)
+    ReleaseSRWLockExclusive(&mutex->lock);
+#elif defined(SIM_HAVE_PTHREADS)
+    pthread_mutex_unlock(&mutex->lock);
+#else
+    (void)mutex;
+#endif
+}
+
+uint64_t sim_now_ns(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (uint64_t)((double)count.QuadPart * 1e9 / (double)freq.QuadPart);
+#elif defined(SIM_HAVE_PTHREADS)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#else
+    return (uint64_t)((double)clock() * 1e9 / (double)CLOCKS_PER_SEC);
+#endif
+}
+
+/*============================================================================*/
+/* END OF FILE                                                               */
+/*============================================================================*/
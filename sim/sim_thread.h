@@ -0,0 +1,95 @@
+/**
+ * @file    sim_thread.h
+ * @brief   Minimal portable threading for host simulation tools
+ * @author  Onesmo Ogore
+ * @version 1.0.0
+ * @date    November 2025
+ * @license MIT
+ *
+ * Fork-join worker runs, an opaque mutex and a monotonic clock over
+ * pthreads (SIM_HAVE_PTHREADS) or Win32 threads. Without either, workers
+ * run one after another on the calling thread, so callers must not make
+ * one worker wait for another. Kept in its own translation unit because
+ * the POSIX headers it needs define a pid_t that clashes with pid.h.
+ */
+
+#ifndef SIM_THREAD_H_
+#define SIM_THREAD_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/** Opaque mutex (see sim_mutex_create()) */
+typedef struct sim_mutex sim_mutex_t;
+
+/**
+ * @brief Worker entry point
+ *
+ * @param context  Caller context passed to sim_parallel_run()
+ * @param worker   Worker index in [0, workers)
+ */
+typedef void (*sim_worker_fn)(void *context, unsigned worker);
+
+/**
+ * @brief Number of online processors
+ *
+ * @return Processor count (at least 1)
+ */
+unsigned sim_cpu_count(void);
+
+/**
+ * @brief Run @p workers copies of @p fn concurrently and wait for all
+ *
+ * Worker 0 runs on the calling thread. A worker whose thread cannot be
+ * created runs on the calling thread after worker 0, so every worker
+ * always runs exactly once.
+ *
+ * @param workers  Number of workers (>= 1)
+ * @param fn       Worker entry point
+ * @param context  Passed to every worker
+ */
+void sim_parallel_run(unsigned workers, sim_worker_fn fn, void *context);
+
+/**
+ * @brief Create a mutex
+ *
+ * @return New mutex, or NULL if out of resources
+ */
+sim_mutex_t *sim_mutex_create(void);
+
+/**
+ * @brief Destroy a mutex created by sim_mutex_create() (NULL is ignored)
+ *
+ * @param mutex Unlocked mutex
+ */
+void sim_mutex_destroy(sim_mutex_t *mutex);
+
+/**
+ * @brief Lock a mutex (not recursive)
+ *
+ * @param mutex Mutex to lock
+ */
+void sim_mutex_lock(sim_mutex_t *mutex);
+
+/**
+ * @brief Unlock a mutex held by the calling thread
+ *
+ * @param mutex Mutex to unlock
+ */
+void sim_mutex_unlock(sim_mutex_t *mutex);
+
+/**
+ * @brief Monotonic wall-clock time
+ *
+ * @return Nanoseconds since an arbitrary epoch
+ */
+uint64_t sim_now_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_THREAD_H_ */
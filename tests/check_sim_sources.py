@@ -0,0 +1,75 @@
+"""
+@file    check_sim_sources.py
+@author  Onesmo Ogore
+@date    11/19/2025
+@brief   Links the SIM_SOURCES list of sim/pid_simulation.py
+
+pid_simulation.py compiles pid_sim itself with gcc instead of using the
+CMake target, so a new dependency of sim_core.c has to be added to its
+SIM_SOURCES list by hand. This check reads the list without importing
+the script (no numpy/matplotlib needed) and compiles and links it with
+the script's flags.
+
+Usage: python check_sim_sources.py CC
+
+SPDX-License-Identifier: MIT
+"""
+
+import ast
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parents[1]
+SCRIPT = ROOT / "sim" / "pid_simulation.py"
+
+# Directory variables SIM_SOURCES entries are built from
+DIRS = {
+    "SIM_DIR": ROOT / "sim",
+    "FIRMWARE_SRC": ROOT / "firmware" / "src",
+}
+
+
+def script_sources():
+    """Evaluate SIM_SOURCES = [DIR / "file.c", ...] from the script's AST."""
+    tree = ast.parse(SCRIPT.read_text(encoding="utf-8"), str(SCRIPT))
+    for node in tree.body:
+        if (isinstance(node, ast.Assign) and len(node.targets) == 1
+                and isinstance(node.targets[0], ast.Name)
+                and node.targets[0].id == "SIM_SOURCES"):
+            sources = []
+            for item in node.value.elts:
+                if not (isinstance(item, ast.BinOp) and isinstance(item.op, ast.Div)
+                        and isinstance(item.left, ast.Name) and item.left.id in DIRS
+                        and isinstance(item.right, ast.Constant)):
+                    raise SystemExit(f"Unsupported SIM_SOURCES entry: {ast.dump(item)}")
+                sources.append(DIRS[item.left.id] / item.right.value)
+            return sources
+    raise SystemExit(f"SIM_SOURCES not found in {SCRIPT}")
+
+
+def main(argv):
+    if len(argv) != 2:
+        raise SystemExit("Usage: check_sim_sources.py CC")
+
+    sources = script_sources()
+    with tempfile.TemporaryDirectory() as tmp:
+        cmd = [
+            argv[1], "-std=c99", "-Wall", "-Wextra", "-Werror",
+            f"-I{ROOT / 'firmware' / 'include'}", f"-I{ROOT / 'sim'}",
+            *[str(src) for src in sources],
+            "-o", str(Path(tmp) / "pid_sim"), "-lm",
+        ]
+        result = subprocess.run(cmd, capture_output=True, text=True)
+
+    if result.returncode != 0:
+        print(result.stdout + result.stderr)
+        print(f"[FAIL] SIM_SOURCES of {SCRIPT.name} does not link")
+        return 1
+    print(f"[OK] SIM_SOURCES links ({len(sources)} files)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,26 @@
+/*
+ * @file    pid_reference.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   pid_compute() reference runs for the C++ tests
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "pid_reference.h"
+#include "../firmware/include/pid.h"
+
+void pid_reference_run(const float gains[9],
+                       const float *setpoints,
+                       const float *measurements,
+                       float *outputs,
+                       size_t count)
+{
+    pid_t pid;
+
+    pid_init_advanced(&pid, gains[0], gains[1], gains[2], gains[3], gains[4], gains[5],
+                      gains[6], gains[7], gains[8]);
+    for (size_t i = 0; i < count; i++) {
+        outputs[i] = pid_compute(&pid, setpoints[i], measurements[i]);
+    }
+}
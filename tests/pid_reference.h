@@ -0,0 +1,43 @@
+/*
+ * @file    pid_reference.h
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   pid_compute() reference runs for the C++ tests
+ *
+ * C++ test files cannot include pid.h next to the standard library on
+ * POSIX systems (pid_t clashes with <sys/types.h>), so they call
+ * pid_compute() through this C wrapper instead.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef PID_REFERENCE_H_
+#define PID_REFERENCE_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Run pid_init_advanced() + pid_compute() over a sample sequence
+ *
+ * @param gains         kp, ki, kd, dt, out_min, out_max, integrator_min,
+ *                      integrator_max, derivative_lpf (in that order)
+ * @param setpoints     Setpoint per sample
+ * @param measurements  Measurement per sample
+ * @param outputs       Receives pid_compute() per sample
+ * @param count         Number of samples
+ */
+void pid_reference_run(const float gains[9],
+                       const float *setpoints,
+                       const float *measurements,
+                       float *outputs,
+                       size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PID_REFERENCE_H_ */
@@ -0,0 +1,128 @@
+/*
+ * @file    test_motor.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the motor plant model
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/motor.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* Test: Init uses default parameters and zero state */
+void test_motor_model_init_defaults(void)
+{
+    motor_model_t motor;
+    motor_model_init(&motor);
+
+    TEST_ASSERT_EQUAL_FLOAT(MOTOR_MODEL_DEFAULT_GAIN, motor.gain);
+    TEST_ASSERT_EQUAL_FLOAT(MOTOR_MODEL_DEFAULT_ALPHA, motor.alpha);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, motor_model_get_speed(&motor));
+}
+
+/* Test: First-order step: speed[1] = alpha * gain * u */
+void test_motor_model_first_order_step(void)
+{
+    motor_model_t motor;
+    motor_model_init_advanced(&motor, 2.0f, 0.5f);
+
+    motor_model_set_output(&motor, 1.0f);
+    motor_model_update(&motor);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, motor_model_get_speed(&motor));
+
+    motor_model_update(&motor);
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, motor_model_get_speed(&motor));
+}
+
+/* Test: Output is clamped to [-1, 1] */
+void test_motor_model_output_clamp(void)
+{
+    motor_model_t motor;
+    motor_model_init_advanced(&motor, 1.0f, 1.0f);
+
+    motor_model_set_output(&motor, 5.0f);
+    motor_model_update(&motor);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, motor_model_get_speed(&motor));
+
+    motor_model_set_output(&motor, -5.0f);
+    motor_model_update(&motor);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, motor_model_get_speed(&motor));
+}
+
+/* Test: Instances evolve independently */
+void test_motor_model_instances_independent(void)
+{
+    motor_model_t a, b;
+    motor_model_init(&a);
+    motor_model_init(&b);
+
+    motor_model_set_output(&a, 1.0f);
+    for (int i = 0; i < 10; i++) {
+        motor_model_update(&a);
+        motor_model_update(&b);
+    }
+
+    TEST_ASSERT_TRUE(motor_model_get_speed(&a) > 0.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, motor_model_get_speed(&b));
+}
+
+/* Test: Single-motor API matches an explicit default instance */
+void test_motor_legacy_api_matches_instance(void)
+{
+    motor_model_t motor;
+    motor_model_init(&motor);
+    motor_init();
+
+    for (int i = 0; i < 50; i++) {
+        float u = (i < 25) ? 0.7f : -0.3f;
+        motor_set_output(u);
+        motor_model_set_output(&motor, u);
+        motor_update();
+        motor_model_update(&motor);
+    }
+
+    TEST_ASSERT_EQUAL_FLOAT(motor_model_get_speed(&motor), motor_get_speed());
+}
+
+/* Test: Variable-length step composes like repeated nominal steps */
+void test_motor_model_update_dt(void)
+{
+    motor_model_t stepped, one, two;
+    motor_model_init(&stepped);
+    motor_model_init(&one);
+    motor_model_init(&two);
+    motor_model_set_output(&stepped, 0.5f);
+    motor_model_set_output(&one, 0.5f);
+    motor_model_set_output(&two, 0.5f);
+
+    motor_model_update(&stepped);
+    motor_model_update_dt(&one, 1.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, motor_model_get_speed(&stepped), motor_model_get_speed(&one));
+
+    motor_model_update(&stepped);
+    motor_model_update_dt(&two, 2.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, motor_model_get_speed(&stepped), motor_model_get_speed(&two));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_motor_model_init_defaults);
+    RUN_TEST(test_motor_model_first_order_step);
+    RUN_TEST(test_motor_model_output_clamp);
+    RUN_TEST(test_motor_model_instances_independent);
+    RUN_TEST(test_motor_legacy_api_matches_instance);
+    RUN_TEST(test_motor_model_update_dt);
+
+    return UNITY_END();
+}
@@ -0,0 +1,155 @@
+/*
+ * @file    test_motor_bank.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the structure-of-arrays motor bank
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/motor_bank.h"
+#include "../firmware/include/pid_bank.h"
+#include <string.h>
+
+#define NUM_MOTORS  21    /* Not a multiple of the vector width: exercises the tail */
+#define NUM_STEPS   300
+
+static float storage[MOTOR_BANK_STORAGE_SIZE(NUM_MOTORS)];
+static motor_bank_t bank;
+static motor_model_t reference[NUM_MOTORS];
+
+void setUp(void)
+{
+    motor_bank_init(&bank, storage, NUM_MOTORS);
+}
+
+void tearDown(void)
+{
+}
+
+/* Give every motor its own gain and time constant */
+static void configure_motors(void)
+{
+    for (int i = 0; i < NUM_MOTORS; i++) {
+        motor_model_init_advanced(&reference[i], 1.0f + 0.5f * (float)i, 0.01f + 0.02f * (float)i);
+        motor_bank_load(&bank, (size_t)i, &reference[i]);
+    }
+}
+
+/* Bitwise float comparison (bit-identical, not approximately equal) */
+static int same_bits(float a, float b)
+{
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+/* Test: Init matches motor_model_init() for every lane */
+void test_motor_bank_init_defaults(void)
+{
+    TEST_ASSERT_EQUAL(NUM_MOTORS, bank.capacity);
+    for (int i = 0; i < NUM_MOTORS; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(MOTOR_MODEL_DEFAULT_GAIN, bank.model_gain[i]);
+        TEST_ASSERT_EQUAL_FLOAT(MOTOR_MODEL_DEFAULT_ALPHA, bank.model_alpha[i]);
+        TEST_ASSERT_EQUAL_FLOAT(0.0f, bank.speed[i]);
+        TEST_ASSERT_EQUAL_FLOAT(0.0f, bank.output[i]);
+    }
+}
+
+/* Test: Load followed by store round-trips a motor */
+void test_motor_bank_load_store_roundtrip(void)
+{
+    motor_model_t src, dst;
+    motor_model_init_advanced(&src, 3.0f, 0.2f);
+    motor_model_set_output(&src, 0.4f);
+    motor_model_update(&src);
+
+    motor_bank_load(&bank, 5, &src);
+    motor_bank_store(&bank, 5, &dst);
+
+    TEST_ASSERT_EQUAL_FLOAT(src.gain, dst.gain);
+    TEST_ASSERT_EQUAL_FLOAT(src.alpha, dst.alpha);
+    TEST_ASSERT_EQUAL_FLOAT(src.speed, dst.speed);
+    TEST_ASSERT_EQUAL_FLOAT(src.output, dst.output);
+}
+
+/* Test: Outputs are clamped like motor_model_set_output() */
+void test_motor_bank_set_outputs_clamps(void)
+{
+    float duty[NUM_MOTORS];
+    for (int i = 0; i < NUM_MOTORS; i++) {
+        duty[i] = -2.5f + 0.25f * (float)i;
+    }
+
+    motor_bank_set_outputs(&bank, duty, NUM_MOTORS);
+
+    for (int i = 0; i < NUM_MOTORS; i++) {
+        motor_model_t motor;
+        motor_model_init(&motor);
+        motor_model_set_output(&motor, duty[i]);
+        TEST_ASSERT_TRUE(same_bits(motor.output, bank.output[i]));
+    }
+}
+
+/* Test: Closed loop with a PID bank is bit-identical to per-motor calls */
+void test_motor_bank_closed_loop_matches_scalar(void)
+{
+    static float pid_storage[PID_BANK_STORAGE_SIZE(NUM_MOTORS)];
+    pid_bank_t pids;
+    pid_t pid_ref[NUM_MOTORS];
+    float sp[NUM_MOTORS], duty[NUM_MOTORS];
+
+    configure_motors();
+    pid_bank_init(&pids, pid_storage, NUM_MOTORS);
+    for (int i = 0; i < NUM_MOTORS; i++) {
+        pid_init_advanced(&pid_ref[i], 0.8f, 0.3f, 0.05f, 0.01f,
+                          -1.0f, 1.0f, -10.0f, 10.0f, (i % 2) ? 0.8f : 0.0f);
+        pid_bank_load(&pids, (size_t)i, &pid_ref[i]);
+        sp[i] = 0.5f * (float)(i % 7);
+    }
+
+    for (int step = 0; step < NUM_STEPS; step++) {
+        pid_bank_compute(&pids, sp, bank.speed, duty, NUM_MOTORS);
+        motor_bank_set_outputs(&bank, duty, NUM_MOTORS);
+        motor_bank_update(&bank, NUM_MOTORS);
+
+        for (int i = 0; i < NUM_MOTORS; i++) {
+            float output = pid_compute(&pid_ref[i], sp[i], motor_model_get_speed(&reference[i]));
+            motor_model_set_output(&reference[i], output);
+            motor_model_update(&reference[i]);
+        }
+    }
+
+    for (int i = 0; i < NUM_MOTORS; i++) {
+        TEST_ASSERT_TRUE_MESSAGE(same_bits(motor_model_get_speed(&reference[i]), bank.speed[i]),
+                                 "Bank speed differs from motor_model_update()");
+    }
+}
+
+/* Test: Partial update leaves motors beyond n untouched */
+void test_motor_bank_partial_update(void)
+{
+    float duty[NUM_MOTORS];
+    for (int i = 0; i < NUM_MOTORS; i++) {
+        duty[i] = 1.0f;
+    }
+
+    motor_bank_set_outputs(&bank, duty, 3);
+    motor_bank_update(&bank, NUM_MOTORS);
+
+    TEST_ASSERT_TRUE(bank.speed[2] > 0.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, bank.output[3]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, bank.speed[3]);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_motor_bank_init_defaults);
+    RUN_TEST(test_motor_bank_load_store_roundtrip);
+    RUN_TEST(test_motor_bank_set_outputs_clamps);
+    RUN_TEST(test_motor_bank_closed_loop_matches_scalar);
+    RUN_TEST(test_motor_bank_partial_update);
+
+    return UNITY_END();
+}
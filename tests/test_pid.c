@@ -200,6 +200,133 @@ void test_pid_integral_accumulation(void)
     TEST_ASSERT_LESS_OR_EQUAL(10.1f, pid.integrator);
 }
 
+/* Test: Init precomputes coefficients for the fast path */
+void test_pid_init_precomputes_coefficients(void)
+{
+    pid_t pid;
+    pid_init_advanced(&pid, 1.0f, 0.5f, 0.2f, 0.01f, -100.0f, 100.0f,
+                      -50.0f, 50.0f, 0.75f);
+
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, pid.inv_dt);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, pid.kd_inv_dt);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, pid.lpf_complement);
+}
+
+/* Test: Fast path tracks pid_compute() with and without filtering */
+void test_pid_compute_fast_matches_compute(void)
+{
+    pid_t ref, fast, ref_lpf, fast_lpf;
+    pid_init(&ref, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f);
+    pid_init(&fast, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f);
+    pid_init_advanced(&ref_lpf, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f, -5.0f, 5.0f, 0.8f);
+    pid_init_advanced(&fast_lpf, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f, -5.0f, 5.0f, 0.8f);
+
+    for (int i = 0; i < 500; i++) {
+        float measurement = 3.0f * (1.0f - expf(-0.01f * (float)i)) + 0.02f * (float)(i % 5);
+
+        float expected = pid_compute(&ref, 3.0f, measurement);
+        float actual = pid_compute_fast(&fast, 3.0f, measurement);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, expected, actual);
+
+        expected = pid_compute(&ref_lpf, 3.0f, measurement);
+        actual = pid_compute_fast(&fast_lpf, 3.0f, measurement);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, expected, actual);
+    }
+
+    // Integrator state keeps the same units
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, ref.integrator, fast.integrator);
+}
+
+/* Test: Variable-dt path at the nominal interval tracks pid_compute() */
+void test_pid_compute_dt_nominal_matches_compute(void)
+{
+    pid_t ref, var;
+    pid_init_advanced(&ref, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f, -5.0f, 5.0f, 0.8f);
+    pid_init_advanced(&var, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f, -5.0f, 5.0f, 0.8f);
+
+    for (int i = 0; i < 500; i++) {
+        float measurement = 3.0f * (1.0f - expf(-0.01f * (float)i)) + 0.02f * (float)(i % 5);
+
+        float expected = pid_compute(&ref, 3.0f, measurement);
+        float actual = pid_compute_dt(&var, 3.0f, measurement, 0.01f);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5f, expected, actual);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, ref.integrator, var.integrator);
+}
+
+/* Test: Derivative and integral use the measured interval */
+void test_pid_compute_dt_uses_measured_interval(void)
+{
+    pid_t pid;
+
+    /* 1% late: Newton step, relative error deviation^2 = 1e-4 */
+    pid_init(&pid, 0.0f, 0.0f, 1.0f, 0.01f, -1000.0f, 1000.0f);
+    pid_compute_dt(&pid, 0.0f, 0.0f, 0.01f);
+    float output = pid_compute_dt(&pid, 0.0f, -1.0f, 0.0101f);
+    TEST_ASSERT_FLOAT_WITHIN(2e-4f * (1.0f / 0.0101f), 1.0f / 0.0101f, output);
+
+    /* Twice the nominal interval: exact division */
+    pid_init(&pid, 0.0f, 0.0f, 1.0f, 0.01f, -1000.0f, 1000.0f);
+    pid_compute_dt(&pid, 0.0f, 0.0f, 0.01f);
+    output = pid_compute_dt(&pid, 0.0f, -1.0f, 0.02f);
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, output);
+
+    /* Integrator accumulates error * dt_actual */
+    pid_init(&pid, 0.0f, 1.0f, 0.0f, 0.01f, -10.0f, 10.0f);
+    pid_compute_dt(&pid, 1.0f, 0.0f, 0.012f);
+    pid_compute_dt(&pid, 1.0f, 0.0f, 0.007f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.019f, pid.integrator);
+}
+
+/* Test: Changing gains keeps the integral term and the fast path in step */
+void test_pid_set_gains_is_bumpless(void)
+{
+    pid_t pid;
+
+    pid_init(&pid, 0.5f, 0.4f, 0.0f, 0.01f, -10.0f, 10.0f);
+    for (int i = 0; i < 200; i++) {
+        pid_compute(&pid, 1.0f, 0.5f);
+    }
+    float integral = pid.ki * pid.integrator;
+
+    /* Doubling ki halves the accumulator; output stays continuous */
+    pid_set_gains(&pid, 0.5f, 0.8f, 0.02f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, integral, pid.ki * pid.integrator);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, -10.0f / 0.8f, pid.integrator_min);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 10.0f / 0.8f, pid.integrator_max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.5f * 0.5f + integral + 0.8f * 0.5f * 0.01f,
+                             pid_compute_fast(&pid, 1.0f, 0.5f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 2.0f, pid.kd_inv_dt);
+
+    /* Integral switched off, then on again from zero */
+    pid_set_gains(&pid, 0.5f, 0.0f, 0.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.25f, pid_compute(&pid, 1.0f, 0.5f));
+    pid_set_gains(&pid, 0.5f, 0.3f, 0.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, pid.integrator);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 10.0f / 0.3f, pid.integrator_max);
+}
+
+/* Test: pid_set_gains() keeps the integral-term bound of custom limits */
+void test_pid_set_gains_keeps_custom_integrator_limits(void)
+{
+    pid_t pid;
+
+    /* Integral term limited to [-0.1, 0.2] (ki 0.5), well inside the output range */
+    pid_init_advanced(&pid, 0.5f, 0.5f, 0.0f, 0.01f, -10.0f, 10.0f, -0.2f, 0.4f, 0.0f);
+
+    /* Scheduled gains: ki changes every sample */
+    for (int i = 0; i < 500; i++) {
+        pid_set_gains(&pid, 0.5f, 0.5f + 0.001f * (float)i, 0.0f);
+        pid_compute(&pid, 1.0f, 0.0f);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5f, -0.1f, pid.ki * pid.integrator_min);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.2f, pid.ki * pid.integrator_max);
+    }
+
+    /* Windup stopped at the custom bound, not at out_max */
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.2f, pid.ki * pid.integrator);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.5f + 0.2f, pid_compute(&pid, 1.0f, 0.0f));
+}
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -216,6 +343,12 @@ int main(void)
     RUN_TEST(test_pid_negative_error);
     RUN_TEST(test_pid_derivative_kick);
     RUN_TEST(test_pid_integral_accumulation);
+    RUN_TEST(test_pid_init_precomputes_coefficients);
+    RUN_TEST(test_pid_compute_fast_matches_compute);
+    RUN_TEST(test_pid_compute_dt_nominal_matches_compute);
+    RUN_TEST(test_pid_compute_dt_uses_measured_interval);
+    RUN_TEST(test_pid_set_gains_is_bumpless);
+    RUN_TEST(test_pid_set_gains_keeps_custom_integrator_limits);
 
     return UNITY_END();
 }
@@ -0,0 +1,189 @@
+/*
+ * @file    test_pid_autotune.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the relay-feedback auto-tuner against the motor model
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/pid.h"
+#include "../firmware/include/pid_autotune.h"
+#include "../firmware/include/motor.h"
+#include <math.h>
+
+#define DT           0.01f
+#define SETPOINT     2.0f
+#define RELAY_D      0.3f
+#define HYSTERESIS   0.05f
+#define MAX_STEPS    5000u
+#define SETTLE_STEPS 1000
+
+static motor_model_t motor;
+static pid_autotune_t tune;
+
+void setUp(void)
+{
+    motor_model_init(&motor);
+    pid_autotune_init_advanced(&tune, SETPOINT, SETPOINT / MOTOR_MODEL_DEFAULT_GAIN,
+                               RELAY_D, HYSTERESIS, DT, PID_AUTOTUNE_DEFAULT_CYCLES,
+                               MAX_STEPS);
+}
+
+void tearDown(void)
+{
+}
+
+static float trace[MAX_STEPS];
+
+/* Run the relay experiment on the motor model; returns the step count */
+static uint32_t run_relay(void)
+{
+    uint32_t steps = 0;
+
+    while (pid_autotune_status(&tune) == PID_AUTOTUNE_RUNNING) {
+        float speed = motor_model_get_speed(&motor);
+
+        trace[steps++] = speed;
+        motor_model_set_output(&motor, pid_autotune_step(&tune, speed));
+        motor_model_update(&motor);
+    }
+    return steps;
+}
+
+/* Test: Relay experiment identifies the limit cycle of the motor model */
+void test_pid_autotune_identifies_motor(void)
+{
+    uint32_t steps = run_relay();
+    float peak_max = -1e9f, peak_min = 1e9f;
+
+    TEST_ASSERT_EQUAL_INT(PID_AUTOTUNE_DONE, pid_autotune_status(&tune));
+    TEST_ASSERT_TRUE(steps < MAX_STEPS);
+
+    /* Extremes over the measured cycles, which end with the last sample */
+    for (uint32_t i = steps - 1u - tune.period_sum; i < steps; i++) {
+        if (trace[i] > peak_max) peak_max = trace[i];
+        if (trace[i] < peak_min) peak_min = trace[i];
+    }
+
+    /* The limit cycle is still converging slowly, so the per-cycle average
+     * and the extremes of the whole window agree to within a fraction of
+     * a percent; the period is a whole number of samples */
+    float a = 0.5f * (peak_max - peak_min);
+    float ku = 4.0f * RELAY_D / (3.14159265f * sqrtf(a * a - HYSTERESIS * HYSTERESIS));
+    TEST_ASSERT_FLOAT_WITHIN(1e-2f * ku, ku, tune.ku);
+    TEST_ASSERT_TRUE(tune.tu > 2.0f * DT);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, roundf(tune.tu / DT) * DT, tune.tu);
+}
+
+/* Test: Relay output is bias +/- amplitude, then holds bias */
+void test_pid_autotune_output_levels(void)
+{
+    const float bias = SETPOINT / MOTOR_MODEL_DEFAULT_GAIN;
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, bias + RELAY_D, pid_autotune_step(&tune, 0.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, bias + RELAY_D, pid_autotune_step(&tune, SETPOINT));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, bias - RELAY_D,
+                             pid_autotune_step(&tune, SETPOINT + 2.0f * HYSTERESIS));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, bias - RELAY_D, pid_autotune_step(&tune, SETPOINT));
+
+    run_relay();
+    TEST_ASSERT_EQUAL_FLOAT(bias, pid_autotune_step(&tune, 0.0f));
+}
+
+/* Test: Every rule yields a controller that settles the motor model */
+void test_pid_autotune_apply_settles_motor(void)
+{
+    const pid_tune_rule_t rules[] = {
+        PID_TUNE_ZIEGLER_NICHOLS, PID_TUNE_TYREUS_LUYBEN, PID_TUNE_NO_OVERSHOOT
+    };
+
+    run_relay();
+    TEST_ASSERT_EQUAL_INT(PID_AUTOTUNE_DONE, pid_autotune_status(&tune));
+
+    for (size_t r = 0; r < sizeof(rules) / sizeof(rules[0]); r++) {
+        pid_t pid;
+
+        TEST_ASSERT_EQUAL_INT(0, pid_autotune_apply(&tune, rules[r], &pid, -1.0f, 1.0f, 0.0f));
+        TEST_ASSERT_EQUAL_FLOAT(DT, pid.dt);
+
+        motor_model_init(&motor);
+        for (int step = 0; step < SETTLE_STEPS; step++) {
+            float speed = motor_model_get_speed(&motor);
+            motor_model_set_output(&motor, pid_compute(&pid, SETPOINT, speed));
+            motor_model_update(&motor);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, SETPOINT, motor_model_get_speed(&motor));
+    }
+}
+
+/* Test: Gains follow the rule constants */
+void test_pid_autotune_rule_gains(void)
+{
+    float kp, ki, kd;
+
+    run_relay();
+
+    TEST_ASSERT_EQUAL_INT(0, pid_autotune_gains(&tune, PID_TUNE_ZIEGLER_NICHOLS, &kp, &ki, &kd));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f * kp, 0.6f * tune.ku, kp);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f * ki, kp / (0.5f * tune.tu), ki);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f * kd, kp * tune.tu / 8.0f, kd);
+
+    TEST_ASSERT_EQUAL_INT(0, pid_autotune_gains(&tune, PID_TUNE_TYREUS_LUYBEN, &kp, &ki, &kd));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f * kp, tune.ku / 2.2f, kp);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f * ki, kp / (2.2f * tune.tu), ki);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f * kd, kp * tune.tu / 6.3f, kd);
+}
+
+/* Test: A plant that never crosses the setpoint times out */
+void test_pid_autotune_timeout(void)
+{
+    pid_t pid;
+    float kp, ki, kd;
+
+    pid_init(&pid, 1.0f, 0.5f, 0.0f, DT, -1.0f, 1.0f);
+
+    for (uint32_t step = 0; step < MAX_STEPS; step++) {
+        pid_autotune_step(&tune, 0.0f);
+    }
+    TEST_ASSERT_EQUAL_INT(PID_AUTOTUNE_FAILED, pid_autotune_status(&tune));
+    TEST_ASSERT_EQUAL_INT(-1, pid_autotune_gains(&tune, PID_TUNE_ZIEGLER_NICHOLS, &kp, &ki, &kd));
+    TEST_ASSERT_EQUAL_INT(-1, pid_autotune_apply(&tune, PID_TUNE_ZIEGLER_NICHOLS, &pid,
+                                                 -1.0f, 1.0f, 0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, pid.kp);
+}
+
+/* Test: The relay only switches on excursions beyond the hysteresis band */
+void test_pid_autotune_hysteresis_band(void)
+{
+    /* Square wave of amplitude 0.1 around the setpoint: a 0.09 band still
+     * switches every sample, a 0.1 band never does */
+    pid_autotune_init(&tune, 0.0f, 0.0f, 1.0f, 0.09f, DT);
+
+    for (int step = 0; step < 200 && pid_autotune_status(&tune) == PID_AUTOTUNE_RUNNING; step++) {
+        pid_autotune_step(&tune, (step & 1) ? 0.1f : -0.1f);
+    }
+    TEST_ASSERT_EQUAL_INT(PID_AUTOTUNE_DONE, pid_autotune_status(&tune));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 2.0f * DT, tune.tu);
+
+    pid_autotune_init(&tune, 0.0f, 0.0f, 1.0f, 0.1f, DT);
+    for (int step = 0; step < 200; step++) {
+        pid_autotune_step(&tune, (step & 1) ? 0.1f : -0.1f);
+    }
+    TEST_ASSERT_EQUAL_INT(PID_AUTOTUNE_RUNNING, pid_autotune_status(&tune));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pid_autotune_identifies_motor);
+    RUN_TEST(test_pid_autotune_output_levels);
+    RUN_TEST(test_pid_autotune_apply_settles_motor);
+    RUN_TEST(test_pid_autotune_rule_gains);
+    RUN_TEST(test_pid_autotune_timeout);
+    RUN_TEST(test_pid_autotune_hysteresis_band);
+
+    return UNITY_END();
+}
@@ -0,0 +1,248 @@
+/*
+ * @file    test_pid_bank.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the structure-of-arrays PID bank
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/pid_bank.h"
+#include <math.h>
+#include <string.h>
+
+#define NUM_LANES  16
+#define NUM_STEPS  200
+
+static float storage[PID_BANK_STORAGE_SIZE(NUM_LANES)];
+static pid_bank_t bank;
+static pid_t reference[NUM_LANES];
+
+void setUp(void)
+{
+    pid_bank_init(&bank, storage, NUM_LANES);
+}
+
+void tearDown(void)
+{
+}
+
+/* Configure a mix of P-only, PID, filtered and saturating lanes */
+static void configure_lanes(void)
+{
+    for (int i = 0; i < NUM_LANES; i++) {
+        float kp = 0.5f + 0.25f * (float)i;
+        float ki = (i % 4 == 0) ? 0.0f : 0.1f * (float)i;
+        float kd = (i % 3 == 0) ? 0.0f : 0.01f * (float)i;
+
+        if (i % 2 == 0) {
+            pid_init(&reference[i], kp, ki, kd, 0.01f, -1.0f, 1.0f);
+        } else {
+            pid_init_advanced(&reference[i], kp, ki, kd, 0.001f * (float)i,
+                              -5.0f, 5.0f, -2.0f, 2.0f, 0.05f * (float)i);
+        }
+        pid_bank_load(&bank, (size_t)i, &reference[i]);
+    }
+}
+
+/* Bitwise float comparison (bit-identical, not approximately equal) */
+static int same_bits(float a, float b)
+{
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+/* Test: Init zeroes state and leaves lanes safe to compute */
+void test_pid_bank_init_clears_state(void)
+{
+    TEST_ASSERT_EQUAL(NUM_LANES, bank.capacity);
+    for (int i = 0; i < NUM_LANES; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(0.0f, bank.integrator[i]);
+        TEST_ASSERT_EQUAL_FLOAT(0.0f, bank.prev_measurement[i]);
+        TEST_ASSERT_EQUAL_FLOAT(0.0f, bank.derivative_filtered[i]);
+    }
+
+    // Unconfigured lanes output zero rather than NaN
+    float sp[NUM_LANES] = {0};
+    float meas[NUM_LANES] = {0};
+    float out[NUM_LANES];
+    pid_bank_compute(&bank, sp, meas, out, NUM_LANES);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, out[0]);
+}
+
+/* Test: Load followed by store round-trips a controller */
+void test_pid_bank_load_store_roundtrip(void)
+{
+    pid_t src, dst;
+    pid_init_advanced(&src, 1.0f, 0.5f, 0.1f, 0.01f, -10.0f, 10.0f, -3.0f, 3.0f, 0.8f);
+    pid_compute(&src, 5.0f, 1.0f);
+    pid_compute(&src, 5.0f, 2.0f);
+
+    pid_bank_load(&bank, 3, &src);
+    pid_bank_store(&bank, 3, &dst);
+
+    TEST_ASSERT_EQUAL_FLOAT(src.kp, dst.kp);
+    TEST_ASSERT_EQUAL_FLOAT(src.integrator_max, dst.integrator_max);
+    TEST_ASSERT_EQUAL_FLOAT(src.derivative_lpf, dst.derivative_lpf);
+    TEST_ASSERT_EQUAL_FLOAT(src.integrator, dst.integrator);
+    TEST_ASSERT_EQUAL_FLOAT(src.prev_measurement, dst.prev_measurement);
+    TEST_ASSERT_EQUAL_FLOAT(src.derivative_filtered, dst.derivative_filtered);
+}
+
+/* Test: Every lane is bit-identical to pid_compute() over a long run */
+void test_pid_bank_matches_scalar(void)
+{
+    configure_lanes();
+
+    float sp[NUM_LANES], meas[NUM_LANES], out[NUM_LANES];
+    for (int step = 0; step < NUM_STEPS; step++) {
+        for (int i = 0; i < NUM_LANES; i++) {
+            // Setpoint steps and a noisy, sometimes saturating measurement
+            sp[i] = (step < NUM_STEPS / 2) ? 3.0f : -2.0f * (float)i;
+            meas[i] = 2.0f * sinf(0.05f * (float)(step + i)) + 0.1f * (float)(step % 7);
+        }
+
+        pid_bank_compute(&bank, sp, meas, out, NUM_LANES);
+
+        for (int i = 0; i < NUM_LANES; i++) {
+            float expected = pid_compute(&reference[i], sp[i], meas[i]);
+            TEST_ASSERT_TRUE_MESSAGE(same_bits(expected, out[i]),
+                                     "Bank output differs from pid_compute()");
+        }
+    }
+
+    // Internal state matches as well
+    for (int i = 0; i < NUM_LANES; i++) {
+        pid_t lane;
+        pid_bank_store(&bank, (size_t)i, &lane);
+        TEST_ASSERT_TRUE(same_bits(reference[i].integrator, lane.integrator));
+        TEST_ASSERT_TRUE(same_bits(reference[i].derivative_filtered, lane.derivative_filtered));
+    }
+}
+
+/* Test: Every kernel matches pid_compute() bit for bit, including the
+ * scalar tail (lane count deliberately not a multiple of 8) */
+void test_pid_bank_kernels_match_scalar(void)
+{
+    static const pid_bank_kernel_t kernels[] = {
+        PID_BANK_KERNEL_SCALAR, PID_BANK_KERNEL_SSE41, PID_BANK_KERNEL_AVX2
+    };
+    const size_t lanes = NUM_LANES - 3;
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (!pid_bank_kernel_supported(kernels[k])) {
+            continue;
+        }
+
+        pid_bank_init(&bank, storage, NUM_LANES);
+        configure_lanes();
+
+        float sp[NUM_LANES], meas[NUM_LANES], out[NUM_LANES];
+        for (int step = 0; step < NUM_STEPS; step++) {
+            for (size_t i = 0; i < lanes; i++) {
+                sp[i] = (step % 50 < 25) ? 4.0f : -4.0f;
+                meas[i] = 3.0f * cosf(0.1f * (float)step + (float)i);
+            }
+
+            pid_bank_compute_with(kernels[k], &bank, sp, meas, out, lanes);
+
+            for (size_t i = 0; i < lanes; i++) {
+                float expected = pid_compute(&reference[i], sp[i], meas[i]);
+                TEST_ASSERT_TRUE_MESSAGE(same_bits(expected, out[i]),
+                                         "Kernel output differs from pid_compute()");
+            }
+        }
+    }
+}
+
+/* Test: Clamping keeps the sign of zero exactly like clamp() in pid.c */
+void test_pid_bank_clamp_signed_zero(void)
+{
+    pid_t ref;
+    pid_init(&ref, 1.0f, 0.0f, 0.0f, 0.01f, -1.0f, 0.0f);
+    ref.integrator = -0.0f;
+
+    for (size_t i = 0; i < NUM_LANES; i++) {
+        pid_bank_load(&bank, i, &ref);
+    }
+
+    // Every term is -0.0; min/max-based clamping to out_max = +0.0 would flip the sign
+    float sp[NUM_LANES], meas[NUM_LANES], out[NUM_LANES];
+    for (size_t i = 0; i < NUM_LANES; i++) {
+        sp[i] = -0.0f;
+        meas[i] = 0.0f;
+    }
+
+    float expected = pid_compute(&ref, -0.0f, 0.0f);
+    pid_bank_compute(&bank, sp, meas, out, NUM_LANES);
+
+    for (size_t i = 0; i < NUM_LANES; i++) {
+        TEST_ASSERT_TRUE(same_bits(expected, out[i]));
+    }
+}
+
+/* Test: Scalar kernel is always available and AUTO resolves to a real kernel */
+void test_pid_bank_kernel_selection(void)
+{
+    TEST_ASSERT_TRUE(pid_bank_kernel_supported(PID_BANK_KERNEL_SCALAR));
+    TEST_ASSERT_TRUE(pid_bank_kernel_supported(PID_BANK_KERNEL_AUTO));
+    TEST_ASSERT_TRUE(pid_bank_kernel_best() != PID_BANK_KERNEL_AUTO);
+    TEST_ASSERT_TRUE(pid_bank_kernel_supported(pid_bank_kernel_best()));
+}
+
+/* Test: Partial update leaves lanes beyond n untouched */
+void test_pid_bank_partial_update(void)
+{
+    configure_lanes();
+
+    float sp[NUM_LANES], meas[NUM_LANES], out[NUM_LANES];
+    for (int i = 0; i < NUM_LANES; i++) {
+        sp[i] = 10.0f;
+        meas[i] = 0.0f;
+        out[i] = 123.0f;
+    }
+
+    pid_bank_compute(&bank, sp, meas, out, 4);
+
+    TEST_ASSERT_TRUE(bank.integrator[1] != 0.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, bank.integrator[5]);
+    TEST_ASSERT_EQUAL_FLOAT(123.0f, out[5]);
+}
+
+/* Test: Reset clears state and preserves configuration */
+void test_pid_bank_reset(void)
+{
+    configure_lanes();
+
+    float sp[NUM_LANES], meas[NUM_LANES], out[NUM_LANES];
+    for (int i = 0; i < NUM_LANES; i++) {
+        sp[i] = 10.0f;
+        meas[i] = 1.0f;
+    }
+    pid_bank_compute(&bank, sp, meas, out, NUM_LANES);
+
+    pid_bank_reset(&bank);
+
+    for (int i = 0; i < NUM_LANES; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(0.0f, bank.integrator[i]);
+        TEST_ASSERT_EQUAL_FLOAT(0.0f, bank.prev_measurement[i]);
+        TEST_ASSERT_EQUAL_FLOAT(0.0f, bank.derivative_filtered[i]);
+        TEST_ASSERT_EQUAL_FLOAT(reference[i].kp, bank.kp[i]);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pid_bank_init_clears_state);
+    RUN_TEST(test_pid_bank_load_store_roundtrip);
+    RUN_TEST(test_pid_bank_matches_scalar);
+    RUN_TEST(test_pid_bank_kernels_match_scalar);
+    RUN_TEST(test_pid_bank_clamp_signed_zero);
+    RUN_TEST(test_pid_bank_kernel_selection);
+    RUN_TEST(test_pid_bank_partial_update);
+    RUN_TEST(test_pid_bank_reset);
+
+    return UNITY_END();
+}
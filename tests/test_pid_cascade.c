@@ -0,0 +1,145 @@
+/*
+ * @file    test_pid_cascade.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the multi-rate PID cascade
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/pid_cascade.h"
+
+#define BASE_DT 0.001f
+
+static pid_cascade_t cascade;
+
+void setUp(void)
+{
+    pid_cascade_init(&cascade, BASE_DT);
+}
+
+void tearDown(void)
+{
+}
+
+/* Append a stage configured with pid_init() at base dt * decimation */
+static void add_stage(float kp, float ki, float kd, float limit, uint32_t decimation)
+{
+    pid_t pid;
+
+    pid_init(&pid, kp, ki, kd, BASE_DT * (float)decimation, -limit, limit);
+    pid_cascade_add_stage(&cascade, &pid, decimation);
+}
+
+/* Test: Stage k runs every decimation[k] ticks and holds its output between */
+void test_pid_cascade_schedule(void)
+{
+    float measurements[3] = { 0.0f, 0.0f, 0.0f };
+
+    /* Proportional-only stages pass reference - measurement inwards */
+    add_stage(1.0f, 0.0f, 0.0f, 1e6f, 100);
+    add_stage(1.0f, 0.0f, 0.0f, 1e6f, 10);
+    add_stage(1.0f, 0.0f, 0.0f, 1e6f, 1);
+    TEST_ASSERT_EQUAL_UINT32(100, cascade.period);
+
+    for (uint32_t tick = 0; tick < 1000; tick++) {
+        measurements[0] = (float)tick;
+        measurements[1] = (float)tick;
+        measurements[2] = (float)tick;
+
+        float output = pid_cascade_step(&cascade, 5000.0f, measurements);
+
+        float position_out = 5000.0f - (float)(tick / 100u * 100u);
+        float velocity_out = position_out - (float)(tick / 10u * 10u);
+        TEST_ASSERT_EQUAL_FLOAT(position_out, pid_cascade_reference(&cascade, 1));
+        TEST_ASSERT_EQUAL_FLOAT(velocity_out, pid_cascade_reference(&cascade, 2));
+        TEST_ASSERT_EQUAL_FLOAT(velocity_out - (float)tick, output);
+    }
+
+    /* Reset restarts the schedule: every stage runs on the next tick */
+    pid_cascade_reset(&cascade);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, pid_cascade_reference(&cascade, 1));
+    measurements[0] = 7.0f;
+    pid_cascade_step(&cascade, 10.0f, measurements);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, pid_cascade_reference(&cascade, 1));
+}
+
+/* Test: Unsaturated cascade equals hand-wired loops with modulo scheduling */
+void test_pid_cascade_matches_hand_wired(void)
+{
+    pid_t position, velocity, current;
+    float position_out = 0.0f, velocity_out = 0.0f;
+
+    pid_init(&position, 2.0f, 0.5f, 0.0f, BASE_DT * 20.0f, -1e4f, 1e4f);
+    pid_init_advanced(&velocity, 0.8f, 4.0f, 0.01f, BASE_DT * 5.0f, -1e4f, 1e4f,
+                      -20.0f, 20.0f, 0.6f);
+    pid_init(&current, 0.5f, 20.0f, 0.0f, BASE_DT, -1e4f, 1e4f);
+    pid_cascade_add_stage(&cascade, &position, 20);
+    pid_cascade_add_stage(&cascade, &velocity, 5);
+    pid_cascade_add_stage(&cascade, &current, 1);
+
+    for (uint32_t tick = 0; tick < 2000; tick++) {
+        float measurements[3] = {
+            0.001f * (float)tick, 0.3f + 0.0001f * (float)(tick % 37), 0.01f * (float)(tick % 11)
+        };
+
+        if (tick % 20u == 0u) {
+            position_out = pid_compute_fast(&position, 2.0f, measurements[0]);
+        }
+        if (tick % 5u == 0u) {
+            velocity_out = pid_compute_fast(&velocity, position_out, measurements[1]);
+        }
+        float expected = pid_compute_fast(&current, velocity_out, measurements[2]);
+
+        TEST_ASSERT_EQUAL_FLOAT(expected, pid_cascade_step(&cascade, 2.0f, measurements));
+    }
+    TEST_ASSERT_EQUAL_FLOAT(velocity.integrator, pid_cascade_stage(&cascade, 1)->integrator);
+}
+
+/* Test: A clamped inner stage stops the outer integrator winding towards it */
+void test_pid_cascade_inner_saturation_blocks_outer_windup(void)
+{
+    float measurements[2] = { 0.0f, 0.0f };
+    pid_t *outer;
+
+    add_stage(1.0f, 10.0f, 0.0f, 100.0f, 10);
+    add_stage(1.0f, 0.0f, 0.0f, 1.0f, 1);
+    outer = pid_cascade_stage(&cascade, 0);
+
+    /* Inner pinned at +1: only the first outer step (before the inner
+     * stage had run) integrates, 10 * 0.01 */
+    for (int tick = 0; tick < 1000; tick++) {
+        TEST_ASSERT_EQUAL_FLOAT(1.0f, pid_cascade_step(&cascade, 10.0f, measurements));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.1f, outer->integrator);
+
+    /* Unwinding away from the block is allowed */
+    measurements[0] = 20.0f;
+    measurements[1] = -1000.0f;
+    for (int tick = 0; tick < 100; tick++) {
+        pid_cascade_step(&cascade, 10.0f, measurements);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.1f - 10.0f * 0.01f * 10.0f, outer->integrator);
+
+    /* Inner in range again: the outer stage integrates normally */
+    measurements[0] = 9.0f;
+    measurements[1] = 0.0f;
+    pid_cascade_reset(&cascade);
+    for (int tick = 0; tick < 100; tick++) {
+        pid_cascade_step(&cascade, 10.0f, measurements);
+        measurements[1] = pid_cascade_reference(&cascade, 1) - 0.5f;
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 10.0f * 1.0f * 0.01f, outer->integrator);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pid_cascade_schedule);
+    RUN_TEST(test_pid_cascade_matches_hand_wired);
+    RUN_TEST(test_pid_cascade_inner_saturation_blocks_outer_windup);
+
+    return UNITY_END();
+}
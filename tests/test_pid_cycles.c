@@ -0,0 +1,155 @@
+/*
+ * @file    test_pid_cycles.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the pid_compute() cycle-budget instrumentation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Built with PID_CYCLE_STATS=1 against its own copy of pid.c.
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/pid.h"
+#include "../firmware/include/pid_cycles.h"
+#include <string.h>
+
+static pid_cycle_stats_t stats;
+
+void setUp(void)
+{
+    pid_cycle_stats_reset(&stats);
+}
+
+void tearDown(void)
+{
+}
+
+static uint32_t histogram_total(const pid_cycle_stats_t *s)
+{
+    uint32_t total = 0;
+
+    for (unsigned bin = 0; bin < PID_CYCLE_HIST_BINS; bin++) {
+        total += s->histogram[bin];
+    }
+    return total;
+}
+
+/* Test: Min, max, mean and calls follow the recorded durations */
+void test_pid_cycle_stats_summary(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(0, pid_cycle_stats_mean(&stats));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, stats.min);
+
+    pid_cycle_stats_record(&stats, 40);
+    pid_cycle_stats_record(&stats, 10);
+    pid_cycle_stats_record(&stats, 100);
+
+    TEST_ASSERT_EQUAL_UINT32(3, stats.calls);
+    TEST_ASSERT_EQUAL_UINT32(10, stats.min);
+    TEST_ASSERT_EQUAL_UINT32(100, stats.max);
+    TEST_ASSERT_EQUAL_UINT32(50, pid_cycle_stats_mean(&stats));
+}
+
+/* Test: Bin k holds durations 2^k .. 2^(k+1)-1, zero in bin 0 */
+void test_pid_cycle_stats_histogram_bins(void)
+{
+    pid_cycle_stats_record(&stats, 0);
+    pid_cycle_stats_record(&stats, 1);
+    pid_cycle_stats_record(&stats, 2);
+    pid_cycle_stats_record(&stats, 3);
+    pid_cycle_stats_record(&stats, 1023);
+    pid_cycle_stats_record(&stats, 1024);
+    pid_cycle_stats_record(&stats, UINT32_MAX);
+
+    TEST_ASSERT_EQUAL_UINT32(2, stats.histogram[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.histogram[1]);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.histogram[9]);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.histogram[10]);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.histogram[31]);
+    TEST_ASSERT_EQUAL_UINT32(7, histogram_total(&stats));
+}
+
+/* Test: Calls over a budget are counted from the budget's bin up */
+void test_pid_cycle_stats_over_budget(void)
+{
+    for (uint32_t cycles = 1; cycles <= 1000; cycles++) {
+        pid_cycle_stats_record(&stats, cycles);
+    }
+
+    /* 512..1000 fall in bins 9 and up; a budget of 600 rounds down to 512 */
+    TEST_ASSERT_EQUAL_UINT32(489, pid_cycle_stats_over(&stats, 512));
+    TEST_ASSERT_EQUAL_UINT32(489, pid_cycle_stats_over(&stats, 600));
+    TEST_ASSERT_EQUAL_UINT32(1000, pid_cycle_stats_over(&stats, 0));
+    TEST_ASSERT_EQUAL_UINT32(0, pid_cycle_stats_over(&stats, 1024));
+}
+
+/* Test: pid_compute() and pid_compute_fast() record every call */
+void test_pid_compute_records_calls(void)
+{
+    pid_t pid;
+    const pid_cycle_stats_t *s;
+
+    pid_init(&pid, 1.0f, 0.5f, 0.1f, 0.01f, -1.0f, 1.0f);
+    s = pid_get_cycle_stats(&pid);
+    TEST_ASSERT_EQUAL_UINT32(0, s->calls);
+
+    for (int i = 0; i < 100; i++) {
+        pid_compute(&pid, 1.0f, 0.01f * (float)i);
+    }
+    for (int i = 0; i < 50; i++) {
+        pid_compute_fast(&pid, 1.0f, 0.01f * (float)i);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(150, s->calls);
+    TEST_ASSERT_EQUAL_UINT32(150, histogram_total(s));
+    TEST_ASSERT_TRUE(s->min <= pid_cycle_stats_mean(s));
+    TEST_ASSERT_TRUE(pid_cycle_stats_mean(s) <= s->max);
+
+    /* pid_reset() keeps the statistics, re-initialization clears them */
+    pid_reset(&pid);
+    TEST_ASSERT_EQUAL_UINT32(150, s->calls);
+    pid_reset_cycle_stats(&pid);
+    TEST_ASSERT_EQUAL_UINT32(0, s->calls);
+    pid_compute(&pid, 1.0f, 0.0f);
+    pid_init_advanced(&pid, 1.0f, 0.5f, 0.1f, 0.01f, -1.0f, 1.0f, -2.0f, 2.0f, 0.5f);
+    TEST_ASSERT_EQUAL_UINT32(0, s->calls);
+}
+
+/* Test: Dump prints the summary and one line per non-empty bin */
+void test_pid_cycle_stats_dump(void)
+{
+    char text[1024];
+    size_t length;
+    FILE *out = tmpfile();
+
+    TEST_ASSERT_NOT_NULL(out);
+    pid_cycle_stats_dump(&stats, "empty", out);
+    pid_cycle_stats_record(&stats, 5);
+    pid_cycle_stats_record(&stats, 6);
+    pid_cycle_stats_record(&stats, 300);
+    pid_cycle_stats_dump(&stats, "loop", out);
+
+    rewind(out);
+    length = fread(text, 1, sizeof(text) - 1, out);
+    text[length] = '\0';
+    fclose(out);
+
+    TEST_ASSERT_NOT_NULL(strstr(text, "empty: no calls recorded\n"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "loop: 3 calls, min 5 mean 103 max 300"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "[         4,          8)          2 ####"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "[       256,        512)          1 ####"));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pid_cycle_stats_summary);
+    RUN_TEST(test_pid_cycle_stats_histogram_bins);
+    RUN_TEST(test_pid_cycle_stats_over_budget);
+    RUN_TEST(test_pid_compute_records_calls);
+    RUN_TEST(test_pid_cycle_stats_dump);
+
+    return UNITY_END();
+}
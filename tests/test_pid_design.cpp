@@ -0,0 +1,158 @@
+/*
+ * @file    test_pid_design.cpp
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for compile-time closed-loop analysis and design
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/pid_design.hpp"
+#include <cmath>
+
+#define STEPS 4000
+#define GROWTH_STEP 400
+
+using pid::design::analyze;
+using pid::design::Plant;
+
+/* main.c tuning against the default motor model. Unfiltered, kd/dt = 5
+ * puts a pole near z = -1.40; in the demo the output clamp turns it into
+ * a chatter between about 0.16 and 1.0 */
+static constexpr auto demo_tuning = pid::Gains<double>::standard(0.8, 0.3, 0.05, 0.01, -1.0, 1.0);
+static constexpr auto demo_loop = analyze(demo_tuning);
+static_assert(!demo_loop.stable, "Unfiltered main.c tuning must be rejected");
+static_assert(demo_loop.stability_margin < 0.0, "Unstable loop has a negative margin");
+
+/* The same gains with the derivative filtered are stable */
+static constexpr pid::Gains<double> filtered_tuning{ 0.8, 0.3, 0.05, 0.01, -1.0, 1.0,
+                                                     -1.0 / 0.3, 1.0 / 0.3, 0.8 };
+static_assert(analyze(filtered_tuning).stable, "Filtered main.c tuning must be stable");
+static_assert(analyze(filtered_tuning).stability_margin > 0.0, "Stable loop has a positive margin");
+
+/* P gain large enough to push the single pole past z = -1 */
+static constexpr auto hot_tuning = pid::Gains<double>::standard(10.0, 0.0, 0.0, 0.01, -1.0, 1.0);
+static_assert(!pid::design::is_stable(hot_tuning), "kp = 10 must be rejected");
+
+/* Designed PI gains are stable by construction */
+static constexpr auto placed = pid::design::place_pi(Plant{}, 0.01, 0.9, -1.0, 1.0);
+static_assert(analyze(placed).stable, "Placed PI loop must be stable");
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* Simulate the loop of main.c with clamps out of reach, from speed 1 to setpoint 0 */
+static void simulate(const pid::Gains<double> &tuning, const Plant &plant, double *speed)
+{
+    pid::Gains<double> g = tuning;
+    g.out_min = -1e12;
+    g.out_max = 1e12;
+    g.integrator_min = -1e12;
+    g.integrator_max = 1e12;
+
+    pid::FullPid<double> controller(g);
+    double y = 1.0;
+
+    for (int n = 0; n < STEPS; n++) {
+        speed[n] = y;
+        double u = controller.compute(0.0, y);
+        y += plant.alpha * (plant.gain * u - y);
+    }
+}
+
+/* Test: Simulated speed obeys the characteristic polynomial, poles are its roots */
+void test_pid_design_poles_match_simulation(void)
+{
+    static double speed[STEPS];
+    const pid::Gains<double> cases[] = {
+        demo_tuning, filtered_tuning, hot_tuning,
+        pid::Gains<double>::standard(0.8, 0.0, 0.05, 0.01, -1.0, 1.0),
+        pid::Gains<double>::standard(0.0, 3.0, 0.0, 0.01, -1.0, 1.0),
+    };
+
+    for (const auto &tuning : cases) {
+        const auto loop = analyze(tuning);
+        const auto &q = loop.characteristic;
+
+        simulate(tuning, Plant{}, speed);
+        for (int n = 2; n + q.degree < 40; n++) {
+            double residual = 0.0;
+            double size = 0.0;
+            for (int k = 0; k <= q.degree; k++) {
+                residual += q.c[k] * speed[n + k];
+                size += std::fabs(q.c[k] * speed[n + k]);
+            }
+            TEST_ASSERT_TRUE(std::fabs(residual) <= 1e-9 * size);
+        }
+        for (int i = 0; i < loop.num_poles; i++) {
+            auto value = pid::design::detail::evaluate(q, loop.poles[i]);
+            TEST_ASSERT_TRUE(std::hypot(value.re, value.im) < 1e-9);
+        }
+
+        /* Stable loops decay, unstable ones grow */
+        if (loop.stable) {
+            TEST_ASSERT_TRUE(std::fabs(speed[STEPS - 1]) < 1e-3);
+        } else {
+            TEST_ASSERT_TRUE(std::fabs(speed[GROWTH_STEP]) > 1e3);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(3, demo_loop.num_poles);
+    TEST_ASSERT_EQUAL_INT(1, analyze(hot_tuning).num_poles);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, -1.55f, (float)analyze(hot_tuning).poles[0].re);
+}
+
+/* Test: Discretized coefficients match the textbook difference equation */
+void test_pid_design_discretized_coefficients(void)
+{
+    const double kp = 0.8, ki = 0.3, kd = 0.05, dt = 0.01;
+
+    /* num(z) / z^2 = b0 + b1 z^-1 + b2 z^-2, den(z) = z^2 - z */
+    TEST_ASSERT_EQUAL_INT(2, demo_loop.controller_num.degree);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9f, (float)(kp + ki * dt + kd / dt),
+                             (float)demo_loop.controller_num.c[2]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9f, (float)(-kp - 2.0 * kd / dt),
+                             (float)demo_loop.controller_num.c[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9f, (float)(kd / dt), (float)demo_loop.controller_num.c[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-12f, -1.0f, (float)demo_loop.controller_den.c[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-12f, 0.0f, (float)demo_loop.controller_den.c[0]);
+
+    /* Plant from motor.c */
+    TEST_ASSERT_FLOAT_WITHIN(1e-12f, 0.95f, (float)demo_loop.plant_pole);
+    TEST_ASSERT_FLOAT_WITHIN(1e-12f, 0.25f, (float)demo_loop.plant_gain);
+}
+
+/* Test: Pole placement lands both poles where requested */
+void test_pid_design_place_pi(void)
+{
+    const Plant slow{ 2.0, 0.02 };
+    const double targets[] = { 0.0, 0.5, 0.8, 0.95 };
+
+    for (double target : targets) {
+        const auto loop = analyze(pid::design::place_pi(slow, 0.01, target, -1.0, 1.0), slow);
+
+        TEST_ASSERT_TRUE(loop.stable);
+        TEST_ASSERT_EQUAL_INT(2, loop.num_poles);
+        for (int i = 0; i < loop.num_poles; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-5f, (float)target, (float)loop.poles[i].re);
+            TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.0f, (float)loop.poles[i].im);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(1e-5f, (float)(1.0 - target), (float)loop.stability_margin);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pid_design_poles_match_simulation);
+    RUN_TEST(test_pid_design_discretized_coefficients);
+    RUN_TEST(test_pid_design_place_pi);
+
+    return UNITY_END();
+}
@@ -0,0 +1,203 @@
+/*
+ * @file    test_pid_fixed.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Equivalence tests for the Q31/Q15 PID against the float PID
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/pid.h"
+#include "../firmware/include/pid_fixed.h"
+#include <math.h>
+
+#define NUM_STEPS     1000
+#define Q31_TOL       1e-5f    /* ~2^-17: rounding of Q31 coefficients */
+#define Q15_TOL       2e-4f    /* a few Q15 LSBs of input/output quantization */
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static int32_t to_q31(float x)
+{
+    double scaled = (double)x * 2147483648.0;
+    if (scaled >= 2147483647.0) return INT32_MAX;
+    if (scaled <= -2147483648.0) return INT32_MIN;
+    return (int32_t)lrint(scaled);
+}
+
+static int16_t to_q15(float x)
+{
+    double scaled = (double)x * 32768.0;
+    if (scaled >= 32767.0) return INT16_MAX;
+    if (scaled <= -32768.0) return INT16_MIN;
+    return (int16_t)lrint(scaled);
+}
+
+static float from_q31(int32_t x)
+{
+    return (float)((double)x / 2147483648.0);
+}
+
+static float from_q15(int16_t x)
+{
+    return (float)x / 32768.0f;
+}
+
+/* Closed loop against a first-order plant (the motor.c model, normalized).
+ * The float loop drives the plant; the fixed-point controllers see the
+ * same measurements, so errors do not compound through the plant. */
+static void run_equivalence(pid_t *ref, pid_q31_t *q31, pid_q15_t *q15, float setpoint)
+{
+    float speed = 0.0f;
+
+    for (int step = 0; step < NUM_STEPS; step++) {
+        // Setpoint steps down halfway to exercise both saturation limits
+        float sp = (step < NUM_STEPS / 2) ? setpoint : -setpoint;
+        float measurement = to_q15(speed) / 32768.0f;
+
+        float expected = pid_compute(ref, sp, measurement);
+        float actual31 = from_q31(pid_q31_compute(q31, to_q31(sp), to_q31(measurement)));
+        float actual15 = from_q15(pid_q15_compute(q15, to_q15(sp), to_q15(measurement)));
+
+        TEST_ASSERT_FLOAT_WITHIN(Q31_TOL, expected, actual31);
+        TEST_ASSERT_FLOAT_WITHIN(Q15_TOL, expected, actual15);
+
+        speed += 0.05f * (0.9f * expected - speed);
+    }
+}
+
+/* Test: Proportional-only matches float */
+void test_pid_fixed_proportional_only(void)
+{
+    pid_t ref;
+    pid_q31_t q31;
+    pid_q15_t q15;
+    pid_init(&ref, 2.0f, 0.0f, 0.0f, 0.01f, -0.9f, 0.9f);
+    pid_q31_init(&q31, 2.0f, 0.0f, 0.0f, 0.01f, to_q31(-0.9f), to_q31(0.9f));
+    pid_q15_init(&q15, 2.0f, 0.0f, 0.0f, 0.01f, to_q15(-0.9f), to_q15(0.9f));
+
+    run_equivalence(&ref, &q31, &q15, 0.25f);
+}
+
+/* Test: Full PID matches float */
+void test_pid_fixed_pid(void)
+{
+    pid_t ref;
+    pid_q31_t q31;
+    pid_q15_t q15;
+    pid_init(&ref, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 0.99f);
+    pid_q31_init(&q31, 0.8f, 0.3f, 0.05f, 0.01f, PID_Q31_MIN, to_q31(0.99f));
+    pid_q15_init(&q15, 0.8f, 0.3f, 0.05f, 0.01f, PID_Q15_MIN, to_q15(0.99f));
+
+    run_equivalence(&ref, &q31, &q15, 0.6f);
+}
+
+/* Test: Derivative filter and custom integrator limits match float */
+void test_pid_fixed_advanced_with_filter(void)
+{
+    pid_t ref;
+    pid_q31_t q31;
+    pid_q15_t q15;
+    pid_init_advanced(&ref, 0.8f, 2.0f, 0.02f, 0.01f, -0.5f, 0.5f, -0.1f, 0.1f, 0.8f);
+    pid_q31_init_advanced(&q31, 0.8f, 2.0f, 0.02f, 0.01f, to_q31(-0.5f), to_q31(0.5f),
+                          -0.1f, 0.1f, 0.8f);
+    pid_q15_init_advanced(&q15, 0.8f, 2.0f, 0.02f, 0.01f, to_q15(-0.5f), to_q15(0.5f),
+                          -0.1f, 0.1f, 0.8f);
+
+    run_equivalence(&ref, &q31, &q15, 0.4f);
+}
+
+/* Test: Anti-windup clamps the I term at the float controller's limit */
+void test_pid_fixed_anti_windup(void)
+{
+    pid_t ref;
+    pid_q31_t q31;
+    pid_init(&ref, 0.0f, 1.0f, 0.0f, 0.1f, -0.5f, 0.5f);
+    pid_q31_init(&q31, 0.0f, 1.0f, 0.0f, 0.1f, to_q31(-0.5f), to_q31(0.5f));
+
+    for (int i = 0; i < 100; i++) {
+        pid_compute(&ref, 0.9f, 0.0f);
+        pid_q31_compute(&q31, to_q31(0.9f), 0);
+    }
+
+    // I term = Ki * integrator, clamped to out_max
+    TEST_ASSERT_FLOAT_WITHIN(Q31_TOL, ref.ki * ref.integrator, from_q31(q31.integrator));
+    TEST_ASSERT_FLOAT_WITHIN(Q31_TOL, 0.5f, from_q31(q31.integrator));
+
+    // Recovers immediately when the error reverses (no wound-up integrator)
+    float expected = pid_compute(&ref, -0.9f, 0.0f);
+    float actual = from_q31(pid_q31_compute(&q31, to_q31(-0.9f), 0));
+    TEST_ASSERT_FLOAT_WITHIN(Q31_TOL, expected, actual);
+}
+
+/* Test: No derivative kick on setpoint change */
+void test_pid_fixed_derivative_on_measurement(void)
+{
+    pid_q31_t q31;
+    pid_q31_init(&q31, 0.0f, 0.0f, 0.01f, 0.01f, PID_Q31_MIN, PID_Q31_MAX);
+
+    pid_q31_compute(&q31, 0, 0);
+    TEST_ASSERT_EQUAL_INT32(0, pid_q31_compute(&q31, to_q31(0.5f), 0));
+
+    // Measurement rises by 0.25: D = -(0.01/0.01) * 0.25
+    TEST_ASSERT_FLOAT_WITHIN(Q31_TOL, -0.25f, from_q31(pid_q31_compute(&q31, to_q31(0.5f), to_q31(0.25f))));
+}
+
+/* Test: Extreme inputs saturate instead of wrapping */
+void test_pid_fixed_saturation(void)
+{
+    pid_q31_t q31;
+    pid_q15_t q15;
+    pid_q31_init(&q31, 100.0f, 0.0f, 0.0f, 0.01f, PID_Q31_MIN, PID_Q31_MAX);
+    pid_q15_init(&q15, 100.0f, 0.0f, 0.0f, 0.01f, PID_Q15_MIN, PID_Q15_MAX);
+
+    TEST_ASSERT_EQUAL_INT32(PID_Q31_MAX, pid_q31_compute(&q31, PID_Q31_MAX, PID_Q31_MIN));
+    TEST_ASSERT_EQUAL_INT32(PID_Q31_MIN, pid_q31_compute(&q31, PID_Q31_MIN, PID_Q31_MAX));
+    TEST_ASSERT_EQUAL_INT16(PID_Q15_MAX, pid_q15_compute(&q15, PID_Q15_MAX, PID_Q15_MIN));
+    TEST_ASSERT_EQUAL_INT16(PID_Q15_MIN, pid_q15_compute(&q15, PID_Q15_MIN, PID_Q15_MAX));
+}
+
+/* Test: Reset clears state */
+void test_pid_fixed_reset(void)
+{
+    pid_q31_t q31;
+    pid_q15_t q15;
+    pid_q31_init_advanced(&q31, 1.0f, 1.0f, 0.1f, 0.01f, PID_Q31_MIN, PID_Q31_MAX,
+                          -1.0f, 1.0f, 0.5f);
+    pid_q15_init(&q15, 1.0f, 1.0f, 0.1f, 0.01f, PID_Q15_MIN, PID_Q15_MAX);
+
+    pid_q31_compute(&q31, to_q31(0.5f), to_q31(0.1f));
+    pid_q31_compute(&q31, to_q31(0.5f), to_q31(0.2f));
+    pid_q15_compute(&q15, to_q15(0.5f), to_q15(0.1f));
+
+    pid_q31_reset(&q31);
+    pid_q15_reset(&q15);
+
+    TEST_ASSERT_EQUAL_INT32(0, q31.integrator);
+    TEST_ASSERT_EQUAL_INT32(0, q31.prev_measurement);
+    TEST_ASSERT_EQUAL_INT32(0, q31.derivative_filtered);
+    TEST_ASSERT_EQUAL_INT32(0, q15.core.integrator);
+    TEST_ASSERT_EQUAL_INT32(0, q15.core.prev_measurement);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pid_fixed_proportional_only);
+    RUN_TEST(test_pid_fixed_pid);
+    RUN_TEST(test_pid_fixed_advanced_with_filter);
+    RUN_TEST(test_pid_fixed_anti_windup);
+    RUN_TEST(test_pid_fixed_derivative_on_measurement);
+    RUN_TEST(test_pid_fixed_saturation);
+    RUN_TEST(test_pid_fixed_reset);
+
+    return UNITY_END();
+}
@@ -0,0 +1,177 @@
+/*
+ * @file    test_pid_gain_schedule.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the gain scheduling table
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/pid_gain_schedule.h"
+#include "../firmware/include/motor.h"
+#include <math.h>
+
+/* Speed-scheduled tuning: softer at low speed, more integral at the top */
+static const pid_gain_point_t speed_table[] = {
+    { 0.0f, { 0.4f, 0.2f, 0.0f } },
+    { 1.0f, { 0.6f, 0.5f, 0.0f } },
+    { 2.5f, { 0.9f, 1.5f, 0.0f } },
+    { 4.0f, { 1.0f, 2.5f, 0.0f } },
+};
+#define SPEED_POINTS (sizeof(speed_table) / sizeof(speed_table[0]))
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* Reference lookup: linear scan */
+static pid_gains_t scan_lookup(const pid_gain_point_t *points, uint32_t count, float at)
+{
+    if (at <= points[0].at) return points[0].gains;
+    for (uint32_t k = 0; k + 1u < count; k++) {
+        if (at < points[k + 1u].at) {
+            float t = (at - points[k].at) / (points[k + 1u].at - points[k].at);
+            pid_gains_t g;
+            g.kp = points[k].gains.kp + t * (points[k + 1u].gains.kp - points[k].gains.kp);
+            g.ki = points[k].gains.ki + t * (points[k + 1u].gains.ki - points[k].gains.ki);
+            g.kd = points[k].gains.kd + t * (points[k + 1u].gains.kd - points[k].gains.kd);
+            return g;
+        }
+    }
+    return points[count - 1u].gains;
+}
+
+/* Test: Breakpoints, midpoints, clamping, and rejected tables */
+void test_pid_gain_schedule_lookup(void)
+{
+    pid_gain_schedule_t schedule;
+    pid_gains_t g;
+
+    TEST_ASSERT_EQUAL_INT(0, pid_gain_schedule_init(&schedule, speed_table, SPEED_POINTS));
+
+    g = pid_gain_schedule_lookup(&schedule, 2.5f);
+    TEST_ASSERT_EQUAL_FLOAT(0.9f, g.kp);
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, g.ki);
+    g = pid_gain_schedule_lookup(&schedule, 0.5f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f, g.kp);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.35f, g.ki);
+    g = pid_gain_schedule_lookup(&schedule, -3.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.4f, g.kp);
+    g = pid_gain_schedule_lookup(&schedule, 100.0f);
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, g.ki);
+
+    /* One row: constant gains */
+    TEST_ASSERT_EQUAL_INT(0, pid_gain_schedule_init(&schedule, &speed_table[2], 1));
+    g = pid_gain_schedule_lookup(&schedule, -7.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.9f, g.kp);
+
+    /* Unsorted, duplicate or non-finite rows */
+    pid_gain_point_t bad[3] = { speed_table[0], speed_table[2], speed_table[1] };
+    TEST_ASSERT_EQUAL_INT(-1, pid_gain_schedule_init(&schedule, bad, 3));
+    bad[2] = speed_table[1];
+    bad[2].at = bad[1].at;
+    TEST_ASSERT_EQUAL_INT(-1, pid_gain_schedule_init(&schedule, bad, 3));
+    bad[2].at = INFINITY;
+    TEST_ASSERT_EQUAL_INT(-1, pid_gain_schedule_init(&schedule, bad, 3));
+    bad[2].at = 10.0f;
+    bad[2].gains.kd = -0.1f;
+    TEST_ASSERT_EQUAL_INT(-1, pid_gain_schedule_init(&schedule, bad, 3));
+}
+
+/* Test: Branch-free search agrees with a linear scan on a full table */
+void test_pid_gain_schedule_matches_scan(void)
+{
+    pid_gain_point_t points[PID_GAIN_SCHEDULE_MAX_POINTS];
+    pid_gain_schedule_t schedule;
+
+    for (uint32_t k = 0; k < PID_GAIN_SCHEDULE_MAX_POINTS; k++) {
+        points[k].at = (float)(k * k) * 0.25f - 3.0f;
+        points[k].gains.kp = 1.0f + 0.5f * sinf((float)k);
+        points[k].gains.ki = (float)(k % 3);
+        points[k].gains.kd = 0.01f * (float)k;
+    }
+
+    for (uint32_t count = 1; count <= PID_GAIN_SCHEDULE_MAX_POINTS; count += 5) {
+        TEST_ASSERT_EQUAL_INT(0, pid_gain_schedule_init(&schedule, points, count));
+        for (int i = -20; i < 260; i++) {
+            float at = (float)i * 0.25f - 3.0f;
+            pid_gains_t expected = scan_lookup(points, count, at);
+            pid_gains_t actual = pid_gain_schedule_lookup(&schedule, at);
+
+            TEST_ASSERT_FLOAT_WITHIN(1e-4f, expected.kp, actual.kp);
+            TEST_ASSERT_FLOAT_WITHIN(1e-4f, expected.ki, actual.ki);
+            TEST_ASSERT_FLOAT_WITHIN(1e-4f, expected.kd, actual.kd);
+        }
+    }
+}
+
+/* Largest sample-to-sample output change over a setpoint ramp across the table */
+static float ramp_max_step(int reinit)
+{
+    pid_gain_schedule_t schedule;
+    motor_model_t motor;
+    pid_t pid;
+    float prev = 0.0f;
+    float max_step = 0.0f;
+    pid_gains_t active;
+
+    pid_gain_schedule_init(&schedule, speed_table, SPEED_POINTS);
+    motor_model_init(&motor);
+    active = pid_gain_schedule_lookup(&schedule, 0.0f);
+    pid_init(&pid, active.kp, active.ki, active.kd, 0.01f, -1.0f, 1.0f);
+
+    for (int n = 0; n < 1200; n++) {
+        float speed = motor_model_get_speed(&motor);
+        float setpoint = 3.5f * (float)(n < 800 ? n : 800) / 800.0f;
+
+        if (reinit) {
+            /* Re-initialize whenever the operating point changes row */
+            pid_gains_t row = speed_table[0].gains;
+            for (uint32_t k = 0; k < SPEED_POINTS; k++) {
+                if (speed >= speed_table[k].at) row = speed_table[k].gains;
+            }
+            if (row.kp != active.kp) {
+                active = row;
+                pid_init(&pid, row.kp, row.ki, row.kd, 0.01f, -1.0f, 1.0f);
+            }
+        } else {
+            pid_gain_schedule_apply(&schedule, &pid, speed);
+        }
+
+        float output = pid_compute(&pid, setpoint, speed);
+        if (n > 0 && fabsf(output - prev) > max_step) {
+            max_step = fabsf(output - prev);
+        }
+        prev = output;
+        motor_model_set_output(&motor, output);
+        motor_model_update(&motor);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 3.5f, motor_model_get_speed(&motor));
+    return max_step;
+}
+
+/* Test: Scheduling every sample tracks the ramp without the re-init bumps */
+void test_pid_gain_schedule_bumpless_ramp(void)
+{
+    float scheduled = ramp_max_step(0);
+    float reinit = ramp_max_step(1);
+
+    TEST_ASSERT_TRUE(scheduled < 0.01f);
+    TEST_ASSERT_TRUE(reinit > 10.0f * scheduled);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pid_gain_schedule_lookup);
+    RUN_TEST(test_pid_gain_schedule_matches_scan);
+    RUN_TEST(test_pid_gain_schedule_bumpless_ramp);
+
+    return UNITY_END();
+}
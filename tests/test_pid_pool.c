@@ -0,0 +1,148 @@
+/*
+ * @file    test_pid_pool.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the static object pool
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/pid_pool.h"
+#include "../firmware/include/pid.h"
+#include "../firmware/include/pid_cascade.h"
+#include "../firmware/include/motor.h"
+#include "../firmware/include/telemetry_ring.h"
+
+#define LOOPS 4u
+#define RING_RECORDS 64u
+
+/* One ring's worth of records per slot */
+typedef struct {
+    telemetry_record_t records[RING_RECORDS];
+} ring_block_t;
+
+PID_POOL_DEFINE(pid_pool, pid_t, LOOPS);
+PID_POOL_DEFINE(motor_pool, motor_model_t, LOOPS);
+PID_POOL_DEFINE(cascade_pool, pid_cascade_t, 1);
+PID_POOL_DEFINE(ring_pool, ring_block_t, 2);
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* Test: Slots are aligned, disjoint and exhaust at capacity */
+void test_pid_pool_acquire_until_full(void)
+{
+    static PID_POOL_ALIGNED unsigned char storage[3 * PID_POOL_SLOT_SIZE(sizeof(pid_t))];
+    uint16_t links[3], generations[3];
+    pid_pool_t pool;
+    pid_pool_handle_t handles[3];
+
+    pid_pool_init(&pool, storage, PID_POOL_SLOT_SIZE(sizeof(pid_t)), 3, links, generations);
+    for (int i = 0; i < 3; i++) {
+        handles[i] = pid_pool_acquire(&pool);
+        TEST_ASSERT_TRUE(handles[i] != PID_POOL_INVALID);
+
+        unsigned char *slot = (unsigned char *)pid_pool_get(&pool, handles[i]);
+        TEST_ASSERT_NOT_NULL(slot);
+        TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)((uintptr_t)slot % PID_POOL_CACHE_LINE));
+        TEST_ASSERT_TRUE(slot == storage + (size_t)i * pool.slot_size);
+    }
+    TEST_ASSERT_EQUAL_UINT32(PID_POOL_INVALID, pid_pool_acquire(&pool));
+    TEST_ASSERT_EQUAL_UINT16(3, pid_pool_live(&pool));
+    TEST_ASSERT_EQUAL_UINT32(3u * (PID_POOL_SLOT_SIZE(sizeof(pid_t)) + 4u),
+                             (uint32_t)pid_pool_footprint(&pool));
+}
+
+/* Test: Released slots are reused, zeroed, and old handles go stale */
+void test_pid_pool_release_and_reuse(void)
+{
+    pid_pool_handle_t a = pid_pool_acquire(&pid_pool);
+    pid_pool_handle_t b = pid_pool_acquire(&pid_pool);
+    pid_t *pid_a = PID_POOL_GET(pid_pool, pid_t, a);
+
+    pid_init(pid_a, 1.0f, 0.5f, 0.0f, 0.01f, -1.0f, 1.0f);
+    pid_compute(pid_a, 1.0f, 0.0f);
+    TEST_ASSERT_EQUAL_INT(0, pid_pool_release(&pid_pool, a));
+    TEST_ASSERT_EQUAL_INT(-1, pid_pool_release(&pid_pool, a));
+    TEST_ASSERT_NULL(pid_pool_get(&pid_pool, a));
+
+    /* Most recently released slot comes back first, cleared */
+    pid_pool_handle_t c = pid_pool_acquire(&pid_pool);
+    TEST_ASSERT_TRUE(c != a);
+    TEST_ASSERT_TRUE(PID_POOL_GET(pid_pool, pid_t, c) == pid_a);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, pid_a->integrator);
+    TEST_ASSERT_NULL(pid_pool_get(&pid_pool, a));
+
+    /* Invalid and never-issued handles do not resolve */
+    TEST_ASSERT_NULL(pid_pool_get(&pid_pool, PID_POOL_INVALID));
+    TEST_ASSERT_NULL(pid_pool_get(&pid_pool, (1u << 16) | 3u));
+    TEST_ASSERT_EQUAL_INT(-1, pid_pool_release(&pid_pool, PID_POOL_INVALID));
+
+    TEST_ASSERT_EQUAL_UINT16(2, pid_pool_live(&pid_pool));
+    TEST_ASSERT_EQUAL_UINT16(2, pid_pool_high_water(&pid_pool));
+    TEST_ASSERT_EQUAL_INT(0, pid_pool_release(&pid_pool, b));
+    TEST_ASSERT_EQUAL_INT(0, pid_pool_release(&pid_pool, c));
+}
+
+/* Test: A complete control setup instantiated from static pools */
+void test_pid_pool_instantiates_library_objects(void)
+{
+    pid_pool_handle_t pids[LOOPS], motors[LOOPS];
+    pid_pool_handle_t cascade_handle = pid_pool_acquire(&cascade_pool);
+    pid_pool_handle_t ring_handle = pid_pool_acquire(&ring_pool);
+    pid_cascade_t *cascade = PID_POOL_GET(cascade_pool, pid_cascade_t, cascade_handle);
+    ring_block_t *block = PID_POOL_GET(ring_pool, ring_block_t, ring_handle);
+    telemetry_ring_t ring;
+
+    TEST_ASSERT_NOT_NULL(cascade);
+    TEST_ASSERT_NOT_NULL(block);
+    telemetry_ring_init(&ring, block->records, RING_RECORDS);
+    pid_cascade_init(cascade, 0.01f);
+
+    for (uint32_t k = 0; k < LOOPS; k++) {
+        pids[k] = pid_pool_acquire(&pid_pool);
+        motors[k] = pid_pool_acquire(&motor_pool);
+        pid_init(PID_POOL_GET(pid_pool, pid_t, pids[k]), 0.8f, 0.3f, 0.0f, 0.01f, -1.0f, 1.0f);
+        motor_model_init(PID_POOL_GET(motor_pool, motor_model_t, motors[k]));
+    }
+    pid_cascade_add_stage(cascade, PID_POOL_GET(pid_pool, pid_t, pids[0]), 1);
+
+    for (uint32_t step = 0; step < RING_RECORDS; step++) {
+        for (uint32_t k = 0; k < LOOPS; k++) {
+            motor_model_t *motor = PID_POOL_GET(motor_pool, motor_model_t, motors[k]);
+            float output = pid_compute(PID_POOL_GET(pid_pool, pid_t, pids[k]), 1.0f,
+                                       motor_model_get_speed(motor));
+            motor_model_set_output(motor, output);
+            motor_model_update(motor);
+        }
+        telemetry_record_t record = { step, 1.0f, 0.0f, 0.0f };
+        TEST_ASSERT_EQUAL_INT(0, telemetry_ring_push(&ring, &record));
+    }
+    TEST_ASSERT_EQUAL_UINT32(RING_RECORDS, telemetry_ring_count(&ring));
+    TEST_ASSERT_TRUE(motor_model_get_speed(PID_POOL_GET(motor_pool, motor_model_t, motors[3])) > 0.5f);
+    TEST_ASSERT_EQUAL_UINT32(PID_POOL_INVALID, pid_pool_acquire(&pid_pool));
+
+    /* Footprints are compile-time constants */
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)PID_POOL_FOOTPRINT(pid_t, LOOPS),
+                             (uint32_t)pid_pool_footprint(&pid_pool));
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)sizeof(cascade_pool_storage),
+                             (uint32_t)PID_POOL_SLOT_SIZE(sizeof(pid_cascade_t)));
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)(sizeof(ring_pool_storage) % PID_POOL_CACHE_LINE));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pid_pool_acquire_until_full);
+    RUN_TEST(test_pid_pool_release_and_reuse);
+    RUN_TEST(test_pid_pool_instantiates_library_objects);
+
+    return UNITY_END();
+}
@@ -0,0 +1,161 @@
+/*
+ * @file    test_pid_schedule.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the static multi-rate PID schedule
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/pid_schedule.h"
+
+#define MAX_LOOPS    48u
+#define MAX_STORAGE  4096u
+
+static pid_t loops[MAX_LOOPS];
+static uint32_t storage[MAX_STORAGE];
+static float setpoints[MAX_LOOPS];
+static float measurements[MAX_LOOPS];
+static float outputs[MAX_LOOPS];
+
+void setUp(void)
+{
+    for (size_t k = 0; k < MAX_LOOPS; k++) {
+        setpoints[k] = 0.0f;
+        measurements[k] = 0.0f;
+        outputs[k] = 0.0f;
+    }
+}
+
+void tearDown(void)
+{
+}
+
+/* Proportional-only loops: output = -measurement marks the tick fired on */
+static void init_p_loops(const uint32_t *periods, size_t count)
+{
+    for (size_t k = 0; k < count; k++) {
+        pid_init(&loops[k], 1.0f, 0.0f, 0.0f, 0.001f * (float)periods[k], -1e6f, 1e6f);
+    }
+}
+
+/* Test: Aligned table fires loop k on ticks divisible by its period */
+void test_pid_schedule_aligned_matches_modulo(void)
+{
+    const uint32_t periods[] = { 1, 2, 4, 5 };
+    pid_schedule_t sched;
+
+    init_p_loops(periods, 4);
+    TEST_ASSERT_EQUAL_UINT32(21 + 39 + 4, pid_schedule_storage_size(periods, 4));
+    TEST_ASSERT_EQUAL_INT(0, pid_schedule_build(&sched, loops, periods, 4, PID_SCHEDULE_ALIGNED,
+                                                storage, MAX_STORAGE));
+    TEST_ASSERT_EQUAL_UINT32(20, sched.hyperperiod);
+    TEST_ASSERT_EQUAL_UINT32(39, sched.total_calls);
+    TEST_ASSERT_EQUAL_UINT32(4, sched.max_calls);
+    TEST_ASSERT_EQUAL_UINT32(0, sched.worst_tick);
+
+    for (uint32_t tick = 0; tick < 60; tick++) {
+        uint32_t expected_calls = 0;
+
+        for (size_t k = 0; k < 4; k++) {
+            measurements[k] = (float)tick;
+        }
+        uint32_t calls = pid_schedule_tick(&sched, setpoints, measurements, outputs);
+
+        for (size_t k = 0; k < 4; k++) {
+            uint32_t last_fired = tick / periods[k] * periods[k];
+            TEST_ASSERT_EQUAL_FLOAT(-(float)last_fired, outputs[k]);
+            expected_calls += (tick % periods[k] == 0u) ? 1u : 0u;
+        }
+        TEST_ASSERT_EQUAL_UINT32(expected_calls, calls);
+    }
+
+    /* Restart goes back to tick 0, where every loop fires */
+    pid_schedule_tick(&sched, setpoints, measurements, outputs);
+    pid_schedule_restart(&sched);
+    TEST_ASSERT_EQUAL_UINT32(4, pid_schedule_tick(&sched, setpoints, measurements, outputs));
+}
+
+/* Test: Staggering keeps every loop's rate and flattens the busiest tick */
+void test_pid_schedule_staggered_balances_load(void)
+{
+    uint32_t periods[MAX_LOOPS];
+    uint32_t fired[MAX_LOOPS];
+    uint32_t first_fired[MAX_LOOPS];
+    pid_schedule_t aligned, staggered;
+
+    for (size_t k = 0; k < MAX_LOOPS; k++) {
+        static const uint32_t rates[] = { 1, 2, 4, 5, 10, 20 };
+        periods[k] = rates[k % 6u];
+        fired[k] = 0;
+        first_fired[k] = UINT32_MAX;
+    }
+    init_p_loops(periods, MAX_LOOPS);
+
+    TEST_ASSERT_EQUAL_INT(0, pid_schedule_build(&aligned, loops, periods, MAX_LOOPS,
+                                                PID_SCHEDULE_ALIGNED, storage, MAX_STORAGE));
+    TEST_ASSERT_EQUAL_UINT32(MAX_LOOPS, aligned.max_calls);
+    uint32_t total = aligned.total_calls;
+
+    TEST_ASSERT_EQUAL_INT(0, pid_schedule_build(&staggered, loops, periods, MAX_LOOPS,
+                                                PID_SCHEDULE_STAGGERED, storage, MAX_STORAGE));
+    TEST_ASSERT_EQUAL_UINT32(total, staggered.total_calls);
+    TEST_ASSERT_TRUE(staggered.max_calls * 2u < aligned.max_calls);
+
+    /* Each loop fires at its own period, from some phase within it */
+    for (uint32_t tick = 0; tick < 2u * staggered.hyperperiod; tick++) {
+        uint32_t calls = 0;
+
+        for (size_t k = 0; k < MAX_LOOPS; k++) {
+            measurements[k] = (float)tick + 1.0f;
+        }
+        uint32_t reported = pid_schedule_tick(&staggered, setpoints, measurements, outputs);
+
+        for (size_t k = 0; k < MAX_LOOPS; k++) {
+            if (outputs[k] == -((float)tick + 1.0f)) {
+                if (first_fired[k] == UINT32_MAX) first_fired[k] = tick;
+                TEST_ASSERT_EQUAL_UINT32(first_fired[k], tick - fired[k] * periods[k]);
+                fired[k]++;
+                calls++;
+            }
+        }
+        TEST_ASSERT_EQUAL_UINT32(calls, reported);
+        TEST_ASSERT_TRUE(calls <= staggered.max_calls);
+    }
+    for (size_t k = 0; k < MAX_LOOPS; k++) {
+        TEST_ASSERT_TRUE(first_fired[k] < periods[k]);
+        TEST_ASSERT_EQUAL_UINT32(2u * staggered.hyperperiod / periods[k], fired[k]);
+    }
+}
+
+/* Test: Long hyperperiods and short buffers are rejected */
+void test_pid_schedule_rejects_oversized_tables(void)
+{
+    const uint32_t coprime[] = { 251, 256, 255 };
+    const uint32_t periods[] = { 1, 3 };
+    pid_schedule_t sched;
+
+    init_p_loops(periods, 2);
+    TEST_ASSERT_EQUAL_UINT32(0, pid_schedule_storage_size(coprime, 3));
+    TEST_ASSERT_EQUAL_INT(-1, pid_schedule_build(&sched, loops, coprime, 3, PID_SCHEDULE_ALIGNED,
+                                                 storage, MAX_STORAGE));
+
+    /* 4 offsets + 3 + 1 entries + 2 phases */
+    TEST_ASSERT_EQUAL_UINT32(10, pid_schedule_storage_size(periods, 2));
+    TEST_ASSERT_EQUAL_INT(-1, pid_schedule_build(&sched, loops, periods, 2, PID_SCHEDULE_ALIGNED,
+                                                 storage, 9));
+    TEST_ASSERT_EQUAL_INT(0, pid_schedule_build(&sched, loops, periods, 2, PID_SCHEDULE_ALIGNED,
+                                                storage, 10));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pid_schedule_aligned_matches_modulo);
+    RUN_TEST(test_pid_schedule_staggered_balances_load);
+    RUN_TEST(test_pid_schedule_rejects_oversized_tables);
+
+    return UNITY_END();
+}
@@ -0,0 +1,108 @@
+/*
+ * @file    test_pid_split.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the split configuration/state PID layout
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/pid_split.h"
+#include <math.h>
+
+/* Const configuration, as it would be placed in flash */
+static const pid_config_t flash_config = PID_CONFIG_INIT(0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f);
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static float measurement_at(int i)
+{
+    return 3.0f * (1.0f - expf(-0.01f * (float)i)) + 0.02f * (float)(i % 5);
+}
+
+/* Test: Split compute is bit-identical to pid_compute(), filtered or not */
+void test_pid_compute_split_matches_compute(void)
+{
+    pid_t ref, ref_lpf;
+    pid_config_t config, config_lpf;
+    pid_state_t state, state_lpf;
+
+    pid_init(&ref, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f);
+    pid_init_advanced(&ref_lpf, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f, -5.0f, 5.0f, 0.8f);
+    pid_config_init(&config, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f);
+    pid_config_init_advanced(&config_lpf, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f, -5.0f, 5.0f, 0.8f);
+    pid_state_reset(&state);
+    pid_state_reset(&state_lpf);
+
+    for (int i = 0; i < 500; i++) {
+        /* Setpoint jumps out of reach halfway to exercise the clamps */
+        float sp = (i < 250) ? 3.0f : 50.0f;
+        float m = measurement_at(i);
+
+        TEST_ASSERT_TRUE(pid_compute(&ref, sp, m) == pid_compute_split(&config, &state, sp, m));
+        TEST_ASSERT_TRUE(pid_compute(&ref_lpf, sp, m) ==
+                         pid_compute_split(&config_lpf, &state_lpf, sp, m));
+    }
+    TEST_ASSERT_TRUE(ref.integrator == state.integrator);
+    TEST_ASSERT_TRUE(ref_lpf.derivative_filtered == state_lpf.derivative_filtered);
+}
+
+/* Test: Constant initializer, runtime init and pid_t agree; state is packed */
+void test_pid_config_init_forms_agree(void)
+{
+    pid_t pid;
+    pid_config_t runtime, from_pid;
+
+    pid_init(&pid, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f);
+    pid_config_init(&runtime, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f);
+    pid_split_from(&pid, &from_pid, NULL);
+
+    TEST_ASSERT_EQUAL_MEMORY(&runtime, &flash_config, sizeof(pid_config_t));
+    TEST_ASSERT_EQUAL_MEMORY(&runtime, &from_pid, sizeof(pid_config_t));
+    TEST_ASSERT_EQUAL_UINT32(12, (uint32_t)sizeof(pid_state_t));
+    TEST_ASSERT_TRUE(sizeof(pid_state_t) * 4u < sizeof(pid_t));
+}
+
+/* Test: One shared config drives independent loops; split resumes a pid_t */
+void test_pid_split_shared_config_and_resume(void)
+{
+    pid_t ref;
+    pid_state_t a, b, resumed;
+
+    pid_state_reset(&a);
+    pid_state_reset(&b);
+    pid_init(&ref, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f);
+
+    for (int i = 0; i < 100; i++) {
+        pid_compute_split(&flash_config, &a, 3.0f, measurement_at(i));
+        pid_compute_split(&flash_config, &b, 1.0f, 0.5f);
+        pid_compute(&ref, 3.0f, measurement_at(i));
+    }
+    TEST_ASSERT_TRUE(a.integrator == ref.integrator);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.5f, b.integrator);
+
+    /* Hand a running pid_t over to the split layout mid-stream */
+    pid_split_from(&ref, NULL, &resumed);
+    for (int i = 100; i < 200; i++) {
+        TEST_ASSERT_TRUE(pid_compute(&ref, 3.0f, measurement_at(i)) ==
+                         pid_compute_split(&flash_config, &resumed, 3.0f, measurement_at(i)));
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pid_compute_split_matches_compute);
+    RUN_TEST(test_pid_config_init_forms_agree);
+    RUN_TEST(test_pid_split_shared_config_and_resume);
+
+    return UNITY_END();
+}
@@ -0,0 +1,133 @@
+/*
+ * @file    test_pid_template.cpp
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the header-only C++ PID template
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/pid.hpp"
+#include "pid_reference.h"
+#include <cmath>
+
+#define SAMPLES 500
+
+static float setpoints[SAMPLES];
+static float measurements[SAMPLES];
+static float reference[SAMPLES];
+
+/* One P step evaluated by the compiler */
+static constexpr float constexpr_step()
+{
+    pid::Pid<float, pid::Proportional> p(2.0f, 0.0f, 0.0f, 0.01f, -10.0f, 10.0f);
+    return p.compute(1.0f, 0.25f);
+}
+static_assert(constexpr_step() == 1.5f, "Pid must be usable in constant expressions");
+
+void setUp(void)
+{
+    for (int i = 0; i < SAMPLES; i++) {
+        /* Setpoint jumps out of reach halfway to exercise the clamps */
+        setpoints[i] = (i < 250) ? 3.0f : 50.0f;
+        measurements[i] = 3.0f * (1.0f - std::exp(-0.01f * (float)i)) + 0.02f * (float)(i % 5);
+    }
+}
+
+void tearDown(void)
+{
+}
+
+/* Test: Every feature selected is bit-identical to pid_compute() */
+void test_pid_template_full_matches_compute(void)
+{
+    const float gains[9] = { 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f, -5.0f, 5.0f, 0.8f };
+    pid::Gains<float> g{};
+
+    g.kp = gains[0];
+    g.ki = gains[1];
+    g.kd = gains[2];
+    g.dt = gains[3];
+    g.out_min = gains[4];
+    g.out_max = gains[5];
+    g.integrator_min = gains[6];
+    g.integrator_max = gains[7];
+    g.derivative_lpf = gains[8];
+
+    pid::FullPid<float> controller(g);
+    pid_reference_run(gains, setpoints, measurements, reference, SAMPLES);
+    for (int i = 0; i < SAMPLES; i++) {
+        TEST_ASSERT_TRUE(controller.compute(setpoints[i], measurements[i]) == reference[i]);
+    }
+
+    /* reset() starts the sequence over */
+    controller.reset();
+    TEST_ASSERT_TRUE(controller.integrator() == 0.0f);
+    TEST_ASSERT_TRUE(controller.compute(setpoints[0], measurements[0]) == reference[0]);
+}
+
+/* Test: Feature subsets equal pid_compute() with the missing gains at 0 */
+void test_pid_template_subsets_match_zero_gains(void)
+{
+    const float p_gains[9] = { 0.8f, 0.0f, 0.0f, 0.01f, -1.0f, 1.0f, -1.0f, 1.0f, 0.0f };
+    const float pd_gains[9] = { 0.8f, 0.0f, 0.05f, 0.01f, -1.0f, 1.0f, -1.0f, 1.0f, 0.0f };
+    const float pi_gains[9] = { 0.8f, 0.3f, 0.0f, 0.01f, -1.0f, 1.0f, -1.0f / 0.3f, 1.0f / 0.3f, 0.0f };
+    pid::Pid<float, pid::Proportional> p(0.8f, 0.0f, 0.0f, 0.01f, -1.0f, 1.0f);
+    pid::Pid<float, pid::Derivative, pid::Proportional> pd(0.8f, 0.0f, 0.05f, 0.01f, -1.0f, 1.0f);
+    pid::PiController<float> pi(0.8f, 0.3f, 0.0f, 0.01f, -1.0f, 1.0f);
+
+    pid_reference_run(p_gains, setpoints, measurements, reference, SAMPLES);
+    for (int i = 0; i < SAMPLES; i++) {
+        TEST_ASSERT_TRUE(p.compute(setpoints[i], measurements[i]) == reference[i]);
+    }
+    pid_reference_run(pd_gains, setpoints, measurements, reference, SAMPLES);
+    for (int i = 0; i < SAMPLES; i++) {
+        TEST_ASSERT_TRUE(pd.compute(setpoints[i], measurements[i]) == reference[i]);
+    }
+    pid_reference_run(pi_gains, setpoints, measurements, reference, SAMPLES);
+    for (int i = 0; i < SAMPLES; i++) {
+        TEST_ASSERT_TRUE(pi.compute(setpoints[i], measurements[i]) == reference[i]);
+    }
+
+    /* Unselected terms carry no state */
+    TEST_ASSERT_TRUE(sizeof(p) < sizeof(pi));
+    TEST_ASSERT_TRUE(sizeof(pi) < sizeof(pid::FullPid<float>));
+}
+
+/* Test: double and Q15.16 fixed-point controllers track the float one */
+void test_pid_template_scalar_types(void)
+{
+    const float gains[9] = { 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f, -1.0f / 0.3f, 1.0f / 0.3f, 0.0f };
+    pid::Pid<double, pid::Proportional, pid::Integral, pid::AntiWindup, pid::Derivative> wide(
+        0.8, 0.3, 0.05, 0.01, -1.0, 1.0);
+    pid::PiController<pid::Q16> fixed(0.8, 0.3, 0.0, 0.01, -1.0, 1.0);
+    pid::PiController<float> pi(0.8f, 0.3f, 0.0f, 0.01f, -1.0f, 1.0f);
+
+    pid_reference_run(gains, setpoints, measurements, reference, SAMPLES);
+    for (int i = 0; i < SAMPLES; i++) {
+        float out = (float)wide.compute(setpoints[i], measurements[i]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, reference[i], out);
+    }
+    for (int i = 0; i < SAMPLES; i++) {
+        float expected = pi.compute(setpoints[i], measurements[i]);
+        float out = (float)fixed.compute(setpoints[i], measurements[i]).to_double();
+        TEST_ASSERT_FLOAT_WITHIN(2e-3f, expected, out);
+    }
+
+    /* Fixed-point arithmetic saturates instead of wrapping */
+    TEST_ASSERT_TRUE(pid::Q16(30000.0) * pid::Q16(10.0) == pid::Q16::from_raw(INT32_MAX));
+    TEST_ASSERT_TRUE(-pid::Q16::from_raw(INT32_MIN) == pid::Q16::from_raw(INT32_MAX));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, -0.75f, (float)(pid::Q16(3.0) / pid::Q16(-4.0)).to_double());
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pid_template_full_matches_compute);
+    RUN_TEST(test_pid_template_subsets_match_zero_gains);
+    RUN_TEST(test_pid_template_scalar_types);
+
+    return UNITY_END();
+}
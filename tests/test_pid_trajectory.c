@@ -0,0 +1,159 @@
+/*
+ * @file    test_pid_trajectory.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for trajectory generation and feedforward tracking
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/pid_trajectory.h"
+#include "../firmware/include/pid.h"
+#include "../firmware/include/motor.h"
+#include <math.h>
+
+#define CAPACITY 1024u
+#define DT 0.01f
+
+static pid_trajectory_point_t buffer[CAPACITY];
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* Limits hold, ends are at rest and velocity integrates to position */
+static void check_move(const pid_profile_t *profile, uint32_t count)
+{
+    float tolerance = 1e-3f * fabsf(profile->end - profile->start) + 1e-4f;
+
+    TEST_ASSERT_EQUAL_UINT32(pid_trajectory_samples(profile), count);
+    TEST_ASSERT_EQUAL_FLOAT(profile->start, buffer[0].position);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, buffer[0].velocity);
+    TEST_ASSERT_EQUAL_FLOAT(profile->end, buffer[count - 1u].position);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, buffer[count - 1u].velocity);
+
+    for (uint32_t n = 0; n < count; n++) {
+        TEST_ASSERT_TRUE(fabsf(buffer[n].velocity) <= profile->max_velocity * 1.0001f);
+        TEST_ASSERT_TRUE(fabsf(buffer[n].acceleration) <= profile->max_acceleration * 1.0001f);
+        if (n > 0u) {
+            /* Trapezoidal rule over one sample (exact for the cubic to O(dt^3 j)) */
+            float step = 0.5f * (buffer[n].velocity + buffer[n - 1u].velocity) * profile->dt;
+            float slack = profile->max_acceleration * profile->dt * profile->dt;
+            TEST_ASSERT_FLOAT_WITHIN(slack + tolerance * 0.01f, step,
+                                     buffer[n].position - buffer[n - 1u].position);
+        }
+    }
+}
+
+/* Test: Trapezoid reaches the velocity limit, or peaks lower on a short move */
+void test_pid_trajectory_trapezoidal(void)
+{
+    pid_profile_t profile = { PID_PROFILE_TRAPEZOIDAL, 1.0f, 5.0f, 2.0f, 4.0f, 0.0f, DT };
+
+    /* 0.5 s accel, 1.5 s cruise, 0.5 s decel */
+    uint32_t count = pid_trajectory_generate(&profile, buffer, CAPACITY);
+    TEST_ASSERT_EQUAL_UINT32(251, count);
+    check_move(&profile, count);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 2.0f, buffer[125].velocity);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 4.0f, buffer[10].acceleration);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, -4.0f, buffer[240].acceleration);
+
+    /* Short and backwards: triangular, peak sqrt(D a) = 1 */
+    profile.start = 0.25f;
+    profile.end = 0.0f;
+    count = pid_trajectory_generate(&profile, buffer, CAPACITY);
+    TEST_ASSERT_EQUAL_UINT32(51, count);
+    check_move(&profile, count);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, -1.0f, buffer[25].velocity);
+
+    /* Too small a buffer is refused; a zero move is one point */
+    TEST_ASSERT_EQUAL_UINT32(0, pid_trajectory_generate(&profile, buffer, count - 1u));
+    profile.end = profile.start;
+    TEST_ASSERT_EQUAL_UINT32(1, pid_trajectory_generate(&profile, buffer, CAPACITY));
+}
+
+/* Test: S-curve respects the jerk limit and keeps acceleration continuous */
+void test_pid_trajectory_s_curve(void)
+{
+    const float distances[] = { 6.0f, 1.0f, 0.05f };
+
+    for (uint32_t c = 0; c < 3u; c++) {
+        pid_profile_t profile = { PID_PROFILE_S_CURVE, -2.0f, -2.0f + distances[c],
+                                  2.0f, 4.0f, 20.0f, DT };
+        uint32_t count = pid_trajectory_generate(&profile, buffer, CAPACITY);
+
+        TEST_ASSERT_TRUE(count > 1u);
+        check_move(&profile, count);
+        for (uint32_t n = 1; n < count; n++) {
+            float jerk = (buffer[n].acceleration - buffer[n - 1u].acceleration) / DT;
+            TEST_ASSERT_TRUE(fabsf(jerk) <= profile.max_jerk * 1.001f);
+        }
+    }
+
+    /* Long move: cruises at the limit, acceleration saturates */
+    pid_profile_t profile = { PID_PROFILE_S_CURVE, 0.0f, 6.0f, 2.0f, 4.0f, 20.0f, DT };
+    uint32_t count = pid_trajectory_generate(&profile, buffer, CAPACITY);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 2.0f, buffer[count / 2u].velocity);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 4.0f, buffer[30].acceleration);
+}
+
+/* Run a speed ramp through the motor model; returns the tracking IAE */
+static float track_profile(const pid_feedforward_t *ff)
+{
+    pid_profile_t profile = { PID_PROFILE_S_CURVE, 0.0f, 3.0f, 6.0f, 30.0f, 300.0f, DT };
+    uint32_t count = pid_trajectory_generate(&profile, buffer, CAPACITY);
+    motor_model_t motor;
+    pid_t pid;
+    float iae = 0.0f;
+
+    motor_model_init(&motor);
+    pid_init_advanced(&pid, 0.8f, 0.3f, 0.05f, DT, -1.0f, 1.0f, -1.0f / 0.3f, 1.0f / 0.3f, 0.8f);
+    for (uint32_t n = 0; n < 200u; n++) {
+        const pid_trajectory_point_t *ref = &buffer[n < count ? n : count - 1u];
+        float speed = motor_model_get_speed(&motor);
+
+        /* Speed loop: the profile's position is the speed reference */
+        motor_model_set_output(&motor, pid_compute_ff(&pid, ff, ref->position, speed,
+                                                      ref->position, ref->velocity));
+        motor_model_update(&motor);
+        iae += fabsf(ref->position - speed) * DT;
+    }
+    return iae;
+}
+
+/* Test: Zero feedforward is pid_compute(); model feedforward cuts the lag */
+void test_pid_trajectory_feedforward_tracking(void)
+{
+    const pid_feedforward_t none = { 0.0f, 0.0f };
+    /* kv = 1/gain, ka = tau/gain with tau = dt/alpha */
+    const pid_feedforward_t model = { 1.0f / MOTOR_MODEL_DEFAULT_GAIN,
+                                      DT / (MOTOR_MODEL_DEFAULT_ALPHA * MOTOR_MODEL_DEFAULT_GAIN) };
+    pid_t a, b;
+
+    pid_init(&a, 0.8f, 0.3f, 0.05f, DT, -1.0f, 1.0f);
+    pid_init(&b, 0.8f, 0.3f, 0.05f, DT, -1.0f, 1.0f);
+    for (int n = 0; n < 300; n++) {
+        float m = 3.0f * (1.0f - expf(-0.01f * (float)n));
+        TEST_ASSERT_TRUE(pid_compute(&a, 3.0f, m) == pid_compute_ff(&b, &none, 3.0f, m, 1.0f, 1.0f));
+    }
+
+    float feedback_only = track_profile(&none);
+    float with_ff = track_profile(&model);
+    TEST_ASSERT_TRUE(with_ff * 5.0f < feedback_only);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pid_trajectory_trapezoidal);
+    RUN_TEST(test_pid_trajectory_s_curve);
+    RUN_TEST(test_pid_trajectory_feedforward_tracking);
+
+    return UNITY_END();
+}
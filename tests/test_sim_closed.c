@@ -0,0 +1,208 @@
+/*
+ * @file    test_sim_closed.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the closed-form evaluator against the stepped loop
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../sim/sim_closed.h"
+#include "../firmware/include/motor.h"
+#include "../firmware/include/pid.h"
+#include <float.h>
+#include <math.h>
+
+#define SPAN_STEPS 400u
+
+static sim_config_t config;
+
+void setUp(void)
+{
+    sim_config_defaults(&config);
+    config.kp = 0.3f;
+    config.ki = 1.0f;
+    config.kd = 0.01f;
+    config.derivative_lpf = 0.5f;
+}
+
+void tearDown(void)
+{
+}
+
+/* Float rounding of the stepped loop around setpoint r, per step */
+static double noise(double r)
+{
+    return SIM_CLOSED_NOISE_ULPS * FLT_EPSILON * fmax(1.0, fabs(r));
+}
+
+/* |expected - actual| <= tolerance, in double (Unity's float asserts
+ * would round the operands) */
+static int within(double tolerance, double expected, double actual)
+{
+    return fabs(expected - actual) <= tolerance;
+}
+
+/* Test: The linear model reproduces pid_compute() on the motor model */
+void test_sim_closed_step_matches_pid(void)
+{
+    sim_closed_model_t model;
+    sim_closed_state_t state = { 0.0, 0.0, 0.0, 0.0 };
+    motor_model_t motor;
+    pid_t pid;
+
+    /* Small step: the output never reaches a limit */
+    TEST_ASSERT_EQUAL_INT(0, sim_closed_model_init(&model, &config, 0.5f));
+    TEST_ASSERT_EQUAL_UINT(4, model.order);
+
+    pid_init_advanced(&pid, config.kp, config.ki, config.kd, config.dt,
+                      config.out_min, config.out_max, -1.0f / config.ki, 1.0f / config.ki,
+                      config.derivative_lpf);
+    motor_model_init(&motor);
+    for (int step = 0; step < 300; step++) {
+        float output = pid_compute(&pid, 0.5f, motor_model_get_speed(&motor));
+
+        TEST_ASSERT_TRUE(output > config.out_min && output < config.out_max);
+        motor_model_set_output(&motor, output);
+        motor_model_update(&motor);
+        sim_closed_step(&model, &state);
+
+        TEST_ASSERT_FLOAT_WITHIN(1e-5f, motor.speed, (float)state.speed);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5f, pid.integrator, (float)state.integrator);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, pid.derivative_filtered, (float)state.derivative_filtered);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.5f, (float)state.speed);
+}
+
+/* Test: A span summarizes the same steps sim_closed_step() takes */
+void test_sim_closed_span_matches_steps(void)
+{
+    sim_closed_model_t model;
+    sim_closed_state_t start = { 0.2, 0.1, 0.05, 0.0 };
+    sim_closed_state_t state = start;
+    sim_closed_span_t span;
+    double sum = 0.0, sum_sq = 0.0, sum_step = 0.0, last = 0.0;
+
+    TEST_ASSERT_EQUAL_INT(0, sim_closed_model_init(&model, &config, 1.0f));
+    TEST_ASSERT_EQUAL_INT(0, sim_closed_span(&model, &start, SPAN_STEPS, &span));
+
+    for (uint32_t m = 0; m < SPAN_STEPS; m++) {
+        double e = model.setpoint - state.speed;
+
+        TEST_ASSERT_TRUE(e >= span.error_min && e <= span.error_max);
+        TEST_ASSERT_TRUE(fabs(e) <= span.error_peak + 1e-12);
+        if (span.error_sign != 0) {
+            TEST_ASSERT_TRUE(e * span.error_sign >= 0.0);
+        }
+        sum += e;
+        sum_sq += e * e;
+        sum_step += (double)m * e;
+        last = e;
+        sim_closed_step(&model, &state);
+    }
+
+    TEST_ASSERT_TRUE(within(1e-9, sum, span.sum_error));
+    TEST_ASSERT_TRUE(within(1e-9, sum_sq, span.sum_error_sq));
+    TEST_ASSERT_TRUE(within(1e-7, sum_step, span.sum_step_error));
+    TEST_ASSERT_TRUE(within(1e-12, last, span.last_error));
+    TEST_ASSERT_TRUE(within(1e-12, state.speed, span.end.speed));
+    TEST_ASSERT_TRUE(within(1e-12, state.prev_measurement, span.end.prev_measurement));
+    TEST_ASSERT_TRUE(within(1e-12, state.integrator, span.end.integrator));
+    TEST_ASSERT_TRUE(within(1e-12, state.derivative_filtered, span.end.derivative_filtered));
+}
+
+/* Test: The default gains oscillate (kd * alpha * gain / dt > 1 pole), so
+ * the loop is stepped throughout and matches sim_run() exactly */
+void test_sim_run_closed_form_steps_unstable_loop(void)
+{
+    sim_closed_model_t model;
+    sim_metrics_t stepped, closed;
+
+    sim_config_defaults(&config);
+    TEST_ASSERT_EQUAL_INT(-1, sim_closed_model_init(&model, &config, 3.0f));
+
+    sim_run(&config, NULL, NULL, &stepped);
+    TEST_ASSERT_EQUAL_UINT32(0, sim_run_closed_form(&config, &closed));
+    TEST_ASSERT_TRUE(stepped.iae == closed.iae && stepped.ise == closed.ise &&
+                     stepped.itae == closed.itae);
+    TEST_ASSERT_TRUE(stepped.overshoot_pct == closed.overshoot_pct);
+    TEST_ASSERT_TRUE(stepped.settling_time == closed.settling_time);
+    TEST_ASSERT_TRUE(stepped.final_error == closed.final_error);
+    TEST_ASSERT_EQUAL_UINT32(stepped.steps_run, closed.steps_run);
+}
+
+/* Test: Metrics agree with sim_run() to float resolution over a gain grid */
+void test_sim_run_closed_form_matches_sim_run(void)
+{
+    const float kps[] = { 0.3f, 0.8f, 1.5f };
+    const float kis[] = { 0.0f, 1.0f, 3.0f };
+    const float kds[] = { 0.0f, 0.01f, 0.05f };
+    const float lpfs[] = { 0.0f, 0.8f };
+    uint32_t skipped = 0, total = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, sim_config_set(&config, "profile", "0:2,2000:1,4000:2.5"));
+    config.steps = 6000;
+
+    for (size_t p = 0; p < 3; p++)
+    for (size_t i = 0; i < 3; i++)
+    for (size_t d = 0; d < 3; d++)
+    for (size_t l = 0; l < 2; l++) {
+        sim_metrics_t stepped, closed;
+        double t = config.steps * config.dt;
+        double tol = noise(2.5);
+
+        config.kp = kps[p];
+        config.ki = kis[i];
+        config.kd = kds[d];
+        config.derivative_lpf = lpfs[l];
+        sim_run(&config, NULL, NULL, &stepped);
+        skipped += sim_run_closed_form(&config, &closed);
+        total += config.steps;
+
+        /* The stepped loop stalls a few ulps off the setpoint where the
+         * closed form converges, which the integrals accumulate */
+        TEST_ASSERT_TRUE(within(1e-4 * stepped.iae + 2.0 * t * tol, stepped.iae, closed.iae));
+        TEST_ASSERT_TRUE(within(1e-4 * stepped.ise + 1e-9, stepped.ise, closed.ise));
+        TEST_ASSERT_TRUE(within(1e-4 * stepped.itae + t * t * tol, stepped.itae, closed.itae));
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, stepped.overshoot_pct, closed.overshoot_pct);
+        TEST_ASSERT_EQUAL_FLOAT(stepped.rise_time, closed.rise_time);
+        TEST_ASSERT_EQUAL_FLOAT(stepped.settling_time, closed.settling_time);
+        TEST_ASSERT_EQUAL_UINT32(stepped.saturated_steps, closed.saturated_steps);
+        TEST_ASSERT_EQUAL_UINT32(stepped.steps_run, closed.steps_run);
+        TEST_ASSERT_FLOAT_WITHIN((float)(2.0 * tol), stepped.final_error, closed.final_error);
+    }
+    TEST_ASSERT_TRUE(skipped > 0 && skipped < total);
+}
+
+/* Test: Settled segments of a stable loop are skipped */
+void test_sim_run_closed_form_skips_settled_tail(void)
+{
+    sim_metrics_t stepped, closed;
+    uint32_t skipped;
+
+    config.kp = 1.5f;
+    config.derivative_lpf = 0.0f;
+    config.steps = 20000;
+    TEST_ASSERT_EQUAL_INT(0, sim_config_set(&config, "profile", "0:2,5000:1,10000:2.5"));
+
+    sim_run(&config, NULL, NULL, &stepped);
+    skipped = sim_run_closed_form(&config, &closed);
+
+    TEST_ASSERT_TRUE(skipped > config.steps / 2u);
+    TEST_ASSERT_EQUAL_FLOAT(stepped.settling_time, closed.settling_time);
+    TEST_ASSERT_TRUE(within(1e-3 * stepped.iae, stepped.iae, closed.iae));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sim_closed_step_matches_pid);
+    RUN_TEST(test_sim_closed_span_matches_steps);
+    RUN_TEST(test_sim_run_closed_form_steps_unstable_loop);
+    RUN_TEST(test_sim_run_closed_form_matches_sim_run);
+    RUN_TEST(test_sim_run_closed_form_skips_settled_tail);
+
+    return UNITY_END();
+}
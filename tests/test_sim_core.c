@@ -0,0 +1,275 @@
+/*
+ * @file    test_sim_core.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the parameterized simulation core
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../sim/sim_core.h"
+#include "../firmware/include/motor.h"
+#include "../firmware/include/pid.h"
+#include <math.h>
+#include <string.h>
+
+#define MAX_STEPS 1000
+
+static sim_config_t config;
+static telemetry_record_t records[MAX_STEPS];
+static size_t num_records;
+
+void setUp(void)
+{
+    sim_config_defaults(&config);
+    num_records = 0;
+}
+
+void tearDown(void)
+{
+}
+
+static void collect(void *context, const telemetry_record_t *record)
+{
+    (void)context;
+    if (num_records < MAX_STEPS) {
+        records[num_records++] = *record;
+    }
+}
+
+/* Bitwise float comparison (bit-identical, not approximately equal) */
+static int same_bits(float a, float b)
+{
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+/* Test: Default configuration reproduces the main.c loop bit for bit */
+void test_sim_run_defaults_match_demo_loop(void)
+{
+    pid_t pid;
+
+    sim_run(&config, collect, NULL, NULL);
+    TEST_ASSERT_EQUAL(500, num_records);
+
+    motor_init();
+    pid_init(&pid, 0.8f, 0.3f, 0.05f, 0.01f, -1.0f, 1.0f);
+    for (size_t step = 0; step < num_records; step++) {
+        float measurement = motor_get_speed();
+        float output = pid_compute(&pid, 3.0f, measurement);
+        motor_set_output(output);
+        motor_update();
+
+        TEST_ASSERT_EQUAL_UINT32(step, records[step].step);
+        TEST_ASSERT_TRUE(same_bits(measurement, records[step].measurement));
+        TEST_ASSERT_TRUE(same_bits(output, records[step].output));
+    }
+}
+
+/* Test: Rise and settling time describe the last setpoint segment */
+void test_sim_run_rise_and_settling_time(void)
+{
+    sim_metrics_t metrics;
+    const size_t start = 500;
+    size_t rise = 0;
+    size_t last_outside = start;
+
+    TEST_ASSERT_EQUAL_INT(0, sim_config_set(&config, "profile", "0:3,500:1"));
+    config.steps = MAX_STEPS;
+    sim_run(&config, collect, NULL, &metrics);
+
+    // Recompute from the samples of the second segment (a step down)
+    double amplitude = records[start].measurement - 1.0;
+    TEST_ASSERT_TRUE(amplitude > 0.0);
+    for (size_t i = num_records; i-- > start;) {
+        double error = (double)records[i].setpoint - records[i].measurement;
+        if (-error <= (1.0 - SIM_RISE_FRACTION) * amplitude) rise = i;
+        if (last_outside == start && fabs(error) > SIM_SETTLING_BAND * amplitude) last_outside = i;
+    }
+    TEST_ASSERT_TRUE(rise > start);
+    TEST_ASSERT_TRUE(last_outside + 1 < num_records);
+
+    TEST_ASSERT_EQUAL_FLOAT((float)(rise - start) * config.dt, metrics.rise_time);
+    TEST_ASSERT_EQUAL_FLOAT((float)(last_outside + 1 - start) * config.dt, metrics.settling_time);
+    TEST_ASSERT_TRUE(metrics.rise_time <= metrics.settling_time);
+
+    // Too short to settle: reported as -1
+    config.steps = 505;
+    sim_run(&config, NULL, NULL, &metrics);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, metrics.settling_time);
+}
+
+/* Test: A settling predicate ends the run early with identical samples */
+void test_sim_run_until_settled(void)
+{
+    sim_settle_stop_t stop;
+    sim_metrics_t full, early;
+    telemetry_record_t reference[MAX_STEPS];
+
+    config.kp = 2.0f;
+    config.ki = 1.0f;
+    config.profile.value[0] = 2.0f;
+    config.steps = MAX_STEPS;
+    sim_run(&config, collect, NULL, &full);
+    memcpy(reference, records, sizeof(reference));
+    TEST_ASSERT_EQUAL_UINT32(MAX_STEPS, full.steps_run);
+
+    num_records = 0;
+    sim_settle_stop_init(&stop, 0.1f, 10, 0);
+    sim_run_until(&config, collect, NULL, sim_stop_settled, &stop, &early);
+
+    TEST_ASSERT_TRUE(early.steps_run < MAX_STEPS);
+    TEST_ASSERT_EQUAL(early.steps_run, num_records);
+    TEST_ASSERT_EQUAL_MEMORY(reference, records, num_records * sizeof(records[0]));
+
+    // The last 10 samples are inside the band, the one before is not
+    for (size_t i = num_records - 10; i < num_records; i++) {
+        TEST_ASSERT_TRUE(fabsf(records[i].setpoint - records[i].measurement) <= 0.1f);
+    }
+    TEST_ASSERT_TRUE(fabsf(records[num_records - 11].setpoint -
+                           records[num_records - 11].measurement) > 0.1f);
+
+    // Steps before after_step never count
+    sim_settle_stop_init(&stop, 0.1f, 10, MAX_STEPS);
+    sim_run_until(&config, NULL, NULL, sim_stop_settled, &stop, &early);
+    TEST_ASSERT_EQUAL_MEMORY(&full, &early, sizeof(full));
+
+    // No predicate: same as sim_run()
+    sim_run_until(&config, NULL, NULL, NULL, NULL, &early);
+    TEST_ASSERT_EQUAL_MEMORY(&full, &early, sizeof(full));
+}
+
+/* Test: Options are parsed by name; bad names and values are rejected */
+void test_sim_config_set(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, sim_config_set(&config, "kp", "1.5"));
+    TEST_ASSERT_EQUAL_INT(0, sim_config_set(&config, "motor-alpha", "0.2"));
+    TEST_ASSERT_EQUAL_INT(0, sim_config_set(&config, "steps", "1234"));
+    TEST_ASSERT_EQUAL_INT(0, sim_config_set(&config, "integrator-max", "2"));
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, config.kp);
+    TEST_ASSERT_EQUAL_FLOAT(0.2f, config.motor_alpha);
+    TEST_ASSERT_EQUAL_UINT32(1234, config.steps);
+    TEST_ASSERT_TRUE(config.has_integrator_limits);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, config.integrator_max);
+    TEST_ASSERT_TRUE(isinf(config.integrator_min) && config.integrator_min < 0.0f);
+
+    TEST_ASSERT_EQUAL_INT(-1, sim_config_set(&config, "kq", "1"));
+    TEST_ASSERT_EQUAL_INT(-1, sim_config_set(&config, "kp", "1x"));
+    TEST_ASSERT_EQUAL_INT(-1, sim_config_set(&config, "kp", ""));
+    TEST_ASSERT_EQUAL_INT(-1, sim_config_set(&config, "steps", "-5"));
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, config.kp);
+}
+
+/* Test: Shared tool parsers consume the whole string and check range */
+void test_sim_parse_values(void)
+{
+    unsigned long count = 7;
+    float value = 1.0f;
+
+    TEST_ASSERT_EQUAL_INT(0, sim_parse_float("-2.5e-1", &value));
+    TEST_ASSERT_EQUAL_FLOAT(-0.25f, value);
+    TEST_ASSERT_EQUAL_INT(-1, sim_parse_float("inf", &value));
+    TEST_ASSERT_EQUAL_INT(-1, sim_parse_float("nan", &value));
+    TEST_ASSERT_EQUAL_INT(-1, sim_parse_float("0.5s", &value));
+    TEST_ASSERT_EQUAL_FLOAT(-0.25f, value);
+
+    TEST_ASSERT_EQUAL_INT(0, sim_parse_count("4096", 4096ul, &count));
+    TEST_ASSERT_EQUAL_UINT32(4096, (uint32_t)count);
+    TEST_ASSERT_EQUAL_INT(-1, sim_parse_count("4097", 4096ul, &count));
+    TEST_ASSERT_EQUAL_INT(-1, sim_parse_count("+1", 4096ul, &count));
+    TEST_ASSERT_EQUAL_INT(-1, sim_parse_count("-1", 4096ul, &count));
+    TEST_ASSERT_EQUAL_INT(-1, sim_parse_count("99999999999999999999999", 0xFFFFFFFFul, &count));
+    TEST_ASSERT_EQUAL_UINT32(4096, (uint32_t)count);
+}
+
+/* Test: Profile strings parse into increasing segments */
+void test_sim_profile_parse(void)
+{
+    sim_profile_t profile;
+
+    TEST_ASSERT_EQUAL_INT(0, sim_profile_parse(&profile, "0:1.5,100:-2,250:0"));
+    TEST_ASSERT_EQUAL(3, profile.count);
+    TEST_ASSERT_EQUAL_UINT32(100, profile.start[1]);
+    TEST_ASSERT_EQUAL_FLOAT(-2.0f, profile.value[1]);
+
+    TEST_ASSERT_EQUAL_INT(-1, sim_profile_parse(&profile, ""));
+    TEST_ASSERT_EQUAL_INT(-1, sim_profile_parse(&profile, "10:1,5:2"));
+    TEST_ASSERT_EQUAL_INT(-1, sim_profile_parse(&profile, "0:1,"));
+    TEST_ASSERT_EQUAL_INT(-1, sim_profile_parse(&profile, "0=1"));
+}
+
+/* Test: Setpoint follows the profile, zero before the first segment */
+void test_sim_run_follows_profile(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, sim_config_set(&config, "profile", "10:2,20:-1"));
+    config.steps = 30;
+
+    sim_run(&config, collect, NULL, NULL);
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, records[9].setpoint);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, records[10].setpoint);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, records[19].setpoint);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, records[20].setpoint);
+}
+
+/* Test: Metrics agree with values recomputed from the samples */
+void test_sim_run_metrics(void)
+{
+    sim_metrics_t metrics;
+    double iae = 0.0;
+    double peak = 0.0;
+    unsigned saturated = 0;
+
+    config.kp = 3.0f;    // Aggressive: overshoots and saturates
+    config.ki = 2.0f;
+    config.steps = MAX_STEPS;
+    sim_run(&config, collect, NULL, &metrics);
+
+    for (size_t i = 0; i < num_records; i++) {
+        iae += fabs((double)records[i].setpoint - records[i].measurement) * config.dt;
+        if (records[i].measurement > peak) peak = records[i].measurement;
+        if (fabsf(records[i].output) >= 1.0f) saturated++;
+    }
+
+    // Same summation order, so the doubles agree exactly
+    TEST_ASSERT_TRUE(iae == metrics.iae);
+    TEST_ASSERT_TRUE(fabs(100.0 * (peak - 3.0) / 3.0 - metrics.overshoot_pct) < 1e-9);
+    TEST_ASSERT_TRUE(metrics.overshoot_pct > 0.0);
+    TEST_ASSERT_EQUAL_UINT32(saturated, metrics.saturated_steps);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, records[MAX_STEPS - 1].setpoint - records[MAX_STEPS - 1].measurement,
+                             metrics.final_error);
+}
+
+/* Test: Invalid configurations are reported instead of asserting */
+void test_sim_config_validate(void)
+{
+    TEST_ASSERT_NULL(sim_config_validate(&config));
+
+    config.dt = 0.0f;
+    TEST_ASSERT_NOT_NULL(sim_config_validate(&config));
+
+    sim_config_defaults(&config);
+    config.out_min = 2.0f;
+    TEST_ASSERT_NOT_NULL(sim_config_validate(&config));
+
+    sim_config_defaults(&config);
+    config.motor_alpha = 1.5f;
+    TEST_ASSERT_NOT_NULL(sim_config_validate(&config));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sim_run_defaults_match_demo_loop);
+    RUN_TEST(test_sim_config_set);
+    RUN_TEST(test_sim_parse_values);
+    RUN_TEST(test_sim_profile_parse);
+    RUN_TEST(test_sim_run_follows_profile);
+    RUN_TEST(test_sim_run_metrics);
+    RUN_TEST(test_sim_run_rise_and_settling_time);
+    RUN_TEST(test_sim_run_until_settled);
+    RUN_TEST(test_sim_config_validate);
+
+    return UNITY_END();
+}
@@ -0,0 +1,213 @@
+/*
+ * @file    test_sim_freq.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the closed-loop frequency-response analysis
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../sim/sim_freq.h"
+#include <math.h>
+#include <string.h>
+
+static sim_config_t base;
+static sim_freq_t freq;
+static sim_freq_point_t points[SIM_FREQ_MAX_POINTS];
+static sim_freq_point_t reference[SIM_FREQ_MAX_POINTS];
+
+void setUp(void)
+{
+    /* main.c tuning with the derivative filtered: linearly stable */
+    sim_config_defaults(&base);
+    base.derivative_lpf = 0.8f;
+    base.steps = 2000;
+    sim_freq_init(&freq, &base);
+    freq.record_log2 = 10;
+    freq.points = 24;
+}
+
+void tearDown(void)
+{
+}
+
+static sim_complex_t cmul(sim_complex_t a, sim_complex_t b)
+{
+    sim_complex_t r = { a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re };
+    return r;
+}
+
+static sim_complex_t cdiv(sim_complex_t a, sim_complex_t b)
+{
+    double scale = 1.0 / (b.re * b.re + b.im * b.im);
+    sim_complex_t r = { (a.re * b.re + a.im * b.im) * scale,
+                        (a.im * b.re - a.re * b.im) * scale };
+    return r;
+}
+
+/* L(z) of pid_compute() (setpoint held) times the motor model, z = e^(j w dt) */
+static sim_complex_t open_loop(const sim_config_t *c, double frequency)
+{
+    double w = 2.0 * 3.14159265358979323846 * frequency * c->dt;
+    sim_complex_t one = { 1.0, 0.0 };
+    sim_complex_t zinv = { cos(w), -sin(w) };
+    sim_complex_t diff = { 1.0 - zinv.re, -zinv.im };                  /* 1 - z^-1 */
+    sim_complex_t lag = { 1.0 - c->derivative_lpf * zinv.re, -c->derivative_lpf * zinv.im };
+    sim_complex_t pole = { 1.0 - (1.0 - c->motor_alpha) * zinv.re,
+                           -(1.0 - c->motor_alpha) * zinv.im };
+    sim_complex_t integral = cdiv(one, diff);
+    sim_complex_t derivative = cdiv(diff, lag);
+    sim_complex_t controller = {
+        c->kp + c->ki * c->dt * integral.re +
+            c->kd / c->dt * (1.0 - c->derivative_lpf) * derivative.re,
+        c->ki * c->dt * integral.im +
+            c->kd / c->dt * (1.0 - c->derivative_lpf) * derivative.im
+    };
+    sim_complex_t plant = cdiv(zinv, pole);
+
+    plant.re *= c->motor_alpha * c->motor_gain;
+    plant.im *= c->motor_alpha * c->motor_gain;
+    return cmul(controller, plant);
+}
+
+/* Test: Measured response matches the loop's transfer function */
+void test_sim_freq_matches_transfer_function(void)
+{
+    uint32_t lines;
+
+    TEST_ASSERT_NULL(sim_freq_validate(&freq));
+    lines = sim_freq_lines(&freq, NULL);
+    TEST_ASSERT_TRUE(lines > 16u && lines <= 24u);
+    TEST_ASSERT_TRUE(sim_freq_run(&freq, 0, points, NULL) >= 1u);
+
+    for (uint32_t i = 0; i < lines; i++) {
+        sim_complex_t l = open_loop(&base, points[i].frequency);
+        double gain = 20.0 * log10(hypot(l.re, l.im));
+        sim_complex_t s = cdiv((sim_complex_t){ 1.0, 0.0 },
+                               (sim_complex_t){ 1.0 + l.re, l.im });
+
+        if (i > 0u) {
+            TEST_ASSERT_TRUE(points[i].bin > points[i - 1u].bin);
+            TEST_ASSERT_TRUE(fabsf(points[i].phase_deg - points[i - 1u].phase_deg) < 180.0f);
+        }
+        TEST_ASSERT_EQUAL_UINT32(0, points[i].saturated_steps);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, (float)gain, points[i].gain_db);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, (float)(atan2(l.im, l.re) * 180.0 / 3.14159265358979),
+                                 fmodf(points[i].phase_deg + 540.0f, 360.0f) - 180.0f);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, (float)s.re, (float)points[i].sensitivity.re);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, (float)s.im, (float)points[i].sensitivity.im);
+    }
+}
+
+/* Test: Margins agree with those of the exact response on the same lines */
+void test_sim_freq_margins(void)
+{
+    sim_freq_margins_t measured, exact;
+    uint32_t lines = sim_freq_lines(&freq, NULL);
+
+    TEST_ASSERT_TRUE(sim_freq_run(&freq, 2, points, NULL) >= 1u);
+    memcpy(reference, points, sizeof(points));
+    for (uint32_t i = 0; i < lines; i++) {
+        sim_complex_t l = open_loop(&base, reference[i].frequency);
+
+        reference[i].open_loop = l;
+        reference[i].sensitivity = cdiv((sim_complex_t){ 1.0, 0.0 },
+                                        (sim_complex_t){ 1.0 + l.re, l.im });
+        reference[i].gain_db = (float)(20.0 * log10(hypot(l.re, l.im)));
+    }
+
+    sim_freq_margins(points, lines, &measured);
+    sim_freq_margins(reference, lines, &exact);
+
+    TEST_ASSERT_EQUAL_UINT32(0, measured.saturated_steps);
+    TEST_ASSERT_TRUE(measured.has_phase_margin && measured.has_gain_margin);
+    TEST_ASSERT_TRUE(measured.phase_margin_deg > 0.0f && measured.gain_margin_db > 0.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, exact.phase_margin_deg, measured.phase_margin_deg);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, exact.gain_margin_db, measured.gain_margin_db);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, exact.gain_crossover_hz, measured.gain_crossover_hz);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, exact.modulus_margin, measured.modulus_margin);
+    TEST_ASSERT_TRUE(measured.gain_crossover_hz < measured.phase_crossover_hz);
+
+    /* Modulus margin bounds the gain margin: GM >= 1 / (1 - modulus) */
+    TEST_ASSERT_TRUE(measured.gain_margin_db >=
+                     -20.0f * log10f(1.0f - measured.modulus_margin) - 0.01f);
+}
+
+/* Test: Any thread count gives the serial result; a clamped loop is flagged */
+void test_sim_freq_parallel_and_saturation(void)
+{
+    uint32_t lines = sim_freq_lines(&freq, NULL);
+    uint32_t records = sim_freq_records(&freq);
+    sim_freq_margins_t margins;
+
+    TEST_ASSERT_EQUAL_UINT32((lines + 3u) / 4u, records);
+    for (uint32_t r = 0; r < records; r++) {
+        TEST_ASSERT_EQUAL_INT(0, sim_freq_evaluate(&freq, r, reference));
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, sim_freq_run(&freq, 1, points, NULL));
+    for (uint32_t i = 0; i < lines; i++) {
+        TEST_ASSERT_TRUE(memcmp(&reference[i].open_loop, &points[i].open_loop,
+                                sizeof(sim_complex_t)) == 0);
+    }
+    freq.policy = SIM_SCHED_STATIC;
+    TEST_ASSERT_TRUE(sim_freq_run(&freq, 4, reference, NULL) > 1u);
+    TEST_ASSERT_TRUE(memcmp(reference, points, lines * sizeof(points[0])) == 0);
+
+    /* Unfiltered derivative: the demo loop limit-cycles against the clamp */
+    freq.base.derivative_lpf = 0.0f;
+    TEST_ASSERT_TRUE(sim_freq_run(&freq, 0, points, NULL) >= 1u);
+    sim_freq_margins(points, lines, &margins);
+    TEST_ASSERT_TRUE(margins.saturated_steps > 0u);
+
+    /* Invalid analyses */
+    freq.amplitude = 0.0f;
+    TEST_ASSERT_NOT_NULL(sim_freq_validate(&freq));
+    freq.amplitude = 0.1f;
+    freq.record_log2 = SIM_FREQ_MAX_LOG2 + 1u;
+    TEST_ASSERT_NOT_NULL(sim_freq_validate(&freq));
+    freq.record_log2 = 10;
+    freq.points = 1;
+    TEST_ASSERT_NOT_NULL(sim_freq_validate(&freq));
+}
+
+/* Test: Output limits wider than the motor's +/-1 input still flag clamping */
+void test_sim_freq_plant_input_clamp(void)
+{
+    sim_freq_margins_t margins;
+    uint32_t lines;
+
+    freq.base.out_min = -5.0f;
+    freq.base.out_max = 5.0f;
+    freq.points = 8;
+    lines = sim_freq_lines(&freq, NULL);
+
+    /* Small excitation around u = 0.6: linear, matches the transfer function */
+    TEST_ASSERT_TRUE(sim_freq_run(&freq, 0, points, NULL) >= 1u);
+    sim_freq_margins(points, lines, &margins);
+    TEST_ASSERT_EQUAL_UINT32(0, margins.saturated_steps);
+    for (uint32_t i = 0; i < lines; i++) {
+        sim_complex_t l = open_loop(&freq.base, points[i].frequency);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, (float)(20.0 * log10(hypot(l.re, l.im))),
+                                 points[i].gain_db);
+    }
+
+    /* Within the PID limits but beyond the motor's: every record is flagged */
+    freq.amplitude = 3.0f;
+    TEST_ASSERT_TRUE(sim_freq_run(&freq, 0, points, NULL) >= 1u);
+    for (uint32_t i = 0; i < lines; i++) {
+        TEST_ASSERT_TRUE(points[i].saturated_steps > 0u);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sim_freq_matches_transfer_function);
+    RUN_TEST(test_sim_freq_margins);
+    RUN_TEST(test_sim_freq_parallel_and_saturation);
+    RUN_TEST(test_sim_freq_plant_input_clamp);
+
+    return UNITY_END();
+}
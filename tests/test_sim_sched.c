@@ -0,0 +1,169 @@
+/*
+ * @file    test_sim_sched.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the work-stealing task scheduler
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../sim/sim_sched.h"
+#include "../sim/sim_thread.h"
+#include <string.h>
+
+#define MAX_TASKS        1000
+#define STEAL_TIMEOUT_NS 2000000000ull
+
+static unsigned runs[MAX_TASKS];
+static unsigned ran_on[MAX_TASKS];
+
+/* Set by a worker other than 0 when it runs a task of worker 0's block */
+static volatile int stolen_from_first_block;
+static size_t first_block_end;
+
+void setUp(void)
+{
+    memset(runs, 0, sizeof(runs));
+    memset(ran_on, 0, sizeof(ran_on));
+    stolen_from_first_block = 0;
+    first_block_end = 0;
+}
+
+void tearDown(void)
+{
+}
+
+/* Each task owns its slot, so no synchronization is needed */
+static void record_task(void *context, size_t task, unsigned worker)
+{
+    (void)context;
+    runs[task]++;
+    ran_on[task] = worker;
+}
+
+/* Task 0 blocks until another worker has stolen from its block */
+static void blocking_task(void *context, size_t task, unsigned worker)
+{
+    record_task(context, task, worker);
+
+    if (task < first_block_end && worker != 0) {
+        stolen_from_first_block = 1;
+    }
+    if (task == 0) {
+        uint64_t start = sim_now_ns();
+        while (!stolen_from_first_block && sim_now_ns() - start < STEAL_TIMEOUT_NS) {
+        }
+    }
+}
+
+static uint64_t total_tasks(const sim_sched_stats_t *stats)
+{
+    uint64_t total = 0;
+    for (unsigned w = 0; w < stats->workers; w++) {
+        total += stats->worker[w].tasks;
+    }
+    return total;
+}
+
+/* Test: Every task runs exactly once under both policies */
+void test_sim_sched_runs_every_task_once(void)
+{
+    const unsigned worker_counts[] = { 1, 3, 8 };
+    sim_sched_stats_t stats;
+
+    for (int policy = SIM_SCHED_STEAL; policy <= SIM_SCHED_STATIC; policy++) {
+        for (size_t i = 0; i < sizeof(worker_counts) / sizeof(worker_counts[0]); i++) {
+            memset(runs, 0, sizeof(runs));
+            TEST_ASSERT_EQUAL_UINT(worker_counts[i],
+                                   sim_sched_run(MAX_TASKS, worker_counts[i],
+                                                 (sim_sched_policy_t)policy,
+                                                 record_task, NULL, &stats));
+            for (size_t task = 0; task < MAX_TASKS; task++) {
+                TEST_ASSERT_EQUAL_UINT(1, runs[task]);
+            }
+            TEST_ASSERT_EQUAL_UINT32(worker_counts[i], stats.workers);
+            TEST_ASSERT_EQUAL_UINT64(MAX_TASKS, total_tasks(&stats));
+        }
+    }
+}
+
+/* Test: Static policy keeps contiguous blocks and never steals */
+void test_sim_sched_static_blocks(void)
+{
+    sim_sched_stats_t stats;
+
+    sim_sched_run(MAX_TASKS, 4, SIM_SCHED_STATIC, record_task, NULL, &stats);
+
+    for (size_t task = 0; task < MAX_TASKS; task++) {
+        TEST_ASSERT_EQUAL_UINT(task * 4 / MAX_TASKS, ran_on[task]);
+    }
+    for (unsigned w = 0; w < 4; w++) {
+        TEST_ASSERT_EQUAL_UINT64(MAX_TASKS / 4, stats.worker[w].tasks);
+        TEST_ASSERT_EQUAL_UINT64(0, stats.worker[w].steals);
+    }
+}
+
+/* Test: An idle worker steals from a worker stuck on a long task */
+void test_sim_sched_steals_from_busy_worker(void)
+{
+    sim_sched_stats_t stats;
+
+    first_block_end = 50;
+    sim_sched_run(100, 2, SIM_SCHED_STEAL, blocking_task, NULL, &stats);
+
+    TEST_ASSERT_TRUE(stolen_from_first_block);
+    TEST_ASSERT_TRUE(stats.worker[1].steals >= 1);
+    TEST_ASSERT_EQUAL_UINT64(100, total_tasks(&stats));
+    for (size_t task = 0; task < 100; task++) {
+        TEST_ASSERT_EQUAL_UINT(1, runs[task]);
+    }
+}
+
+/* Test: Utilization is busy time over wall time */
+void test_sim_sched_utilization(void)
+{
+    sim_sched_stats_t stats;
+
+    first_block_end = 50;
+    sim_sched_run(100, 2, SIM_SCHED_STEAL, blocking_task, NULL, &stats);
+
+    TEST_ASSERT_TRUE(stats.wall_ns > 0);
+    for (unsigned w = 0; w < stats.workers; w++) {
+        double utilization = sim_sched_utilization(&stats, w);
+        TEST_ASSERT_TRUE(utilization >= 0.0 && utilization <= 1.0);
+    }
+    // Worker 0 spent most of the run inside task 0
+    TEST_ASSERT_TRUE(sim_sched_utilization(&stats, 0) > 0.5);
+}
+
+/* Test: Degenerate task and worker counts */
+void test_sim_sched_edge_cases(void)
+{
+    sim_sched_stats_t stats;
+
+    TEST_ASSERT_EQUAL_UINT(1, sim_sched_run(0, 4, SIM_SCHED_STEAL, record_task, NULL, &stats));
+    TEST_ASSERT_EQUAL_UINT64(0, total_tasks(&stats));
+
+    TEST_ASSERT_EQUAL_UINT(1, sim_sched_run(1, 4, SIM_SCHED_STEAL, record_task, NULL, NULL));
+    TEST_ASSERT_EQUAL_UINT(1, runs[0]);
+
+    TEST_ASSERT_EQUAL_UINT(SIM_SCHED_MAX_WORKERS,
+                           sim_sched_run(MAX_TASKS, 1000, SIM_SCHED_STEAL, record_task, NULL, NULL));
+
+    unsigned workers = sim_sched_run(MAX_TASKS, 0, SIM_SCHED_STEAL, record_task, NULL, NULL);
+    TEST_ASSERT_TRUE(workers >= 1 && workers <= SIM_SCHED_MAX_WORKERS);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sim_sched_runs_every_task_once);
+    RUN_TEST(test_sim_sched_static_blocks);
+    RUN_TEST(test_sim_sched_steals_from_busy_worker);
+    RUN_TEST(test_sim_sched_utilization);
+    RUN_TEST(test_sim_sched_edge_cases);
+
+    return UNITY_END();
+}
@@ -0,0 +1,344 @@
+/*
+ * @file    test_sim_sweep.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the multithreaded gain sweep
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../sim/sim_sweep.h"
+#include <math.h>
+#include <string.h>
+
+#define MAX_CANDIDATES 256
+
+static sim_config_t base;
+static sim_sweep_t sweep;
+static sim_sweep_result_t results[MAX_CANDIDATES];
+static unsigned seen[MAX_CANDIDATES];
+static size_t received;
+static unsigned bad_batches;
+
+void setUp(void)
+{
+    sim_config_defaults(&base);
+    base.steps = 300;
+    sim_sweep_init(&sweep, &base);
+    memset(seen, 0, sizeof(seen));
+    received = 0;
+    bad_batches = 0;
+}
+
+void tearDown(void)
+{
+    TEST_ASSERT_EQUAL_UINT(0, bad_batches);
+}
+
+/* Callbacks are serialized, so plain stores are safe here. Runs on worker
+ * threads: problems are counted and asserted on the test thread. */
+static void collect(void *context, const sim_sweep_result_t *batch, size_t count)
+{
+    (void)context;
+    if (count < 1 || count > SIM_SWEEP_BATCH) {
+        bad_batches++;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (batch[i].index >= MAX_CANDIDATES) {
+            bad_batches++;
+            continue;
+        }
+        results[batch[i].index] = batch[i];
+        seen[batch[i].index]++;
+        received++;
+    }
+}
+
+/* Sink counting steps whose output motor_model_set_output() clamps */
+static void count_pinned(void *context, const telemetry_record_t *record)
+{
+    if (fabsf(record->output) > 1.0f) {
+        (*(uint32_t *)context)++;
+    }
+}
+
+static void set_grid(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.kp, "0.2:3:5"));
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.ki, "0:2:4"));
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.kd, "0:0.1:3"));
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.lpf, "0:0.8:2"));
+    TEST_ASSERT_NULL(sim_sweep_validate(&sweep));
+}
+
+/* Test: Axis specs parse as a single value or MIN:MAX:COUNT */
+void test_sim_sweep_axis_parse(void)
+{
+    sim_sweep_axis_t axis;
+
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&axis, "0.5"));
+    TEST_ASSERT_EQUAL_UINT32(1, axis.count);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, axis.min);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, axis.max);
+
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&axis, "0.1:2.5:25"));
+    TEST_ASSERT_EQUAL_UINT32(25, axis.count);
+    TEST_ASSERT_EQUAL_FLOAT(0.1f, axis.min);
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, axis.max);
+
+    TEST_ASSERT_EQUAL_INT(-1, sim_sweep_axis_parse(&axis, ""));
+    TEST_ASSERT_EQUAL_INT(-1, sim_sweep_axis_parse(&axis, "1:0:3"));
+    TEST_ASSERT_EQUAL_INT(-1, sim_sweep_axis_parse(&axis, "0:1:0"));
+    TEST_ASSERT_EQUAL_INT(-1, sim_sweep_axis_parse(&axis, "0:1"));
+    TEST_ASSERT_EQUAL_INT(-1, sim_sweep_axis_parse(&axis, "0:1:-2"));
+    TEST_ASSERT_EQUAL_INT(-1, sim_sweep_axis_parse(&axis, "0:1:3x"));
+}
+
+/* Test: Index order is kp-major, lpf-minor, with exact endpoints */
+void test_sim_sweep_config_mapping(void)
+{
+    sim_config_t config;
+
+    set_grid();
+    TEST_ASSERT_EQUAL(5 * 4 * 3 * 2, sim_sweep_size(&sweep));
+
+    sim_sweep_config(&sweep, 0, &config);
+    TEST_ASSERT_EQUAL_FLOAT(0.2f, config.kp);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, config.ki);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, config.kd);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, config.derivative_lpf);
+
+    // kp index 2, ki index 1, kd index 2, lpf index 1
+    sim_sweep_config(&sweep, ((2 * 4 + 1) * 3 + 2) * 2 + 1, &config);
+    TEST_ASSERT_EQUAL_FLOAT(1.6f, config.kp);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 2.0f / 3.0f, config.ki);
+    TEST_ASSERT_EQUAL_FLOAT(0.1f, config.kd);
+    TEST_ASSERT_EQUAL_FLOAT(0.8f, config.derivative_lpf);
+
+    sim_sweep_config(&sweep, sim_sweep_size(&sweep) - 1, &config);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, config.kp);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, config.ki);
+    TEST_ASSERT_EQUAL_UINT32(base.steps, config.steps);
+}
+
+/* Test: Parallel results are bit-identical to serial sim_run() */
+void test_sim_sweep_matches_serial(void)
+{
+    sim_config_t config;
+    sim_metrics_t expected;
+
+    set_grid();
+    TEST_ASSERT_EQUAL_UINT(4, sim_sweep_run(&sweep, 4, collect, NULL, NULL));
+    TEST_ASSERT_EQUAL(sim_sweep_size(&sweep), received);
+
+    for (size_t i = 0; i < sim_sweep_size(&sweep); i++) {
+        TEST_ASSERT_EQUAL_UINT(1, seen[i]);
+        sim_sweep_config(&sweep, i, &config);
+        memset(&expected, 0, sizeof(expected));
+        sim_run(&config, NULL, NULL, &expected);
+
+        TEST_ASSERT_EQUAL_FLOAT(config.kp, results[i].kp);
+        TEST_ASSERT_EQUAL_FLOAT(config.derivative_lpf, results[i].lpf);
+        TEST_ASSERT_EQUAL_MEMORY(&expected, &results[i].metrics, sizeof(expected));
+    }
+}
+
+/* Test: Monte-Carlo trials perturb the plant within the spread,
+ * independently of worker count and scheduling policy */
+void test_sim_sweep_monte_carlo(void)
+{
+    sim_sweep_result_t first[MAX_CANDIDATES];
+    sim_config_t config;
+
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.kp, "0.5:2:3"));
+    sweep.trials = 40;
+    sweep.plant_spread = 0.2f;
+    sweep.seed = 7;
+    TEST_ASSERT_NULL(sim_sweep_validate(&sweep));
+    TEST_ASSERT_EQUAL(120, sim_sweep_size(&sweep));
+
+    sweep.policy = SIM_SCHED_STATIC;
+    sim_sweep_run(&sweep, 1, collect, NULL, NULL);
+    memcpy(first, results, sizeof(first));
+
+    received = 0;
+    memset(seen, 0, sizeof(seen));
+    sweep.policy = SIM_SCHED_STEAL;
+    sim_sweep_run(&sweep, 5, collect, NULL, NULL);
+    TEST_ASSERT_EQUAL(120, received);
+
+    for (size_t i = 0; i < 120; i++) {
+        TEST_ASSERT_EQUAL_UINT(1, seen[i]);
+        TEST_ASSERT_EQUAL_UINT32(i % 40, results[i].trial);
+        TEST_ASSERT_EQUAL_FLOAT(first[i].kp, results[i].kp);
+        TEST_ASSERT_EQUAL_FLOAT(first[i].motor_gain, results[i].motor_gain);
+        TEST_ASSERT_EQUAL_FLOAT(first[i].motor_alpha, results[i].motor_alpha);
+        TEST_ASSERT_EQUAL_MEMORY(&first[i].metrics, &results[i].metrics, sizeof(results[i].metrics));
+
+        TEST_ASSERT_EQUAL_UINT32(i % 40, sim_sweep_config(&sweep, i, &config));
+        TEST_ASSERT_TRUE(fabsf(config.motor_gain / base.motor_gain - 1.0f) <= 0.2f + 1e-6f);
+        TEST_ASSERT_TRUE(fabsf(config.motor_alpha / base.motor_alpha - 1.0f) <= 0.2f + 1e-6f);
+    }
+    // Trials actually differ
+    TEST_ASSERT_TRUE(results[0].motor_gain != results[1].motor_gain);
+
+    // Spread pushing alpha past 1 is rejected
+    sweep.base.motor_alpha = 0.9f;
+    TEST_ASSERT_NOT_NULL(sim_sweep_validate(&sweep));
+}
+
+/* Test: Early termination ends settled runs and matches sim_run_until() */
+void test_sim_sweep_early_termination(void)
+{
+    sim_sweep_result_t full;
+    sim_config_t config;
+    sim_settle_stop_t stop;
+    sim_metrics_t expected;
+
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.kp, "0.5:3:6"));
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.ki, "1"));
+    sweep.base.profile.value[0] = 2.0f;
+    sweep.base.steps = 3000;
+    sweep.stop_band = 0.1f;
+    sweep.stop_hold = 20;
+    TEST_ASSERT_NULL(sim_sweep_validate(&sweep));
+
+    sim_sweep_run(&sweep, 3, collect, NULL, NULL);
+    TEST_ASSERT_EQUAL(6, received);
+
+    for (size_t i = 0; i < 6; i++) {
+        sim_sweep_config(&sweep, i, &config);
+        sim_settle_stop_init(&stop, 0.1f, 20, 0);
+        memset(&expected, 0, sizeof(expected));
+        sim_run_until(&config, NULL, NULL, sim_stop_settled, &stop, &expected);
+        TEST_ASSERT_EQUAL_MEMORY(&expected, &results[i].metrics, sizeof(expected));
+    }
+
+    // Every candidate settles well before the horizon
+    for (size_t i = 0; i < 6; i++) {
+        TEST_ASSERT_TRUE(results[i].metrics.steps_run < 1500);
+    }
+    sweep.stop_band = 0.0f;
+    sim_sweep_evaluate(&sweep, 5, &full);
+    TEST_ASSERT_EQUAL_UINT32(3000, full.metrics.steps_run);
+}
+
+/* Test: Closed-form sweeps match sim_run_closed_form() per candidate */
+void test_sim_sweep_closed_form(void)
+{
+    sim_config_t config;
+    sim_metrics_t expected;
+
+    set_grid();
+    sweep.base.steps = 2000;
+    sweep.base.profile.value[0] = 2.0f;
+    sweep.closed_form = 1;
+    TEST_ASSERT_NULL(sim_sweep_validate(&sweep));
+
+    sim_sweep_run(&sweep, 3, collect, NULL, NULL);
+    TEST_ASSERT_EQUAL(sim_sweep_size(&sweep), received);
+
+    for (size_t i = 0; i < sim_sweep_size(&sweep); i++) {
+        sim_sweep_config(&sweep, i, &config);
+        memset(&expected, 0, sizeof(expected));
+        sim_run_closed_form(&config, &expected);
+        TEST_ASSERT_EQUAL_MEMORY(&expected, &results[i].metrics, sizeof(expected));
+    }
+
+    // Closed-form spans cannot end a run early
+    sweep.stop_band = 0.1f;
+    TEST_ASSERT_NOT_NULL(sim_sweep_validate(&sweep));
+}
+
+/* Test: Worker count defaults to the processors and is capped by the grid */
+void test_sim_sweep_worker_count(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.kp, "0.5:1.5:3"));
+
+    TEST_ASSERT_EQUAL_UINT(3, sim_sweep_run(&sweep, 64, collect, NULL, NULL));
+    TEST_ASSERT_EQUAL(3, received);
+
+    received = 0;
+    unsigned workers = sim_sweep_run(&sweep, 0, collect, NULL, NULL);
+    TEST_ASSERT_TRUE(workers >= 1 && workers <= 3);
+    TEST_ASSERT_EQUAL(3, received);
+
+    // Single candidate: one worker, no threads
+    sim_sweep_init(&sweep, &base);
+    received = 0;
+    TEST_ASSERT_EQUAL_UINT(1, sim_sweep_run(&sweep, 8, collect, NULL, NULL));
+    TEST_ASSERT_EQUAL(1, received);
+}
+
+/* Test: Output limits wider than the motor's +/-1 input still count saturation */
+void test_sim_sweep_plant_input_saturation(void)
+{
+    sim_metrics_t metrics;
+    uint32_t pinned = 0;
+
+    sweep.base.out_min = -5.0f;
+    sweep.base.out_max = 5.0f;
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.kp, "0.5:3:4"));
+    TEST_ASSERT_NULL(sim_sweep_validate(&sweep));
+
+    sim_sweep_run(&sweep, 2, collect, NULL, NULL);
+    TEST_ASSERT_EQUAL(4, received);
+    for (size_t i = 0; i < 4; i++) {
+        // A 3-unit step drives every candidate's output past 1 at the start
+        TEST_ASSERT_TRUE(results[i].metrics.saturated_steps > 0u);
+    }
+
+    // Counted exactly when the plant input is clamped
+    base.out_min = -5.0f;
+    base.out_max = 5.0f;
+    base.kp = 3.0f;
+    sim_run(&base, count_pinned, &pinned, &metrics);
+    TEST_ASSERT_TRUE(pinned > 0u);
+    TEST_ASSERT_EQUAL_UINT32(pinned, metrics.saturated_steps);
+}
+
+/* Test: Invalid grids are reported before running */
+void test_sim_sweep_validate(void)
+{
+    TEST_ASSERT_NULL(sim_sweep_validate(&sweep));
+
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.lpf, "0:1.5:4"));
+    TEST_ASSERT_NOT_NULL(sim_sweep_validate(&sweep));
+
+    sim_sweep_init(&sweep, &base);
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.kd, "-0.1:0.1:3"));
+    TEST_ASSERT_NOT_NULL(sim_sweep_validate(&sweep));
+
+    sim_sweep_init(&sweep, &base);
+    sweep.ki.count = 0;
+    TEST_ASSERT_NOT_NULL(sim_sweep_validate(&sweep));
+
+    // Candidate count overflowing size_t (2^64 here) is refused, not wrapped
+    sim_sweep_init(&sweep, &base);
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.kp, "0:1:65536"));
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.ki, "0:1:65536"));
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.kd, "0:0.1:65536"));
+    TEST_ASSERT_EQUAL_INT(0, sim_sweep_axis_parse(&sweep.lpf, "0:0.5:65536"));
+    TEST_ASSERT_NOT_NULL(sim_sweep_validate(&sweep));
+    sweep.lpf.count = 1;
+    sweep.trials = 0xFFFFFFFFu;
+    TEST_ASSERT_NOT_NULL(sim_sweep_validate(&sweep));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sim_sweep_axis_parse);
+    RUN_TEST(test_sim_sweep_config_mapping);
+    RUN_TEST(test_sim_sweep_matches_serial);
+    RUN_TEST(test_sim_sweep_monte_carlo);
+    RUN_TEST(test_sim_sweep_early_termination);
+    RUN_TEST(test_sim_sweep_closed_form);
+    RUN_TEST(test_sim_sweep_worker_count);
+    RUN_TEST(test_sim_sweep_plant_input_saturation);
+    RUN_TEST(test_sim_sweep_validate);
+
+    return UNITY_END();
+}
@@ -0,0 +1,178 @@
+/*
+ * @file    test_telemetry.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit tests for the buffered binary telemetry writer
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/telemetry.h"
+#include <string.h>
+
+/* Records in the long run: three full buffers and a partial one */
+#define LONG_RECORDS (3u * TELEMETRY_BUFFER_RECORDS + 123u)
+
+/* Scratch file for the read-only stream of the error-path test */
+#define READ_ONLY_PATH "test_telemetry.bin"
+
+static telemetry_writer_t writer;
+static FILE *file;
+
+void setUp(void)
+{
+    file = tmpfile();
+    TEST_ASSERT_NOT_NULL(file);
+}
+
+void tearDown(void)
+{
+    if (file != NULL) {
+        fclose(file);
+    }
+}
+
+static uint32_t get_u32(const unsigned char *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+static float get_f32(const unsigned char *p)
+{
+    uint32_t bits = get_u32(p);
+    float value;
+
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/* Read @p size bytes at @p offset of the written stream */
+static void read_back(long offset, unsigned char *bytes, size_t size)
+{
+    TEST_ASSERT_EQUAL_INT(0, fseek(file, offset, SEEK_SET));
+    TEST_ASSERT_EQUAL_size_t(size, fread(bytes, 1, size, file));
+}
+
+/* Test: Header holds magic, version, sizes, sample time and field layout */
+void test_telemetry_header(void)
+{
+    static const unsigned char expected[16] = {
+        'P', 'I', 'D', 'T',
+        0x01, 0x00,                 /* version 1 */
+        0x40, 0x00,                 /* 64-byte header */
+        0x10, 0x00, 0x00, 0x00,     /* 16-byte records */
+        0x0A, 0xD7, 0x23, 0x3C      /* 0.01f = 0x3C23D70A */
+    };
+    static const char layout[] = "step:u4,setpoint:f4,measurement:f4,output:f4";
+    unsigned char header[TELEMETRY_HEADER_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(0, telemetry_open(&writer, file, 0.01f));
+    TEST_ASSERT_EQUAL_INT(0, telemetry_close(&writer));
+    TEST_ASSERT_EQUAL_INT32(TELEMETRY_HEADER_SIZE, ftell(file));
+
+    read_back(0, header, sizeof(header));
+    TEST_ASSERT_EQUAL_MEMORY(expected, header, sizeof(expected));
+    TEST_ASSERT_EQUAL_MEMORY(layout, header + 16, sizeof(layout));
+    for (size_t i = 16 + sizeof(layout); i < sizeof(header); i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, header[i]);
+    }
+}
+
+/* Test: Records are 16 little-endian bytes, written only when flushed */
+void test_telemetry_records(void)
+{
+    static const unsigned char expected[2][TELEMETRY_RECORD_SIZE] = {
+        { 0x00, 0x00, 0x00, 0x00,     /* step 0 */
+          0x00, 0x00, 0x40, 0x40,     /* 3.0f */
+          0x00, 0x00, 0x00, 0x00,     /* 0.0f */
+          0x00, 0x00, 0x80, 0x3F },   /* 1.0f */
+        { 0x04, 0x03, 0x02, 0x01,     /* step 0x01020304 */
+          0x00, 0x00, 0x00, 0xC0,     /* -2.0f */
+          0x00, 0x00, 0xC0, 0x3F,     /* 1.5f */
+          0x00, 0x00, 0x00, 0xBF }    /* -0.5f */
+    };
+    unsigned char records[2][TELEMETRY_RECORD_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(0, telemetry_open(&writer, file, 0.01f));
+    telemetry_write(&writer, 0, 3.0f, 0.0f, 1.0f);
+    telemetry_write(&writer, 0x01020304u, -2.0f, 1.5f, -0.5f);
+
+    // Buffered: nothing past the header until a flush
+    TEST_ASSERT_EQUAL_size_t(2 * TELEMETRY_RECORD_SIZE, writer.used);
+    TEST_ASSERT_EQUAL_INT(0, telemetry_flush(&writer));
+    TEST_ASSERT_EQUAL_size_t(0, writer.used);
+    TEST_ASSERT_EQUAL_INT(0, telemetry_close(&writer));
+    TEST_ASSERT_NULL(writer.file);
+
+    read_back(TELEMETRY_HEADER_SIZE, &records[0][0], sizeof(records));
+    TEST_ASSERT_EQUAL_MEMORY(expected, records, sizeof(expected));
+}
+
+/* Test: A run longer than the buffer is written out whole and in order */
+void test_telemetry_long_run(void)
+{
+    unsigned char record[TELEMETRY_RECORD_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(0, telemetry_open(&writer, file, 0.001f));
+    for (uint32_t n = 0; n < LONG_RECORDS; n++) {
+        telemetry_write(&writer, n, (float)n, 0.5f * (float)n, -(float)n);
+        // The buffer drains only when it is full
+        TEST_ASSERT_EQUAL_size_t(((n % TELEMETRY_BUFFER_RECORDS) + 1u) * TELEMETRY_RECORD_SIZE,
+                                 writer.used);
+    }
+    TEST_ASSERT_EQUAL_INT(0, telemetry_close(&writer));
+    TEST_ASSERT_EQUAL_INT(0, fseek(file, 0, SEEK_END));
+    TEST_ASSERT_EQUAL_INT32(TELEMETRY_HEADER_SIZE + LONG_RECORDS * TELEMETRY_RECORD_SIZE,
+                            ftell(file));
+
+    TEST_ASSERT_EQUAL_INT(0, fseek(file, TELEMETRY_HEADER_SIZE, SEEK_SET));
+    for (uint32_t n = 0; n < LONG_RECORDS; n++) {
+        TEST_ASSERT_EQUAL_size_t(sizeof(record), fread(record, 1, sizeof(record), file));
+        TEST_ASSERT_EQUAL_UINT32(n, get_u32(record));
+        TEST_ASSERT_EQUAL_FLOAT((float)n, get_f32(record + 4));
+        TEST_ASSERT_EQUAL_FLOAT(0.5f * (float)n, get_f32(record + 8));
+        TEST_ASSERT_EQUAL_FLOAT(-(float)n, get_f32(record + 12));
+    }
+}
+
+/* Test: Write errors are latched and reported by flush and close */
+void test_telemetry_write_errors(void)
+{
+    FILE *read_only;
+
+    read_only = fopen(READ_ONLY_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(read_only);
+    fclose(read_only);
+    read_only = fopen(READ_ONLY_PATH, "rb");
+    TEST_ASSERT_NOT_NULL(read_only);
+
+    // The header cannot be written to a read-only stream
+    TEST_ASSERT_EQUAL_INT(-1, telemetry_open(&writer, read_only, 0.01f));
+
+    // Records still buffer; the failed write of a full buffer drops it
+    for (uint32_t n = 0; n <= TELEMETRY_BUFFER_RECORDS; n++) {
+        telemetry_write(&writer, n, 1.0f, 0.0f, 0.5f);
+    }
+    TEST_ASSERT_EQUAL_size_t(TELEMETRY_RECORD_SIZE, writer.used);
+    TEST_ASSERT_EQUAL_INT(-1, telemetry_flush(&writer));
+    TEST_ASSERT_EQUAL_size_t(0, writer.used);
+    TEST_ASSERT_EQUAL_INT(-1, telemetry_close(&writer));
+    TEST_ASSERT_NULL(writer.file);
+
+    fclose(read_only);
+    remove(READ_ONLY_PATH);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_telemetry_header);
+    RUN_TEST(test_telemetry_records);
+    RUN_TEST(test_telemetry_long_run);
+    RUN_TEST(test_telemetry_write_errors);
+
+    return UNITY_END();
+}
@@ -0,0 +1,236 @@
+/*
+ * @file    test_telemetry_ring.c
+ * @author  Onesmo Ogore
+ * @date    11/19/2025
+ * @brief   Unit and thread stress tests for the SPSC telemetry ring
+ *
+ * Built twice by CMake: against the C99 barrier fallback and with C11
+ * atomics, so both synchronization paths are exercised.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _POSIX_C_SOURCE 200809L   /* pthreads under -std=c99/c11 */
+
+#include "Unity/src/unity.h"
+#include "../firmware/include/telemetry_ring.h"
+#include <pthread.h>
+
+#define RING_CAPACITY   256u
+#define STRESS_RECORDS  1000000u
+#define BATCH_SIZE      64u
+
+static telemetry_record_t storage[RING_CAPACITY];
+static telemetry_ring_t ring;
+
+void setUp(void)
+{
+    telemetry_ring_init(&ring, storage, RING_CAPACITY);
+}
+
+void tearDown(void)
+{
+}
+
+/* Record whose fields are all derived from the step, to detect torn reads */
+static telemetry_record_t make_record(uint32_t step)
+{
+    telemetry_record_t r;
+    r.step = step;
+    r.setpoint = (float)(step & 0xFFFFu);
+    r.measurement = (float)(step >> 16);
+    r.output = (float)(step % 977u);
+    return r;
+}
+
+static int record_consistent(const telemetry_record_t *r)
+{
+    telemetry_record_t expected = make_record(r->step);
+    return r->setpoint == expected.setpoint &&
+           r->measurement == expected.measurement &&
+           r->output == expected.output;
+}
+
+/* Test: A new ring is empty */
+void test_telemetry_ring_init_empty(void)
+{
+    telemetry_record_t out[4];
+
+    TEST_ASSERT_EQUAL_UINT32(0, telemetry_ring_count(&ring));
+    TEST_ASSERT_EQUAL_UINT32(0, telemetry_ring_dropped(&ring));
+    TEST_ASSERT_EQUAL(0, telemetry_ring_pop(&ring, out, 4));
+}
+
+/* Test: Records come out in FIFO order, in batches */
+void test_telemetry_ring_fifo_batches(void)
+{
+    telemetry_record_t out[RING_CAPACITY];
+
+    for (uint32_t i = 0; i < 10; i++) {
+        telemetry_record_t r = make_record(i);
+        TEST_ASSERT_EQUAL_INT(0, telemetry_ring_push(&ring, &r));
+    }
+    TEST_ASSERT_EQUAL_UINT32(10, telemetry_ring_count(&ring));
+
+    TEST_ASSERT_EQUAL(4, telemetry_ring_pop(&ring, out, 4));
+    TEST_ASSERT_EQUAL(6, telemetry_ring_pop(&ring, out + 4, RING_CAPACITY));
+
+    for (uint32_t i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i, out[i].step);
+        TEST_ASSERT_TRUE(record_consistent(&out[i]));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, telemetry_ring_count(&ring));
+}
+
+/* Test: Push into a full ring drops the record and counts it */
+void test_telemetry_ring_full_drops(void)
+{
+    telemetry_record_t out[RING_CAPACITY];
+
+    for (uint32_t i = 0; i < RING_CAPACITY; i++) {
+        telemetry_record_t r = make_record(i);
+        TEST_ASSERT_EQUAL_INT(0, telemetry_ring_push(&ring, &r));
+    }
+
+    telemetry_record_t extra = make_record(999);
+    TEST_ASSERT_EQUAL_INT(-1, telemetry_ring_push(&ring, &extra));
+    TEST_ASSERT_EQUAL_INT(-1, telemetry_ring_push(&ring, &extra));
+    TEST_ASSERT_EQUAL_UINT32(2, telemetry_ring_dropped(&ring));
+
+    // The ring still holds the original records, oldest first
+    TEST_ASSERT_EQUAL(RING_CAPACITY, telemetry_ring_pop(&ring, out, RING_CAPACITY));
+    TEST_ASSERT_EQUAL_UINT32(0, out[0].step);
+    TEST_ASSERT_EQUAL_UINT32(RING_CAPACITY - 1u, out[RING_CAPACITY - 1u].step);
+
+    // Space is available again after draining
+    TEST_ASSERT_EQUAL_INT(0, telemetry_ring_push(&ring, &extra));
+}
+
+/* Test: Fill level stays correct when the free-running indices wrap */
+void test_telemetry_ring_index_wraparound(void)
+{
+    telemetry_record_t out[RING_CAPACITY];
+
+    ring.head = 0xFFFFFFF0u;
+    ring.tail = 0xFFFFFFF0u;
+
+    for (uint32_t i = 0; i < 100; i++) {
+        telemetry_record_t r = make_record(i);
+        TEST_ASSERT_EQUAL_INT(0, telemetry_ring_push(&ring, &r));
+    }
+    TEST_ASSERT_EQUAL_UINT32(100, telemetry_ring_count(&ring));
+
+    TEST_ASSERT_EQUAL(100, telemetry_ring_pop(&ring, out, RING_CAPACITY));
+    for (uint32_t i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i, out[i].step);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/* Thread stress tests                                                        */
+/*----------------------------------------------------------------------------*/
+
+typedef struct {
+    int lossless;          /* 1: retry when full, 0: drop like an ISR would */
+    int done;              /* Set by the producer when finished */
+} stress_run_t;
+
+/* Give the other thread the CPU. sched_yield() is not enough: on a
+ * single-core host the scheduler may return straight to the spinning
+ * thread, costing a full time slice per hand-off */
+static void back_off(void)
+{
+    struct timespec pause = { 0, 1000 };
+    nanosleep(&pause, NULL);
+}
+
+static void *producer(void *arg)
+{
+    stress_run_t *run = (stress_run_t *)arg;
+
+    for (uint32_t step = 0; step < STRESS_RECORDS; step++) {
+        telemetry_record_t r = make_record(step);
+        while (telemetry_ring_push(&ring, &r) != 0 && run->lossless) {
+            back_off();
+        }
+    }
+    __atomic_store_n(&run->done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+/* Drain concurrently with the producer; returns records received or
+ * STRESS_RECORDS + 1 on the first ordering or consistency failure */
+static uint32_t consume(stress_run_t *run)
+{
+    telemetry_record_t batch[BATCH_SIZE];
+    uint32_t received = 0;
+    uint32_t next_min = 0;
+
+    for (;;) {
+        int finished = __atomic_load_n(&run->done, __ATOMIC_ACQUIRE);
+        size_t n = telemetry_ring_pop(&ring, batch, BATCH_SIZE);
+
+        for (size_t i = 0; i < n; i++) {
+            // Steps are strictly increasing, with gaps only when dropping
+            if (batch[i].step < next_min || !record_consistent(&batch[i]) ||
+                (run->lossless && batch[i].step != next_min)) {
+                return STRESS_RECORDS + 1u;
+            }
+            next_min = batch[i].step + 1u;
+        }
+        received += (uint32_t)n;
+
+        if (n == 0) {
+            if (finished) {
+                return received;
+            }
+            back_off();
+        }
+    }
+}
+
+static uint32_t run_stress(stress_run_t *run)
+{
+    pthread_t thread;
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, producer, run));
+    uint32_t received = consume(run);
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+    return received;
+}
+
+/* Test: Every record arrives exactly once and in order */
+void test_telemetry_ring_stress_lossless(void)
+{
+    stress_run_t run = { 1, 0 };
+
+    uint32_t received = run_stress(&run);
+
+    TEST_ASSERT_TRUE_MESSAGE(received <= STRESS_RECORDS, "Corrupt or reordered record");
+    TEST_ASSERT_EQUAL_UINT32(STRESS_RECORDS, received);
+}
+
+/* Test: A dropping producer loses records but never corrupts or reorders */
+void test_telemetry_ring_stress_dropping(void)
+{
+    stress_run_t run = { 0, 0 };
+
+    uint32_t received = run_stress(&run);
+
+    TEST_ASSERT_TRUE_MESSAGE(received <= STRESS_RECORDS, "Corrupt or reordered record");
+    TEST_ASSERT_EQUAL_UINT32(STRESS_RECORDS, received + telemetry_ring_dropped(&ring));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_telemetry_ring_init_empty);
+    RUN_TEST(test_telemetry_ring_fifo_batches);
+    RUN_TEST(test_telemetry_ring_full_drops);
+    RUN_TEST(test_telemetry_ring_index_wraparound);
+    RUN_TEST(test_telemetry_ring_stress_lossless);
+    RUN_TEST(test_telemetry_ring_stress_dropping);
+
+    return UNITY_END();
+}